@@ -0,0 +1,826 @@
+#include "anantadigital_core.hpp"
+#include "multi_venue_engine.hpp"
+#include "spectral_analyzer.hpp"
+#include "resampler.hpp"
+#include "offline_renderer.hpp"
+#include "spectral_synthesizer.hpp"
+#include "dome_texture_renderer.hpp"
+#include "worker_pool.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+using namespace AnantaDigital;
+using Clock = std::chrono::steady_clock;
+
+// Сводка по распределению времени обработки блока
+struct LatencySummary {
+    double p50_us;
+    double p99_us;
+    double max_us;
+};
+
+static LatencySummary summarize(std::vector<double> samples_us) {
+    std::sort(samples_us.begin(), samples_us.end());
+    auto percentile = [&](double p) {
+        size_t index = static_cast<size_t>(p * (samples_us.size() - 1));
+        return samples_us[index];
+    };
+    return LatencySummary{percentile(0.50), percentile(0.99), samples_us.back()};
+}
+
+static void printSummary(const std::string& label, const LatencySummary& summary) {
+    std::cout << "  " << std::left << std::setw(28) << label << std::right << std::fixed << std::setprecision(2)
+              << " p50=" << std::setw(8) << summary.p50_us << " us"
+              << " p99=" << std::setw(8) << summary.p99_us << " us"
+              << " max=" << std::setw(9) << summary.max_us << " us" << std::endl;
+}
+
+// Задержка аудио-потока при параллельных правках из управляющего потока
+static void benchmarkSnapshots() {
+    const double sample_rate = 48000.0;
+    const size_t block = 64;
+    const size_t field_count = 512;
+    const int blocks = 20000;
+
+    std::cout << "\n[snapshots] processBlock latency, " << field_count << " fields, "
+              << block << "-frame blocks" << std::endl;
+
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    core.prepareBlockProcessing(sample_rate, block);
+
+    for (size_t i = 0; i < field_count; ++i) {
+        SphericalCoord position{1.0 + 0.01 * i, M_PI / 2, 0.0, 1.0};
+        core.processSoundField(core.createQuantumSoundField(100.0 + i, position, QuantumSoundState::COHERENT));
+    }
+
+    std::vector<float> output(block);
+    auto runAudio = [&]() {
+        std::vector<double> samples_us;
+        samples_us.reserve(blocks);
+        for (int b = 0; b < blocks; ++b) {
+            auto start = Clock::now();
+            core.processBlock(nullptr, output.data(), block);
+            auto end = Clock::now();
+            samples_us.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        return samples_us;
+    };
+
+    printSummary("idle control thread", summarize(runAudio()));
+
+    // Управляющий поток правит поля несколько тысяч раз в секунду
+    std::atomic<bool> running(true);
+    std::atomic<long> edits(0);
+    std::thread control([&]() {
+        size_t i = 0;
+        while (running.load(std::memory_order_relaxed)) {
+            SphericalCoord position{1.0 + 0.01 * (i % field_count), M_PI / 2, 0.0, 1.0};
+            core.processSoundField(core.createQuantumSoundField(100.0 + (i % 977), position,
+                                                                QuantumSoundState::COHERENT));
+            edits.fetch_add(1, std::memory_order_relaxed);
+            ++i;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+
+    auto start = Clock::now();
+    auto busy = summarize(runAudio());
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    running.store(false);
+    control.join();
+    core.collectRetiredSnapshots();
+
+    printSummary("control thread editing", busy);
+    std::cout << "  edits/s during run: " << std::setprecision(0) << edits.load() / seconds << std::endl;
+}
+
+// Пакетная обработка нескольких куполов на пуле потоков
+static void benchmarkVenues() {
+    const double sample_rate = 48000.0;
+    const size_t block = 64;
+    const size_t venue_count = 24;
+    const size_t fields_per_venue = 256;
+    const int blocks = 2000;
+
+    std::cout << "\n[venues] " << venue_count << " domes x " << fields_per_venue << " fields, "
+              << block << "-frame blocks" << std::endl;
+
+    MultiVenueEngine engine;
+    for (size_t v = 0; v < venue_count; ++v) {
+        auto core = std::make_unique<AnantaDigitalCore>(10.0, 5.0);
+        core->initialize();
+        engine.addVenue(std::move(core));
+    }
+    engine.prepare(sample_rate, block);
+
+    for (size_t v = 0; v < venue_count; ++v) {
+        AnantaDigitalCore* core = engine.getVenue(v);
+        for (size_t i = 0; i < fields_per_venue; ++i) {
+            SphericalCoord position{1.0 + 0.01 * i, M_PI / 2, 0.0, 1.0};
+            core->processSoundField(core->createQuantumSoundField(100.0 + i + v, position, QuantumSoundState::COHERENT));
+        }
+    }
+
+    std::vector<std::vector<float>> buffers(venue_count, std::vector<float>(block));
+    std::vector<float*> outputs(venue_count);
+    for (size_t v = 0; v < venue_count; ++v) {
+        outputs[v] = buffers[v].data();
+    }
+
+    std::vector<double> samples_us;
+    samples_us.reserve(blocks);
+    for (int b = 0; b < blocks; ++b) {
+        auto start = Clock::now();
+        engine.processBlock(nullptr, outputs.data(), block);
+        samples_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+
+    printSummary("block wall time", summarize(samples_us));
+    std::cout << "  workers: " << engine.getWorkerCount()
+              << ", block period: " << std::setprecision(2) << 1e6 * block / sample_rate << " us" << std::endl;
+
+    double total_load = 0.0;
+    for (size_t v = 0; v < venue_count; ++v) {
+        auto stats = engine.getVenueStatistics(v);
+        total_load += stats.cpu_load;
+        if (v < 4) {
+            std::cout << "  venue " << v << ": avg " << stats.average_cpu_us << " us cpu, peak "
+                      << stats.peak_cpu_us << " us, load " << 100.0 * stats.cpu_load << "%, worker "
+                      << stats.last_worker << " (home " << stats.home_worker << ")" << std::endl;
+        }
+    }
+    std::cout << "  total load: " << 100.0 * total_load << "% of one core" << std::endl;
+}
+
+// Потоковый анализ STFT: 48 кГц, стерео, бюджет 5 мс на блок
+static void benchmarkSTFT() {
+    const double sample_rate = 48000.0;
+    const size_t block = 512;
+    const size_t channels = 2;
+    const int blocks = 2000;
+    const double budget_us = 5000.0;
+
+    std::cout << "\n[stft] 2048-point STFT, hop 512, " << channels << " channels, "
+              << block << "-frame blocks" << std::endl;
+
+    std::vector<std::unique_ptr<SpectralAnalyzer>> analyzers;
+    for (size_t c = 0; c < channels; ++c) {
+        analyzers.push_back(std::make_unique<SpectralAnalyzer>(2048, 512, WindowType::HANN));
+        analyzers.back()->setSampleRate(sample_rate);
+    }
+
+    // Многотональный сигнал с шумом
+    std::vector<std::vector<float>> input(channels, std::vector<float>(block));
+    std::vector<std::vector<float>> output(channels, std::vector<float>(block));
+    uint32_t noise = 12345;
+    auto fillBlock = [&](int b) {
+        for (size_t c = 0; c < channels; ++c) {
+            for (size_t i = 0; i < block; ++i) {
+                double t = static_cast<double>(b * block + i) / sample_rate;
+                noise = noise * 1664525u + 1013904223u;
+                double white = (static_cast<double>(noise >> 8) / 16777216.0 - 0.5) * 0.01;
+                input[c][i] = static_cast<float>(0.4 * std::sin(2.0 * M_PI * (220.0 + 110.0 * c) * t) +
+                                                 0.2 * std::sin(2.0 * M_PI * 1234.5 * t) +
+                                                 0.1 * std::sin(2.0 * M_PI * 5000.0 * t) + white);
+            }
+        }
+    };
+
+    std::vector<double> analysis_us;
+    std::vector<double> resynthesis_us;
+    analysis_us.reserve(blocks);
+    resynthesis_us.reserve(blocks);
+    size_t peaks = 0;
+    for (int b = 0; b < blocks; ++b) {
+        fillBlock(b);
+
+        auto start = Clock::now();
+        for (size_t c = 0; c < channels; ++c) {
+            analyzers[c]->process(input[c].data(), block);
+            peaks += analyzers[c]->getPeaks().size();
+        }
+        analysis_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+
+        start = Clock::now();
+        for (size_t c = 0; c < channels; ++c) {
+            analyzers[c]->process(input[c].data(), output[c].data(), block);
+        }
+        resynthesis_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+
+    printSummary("analysis + peaks", summarize(analysis_us));
+    printSummary("analysis + overlap-add", summarize(resynthesis_us));
+
+    // Полный путь ядра: анализ и обновление полей из пиков
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    core.prepareBlockProcessing(sample_rate, block);
+    std::vector<double> signal(block);
+    std::vector<double> core_us;
+    core_us.reserve(blocks);
+    for (int b = 0; b < blocks; ++b) {
+        fillBlock(b);
+        signal.assign(input[0].begin(), input[0].end());
+        auto start = Clock::now();
+        core.processInterferenceField(signal);
+        core_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    core.collectRetiredSnapshots();
+
+    auto core_summary = summarize(core_us);
+    printSummary("processInterferenceField", core_summary);
+    std::cout << "  average peaks/frame: " << std::setprecision(1)
+              << static_cast<double>(peaks) / (blocks * channels)
+              << ", input fields: " << core.getInputFieldCount()
+              << ", budget: " << std::setprecision(0) << budget_us << " us, block period: "
+              << std::setprecision(2) << 1e6 * block / sample_rate << " us" << std::endl;
+}
+
+// Многоканальный рендер: до 128 громкоговорителей на одном ядре, 48 кГц
+static void benchmarkSpeakers() {
+    const double sample_rate = 48000.0;
+    const size_t block = 256;
+    const int blocks = 400;
+
+    std::cout << "\n[speakers] interleaved dome rendering, " << block << "-frame blocks" << std::endl;
+
+    for (size_t channels : {32u, 64u, 128u}) {
+        for (size_t field_count : {16u, 64u}) {
+            AnantaDigitalCore core(10.0, 5.0);
+            core.initialize();
+            core.prepareBlockProcessing(sample_rate, block);
+
+            // Кольца громкоговорителей по высоте купола
+            std::vector<SphericalCoord> speakers;
+            for (size_t s = 0; s < channels; ++s) {
+                double elevation = (M_PI / 2) * (0.1 + 0.8 * static_cast<double>(s % 4) / 4.0);
+                speakers.push_back(SphericalCoord{10.0, elevation, 2.0 * M_PI * s / channels, 0.0});
+            }
+            core.prepareSpeakerRendering(speakers);
+
+            for (size_t i = 0; i < field_count; ++i) {
+                SphericalCoord position{1.0 + 0.1 * i, M_PI / 3, 0.4 * i, 1.0};
+                core.processSoundField(core.createQuantumSoundField(100.0 + 37.0 * i, position,
+                                                                    QuantumSoundState::COHERENT));
+            }
+
+            std::vector<float> output(block * channels);
+            std::vector<double> samples_us;
+            samples_us.reserve(blocks);
+            for (int b = 0; b < blocks; ++b) {
+                auto start = Clock::now();
+                core.processBlockInterleaved(nullptr, output.data(), block);
+                samples_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            }
+            core.collectRetiredSnapshots();
+
+            auto summary = summarize(samples_us);
+            printSummary(std::to_string(channels) + " ch x " + std::to_string(field_count) + " fields", summary);
+            std::cout << "    load " << std::setprecision(1)
+                      << 100.0 * summary.p50_us / (1e6 * block / sample_rate) << "% of one core" << std::endl;
+        }
+    }
+}
+
+// Шина Ambisonics: стоимость блока в зависимости от порядка при 64 источниках
+static void benchmarkAmbisonics() {
+    const double sample_rate = 48000.0;
+    const size_t block = 256;
+    const size_t field_count = 64;
+    const int blocks = 400;
+
+    std::cout << "\n[hoa] ambisonic dome rendering, " << field_count << " fields, "
+              << block << "-frame blocks" << std::endl;
+
+    for (size_t channels : {64u, 128u}) {
+        for (int order : {1, 3, 5, 7}) {
+            AnantaDigitalCore core(10.0, 5.0);
+            core.initialize();
+            core.prepareBlockProcessing(sample_rate, block);
+
+            std::vector<SphericalCoord> speakers;
+            for (size_t s = 0; s < channels; ++s) {
+                double elevation = (M_PI / 2) * (0.1 + 0.8 * static_cast<double>(s % 4) / 4.0);
+                speakers.push_back(SphericalCoord{10.0, elevation, 2.0 * M_PI * s / channels, 0.0});
+            }
+            core.prepareAmbisonicRendering(speakers, order);
+
+            for (size_t i = 0; i < field_count; ++i) {
+                SphericalCoord position{1.0 + 0.1 * i, M_PI / 3, 0.4 * i, 1.0};
+                core.processSoundField(core.createQuantumSoundField(100.0 + 37.0 * i, position,
+                                                                    QuantumSoundState::COHERENT));
+            }
+
+            std::vector<float> output(block * channels);
+            std::vector<double> samples_us;
+            samples_us.reserve(blocks);
+            for (int b = 0; b < blocks; ++b) {
+                auto start = Clock::now();
+                core.processBlockInterleaved(nullptr, output.data(), block);
+                samples_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            }
+            core.collectRetiredSnapshots();
+
+            auto summary = summarize(samples_us);
+            printSummary(std::to_string(channels) + " ch, order " + std::to_string(order), summary);
+            std::cout << "    load " << std::setprecision(1)
+                      << 100.0 * summary.p50_us / (1e6 * block / sample_rate) << "% of one core" << std::endl;
+        }
+    }
+}
+
+// Преобразователь частоты: скорость, задержка, точность синуса и подавление наложения
+static void benchmarkResampler() {
+    std::cout << "\n[resample] polyphase sample-rate conversion, 1 s of audio per run" << std::endl;
+
+    struct Ratio { double in, out; };
+    const Ratio ratios[] = {{44100.0, 48000.0}, {48000.0, 44100.0}, {48000.0, 96000.0}, {96000.0, 48000.0}};
+    const std::pair<ResamplerQuality, const char*> qualities[] = {
+        {ResamplerQuality::FAST, "fast"}, {ResamplerQuality::STANDARD, "standard"}, {ResamplerQuality::HIGH, "high"}};
+
+    for (const auto& ratio : ratios) {
+        for (const auto& quality : qualities) {
+            PolyphaseResampler resampler;
+            resampler.configure(ratio.in, ratio.out, quality.first);
+            resampler.prepare(512);
+
+            // Синус 1 кГц: ошибка относительно идеального с учетом задержки
+            const size_t frames = static_cast<size_t>(ratio.in);
+            std::vector<float> input(frames);
+            for (size_t t = 0; t < frames; ++t) {
+                input[t] = static_cast<float>(0.5 * std::sin(2.0 * M_PI * 1000.0 * t / ratio.in));
+            }
+            std::vector<float> output(resampler.getMaxOutputFrames(frames));
+
+            auto start = Clock::now();
+            size_t produced = 0;
+            for (size_t offset = 0; offset < frames; offset += 512) {
+                size_t count = std::min<size_t>(512, frames - offset);
+                produced += resampler.process(input.data() + offset, count, output.data() + produced);
+            }
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            const size_t skip = static_cast<size_t>(4.0 * resampler.getLatencyFrames() * ratio.out / ratio.in) + 16;
+            double signal = 0.0, error = 0.0;
+            for (size_t t = skip; t < produced; ++t) {
+                double expected = 0.5 * std::sin(2.0 * M_PI * 1000.0 * (t / ratio.out - resampler.getLatencySeconds()));
+                signal += expected * expected;
+                error += (output[t] - expected) * (output[t] - expected);
+            }
+
+            // Наложение (понижение) или зеркальная полоса (повышение): тон, отражение
+            // которого попадает в полосу выхода, и уровень на частоте отражения
+            const bool downsampling = ratio.out < ratio.in;
+            const double tone = downsampling ? 0.55 * ratio.out : 0.3 * ratio.in;
+            const double image = downsampling ? ratio.out - tone : ratio.in - tone;
+            for (size_t t = 0; t < frames; ++t) {
+                input[t] = static_cast<float>(0.5 * std::sin(2.0 * M_PI * tone * t / ratio.in));
+            }
+            resampler.reset();
+            size_t artifact_frames = resampler.process(input.data(), frames, output.data());
+            double re = 0.0, im = 0.0;
+            for (size_t t = skip; t < artifact_frames; ++t) {
+                re += output[t] * std::cos(2.0 * M_PI * image * t / ratio.out);
+                im += output[t] * std::sin(2.0 * M_PI * image * t / ratio.out);
+            }
+            double artifact = 2.0 * std::sqrt(re * re + im * im) / (artifact_frames - skip);
+
+            std::cout << "  " << std::setw(6) << ratio.in / 1000.0 << " -> " << std::setw(5) << ratio.out / 1000.0
+                      << " kHz " << std::setw(8) << quality.second
+                      << "  taps " << std::setw(4) << resampler.getTapsPerPhase()
+                      << "  latency " << std::setprecision(2) << std::fixed << std::setw(5)
+                      << 1000.0 * resampler.getLatencySeconds() << " ms"
+                      << "  SNR " << std::setprecision(1) << std::setw(6) << -10.0 * std::log10(error / signal) << " dB"
+                      << "  rejection " << std::setw(6) << -20.0 * std::log10(artifact / 0.5 + 1e-12) << " dB"
+                      << "  " << std::setprecision(0) << std::setw(5) << 1.0 / seconds << "x realtime"
+                      << std::defaultfloat << std::setprecision(6) << std::endl;
+        }
+    }
+}
+
+static void benchmarkOffline() {
+    std::cout << "\n[offline] chunk-parallel offline render, 60 s of audio at 48 kHz" << std::endl;
+
+    const double sample_rate = 48000.0;
+    std::vector<float> input(static_cast<size_t>(60.0 * sample_rate));
+    for (size_t t = 0; t < input.size(); ++t) {
+        input[t] = static_cast<float>(0.3 * std::sin(2.0 * M_PI * 440.0 * t / sample_rate) +
+                                      0.2 * std::sin(2.0 * M_PI * 1870.0 * t / sample_rate));
+    }
+    std::vector<float> output;
+
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> worker_counts = {1, std::min<size_t>(4, hardware), hardware};
+    worker_counts.erase(std::unique(worker_counts.begin(), worker_counts.end()), worker_counts.end());
+    for (size_t workers : worker_counts) {
+        OfflineRenderer renderer([] { return std::make_unique<AnantaDigitalCore>(10.0, 5.0); }, workers);
+        OfflineRenderSettings settings;
+        settings.sample_rate = sample_rate;
+        settings.chunk_frames = 1 << 18;
+        renderer.setSettings(settings);
+
+        // Сообщения инициализации ядер фрагментов не выводятся
+        std::ostringstream silenced;
+        std::streambuf* previous = std::cout.rdbuf(silenced.rdbuf());
+        OfflineRenderReport report = renderer.render(input, output);
+        std::cout.rdbuf(previous);
+
+        std::cout << "  workers " << std::setw(3) << report.workers
+                  << "  chunks " << std::setw(3) << report.chunks
+                  << "  warm-up overhead " << std::setprecision(1) << std::fixed << std::setw(4)
+                  << 100.0 * (static_cast<double>(report.processed_frames) / report.frames - 1.0) << " %"
+                  << "  catch-up " << std::setw(6)
+                  << 100.0 * static_cast<double>(report.advanced_frames) / report.frames << " %"
+                  << "  wall " << std::setprecision(2) << std::setw(6) << report.wall_seconds << " s"
+                  << "  " << std::setprecision(1) << std::setw(7) << report.real_time_factor << "x realtime"
+                  << std::defaultfloat << std::setprecision(6) << std::endl;
+    }
+}
+
+static void benchmarkGraph() {
+    std::cout << "\n[graph] processAudioSignal dataflow graph, 32 interference fields x 400 sources" << std::endl;
+
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> thread_counts = {1, std::min<size_t>(4, hardware), hardware};
+    thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+
+    for (bool pipelined : {false, true}) {
+        for (size_t threads : thread_counts) {
+            std::ostringstream silenced;
+            std::streambuf* previous = std::cout.rdbuf(silenced.rdbuf());
+            AnantaDigitalCore core(10.0, 5.0);
+            core.initialize();
+            std::cout.rdbuf(previous);
+
+            core.setProcessingThreads(threads);
+            core.setPipelinedProcessing(pipelined);
+            for (int k = 0; k < 32; ++k) {
+                SphericalCoord center{1.0 + 0.2 * k, M_PI / 3, 0.2 * k, 1.0};
+                auto field = std::make_unique<InterferenceField>(InterferenceFieldType::CONSTRUCTIVE, center, 2.0);
+                for (int s = 0; s < 400; ++s) {
+                    field->addSourceField(core.createQuantumSoundField(100.0 + s, center, QuantumSoundState::SUPERPOSITION));
+                }
+                core.addInterferenceField(std::move(field));
+            }
+
+            std::vector<double> input(1024);
+            std::vector<double> samples;
+            for (int block = 0; block < 300; ++block) {
+                for (size_t t = 0; t < input.size(); ++t) {
+                    input[t] = 0.5 * std::sin(2.0 * M_PI * 880.0 * (block * 1024.0 + t) / core.getSampleRate());
+                }
+                auto start = Clock::now();
+                core.processAudioSignal(input);
+                samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            }
+            samples.erase(samples.begin(), samples.begin() + 20);
+
+            std::ostringstream label;
+            label << (pipelined ? "pipelined, " : "in-block, ") << threads << " threads";
+            printSummary(label.str(), summarize(samples));
+        }
+    }
+}
+
+static void benchmarkCulling() {
+    const double sample_rate = 48000.0;
+    const size_t block = 512;
+    const size_t field_count = 10000;
+    std::cout << "\n[culling] processBlock with " << field_count << " fields, " << block
+              << "-frame blocks (" << std::fixed << std::setprecision(0) << 1e6 * block / sample_rate
+              << " us)" << std::defaultfloat << std::setprecision(6) << std::endl;
+
+    PoolLimits limits;
+    limits.max_fields = field_count;
+    std::ostringstream silenced;
+    std::streambuf* previous = std::cout.rdbuf(silenced.rdbuf());
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize(limits);
+    std::cout.rdbuf(previous);
+    core.prepareBlockProcessing(sample_rate, block);
+
+    // Треть полей рядом со слушателем, остальные — 32 дальних группы по 2 м
+    // на 12 высотах тона; уровни от 0 до -90 дБ. Отбор выключен на время заполнения.
+    CullingSettings off;
+    off.enabled = false;
+    core.setCulling(off);
+    auto fraction = [](double x) { return x - std::floor(x); };
+    for (size_t i = 0; i < field_count; ++i) {
+        SphericalCoord position{2.0 + 18.0 * fraction(i * 0.618034), M_PI * fraction(i * 0.414214), 0.37 * i, 0.0};
+        double frequency = 110.0 * std::pow(2.0, static_cast<double>(i % 96) / 12.0);
+        if (i % 3 != 0) {
+            const size_t group = i % 32;
+            position = SphericalCoord{60.0 + 3.0 * group + 2.0 * fraction(i * 0.7548777), 0.3 + 0.08 * group,
+                                      0.2 * group + 0.02 * fraction(i * 0.5698403), 0.0};
+            frequency = 220.0 * std::pow(2.0, static_cast<double>(i % 12) / 12.0);
+        }
+        QuantumSoundField field = core.createQuantumSoundField(frequency, position, QuantumSoundState::COHERENT);
+        field.amplitude = std::pow(10.0, -4.5 * fraction(i * 0.3819660));
+        core.processSoundField(field);
+    }
+
+    std::vector<float> output(block);
+    auto run = [&](const std::string& label, const CullingSettings& settings) {
+        core.setCulling(settings);
+        std::vector<double> samples_us;
+        for (int b = 0; b < 400; ++b) {
+            auto start = Clock::now();
+            core.processBlock(nullptr, output.data(), block);
+            samples_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+        samples_us.erase(samples_us.begin(), samples_us.begin() + 100);
+        printSummary(label, summarize(samples_us));
+        const CullingStatistics stats = core.getCullingStatistics();
+        std::cout << "    fields " << stats.fields << "  voices " << core.getRealtimeVoiceCount()
+                  << " (planned " << stats.voices << ", silent " << stats.culled_silent
+                  << ", masked " << stats.culled_masked << ", merged " << stats.merged << ")" << std::endl;
+    };
+
+    run("no culling", off);
+    CullingSettings culling;
+    run("culling", culling);
+    culling.cpu_budget = 0.05;
+    run("culling, 5 % CPU budget", culling);
+}
+
+static void benchmarkSpectralSynthesis() {
+    const double sample_rate = 48000.0;
+    const size_t block = 1024;
+    std::cout << "\n[ifft] " << block << "-frame blocks, oscillator bank vs inverse FFT ("
+              << SpectralSynthesizer().getFrameSize() << "-point frames)" << std::endl;
+
+    for (size_t partials : {64, 256, 1024, 4096, 16384}) {
+        OscillatorBank oscillators(sample_rate), spectral_bank(sample_rate);
+        for (size_t i = 0; i < partials; ++i) {
+            const double frequency = 50.0 + std::fmod(i * 137.3, 18000.0);
+            oscillators.addOscillator(frequency, 0.01, 0.7 * i);
+            spectral_bank.addOscillator(frequency, 0.01, 0.7 * i);
+        }
+        SpectralSynthesizer synthesizer;
+        synthesizer.prime(spectral_bank);
+
+        std::vector<float> output(block);
+        std::vector<double> bank_us, spectral_us;
+        for (int b = 0; b < 100; ++b) {
+            auto start = Clock::now();
+            oscillators.render(output.data(), block);
+            bank_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            start = Clock::now();
+            synthesizer.render(spectral_bank, output.data(), block);
+            spectral_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+
+        printSummary(std::to_string(partials) + " partials, oscillators", summarize(bank_us));
+        printSummary(std::to_string(partials) + " partials, inverse FFT", summarize(spectral_us));
+    }
+}
+
+static void benchmarkBatchInterference() {
+    const size_t point_count = 100000;
+    const size_t source_count = 64;
+    std::cout << "\n[batch] calculateInterference over " << point_count << " observer points, "
+              << source_count << " sources" << std::endl;
+
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord{0.0, 0.0, 0.0, 0.0}, 20.0);
+    for (size_t i = 0; i < source_count; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.2 + 0.01 * i, 0.0);
+        source.frequency = 110.0 + 37.0 * i;
+        source.position = SphericalCoord{3.0 + 0.1 * i, 0.3 + 0.02 * i, 0.7 * i, 0.0};
+        field.addSourceField(source);
+    }
+
+    // Сетка слушателей превью: полусфера радиусом до 15 м
+    std::vector<double> r(point_count), theta(point_count), phi(point_count);
+    for (size_t i = 0; i < point_count; ++i) {
+        r[i] = 1.0 + 14.0 * (i % 100) / 100.0;
+        theta[i] = 0.5 * M_PI * ((i / 100) % 31) / 31.0;
+        phi[i] = 2.0 * M_PI * (i / 3100) / 33.0;
+    }
+    ObserverBatch batch;
+    batch.r = r.data();
+    batch.theta = theta.data();
+    batch.phi = phi.data();
+    batch.common_time = 1.5;
+    batch.count = point_count;
+    std::vector<std::complex<double>> out(point_count);
+
+    auto report = [](const std::string& label, double seconds) {
+        std::cout << "  " << std::left << std::setw(28) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << seconds * 1e3 << " ms" << std::defaultfloat << std::setprecision(6) << std::endl;
+    };
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < point_count; ++i) {
+        out[i] = field.calculateInterference(SphericalCoord{r[i], theta[i], phi[i], 0.0}, batch.common_time);
+    }
+    report("per point", std::chrono::duration<double>(Clock::now() - start).count());
+
+    // Декартовы точки: без тригонометрии ни на точку, ни на источник
+    std::vector<Kernels::CartesianPoint<double>> points(point_count);
+    std::vector<double> x(point_count), y(point_count), z(point_count);
+    for (size_t i = 0; i < point_count; ++i) {
+        points[i] = Kernels::toCartesian<double>(SphericalCoord{r[i], theta[i], phi[i], 0.0});
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        z[i] = points[i].z;
+    }
+    start = Clock::now();
+    for (size_t i = 0; i < point_count; ++i) {
+        out[i] = field.calculateInterference(points[i], batch.common_time);
+    }
+    report("per point, Cartesian", std::chrono::duration<double>(Clock::now() - start).count());
+
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> thread_counts = {1, std::min<size_t>(4, hardware), hardware};
+    thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+    for (size_t threads : thread_counts) {
+        WorkerPool pool(threads);
+        start = Clock::now();
+        field.calculateInterferenceBatch(batch, out.data(), &pool);
+        report("batch, " + std::to_string(threads) + " threads", std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    batch.x = x.data();
+    batch.y = y.data();
+    batch.z = z.data();
+    start = Clock::now();
+    field.calculateInterferenceBatch(batch, out.data());
+    report("batch, Cartesian", std::chrono::duration<double>(Clock::now() - start).count());
+}
+
+static void benchmarkInterferenceStream() {
+    const double sample_rate = 48000.0;
+    const size_t frames = 48000;
+    const size_t source_count = 256;
+    std::cout << "\n[stream] one second of interference at a listener, " << source_count << " sources" << std::endl;
+
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord{0.0, 0.0, 0.0, 0.0}, 20.0);
+    for (size_t i = 0; i < source_count; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.05, 0.0);
+        source.frequency = 80.0 + 41.0 * i;
+        source.position = SphericalCoord{3.0 + 0.05 * i, 0.3 + 0.004 * i, 0.7 * i, 0.0};
+        field.addSourceField(source);
+    }
+    const SphericalCoord listener{2.0, 1.0, 0.5, 1.2};
+    std::vector<std::complex<double>> out(frames);
+
+    auto report = [](const std::string& label, double seconds) {
+        std::cout << "  " << std::left << std::setw(28) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << seconds * 1e3 << " ms" << std::defaultfloat << std::setprecision(6) << std::endl;
+    };
+
+    auto start = Clock::now();
+    for (size_t t = 0; t < frames; ++t) {
+        out[t] = field.calculateInterference(listener, t / sample_rate);
+    }
+    report("calculateInterference", std::chrono::duration<double>(Clock::now() - start).count());
+
+    InterferenceStream stream;
+    start = Clock::now();
+    stream.prepare(field, listener, 0.0, sample_rate);
+    for (size_t t = 0; t < frames; t += 512) {
+        stream.render(out.data() + t, std::min<size_t>(512, frames - t));
+    }
+    report("InterferenceStream", std::chrono::duration<double>(Clock::now() - start).count());
+}
+
+static void benchmarkSourceOctree() {
+    const size_t source_count = 20000;
+    const size_t point_count = 1000;
+    std::cout << "\n[octree] " << source_count << " sources on 4 shared frequencies, " << point_count
+              << " distant listeners" << std::endl;
+
+    InterferenceField exact(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord{0.0, 0.0, 0.0, 0.0}, 15.0);
+    InterferenceField fast(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord{0.0, 0.0, 0.0, 0.0}, 15.0);
+    fast.setTreeAcceleration(3e-2);
+    const double frequencies[] = {40.0, 63.0, 80.0, 125.0};
+    for (size_t i = 0; i < source_count; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.01, 0.0);
+        source.frequency = frequencies[i % 4];
+        source.position = SphericalCoord{1.0 + std::fmod(i * 0.731, 14.0), std::fmod(i * 0.0137, 0.5 * M_PI),
+                                         std::fmod(i * 0.317, 2.0 * M_PI), 0.0};
+        exact.addSourceField(source);
+        fast.addSourceField(source);
+    }
+    std::vector<Kernels::CartesianPoint<double>> points(point_count);
+    for (size_t i = 0; i < point_count; ++i) {
+        const double angle = 2.0 * M_PI * i / point_count;
+        points[i] = {120.0 * std::cos(angle), 120.0 * std::sin(angle), 10.0 + 0.02 * i};
+    }
+
+    auto report = [](const std::string& label, double seconds) {
+        std::cout << "  " << std::left << std::setw(28) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << seconds * 1e3 << " ms" << std::defaultfloat << std::setprecision(6) << std::endl;
+    };
+
+    std::vector<std::complex<double>> expected(point_count), actual(point_count);
+    auto start = Clock::now();
+    for (size_t i = 0; i < point_count; ++i) {
+        expected[i] = exact.calculateInterference(points[i], 1.5);
+    }
+    report("direct", std::chrono::duration<double>(Clock::now() - start).count());
+
+    start = Clock::now();
+    fast.rebuildSourceTree();
+    report("tree build", std::chrono::duration<double>(Clock::now() - start).count());
+
+    start = Clock::now();
+    for (size_t i = 0; i < point_count; ++i) {
+        actual[i] = fast.calculateInterference(points[i], 1.5);
+    }
+    report("tree", std::chrono::duration<double>(Clock::now() - start).count());
+
+    // 1% источников сдвигается внутри своих листов
+    const auto sources = fast.getSourceFields();
+    start = Clock::now();
+    for (size_t i = 0; i < source_count; i += 100) {
+        SphericalCoord position = sources[i].position;
+        position.r += 1e-3;
+        fast.moveSourceField(i, position);
+    }
+    fast.calculateInterference(points[0], 1.5);
+    report("refit 1% moved", std::chrono::duration<double>(Clock::now() - start).count());
+
+    double error = 0.0, signal = 0.0;
+    for (size_t i = 0; i < point_count; ++i) {
+        error += std::norm(actual[i] - expected[i]);
+        signal += std::norm(expected[i]);
+    }
+    std::cout << "  relative error " << std::sqrt(error / signal) << std::endl;
+}
+
+static void benchmarkDomeTexture() {
+    const size_t source_count = 64;
+    const uint32_t size = 2048;
+    std::cout << "\n[dome] " << size << "x" << size << " domemaster frame, " << source_count << " sources"
+              << std::endl;
+
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord{0.0, 0.0, 0.0, 0.0}, 10.0);
+    for (size_t i = 0; i < source_count; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.1, 0.0);
+        source.frequency = 80.0 + 23.0 * i;
+        source.position = SphericalCoord{3.0 + 0.1 * i, 0.2 + 0.02 * i, 0.9 * i, 0.0};
+        field.addSourceField(source);
+    }
+
+    DomeTextureSettings settings;
+    settings.width = settings.height = size;
+    settings.reference = 2.0;
+    DomeTextureRenderer renderer(settings);
+    std::vector<uint8_t> frame(renderer.getFrameBytes());
+
+    auto report = [](const std::string& label, double seconds) {
+        std::cout << "  " << std::left << std::setw(28) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << seconds * 1e3 << " ms" << std::defaultfloat << std::setprecision(6) << std::endl;
+    };
+
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> thread_counts = {1, hardware};
+    thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+    for (size_t threads : thread_counts) {
+        WorkerPool pool(threads);
+        auto start = Clock::now();
+        renderer.renderFrame(field, 1.0, frame.data(), &pool);
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        report("frame, " + std::to_string(threads) + " threads", seconds);
+        std::cout << "  " << renderer.getCoveredPixels() * source_count / seconds / 1e9
+                  << " G source-pixels/s" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== anAntaDigital DSP Benchmark ===" << std::endl;
+
+    std::string only = argc > 1 ? argv[1] : "";
+    auto selected = [&](const std::string& name) { return only.empty() || only == name; };
+
+    if (selected("snapshots")) benchmarkSnapshots();
+    if (selected("venues")) benchmarkVenues();
+    if (selected("stft")) benchmarkSTFT();
+    if (selected("speakers")) benchmarkSpeakers();
+    if (selected("hoa")) benchmarkAmbisonics();
+    if (selected("resample")) benchmarkResampler();
+    if (selected("offline")) benchmarkOffline();
+    if (selected("graph")) benchmarkGraph();
+    if (selected("culling")) benchmarkCulling();
+    if (selected("ifft")) benchmarkSpectralSynthesis();
+    if (selected("batch")) benchmarkBatchInterference();
+    if (selected("stream")) benchmarkInterferenceStream();
+    if (selected("octree")) benchmarkSourceOctree();
+    if (selected("dome")) benchmarkDomeTexture();
+
+    return 0;
+}
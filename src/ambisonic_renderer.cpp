@@ -0,0 +1,544 @@
+#include "ambisonic_renderer.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace AnantaDigital {
+
+namespace {
+
+using Vector3 = std::array<double, 3>;
+
+double dot(const Vector3& a, const Vector3& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Vector3 cross(const Vector3& a, const Vector3& b) {
+    return Vector3{a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+// Направление из центра купола; false — точка в центре
+bool directionOf(const SphericalCoord& position, Vector3& direction, double& distance) {
+    const auto point = Kernels::toCartesian<double>(position);
+    distance = std::sqrt(point.x * point.x + point.y * point.y + point.z * point.z);
+    if (distance < 1e-9) return false;
+    direction = Vector3{point.x / distance, point.y / distance, point.z / distance};
+    return true;
+}
+
+void harmonicsAt(int order, const Vector3& direction, double* out) {
+    const double theta = std::acos(std::max(-1.0, std::min(1.0, direction[2])));
+    const double phi = std::atan2(direction[1], direction[0]);
+    Kernels::realSphericalHarmonics(order, theta, phi, out);
+}
+
+// Веса max-rE для порядка l: P_l(cos(137.9° / (N + 1.51)))
+std::vector<double> maxREWeights(int order) {
+    const double x = std::cos(137.9 * M_PI / 180.0 / (order + 1.51));
+    std::vector<double> weights(order + 1);
+    double p_prev = 1.0, p = x;
+    weights[0] = 1.0;
+    if (order >= 1) weights[1] = x;
+    for (int l = 2; l <= order; ++l) {
+        double p_next = ((2 * l - 1) * x * p - (l - 1) * p_prev) / l;
+        p_prev = p;
+        p = p_next;
+        weights[l] = p;
+    }
+    return weights;
+}
+
+// Решение A·X = B для симметричной положительно определенной A (n × n),
+// B — n × m; результат записывается в B. Разложение Холецкого.
+void solveCholesky(std::vector<double>& a, size_t n, std::vector<double>& b, size_t m) {
+    for (size_t j = 0; j < n; ++j) {
+        double diagonal = a[j * n + j];
+        for (size_t k = 0; k < j; ++k) diagonal -= a[j * n + k] * a[j * n + k];
+        diagonal = std::sqrt(std::max(diagonal, 1e-12));
+        a[j * n + j] = diagonal;
+        for (size_t i = j + 1; i < n; ++i) {
+            double value = a[i * n + j];
+            for (size_t k = 0; k < j; ++k) value -= a[i * n + k] * a[j * n + k];
+            a[i * n + j] = value / diagonal;
+        }
+    }
+    for (size_t col = 0; col < m; ++col) {
+        for (size_t i = 0; i < n; ++i) {
+            double value = b[i * m + col];
+            for (size_t k = 0; k < i; ++k) value -= a[i * n + k] * b[k * m + col];
+            b[i * m + col] = value / a[i * n + i];
+        }
+        for (size_t i = n; i-- > 0;) {
+            double value = b[i * m + col];
+            for (size_t k = i + 1; k < n; ++k) value -= a[k * n + i] * b[k * m + col];
+            b[i * m + col] = value / a[i * n + i];
+        }
+    }
+}
+
+// Грани выпуклой оболочки направлений громкоговорителей: тройки, у которых
+// все остальные точки лежат по одну сторону плоскости. Перебор O(n⁴)
+// выполняется один раз при построении декодера.
+std::vector<std::array<size_t, 3>> hullTriangles(const std::vector<Vector3>& points) {
+    std::vector<std::array<size_t, 3>> triangles;
+    const size_t count = points.size();
+    for (size_t a = 0; a < count; ++a) {
+        for (size_t b = a + 1; b < count; ++b) {
+            for (size_t c = b + 1; c < count; ++c) {
+                const Vector3 ab{points[b][0] - points[a][0], points[b][1] - points[a][1], points[b][2] - points[a][2]};
+                const Vector3 ac{points[c][0] - points[a][0], points[c][1] - points[a][1], points[c][2] - points[a][2]};
+                const Vector3 normal = cross(ab, ac);
+                if (dot(normal, normal) < 1e-12) continue;
+
+                bool above = false, below = false;
+                for (size_t p = 0; p < count && !(above && below); ++p) {
+                    const Vector3 ap{points[p][0] - points[a][0], points[p][1] - points[a][1], points[p][2] - points[a][2]};
+                    const double side = dot(normal, ap);
+                    if (side > 1e-9) above = true;
+                    if (side < -1e-9) below = true;
+                }
+                if (!(above && below)) triangles.push_back({a, b, c});
+            }
+        }
+    }
+    return triangles;
+}
+
+// VBAP: веса громкоговорителей для направления target (единичная норма).
+// Ищется грань оболочки, которую пересекает направление; если направление
+// вне оболочки — пара ближайших (проекция на дугу) или ближайший громкоговоритель.
+void vbapGains(const std::vector<Vector3>& speakers, const std::vector<std::array<size_t, 3>>& triangles,
+               const Vector3& target, double* gains) {
+    const size_t count = speakers.size();
+    std::fill(gains, gains + count, 0.0);
+    if (count == 0) return;
+
+    for (const auto& triangle : triangles) {
+        const Vector3& la = speakers[triangle[0]];
+        const Vector3& lb = speakers[triangle[1]];
+        const Vector3& lc = speakers[triangle[2]];
+        const double det = dot(la, cross(lb, lc));
+        if (std::abs(det) < 1e-9) continue;
+
+        // Правило Крамера
+        Vector3 g{dot(target, cross(lb, lc)) / det,
+                  dot(la, cross(target, lc)) / det,
+                  dot(la, cross(lb, target)) / det};
+        if (std::min(g[0], std::min(g[1], g[2])) < -1e-9) continue;
+
+        const double norm = std::sqrt(dot(g, g));
+        for (int i = 0; i < 3; ++i) gains[triangle[i]] = std::max(0.0, g[i]) / norm;
+        return;
+    }
+
+    std::vector<size_t> nearest(count);
+    for (size_t s = 0; s < count; ++s) nearest[s] = s;
+    const size_t k = std::min<size_t>(8, count);
+    std::partial_sort(nearest.begin(), nearest.begin() + k, nearest.end(), [&](size_t a, size_t b) {
+        return dot(speakers[a], target) > dot(speakers[b], target);
+    });
+
+    // Пара с наименьшей невязкой проекции на ее плоскость
+    double best_residual = -1.0;
+    size_t pair_a = nearest[0], pair_b = nearest[0];
+    double gain_a = 1.0, gain_b = 0.0;
+    for (size_t a = 0; a < k; ++a) {
+        for (size_t b = a + 1; b < k; ++b) {
+            const Vector3& la = speakers[nearest[a]];
+            const Vector3& lb = speakers[nearest[b]];
+            const double ab = dot(la, lb);
+            const double det = 1.0 - ab * ab;
+            if (det < 1e-9) continue;
+            const double ta = dot(la, target);
+            const double tb = dot(lb, target);
+            const double ga = (ta - ab * tb) / det;
+            const double gb = (tb - ab * ta) / det;
+            if (ga < -1e-9 || gb < -1e-9) continue;
+
+            Vector3 residual{target[0] - ga * la[0] - gb * lb[0],
+                             target[1] - ga * la[1] - gb * lb[1],
+                             target[2] - ga * la[2] - gb * lb[2]};
+            double error = dot(residual, residual);
+            if (best_residual < 0.0 || error < best_residual) {
+                best_residual = error;
+                pair_a = nearest[a];
+                pair_b = nearest[b];
+                gain_a = ga;
+                gain_b = gb;
+            }
+        }
+    }
+
+    double norm = std::sqrt(gain_a * gain_a + gain_b * gain_b);
+    gains[pair_a] = gain_a / norm;
+    if (pair_b != pair_a) gains[pair_b] = gain_b / norm;
+}
+
+#if defined(__AVX2__)
+
+// outputs[r][t] = Σ_c matrix[r·stride + c] · inputs[c][t] (при accumulate — прибавляется к outputs)
+void mixMatrix(const float* matrix, size_t stride, size_t rows, size_t cols,
+               const float* const* inputs, float* const* outputs, size_t frames, bool accumulate) {
+    for (size_t r = 0; r < rows; ++r) {
+        float* out = outputs[r];
+        if (!out) continue;
+        const float* row = matrix + r * stride;
+
+        size_t t = 0;
+        for (; t + 32 <= frames; t += 32) {
+            __m256 acc0 = accumulate ? _mm256_loadu_ps(out + t) : _mm256_setzero_ps();
+            __m256 acc1 = accumulate ? _mm256_loadu_ps(out + t + 8) : _mm256_setzero_ps();
+            __m256 acc2 = accumulate ? _mm256_loadu_ps(out + t + 16) : _mm256_setzero_ps();
+            __m256 acc3 = accumulate ? _mm256_loadu_ps(out + t + 24) : _mm256_setzero_ps();
+            for (size_t c = 0; c < cols; ++c) {
+                const float* in = inputs[c];
+                if (!in) continue;
+                const __m256 weight = _mm256_set1_ps(row[c]);
+                acc0 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(in + t), acc0);
+                acc1 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(in + t + 8), acc1);
+                acc2 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(in + t + 16), acc2);
+                acc3 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(in + t + 24), acc3);
+            }
+            _mm256_storeu_ps(out + t, acc0);
+            _mm256_storeu_ps(out + t + 8, acc1);
+            _mm256_storeu_ps(out + t + 16, acc2);
+            _mm256_storeu_ps(out + t + 24, acc3);
+        }
+        for (; t + 8 <= frames; t += 8) {
+            __m256 acc = accumulate ? _mm256_loadu_ps(out + t) : _mm256_setzero_ps();
+            for (size_t c = 0; c < cols; ++c) {
+                if (!inputs[c]) continue;
+                acc = _mm256_fmadd_ps(_mm256_set1_ps(row[c]), _mm256_loadu_ps(inputs[c] + t), acc);
+            }
+            _mm256_storeu_ps(out + t, acc);
+        }
+        for (; t < frames; ++t) {
+            float acc = accumulate ? out[t] : 0.0f;
+            for (size_t c = 0; c < cols; ++c) {
+                if (inputs[c]) acc += row[c] * inputs[c][t];
+            }
+            out[t] = acc;
+        }
+    }
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+void mixMatrix(const float* matrix, size_t stride, size_t rows, size_t cols,
+               const float* const* inputs, float* const* outputs, size_t frames, bool accumulate) {
+    for (size_t r = 0; r < rows; ++r) {
+        float* out = outputs[r];
+        if (!out) continue;
+        const float* row = matrix + r * stride;
+
+        size_t t = 0;
+        for (; t + 16 <= frames; t += 16) {
+            float32x4_t acc0 = accumulate ? vld1q_f32(out + t) : vdupq_n_f32(0.0f);
+            float32x4_t acc1 = accumulate ? vld1q_f32(out + t + 4) : vdupq_n_f32(0.0f);
+            float32x4_t acc2 = accumulate ? vld1q_f32(out + t + 8) : vdupq_n_f32(0.0f);
+            float32x4_t acc3 = accumulate ? vld1q_f32(out + t + 12) : vdupq_n_f32(0.0f);
+            for (size_t c = 0; c < cols; ++c) {
+                const float* in = inputs[c];
+                if (!in) continue;
+                const float weight = row[c];
+                acc0 = vfmaq_n_f32(acc0, vld1q_f32(in + t), weight);
+                acc1 = vfmaq_n_f32(acc1, vld1q_f32(in + t + 4), weight);
+                acc2 = vfmaq_n_f32(acc2, vld1q_f32(in + t + 8), weight);
+                acc3 = vfmaq_n_f32(acc3, vld1q_f32(in + t + 12), weight);
+            }
+            vst1q_f32(out + t, acc0);
+            vst1q_f32(out + t + 4, acc1);
+            vst1q_f32(out + t + 8, acc2);
+            vst1q_f32(out + t + 12, acc3);
+        }
+        for (; t < frames; ++t) {
+            float acc = accumulate ? out[t] : 0.0f;
+            for (size_t c = 0; c < cols; ++c) {
+                if (inputs[c]) acc += row[c] * inputs[c][t];
+            }
+            out[t] = acc;
+        }
+    }
+}
+
+#else
+
+void mixMatrix(const float* matrix, size_t stride, size_t rows, size_t cols,
+               const float* const* inputs, float* const* outputs, size_t frames, bool accumulate) {
+    for (size_t r = 0; r < rows; ++r) {
+        float* out = outputs[r];
+        if (!out) continue;
+        const float* row = matrix + r * stride;
+        if (!accumulate) std::fill(out, out + frames, 0.0f);
+        for (size_t c = 0; c < cols; ++c) {
+            const float* in = inputs[c];
+            if (!in) continue;
+            const float weight = row[c];
+            for (size_t t = 0; t < frames; ++t) {
+                out[t] += weight * in[t];
+            }
+        }
+    }
+}
+
+#endif
+
+} // namespace
+
+AmbisonicRenderer::AmbisonicRenderer()
+    : order_(3)
+    , channels_(Kernels::sphericalHarmonicCount(3))
+    , decoder_(AmbisonicDecoder::ALLRAD)
+    , max_re_(true)
+    , max_block_frames_(0)
+    , max_sources_(0)
+    , source_count_(0) {
+}
+
+void AmbisonicRenderer::setOrder(int order) {
+    order_ = std::max(0, std::min(kMaxOrder, order));
+    channels_ = Kernels::sphericalHarmonicCount(order_);
+    buildDecoder();
+
+    // Размер шины зависит от порядка, источники нужно задать заново
+    max_sources_ = 0;
+    source_count_ = 0;
+}
+
+void AmbisonicRenderer::setMaxRE(bool enabled) {
+    max_re_ = enabled;
+    buildDecoder();
+}
+
+void AmbisonicRenderer::setSpeakers(const std::vector<SphericalCoord>& speakers, AmbisonicDecoder decoder) {
+    speakers_ = speakers;
+    decoder_ = decoder;
+    buildDecoder();
+}
+
+void AmbisonicRenderer::buildDecoder() {
+    const size_t speaker_count = speakers_.size();
+    decode_.assign(speaker_count * channels_, 0.0f);
+    if (speaker_count == 0) return;
+
+    // Направления громкоговорителей из центра купола (громкоговоритель в центре — вверх)
+    std::vector<Vector3> directions(speaker_count, Vector3{0.0, 0.0, 1.0});
+    for (size_t s = 0; s < speaker_count; ++s) {
+        double distance;
+        directionOf(speakers_[s], directions[s], distance);
+    }
+
+    std::vector<double> matrix(speaker_count * channels_, 0.0);
+
+    if (decoder_ == AmbisonicDecoder::MODE_MATCHING) {
+        // D = Yᵀ(Y·Yᵀ + λI)⁻¹, Y — каналы × громкоговорители
+        std::vector<double> y(channels_ * speaker_count);
+        std::vector<double> harmonics(channels_);
+        for (size_t s = 0; s < speaker_count; ++s) {
+            harmonicsAt(order_, directions[s], harmonics.data());
+            for (size_t c = 0; c < channels_; ++c) y[c * speaker_count + s] = harmonics[c];
+        }
+
+        std::vector<double> gram(channels_ * channels_, 0.0);
+        double trace = 0.0;
+        for (size_t i = 0; i < channels_; ++i) {
+            for (size_t j = 0; j <= i; ++j) {
+                double value = 0.0;
+                for (size_t s = 0; s < speaker_count; ++s) value += y[i * speaker_count + s] * y[j * speaker_count + s];
+                gram[i * channels_ + j] = value;
+                gram[j * channels_ + i] = value;
+            }
+            trace += gram[i * channels_ + i];
+        }
+        // Регуляризация для неполных расстановок (полусфера купола)
+        const double lambda = 1e-3 * trace / static_cast<double>(channels_);
+        for (size_t i = 0; i < channels_; ++i) gram[i * channels_ + i] += lambda;
+
+        solveCholesky(gram, channels_, y, speaker_count);
+        for (size_t s = 0; s < speaker_count; ++s) {
+            for (size_t c = 0; c < channels_; ++c) matrix[s * channels_ + c] = y[c * speaker_count + s];
+        }
+    } else {
+        // AllRAD: декодер выборки на сетке Фибоначчи, затем VBAP каждой точки сетки
+        const size_t virtual_count = std::max<size_t>(240, 20 * channels_);
+        const double golden_angle = M_PI * (3.0 - std::sqrt(5.0));
+        const double weight = 4.0 * M_PI / static_cast<double>(virtual_count);
+
+        // Купол не закрывает нижнюю полусферу: мнимый громкоговоритель в надире
+        // забирает энергию точек ниже нижнего кольца, его сигнал отбрасывается
+        std::vector<Vector3> hull = directions;
+        double lowest = 1.0;
+        for (const auto& direction : directions) lowest = std::min(lowest, direction[2]);
+        if (lowest > -0.5) hull.push_back(Vector3{0.0, 0.0, -1.0});
+
+        const auto triangles = hullTriangles(hull);
+
+        std::vector<double> harmonics(channels_);
+        std::vector<double> gains(hull.size());
+        for (size_t v = 0; v < virtual_count; ++v) {
+            const double z = 1.0 - (2.0 * v + 1.0) / static_cast<double>(virtual_count);
+            const double radius = std::sqrt(std::max(0.0, 1.0 - z * z));
+            const double azimuth = golden_angle * static_cast<double>(v);
+            const Vector3 point{radius * std::cos(azimuth), radius * std::sin(azimuth), z};
+
+            harmonicsAt(order_, point, harmonics.data());
+            vbapGains(hull, triangles, point, gains.data());
+            for (size_t s = 0; s < speaker_count; ++s) {
+                if (gains[s] == 0.0) continue;
+                for (size_t c = 0; c < channels_; ++c) {
+                    matrix[s * channels_ + c] += weight * gains[s] * harmonics[c];
+                }
+            }
+        }
+    }
+
+    std::vector<double> order_weights(order_ + 1, 1.0);
+    if (max_re_) order_weights = maxREWeights(order_);
+    for (size_t s = 0; s < speaker_count; ++s) {
+        for (int l = 0; l <= order_; ++l) {
+            for (int m = -l; m <= l; ++m) {
+                const size_t c = Kernels::sphericalHarmonicIndex(l, m);
+                decode_[s * channels_ + c] = static_cast<float>(matrix[s * channels_ + c] * order_weights[l]);
+            }
+        }
+    }
+}
+
+void AmbisonicRenderer::prepare(size_t max_block_frames, size_t max_sources) {
+    max_block_frames_ = std::max<size_t>(1, max_block_frames);
+    max_sources_ = max_sources;
+    source_count_ = 0;
+
+    encoding_.assign(channels_ * max_sources_, 0.0f);
+    bus_.assign(channels_ * max_block_frames_, 0.0f);
+    bus_ptrs_.resize(channels_);
+    for (size_t c = 0; c < channels_; ++c) {
+        bus_ptrs_[c] = bus_.data() + c * max_block_frames_;
+    }
+
+    scratch_.assign(speakers_.size() * max_block_frames_, 0.0f);
+    scratch_ptrs_.resize(speakers_.size());
+    for (size_t s = 0; s < speakers_.size(); ++s) {
+        scratch_ptrs_[s] = scratch_.data() + s * max_block_frames_;
+    }
+}
+
+void AmbisonicRenderer::computeSourceEncoding(const SphericalCoord& position, double gain, InterferenceFieldType type,
+                                              float* coefficients) const {
+    Vector3 direction{0.0, 0.0, 1.0};
+    double distance = 0.0;
+    const bool directional = directionOf(position, direction, distance);
+
+    // Затухание и вес типа интерференции — как в SpeakerRenderer, расстояние — до центра купола
+    double attenuation = Kernels::distanceAttenuation(distance);
+    double weighted = std::real(Kernels::applyInterferenceType(std::complex<double>(gain * attenuation, 0.0), type));
+
+    std::array<double, Kernels::sphericalHarmonicCount(kMaxOrder)> harmonics{};
+    if (directional) {
+        harmonicsAt(order_, direction, harmonics.data());
+    } else {
+        // Источник в центре слышен одинаково со всех направлений
+        harmonics[0] = 1.0 / std::sqrt(4.0 * M_PI);
+    }
+    for (size_t c = 0; c < channels_; ++c) {
+        coefficients[c] = static_cast<float>(weighted * harmonics[c]);
+    }
+}
+
+void AmbisonicRenderer::setSourceEncoding(size_t source, const float* coefficients) {
+    if (source >= max_sources_) return;
+    for (size_t c = 0; c < channels_; ++c) {
+        encoding_[c * max_sources_ + source] = coefficients[c];
+    }
+}
+
+void AmbisonicRenderer::getSourceEncoding(size_t source, float* coefficients) const {
+    for (size_t c = 0; c < channels_; ++c) {
+        coefficients[c] = source < max_sources_ ? encoding_[c * max_sources_ + source] : 0.0f;
+    }
+}
+
+void AmbisonicRenderer::moveSource(size_t from, size_t to) {
+    if (from >= max_sources_ || to >= max_sources_) return;
+    for (size_t c = 0; c < channels_; ++c) {
+        encoding_[c * max_sources_ + to] = encoding_[c * max_sources_ + from];
+    }
+}
+
+void AmbisonicRenderer::setSource(size_t source, const SphericalCoord& position, double gain, InterferenceFieldType type) {
+    if (source >= max_sources_) return;
+    std::array<float, Kernels::sphericalHarmonicCount(kMaxOrder)> coefficients{};
+    computeSourceEncoding(position, gain, type, coefficients.data());
+    setSourceEncoding(source, coefficients.data());
+}
+
+void AmbisonicRenderer::setSourceCount(size_t count) {
+    source_count_ = std::min(count, max_sources_);
+}
+
+void AmbisonicRenderer::encode(const float* const* sources, size_t frames) {
+    if (source_count_ == 0 || !sources) {
+        std::fill(bus_.begin(), bus_.end(), 0.0f);
+        return;
+    }
+    mixMatrix(encoding_.data(), max_sources_, channels_, source_count_, sources, bus_ptrs_.data(), frames, false);
+}
+
+void AmbisonicRenderer::clearBus() {
+    std::fill(bus_.begin(), bus_.end(), 0.0f);
+}
+
+void AmbisonicRenderer::encodeSources(size_t first, const float* const* sources, size_t count, size_t frames) {
+    frames = std::min(frames, max_block_frames_);
+    if (!sources || first >= source_count_ || bus_ptrs_.size() != channels_) return;
+    count = std::min(count, source_count_ - first);
+
+    // Столбцы first.. матрицы кодирования — коэффициенты источников группы
+    mixMatrix(encoding_.data() + first, max_sources_, channels_, count, sources, bus_ptrs_.data(), frames, true);
+}
+
+void AmbisonicRenderer::decode(size_t frames, float* const* outputs) {
+    frames = std::min(frames, max_block_frames_);
+    if (!outputs || frames == 0 || bus_ptrs_.size() != channels_) return;
+
+    mixMatrix(decode_.data(), channels_, speakers_.size(), channels_, bus_ptrs_.data(), outputs, frames, false);
+}
+
+void AmbisonicRenderer::decodeInterleaved(size_t frames, float* output) {
+    frames = std::min(frames, max_block_frames_);
+    const size_t speaker_count = speakers_.size();
+    if (!output || frames == 0 || bus_ptrs_.size() != channels_ || scratch_ptrs_.size() != speaker_count) return;
+
+    mixMatrix(decode_.data(), channels_, speaker_count, channels_, bus_ptrs_.data(), scratch_ptrs_.data(), frames,
+              false);
+    for (size_t t = 0; t < frames; ++t) {
+        for (size_t s = 0; s < speaker_count; ++s) {
+            output[t * speaker_count + s] = scratch_ptrs_[s][t];
+        }
+    }
+}
+
+void AmbisonicRenderer::render(const float* const* sources, size_t frames, float* const* outputs) {
+    frames = std::min(frames, max_block_frames_);
+    if (!outputs || frames == 0 || bus_ptrs_.size() != channels_) return;
+
+    encode(sources, frames);
+    decode(frames, outputs);
+}
+
+void AmbisonicRenderer::renderInterleaved(const float* const* sources, size_t frames, float* output) {
+    frames = std::min(frames, max_block_frames_);
+    if (!output || frames == 0 || bus_ptrs_.size() != channels_ || scratch_ptrs_.size() != speakers_.size()) return;
+
+    encode(sources, frames);
+    decodeInterleaved(frames, output);
+}
+
+} // namespace AnantaDigital
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "anantadigital_types.hpp"
+#include "dsp_kernels.hpp"
+#include <vector>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Способ построения матрицы декодирования
+enum class AmbisonicDecoder {
+    MODE_MATCHING,  // Регуляризованная псевдообратная матрица гармоник громкоговорителей
+    ALLRAD          // Декодирование на плотную виртуальную сетку + VBAP на реальные громкоговорители
+};
+
+// Рендер на громкоговорители купола через шину Ambisonics высокого порядка (до 7-го).
+//
+// Каждый источник один раз кодируется в (N+1)² коэффициентов сферических
+// гармоник по направлению из центра купола (с тем же затуханием и весом
+// интерференции, что и SpeakerRenderer, но без задержек). Источники
+// смешиваются на шине, а шина декодируется на громкоговорители заранее
+// вычисленной матрицей. Стоимость блока — O((источники + громкоговорители) ×
+// каналы шины) вместо O(источники × громкоговорители).
+//
+// Оба шага — умножение матрицы на планарный блок, векторизованное по отсчетам
+// (AVX2/NEON). После prepare() методы рендера не выделяют память.
+class AmbisonicRenderer {
+public:
+    static constexpr int kMaxOrder = 7;
+
+private:
+    int order_;
+    size_t channels_;                       // (order_ + 1)²
+    AmbisonicDecoder decoder_;
+    bool max_re_;
+
+    std::vector<SphericalCoord> speakers_;
+
+    // Матрица декодирования: громкоговорители × каналы шины
+    std::vector<float> decode_;
+
+    size_t max_block_frames_;
+    size_t max_sources_;
+    size_t source_count_;
+
+    // Коэффициенты кодирования: каналы шины × max_sources_ (столбец — источник)
+    std::vector<float> encoding_;
+
+    // Шина: каналы × max_block_frames_ (планарно)
+    std::vector<float> bus_;
+    std::vector<float*> bus_ptrs_;
+
+    // Планарный выход для чередующегося рендера: громкоговорители × max_block_frames_
+    std::vector<float> scratch_;
+    std::vector<float*> scratch_ptrs_;
+
+public:
+    AmbisonicRenderer();
+
+    // Порядок шины 0..kMaxOrder (вне аудио-потока; затем setSpeakers() и prepare())
+    void setOrder(int order);
+    int getOrder() const { return order_; }
+    size_t getChannelCount() const { return channels_; }
+
+    // Веса max-rE по порядкам (меньше боковых лепестков); по умолчанию включены
+    void setMaxRE(bool enabled);
+    bool getMaxRE() const { return max_re_; }
+
+    // Расстановка громкоговорителей и построение матрицы декодирования
+    void setSpeakers(const std::vector<SphericalCoord>& speakers,
+                     AmbisonicDecoder decoder = AmbisonicDecoder::ALLRAD);
+    const std::vector<SphericalCoord>& getSpeakers() const { return speakers_; }
+    size_t getSpeakerCount() const { return speakers_.size(); }
+    AmbisonicDecoder getDecoder() const { return decoder_; }
+    const std::vector<float>& getDecodeMatrix() const { return decode_; }
+
+    void prepare(size_t max_block_frames, size_t max_sources);
+    size_t getMaxSources() const { return max_sources_; }
+    size_t getMaxBlockFrames() const { return max_block_frames_; }
+
+    // Коэффициенты источника в позиции position (getChannelCount() значений).
+    // Не зависит от состояния рендера, кроме порядка.
+    void computeSourceEncoding(const SphericalCoord& position, double gain, InterferenceFieldType type,
+                               float* coefficients) const;
+
+    // Загрузить готовые коэффициенты (аудио-поток, без выделений)
+    void setSourceEncoding(size_t source, const float* coefficients);
+
+    // Текущие коэффициенты источника (getChannelCount() значений)
+    void getSourceEncoding(size_t source, float* coefficients) const;
+
+    // Перенести коэффициенты источника from в индекс to
+    void moveSource(size_t from, size_t to);
+
+    void setSource(size_t source, const SphericalCoord& position, double gain = 1.0,
+                   InterferenceFieldType type = InterferenceFieldType::CONSTRUCTIVE);
+
+    void setSourceCount(size_t count);
+    size_t getSourceCount() const { return source_count_; }
+
+    // sources[j] — frames отсчетов источника j (nullptr — тишина), frames <= max_block_frames.
+    // Планарный выход: outputs[s] — буфер громкоговорителя s.
+    void render(const float* const* sources, size_t frames, float* const* outputs);
+
+    // Чередующийся выход: output[t·N + s]
+    void renderInterleaved(const float* const* sources, size_t frames, float* output);
+
+    // Рендер группами: clearBus(), затем encodeSources() для источников
+    // [first, first + count) (sources[j] — сигнал источника first + j) прибавляет
+    // их к шине, и decode() или decodeInterleaved() выводит шину на громкоговорители.
+    void clearBus();
+    void encodeSources(size_t first, const float* const* sources, size_t count, size_t frames);
+    void decode(size_t frames, float* const* outputs);
+    void decodeInterleaved(size_t frames, float* output);
+
+    // Канал шины последнего блока (ACN)
+    const float* getBusChannel(size_t channel) const { return bus_.data() + channel * max_block_frames_; }
+
+private:
+    void buildDecoder();
+    void encode(const float* const* sources, size_t frames);
+};
+
+} // namespace AnantaDigital
@@ -0,0 +1,190 @@
+#include "audibility_culler.hpp"
+#include "dsp_kernels.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace AnantaDigital {
+
+bool AudibilityCuller::ClusterKey::operator<(const ClusterKey& other) const {
+    if (x != other.x) return x < other.x;
+    if (y != other.y) return y < other.y;
+    if (z != other.z) return z < other.z;
+    return band < other.band;
+}
+
+bool AudibilityCuller::ClusterKey::operator==(const ClusterKey& other) const {
+    return x == other.x && y == other.y && z == other.z && band == other.band;
+}
+
+AudibilityCuller::AudibilityCuller() {
+    setSettings(CullingSettings{});
+}
+
+void AudibilityCuller::setSettings(const CullingSettings& settings) {
+    settings_ = settings;
+    settings_.masking_db = std::max(0.0, settings_.masking_db);
+    settings_.cluster_distance = std::max(0.0, settings_.cluster_distance);
+    if (!(settings_.cluster_cell > 0.0)) settings_.cluster_cell = 4.0;
+    if (!(settings_.cluster_bandwidth > 0.0)) settings_.cluster_bandwidth = 1.0;
+    settings_.cpu_budget = std::max(0.0, settings_.cpu_budget);
+}
+
+void AudibilityCuller::reserve(size_t capacity) {
+    voices_.reserve(capacity);
+    keys_.reserve(capacity);
+    levels_.reserve(capacity);
+    far_.reserve(capacity);
+}
+
+size_t AudibilityCuller::barkBand(double frequency) {
+    // Шкала Барка по Цвикеру
+    const double f = std::max(0.0, frequency);
+    const double z = 13.0 * std::atan(0.00076 * f) + 3.5 * std::atan((f / 7500.0) * (f / 7500.0));
+    return std::min(kBarkBands - 1, static_cast<size_t>(std::max(0.0, z)));
+}
+
+void AudibilityCuller::plan(const double* frequencies, const std::complex<double>* amplitudes,
+                            const SphericalCoord* positions, size_t count) {
+    statistics_ = CullingStatistics{};
+    statistics_.fields = count;
+    voices_.clear();
+    if (!frequencies || !amplitudes || !positions) count = 0;
+
+    if (!settings_.enabled) {
+        for (size_t i = 0; i < count; ++i) {
+            const double amplitude = std::real(amplitudes[i]);
+            voices_.push_back(Voice{static_cast<uint32_t>(i), 1, frequencies[i], amplitude, positions[i],
+                                    static_cast<float>(std::abs(amplitude))});
+        }
+        statistics_.voices = voices_.size();
+        return;
+    }
+
+    // Уровень у слушателя; тихие поля отбрасываются, дальние откладываются для слияния
+    const auto listener = Kernels::toCartesian<double>(settings_.listener);
+    const double threshold = std::pow(10.0, settings_.threshold_db / 20.0);
+    const double cell = settings_.cluster_cell;
+    levels_.resize(count);
+    keys_.resize(count);
+    far_.clear();
+
+    for (size_t i = 0; i < count; ++i) {
+        const double amplitude = std::real(amplitudes[i]);
+        const auto point = Kernels::toCartesian<double>(positions[i]);
+        const double distance = Kernels::distance(point, listener);
+        const double level = std::abs(amplitude) * Kernels::distanceAttenuation(distance);
+        levels_[i] = static_cast<float>(level);
+        // Нулевое поле неслышно при любом пороге и не дает веса скоплению
+        if (!(level >= threshold) || !(level > 0.0)) {
+            ++statistics_.culled_silent;
+            continue;
+        }
+
+        if (settings_.cluster_distance > 0.0 && distance > settings_.cluster_distance) {
+            keys_[i] = ClusterKey{static_cast<int32_t>(std::floor(point.x / cell)),
+                                  static_cast<int32_t>(std::floor(point.y / cell)),
+                                  static_cast<int32_t>(std::floor(point.z / cell)),
+                                  static_cast<int64_t>(std::floor(frequencies[i] / settings_.cluster_bandwidth))};
+            far_.push_back(static_cast<uint32_t>(i));
+        } else {
+            voices_.push_back(Voice{static_cast<uint32_t>(i), 1, frequencies[i], amplitude, positions[i],
+                                    static_cast<float>(level)});
+        }
+    }
+
+    // Скопления: дальние поля с одинаковым ключом идут подряд
+    std::sort(far_.begin(), far_.end(), [this](uint32_t a, uint32_t b) {
+        if (keys_[a] == keys_[b]) return a < b;
+        return keys_[a] < keys_[b];
+    });
+    for (size_t begin = 0; begin < far_.size();) {
+        size_t end = begin + 1;
+        while (end < far_.size() && keys_[far_[end]] == keys_[far_[begin]]) ++end;
+
+        uint32_t representative = far_[begin];
+        double energy = 0.0, level_energy = 0.0, frequency = 0.0;
+        Kernels::CartesianPoint<double> center{0.0, 0.0, 0.0};
+        for (size_t k = begin; k < end; ++k) {
+            const uint32_t i = far_[k];
+            const double amplitude = std::real(amplitudes[i]);
+            const double weight = amplitude * amplitude;
+            const auto point = Kernels::toCartesian<double>(positions[i]);
+            energy += weight;
+            level_energy += static_cast<double>(levels_[i]) * levels_[i];
+            frequency += weight * frequencies[i];
+            center.x += weight * point.x;
+            center.y += weight * point.y;
+            center.z += weight * point.z;
+            if (levels_[i] > levels_[representative]) representative = i;
+        }
+
+        const uint32_t members = static_cast<uint32_t>(end - begin);
+        Voice voice{representative, members, frequencies[representative], std::real(amplitudes[representative]),
+                    positions[representative], levels_[representative]};
+        if (members > 1 && energy > 0.0) {
+            // Центр скопления обратно в сферические координаты (высота — в z)
+            center.x /= energy;
+            center.y /= energy;
+            center.z /= energy;
+            const double r = std::sqrt(center.x * center.x + center.y * center.y + center.z * center.z);
+            double phi = std::atan2(center.y, center.x);
+            if (phi < 0.0) phi += 2.0 * M_PI;
+            voice.frequency = frequency / energy;
+            voice.amplitude = std::copysign(std::sqrt(energy), voice.amplitude);
+            voice.position = SphericalCoord{r, r > 0.0 ? std::acos(center.z / r) : 0.0, phi, 0.0};
+            voice.level = static_cast<float>(std::sqrt(level_energy));
+            statistics_.merged += members - 1;
+        }
+        voices_.push_back(voice);
+        begin = end;
+    }
+
+    // Маскировка: голос много тише самого громкого в своей критической полосе
+    if (settings_.masking_db > 0.0) {
+        std::array<float, kBarkBands> loudest{};
+        for (const Voice& voice : voices_) {
+            float& band = loudest[barkBand(voice.frequency)];
+            band = std::max(band, voice.level);
+        }
+        const float ratio = static_cast<float>(std::pow(10.0, -settings_.masking_db / 20.0));
+        const size_t before = voices_.size();
+        voices_.erase(std::remove_if(voices_.begin(), voices_.end(),
+                                     [&](const Voice& voice) {
+                                         return voice.level < loudest[barkBand(voice.frequency)] * ratio;
+                                     }),
+                      voices_.end());
+        statistics_.culled_masked = before - voices_.size();
+    }
+
+    // По убыванию уровня; при равенстве — по полю, чтобы порядок был воспроизводим
+    std::sort(voices_.begin(), voices_.end(), [](const Voice& a, const Voice& b) {
+        if (a.level != b.level) return a.level > b.level;
+        return a.field < b.field;
+    });
+    if (settings_.max_voices > 0 && voices_.size() > settings_.max_voices) {
+        statistics_.culled_limit = voices_.size() - settings_.max_voices;
+        voices_.resize(settings_.max_voices);
+    }
+    statistics_.voices = voices_.size();
+}
+
+bool VoiceBudget::update(double budget, double block_seconds, double render_seconds, size_t voices,
+                         size_t available) {
+    const size_t previous = limit_;
+    if (!(budget > 0.0) || !(block_seconds > 0.0)) {
+        limit_ = kUnlimited;
+        return limit_ != previous;
+    }
+
+    const double allowed = budget * block_seconds;
+    if (render_seconds > allowed && voices > kMinVoices) {
+        const double scaled = static_cast<double>(voices) * allowed / render_seconds * 0.9;
+        limit_ = std::max(kMinVoices, std::min(voices - 1, static_cast<size_t>(scaled)));
+    } else if (render_seconds < 0.7 * allowed && limit_ < available) {
+        limit_ = std::min(available, limit_ + std::max<size_t>(1, limit_ / 8));
+    }
+    return limit_ != previous;
+}
+
+} // namespace AnantaDigital
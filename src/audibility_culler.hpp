@@ -0,0 +1,128 @@
+#pragma once
+
+#include "anantadigital_types.hpp"
+#include <vector>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Параметры отбора слышимых полей
+struct CullingSettings {
+    bool enabled = true;
+    SphericalCoord listener{0.0, 0.0, 0.0, 0.0};    // точка слушателя (центр купола)
+    double threshold_db = -100.0;       // уровень у слушателя, ниже которого поле не озвучивается
+    double masking_db = 60.0;           // поле тише самого громкого в своей критической полосе
+                                        // на столько дБ маскируется; 0 — без маскировки
+    double cluster_distance = 30.0;     // поля дальше (м) сливаются в скопления; 0 — без слияния
+    double cluster_cell = 4.0;          // размер ячейки скопления, м
+    double cluster_bandwidth = 1.0;     // ширина полосы частот скопления, Гц
+    size_t max_voices = 0;              // не больше голосов; 0 — без ограничения
+    double cpu_budget = 0.0;            // доля длительности блока на синтез; 0 — без бюджета
+};
+
+// Итог последнего отбора
+struct CullingStatistics {
+    size_t fields = 0;                  // полей на входе
+    size_t voices = 0;                  // голосов на выходе
+    size_t culled_silent = 0;           // ниже порога слышимости
+    size_t culled_masked = 0;           // замаскированы в своей полосе
+    size_t merged = 0;                  // полей, вошедших в чужие скопления
+    size_t culled_limit = 0;            // голосов сверх max_voices
+};
+
+// Отбор и укрупнение звуковых полей перед синтезом (LOD).
+//
+// Уровень поля у слушателя — |Re a|·1/(1 + 0.1·d), та же модель затухания,
+// что и в calculateInterference. Поля ниже threshold_db отбрасываются.
+// Дальние поля (d > cluster_distance) с близкими частотами в одной ячейке
+// пространства сливаются в один голос: амплитуда — энергетическая сумма
+// sqrt(Σa²) (некогерентные источники), частота — средняя по энергии,
+// позиция — центр ячейки по энергии; идентичность и фаза голоса берутся
+// у самого громкого поля скопления. Затем голос, который тише самого громкого
+// в той же критической полосе (шкала Барка) на masking_db, маскируется.
+//
+// Голоса упорядочены по убыванию уровня: любой префикс списка — лучшее
+// приближение смеси при меньшем числе голосов, поэтому бюджет CPU снижает
+// качество плавно, отбрасывая хвост списка.
+//
+// После reserve() plan() не выделяет память для count ≤ емкости.
+class AudibilityCuller {
+public:
+    static constexpr size_t kBarkBands = 25;
+
+    // Голос синтеза: одно поле или скопление дальних полей
+    struct Voice {
+        uint32_t field;             // поле-представитель (плотный индекс): его идентичность и фаза
+        uint32_t members;           // число полей в голосе
+        double frequency;
+        double amplitude;
+        SphericalCoord position;
+        float level;                // уровень у слушателя
+    };
+
+private:
+    CullingSettings settings_;
+    CullingStatistics statistics_;
+    std::vector<Voice> voices_;
+
+    // Ключ скопления: ячейка пространства и полоса частот
+    struct ClusterKey {
+        int32_t x, y, z;
+        int64_t band;
+        bool operator<(const ClusterKey& other) const;
+        bool operator==(const ClusterKey& other) const;
+    };
+    std::vector<ClusterKey> keys_;
+    std::vector<float> levels_;
+    std::vector<uint32_t> far_;
+
+public:
+    AudibilityCuller();
+
+    void setSettings(const CullingSettings& settings);
+    const CullingSettings& getSettings() const { return settings_; }
+
+    // Выделить память под capacity полей
+    void reserve(size_t capacity);
+
+    // Построить голоса для count полей. Выключенный отбор оставляет все поля
+    // в исходном порядке.
+    void plan(const double* frequencies, const std::complex<double>* amplitudes,
+              const SphericalCoord* positions, size_t count);
+
+    // Голоса последнего plan() по убыванию уровня
+    const std::vector<Voice>& getVoices() const { return voices_; }
+
+    const CullingStatistics& getStatistics() const { return statistics_; }
+
+    // Критическая полоса (0..kBarkBands-1) частоты по шкале Барка
+    static size_t barkBand(double frequency);
+};
+
+// Предел числа голосов под бюджет CPU. После каждого блока время синтеза
+// сравнивается с долей budget длительности блока: при превышении предел сразу
+// уменьшается пропорционально (с запасом 10 %), при запасе больше 30 % растет
+// на восьмую часть за блок. Голоса упорядочены по уровню, поэтому под пределом
+// остаются самые громкие. Без бюджета предела нет.
+class VoiceBudget {
+public:
+    static constexpr size_t kMinVoices = 16;
+    static constexpr size_t kUnlimited = SIZE_MAX;
+
+private:
+    size_t limit_;
+
+public:
+    VoiceBudget() : limit_(kUnlimited) {}
+
+    // voices — голосов в этом блоке, available — сколько можно было бы озвучить.
+    // true — предел изменился.
+    bool update(double budget, double block_seconds, double render_seconds, size_t voices, size_t available);
+
+    size_t getLimit() const { return limit_; }
+    void reset() { limit_ = kUnlimited; }
+};
+
+} // namespace AnantaDigital
@@ -1,7 +1,6 @@
 #include "consciousness_hybrid.hpp"
 #include <algorithm>
 #include <cmath>
-#include <random>
 
 namespace AnantaDigital::Consciousness {
 
@@ -92,6 +91,11 @@ void ConsciousnessHybrid::createQuantumEntanglement(ConsciousnessHybrid& other)
     other.normalizeStateAmplitudes();
 }
 
+void ConsciousnessHybrid::setRandomSeed(uint64_t seed, uint64_t stream) {
+    std::lock_guard<std::mutex> lock(consciousness_mutex_);
+    rng_.seed(seed, stream);
+}
+
 QuantumConsciousness ConsciousnessHybrid::getCurrentState() const {
     std::lock_guard<std::mutex> lock(consciousness_mutex_);
     return consciousness_;
@@ -110,15 +114,12 @@ void ConsciousnessHybrid::cleanup() {
 void ConsciousnessHybrid::updateStateSuperposition(double dt) {
     // Обновляем суперпозицию состояний с учетом квантовых флуктуаций
     
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::normal_distribution<double> noise(0.0, 0.01);
-    
-    // Добавляем квантовые флуктуации
-    for (auto& amplitude : consciousness_.state_amplitudes) {
-        double real_noise = noise(gen);
-        double imag_noise = noise(gen);
-        amplitude += std::complex<double>(real_noise, imag_noise) * dt;
+    // Добавляем квантовые флуктуации: пара нормальных величин на амплитуду
+    auto& amplitudes = consciousness_.state_amplitudes;
+    noise_buffer_.resize(2 * amplitudes.size());
+    rng_.fillNormal(noise_buffer_.data(), noise_buffer_.size(), 0.0, 0.01);
+    for (size_t i = 0; i < amplitudes.size(); ++i) {
+        amplitudes[i] += std::complex<double>(noise_buffer_[2 * i], noise_buffer_[2 * i + 1]) * dt;
     }
     
     // Нормализуем амплитуды
@@ -162,11 +163,7 @@ void ConsciousnessHybrid::normalizeStateAmplitudes() {
 void ConsciousnessHybrid::collapseToState() {
     // Коллапс квантовой суперпозиции к одному состоянию
     
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<double> dist(0.0, 1.0);
-    
-    double random_value = dist(gen);
+    double random_value = rng_.uniform();
     double cumulative_probability = 0.0;
     
     for (size_t i = 0; i < consciousness_.state_amplitudes.size(); ++i) {
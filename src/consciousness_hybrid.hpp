@@ -6,6 +6,7 @@
 #include <functional>
 #include <chrono>
 #include <mutex>
+#include "philox_random.hpp"
 
 namespace AnantaDigital::Consciousness {
 
@@ -35,6 +36,10 @@ private:
     QuantumConsciousness consciousness_;
     std::vector<std::function<void(const QuantumConsciousness&)>> observers_;
     mutable std::mutex consciousness_mutex_;
+    
+    // Флуктуации и коллапс состояний (под consciousness_mutex_)
+    PhiloxRandom rng_;
+    std::vector<double> noise_buffer_;
 
 public:
     ConsciousnessHybrid();
@@ -51,6 +56,9 @@ public:
     // Создание квантовой запутанности
     void createQuantumEntanglement(ConsciousnessHybrid& other);
     
+    // Seed и поток генератора флуктуаций
+    void setRandomSeed(uint64_t seed, uint64_t stream = 0);
+    
     // Получение текущего состояния
     QuantumConsciousness getCurrentState() const;
     
@@ -1,4 +1,5 @@
 #include "dome_acoustic_resonator.hpp"
+#include "dsp_kernels.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -6,9 +7,10 @@ namespace AnantaDigital {
 
 DomeAcousticResonator::DomeAcousticResonator(double radius, double height)
     : dome_radius_(radius)
-    , dome_height_(height) {
+    , dome_height_(height)
+    , model_version_(0) {
     // Вычисляем собственные частоты при создании
-    resonant_frequencies_ = calculateEigenFrequencies();
+    rebuildResonanceModel();
 }
 
 std::vector<double> DomeAcousticResonator::calculateEigenFrequencies() const {
@@ -37,11 +39,27 @@ std::vector<double> DomeAcousticResonator::calculateEigenFrequencies() const {
 }
 
 void DomeAcousticResonator::setMaterialProperties(const std::map<double, double>& properties) {
+    // Модель перестраивается только если свойства действительно изменились
+    if (properties == acoustic_properties_) return;
+    
     acoustic_properties_ = properties;
+    rebuildResonanceModel();
 }
 
 void DomeAcousticResonator::setAcousticProperty(double frequency, double absorption) {
+    if (setAcousticPropertyValue(frequency, absorption)) {
+        rebuildResonanceModel();
+    }
+}
+
+bool DomeAcousticResonator::setAcousticPropertyValue(double frequency, double absorption) {
+    auto it = acoustic_properties_.find(frequency);
+    if (it != acoustic_properties_.end() && it->second == absorption) {
+        return false;
+    }
+    
     acoustic_properties_[frequency] = absorption;
+    return true;
 }
 
 double DomeAcousticResonator::getAcousticProperty(double frequency) const {
@@ -90,6 +108,7 @@ double DomeAcousticResonator::calculateReverbTime(double frequency) const {
 void DomeAcousticResonator::optimizeFrequencyResponse(const std::vector<double>& target_frequencies) {
     // Простая оптимизация - устанавливаем оптимальные значения поглощения
     // для целевых частот
+    bool changed = false;
     
     for (double freq : target_frequencies) {
         // Оптимальное поглощение зависит от частоты
@@ -106,11 +125,36 @@ void DomeAcousticResonator::optimizeFrequencyResponse(const std::vector<double>&
             optimal_absorption = 0.6;
         }
         
-        setAcousticProperty(freq, optimal_absorption);
+        changed |= setAcousticPropertyValue(freq, optimal_absorption);
     }
     
-    // Пересчитываем резонансные частоты
+    // Пересчитываем резонансную модель один раз и только при изменениях
+    if (changed) {
+        rebuildResonanceModel();
+    }
+}
+
+void DomeAcousticResonator::rebuildResonanceModel() {
     resonant_frequencies_ = calculateEigenFrequencies();
+    
+    // Объединяем вырожденные моды (одинаковая частота при разных m)
+    resonance_modes_.clear();
+    for (double freq : resonant_frequencies_) {
+        if (!resonance_modes_.empty() &&
+            std::abs(resonance_modes_.back().frequency - freq) <= 1e-9 * freq) {
+            ++resonance_modes_.back().degeneracy;
+            continue;
+        }
+        
+        ResonanceMode mode;
+        mode.frequency = freq;
+        mode.absorption = getAcousticProperty(freq);
+        mode.reverb_time = calculateReverbTime(freq);
+        mode.degeneracy = 1;
+        resonance_modes_.push_back(mode);
+    }
+    
+    model_version_.fetch_add(1, std::memory_order_acq_rel);
 }
 
 double DomeAcousticResonator::calculateVolume() const {
@@ -147,31 +191,19 @@ double DomeAcousticResonator::calculateDomeEigenFrequency(int n, int m) const {
     // Собственные частоты сферического купола
     // Используем приближение для сферических гармоник
     
-    const double speed_of_sound = 343.0;
-    
     // Для сферического купола собственные частоты определяются как:
     // f_nm = (c / (2π)) * sqrt(n(n+1)) / R
-    // где c - скорость звука, n - радиальное квантовое число, R - радиус
-    
-    double frequency = (speed_of_sound / (2.0 * M_PI)) * std::sqrt(n * (n + 1.0)) / dome_radius_;
-    
-    // Добавляем поправку для высоты купола
-    double height_factor = 1.0 + (dome_height_ / dome_radius_) * 0.1;
-    frequency *= height_factor;
-    
-    return frequency;
+    // где c - скорость звука, n - радиальное квантовое число, R - радиус.
+    // Добавляется поправка для высоты купола.
+    (void)m;
+    return Kernels::domeEigenFrequency<Sample>(n, static_cast<Sample>(dome_radius_),
+                                               static_cast<Sample>(dome_height_));
 }
 
 double DomeAcousticResonator::calculateSphericalHarmonic(int l, int m, double theta, double phi) const {
-    // Вычисление сферических гармоник (упрощенная версия)
-    // Это используется для более точного расчета собственных частот
-    
-    if (l == 0 && m == 0) {
-        return 1.0 / std::sqrt(4.0 * M_PI);
-    }
-    
-    // Упрощенная версия - возвращаем базовое значение
-    return std::cos(m * phi) * std::sin(theta);
+    // Вещественная ортонормированная сферическая гармоника Y_l^m (ACN, N3D/√4π);
+    // вне -l ≤ m ≤ l — ноль
+    return Kernels::realSphericalHarmonic<double>(l, m, theta, phi);
 }
 
 double DomeAcousticResonator::calculateAcousticImpedance(double frequency) const {
@@ -3,9 +3,19 @@
 #include <vector>
 #include <map>
 #include <cmath>
+#include <atomic>
+#include <cstdint>
 
 namespace AnantaDigital {
 
+// Резонансная мода купола (вырожденные моды с одной частотой объединены)
+struct ResonanceMode {
+    double frequency;       // частота, Гц
+    double absorption;      // поглощение материала на этой частоте
+    double reverb_time;     // время реверберации, с
+    int degeneracy;         // число вырожденных мод
+};
+
 // Акустический резонатор для купола
 class DomeAcousticResonator {
 private:
@@ -13,6 +23,10 @@ private:
     double dome_height_;
     std::vector<double> resonant_frequencies_;
     std::map<double, double> acoustic_properties_;
+    
+    // Кэш резонансной модели; версия растет при каждом фактическом изменении
+    std::vector<ResonanceMode> resonance_modes_;
+    std::atomic<uint64_t> model_version_;
 
 public:
     DomeAcousticResonator(double radius, double height);
@@ -44,8 +58,16 @@ public:
     // Получить резонансные частоты
     const std::vector<double>& getResonantFrequencies() const { return resonant_frequencies_; }
     
+    // Кэшированная резонансная модель
+    const std::vector<ResonanceMode>& getResonanceModes() const { return resonance_modes_; }
+    
+    // Версия модели: дешевая проверка, изменилась ли она с прошлого блока
+    uint64_t getModelVersion() const { return model_version_.load(std::memory_order_acquire); }
+    
 private:
     // Приватные методы
+    void rebuildResonanceModel();
+    bool setAcousticPropertyValue(double frequency, double absorption);
     double calculateDomeEigenFrequency(int n, int m) const;
     double calculateSphericalHarmonic(int l, int m, double theta, double phi) const;
     double calculateAcousticImpedance(double frequency) const;
@@ -0,0 +1,248 @@
+#include "dome_texture_renderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace AnantaDigital {
+
+namespace {
+
+// Опорный цвет палитры в позиции [0, 1]
+struct ColorStop {
+    float position;
+    float r, g, b;
+};
+
+const ColorStop kHeatStops[] = {
+    {0.0f, 0.0f, 0.0f, 0.0f}, {0.35f, 180.0f, 20.0f, 10.0f}, {0.7f, 255.0f, 200.0f, 0.0f},
+    {1.0f, 255.0f, 255.0f, 255.0f}};
+const ColorStop kDivergingStops[] = {
+    {0.0f, 20.0f, 40.0f, 160.0f}, {0.5f, 255.0f, 255.0f, 255.0f}, {1.0f, 180.0f, 20.0f, 20.0f}};
+const ColorStop kCyclicStops[] = {
+    {0.0f, 255.0f, 0.0f, 0.0f}, {1.0f / 6, 255.0f, 255.0f, 0.0f}, {2.0f / 6, 0.0f, 255.0f, 0.0f},
+    {3.0f / 6, 0.0f, 255.0f, 255.0f}, {4.0f / 6, 0.0f, 0.0f, 255.0f}, {5.0f / 6, 255.0f, 0.0f, 255.0f},
+    {1.0f, 255.0f, 0.0f, 0.0f}};
+
+uint32_t packColor(float r, float g, float b) {
+    auto channel = [](float value) { return static_cast<uint32_t>(std::clamp(value, 0.0f, 255.0f) + 0.5f); };
+    return channel(r) | (channel(g) << 8) | (channel(b) << 16) | (255u << 24);
+}
+
+// Пикселей, переводимых в цвет за шаг
+constexpr size_t kColorChunk = 64;
+
+} // namespace
+
+DomeTextureRenderer::DomeTextureRenderer(const DomeTextureSettings& settings) {
+    setSettings(settings);
+}
+
+void DomeTextureRenderer::setSettings(const DomeTextureSettings& settings) {
+    settings_ = settings;
+    settings_.width = std::max<uint32_t>(settings_.width, 1);
+    settings_.height = std::max<uint32_t>(settings_.height, 1);
+    if (!(settings_.dome_radius > 0.0)) settings_.dome_radius = 10.0;
+    if (!(settings_.aperture > 0.0)) settings_.aperture = M_PI;
+    if (!(settings_.reference > 0.0)) settings_.reference = 1.0;
+    if (!(settings_.fps > 0.0f)) settings_.fps = 30.0f;
+    buildGrid();
+    buildColormap();
+}
+
+bool DomeTextureRenderer::pixelPoint(uint32_t px, uint32_t py, Kernels::CartesianPoint<double>& point) const {
+    if (px >= settings_.width || py >= settings_.height) return false;
+
+    double theta, phi;
+    if (settings_.projection == DomeProjection::FISHEYE) {
+        // Круг доммастера вписан в кадр; ось y кадра направлена вниз
+        const double radius = 0.5 * std::min(settings_.width, settings_.height);
+        const double u = (px + 0.5 - 0.5 * settings_.width) / radius;
+        const double v = (0.5 * settings_.height - py - 0.5) / radius;
+        const double rho = std::sqrt(u * u + v * v);
+        if (rho > 1.0) return false;
+        theta = rho * 0.5 * settings_.aperture;
+        phi = std::atan2(v, u);
+    } else {
+        theta = M_PI * (py + 0.5) / settings_.height;
+        phi = 2.0 * M_PI * (px + 0.5) / settings_.width - M_PI;
+    }
+    point = Kernels::toCartesian<double>(SphericalCoord{settings_.dome_radius, theta, phi, 0.0});
+    return true;
+}
+
+void DomeTextureRenderer::buildGrid() {
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    rows_.assign(settings_.height, RowSpan{0, 0, 0});
+    band_rows_.assign(1, 0);
+
+    // Покрытые пиксели строки идут подряд (круг выпуклый)
+    size_t band_points = 0, largest_band = 0;
+    for (uint32_t py = 0; py < settings_.height; ++py) {
+        RowSpan& row = rows_[py];
+        row.point = static_cast<uint32_t>(x_.size());
+        row.pixel = py * settings_.width;
+        for (uint32_t px = 0; px < settings_.width; ++px) {
+            Kernels::CartesianPoint<double> point;
+            if (!pixelPoint(px, py, point)) continue;
+            if (row.count == 0) row.pixel = py * settings_.width + px;
+            x_.push_back(point.x);
+            y_.push_back(point.y);
+            z_.push_back(point.z);
+            ++row.count;
+        }
+
+        band_points += row.count;
+        if (band_points >= kBandPixels || py + 1 == settings_.height) {
+            band_rows_.push_back(py + 1);
+            largest_band = std::max(largest_band, band_points);
+            band_points = 0;
+        }
+    }
+    values_.assign(largest_band, std::complex<double>(0.0, 0.0));
+}
+
+void DomeTextureRenderer::buildColormap() {
+    const ColorStop* stops = kHeatStops;
+    size_t count = sizeof(kHeatStops) / sizeof(kHeatStops[0]);
+    if (settings_.color_mode == DomeColorMode::REAL_PART) {
+        stops = kDivergingStops;
+        count = sizeof(kDivergingStops) / sizeof(kDivergingStops[0]);
+    } else if (settings_.color_mode == DomeColorMode::PHASE) {
+        stops = kCyclicStops;
+        count = sizeof(kCyclicStops) / sizeof(kCyclicStops[0]);
+    }
+
+    colormap_.resize(kColormapSize);
+    for (size_t i = 0; i < kColormapSize; ++i) {
+        // Циклическая палитра не повторяет начальный цвет в конце
+        const float position = settings_.color_mode == DomeColorMode::PHASE
+                                   ? static_cast<float>(i) / kColormapSize
+                                   : static_cast<float>(i) / (kColormapSize - 1);
+        size_t stop = 1;
+        while (stop + 1 < count && stops[stop].position < position) ++stop;
+        const ColorStop& a = stops[stop - 1];
+        const ColorStop& b = stops[stop];
+        const float t = std::clamp((position - a.position) / (b.position - a.position), 0.0f, 1.0f);
+        colormap_[i] = packColor(a.r + (b.r - a.r) * t, a.g + (b.g - a.g) * t, a.b + (b.b - a.b) * t);
+    }
+}
+
+float DomeTextureRenderer::levelOf(const std::complex<double>& value) const {
+    const double scale = (kColormapSize - 1) / settings_.reference;
+    switch (settings_.color_mode) {
+        case DomeColorMode::REAL_PART:
+            return static_cast<float>(0.5 * (kColormapSize - 1) + 0.5 * scale * value.real());
+        case DomeColorMode::PHASE: {
+            // Индекс 256 совпадает с 0
+            float level = static_cast<float>((std::arg(value) + M_PI) * (kColormapSize / (2.0 * M_PI)));
+            return level >= kColormapSize - 0.5f ? 0.0f : level;
+        }
+        case DomeColorMode::MAGNITUDE:
+        default:
+            return static_cast<float>(scale * std::sqrt(std::norm(value)));
+    }
+}
+
+uint32_t DomeTextureRenderer::colorFor(const std::complex<double>& value) const {
+    const float level = std::clamp(levelOf(value) + 0.5f, 0.0f, static_cast<float>(kColormapSize - 1));
+    return colormap_[static_cast<size_t>(level)];
+}
+
+void DomeTextureRenderer::colorRow(uint32_t row, size_t first_point, uint8_t* rgba) const {
+    const RowSpan& span = rows_[row];
+    uint8_t* line = rgba + size_t(row) * settings_.width * 4;
+    const size_t left = span.count > 0 ? span.pixel - size_t(row) * settings_.width : settings_.width;
+    std::memset(line, 0, left * 4);
+    std::memset(line + (left + span.count) * 4, 0, (settings_.width - left - span.count) * 4);
+    if (span.count == 0) return;
+
+    const std::complex<double>* values = values_.data() + (span.point - first_point);
+    uint8_t* out = line + left * 4;
+    alignas(32) float levels[kColorChunk];
+    for (size_t begin = 0; begin < span.count; begin += kColorChunk) {
+        const size_t count = std::min(kColorChunk, span.count - begin);
+        for (size_t i = 0; i < count; ++i) {
+            levels[i] = levelOf(values[begin + i]);
+        }
+
+        size_t i = 0;
+#if defined(__AVX2__)
+        // Округление, ограничение и выборка из палитры по 8 пикселей
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 top = _mm256_set1_ps(static_cast<float>(kColormapSize - 1));
+        const int* table = reinterpret_cast<const int*>(colormap_.data());
+        for (; i + 8 <= count; i += 8) {
+            __m256 level = _mm256_add_ps(_mm256_load_ps(levels + i), half);
+            level = _mm256_min_ps(_mm256_max_ps(level, zero), top);
+            const __m256i colors = _mm256_i32gather_epi32(table, _mm256_cvttps_epi32(level), 4);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + (begin + i) * 4), colors);
+        }
+#endif
+        for (; i < count; ++i) {
+            const float level = std::clamp(levels[i] + 0.5f, 0.0f, static_cast<float>(kColormapSize - 1));
+            std::memcpy(out + (begin + i) * 4, &colormap_[static_cast<size_t>(level)], 4);
+        }
+    }
+}
+
+void DomeTextureRenderer::renderFrame(const InterferenceField& field, double time, uint8_t* rgba,
+                                      WorkerPool* pool) {
+    if (!rgba) return;
+
+    for (size_t band = 0; band + 1 < band_rows_.size(); ++band) {
+        const uint32_t row_begin = band_rows_[band];
+        const uint32_t row_end = band_rows_[band + 1];
+        const size_t first_point = rows_[row_begin].point;
+        const size_t end_point = rows_[row_end - 1].point + rows_[row_end - 1].count;
+
+        ObserverBatch batch;
+        batch.x = x_.data() + first_point;
+        batch.y = y_.data() + first_point;
+        batch.z = z_.data() + first_point;
+        batch.common_time = time;
+        batch.count = end_point - first_point;
+        field.calculateInterferenceBatch(batch, values_.data(), pool);
+
+        auto colorTask = [&](size_t task, size_t) {
+            colorRow(row_begin + static_cast<uint32_t>(task), first_point, rgba);
+        };
+        const size_t row_count = row_end - row_begin;
+        if (pool && row_count > 1) {
+            pool->run(row_count, colorTask);
+        } else {
+            for (size_t task = 0; task < row_count; ++task) colorTask(task, 0);
+        }
+    }
+}
+
+FreeDomeVision::VisualData DomeTextureRenderer::renderSequence(const InterferenceField& field, double start_time,
+                                                               uint32_t frame_count, WorkerPool* pool) {
+    FreeDomeVision::VisualData visual;
+    visual.width = settings_.width;
+    visual.height = settings_.height;
+    visual.depth = 0;
+    visual.frameCount = frame_count;
+    visual.fps = settings_.fps;
+    visual.pixelFormat = FreeDomeVision::PixelFormat::RGBA8;
+    visual.data.resize(getFrameBytes() * frame_count);
+    
+    // Элементы — источники поля на сферической поверхности купола, состояния — цвета палитры
+    visual.quantumData.elementCount = static_cast<uint32_t>(field.getSourceFieldCount());
+    visual.quantumData.geometryType = FreeDomeVision::QuantumGeometryType::SPHERICAL;
+    visual.quantumData.quantumStates = static_cast<uint32_t>(kColormapSize);
+
+    for (uint32_t frame = 0; frame < frame_count; ++frame) {
+        const double time = start_time + frame / static_cast<double>(settings_.fps);
+        renderFrame(field, time, visual.data.data() + getFrameBytes() * frame, pool);
+    }
+    return visual;
+}
+
+} // namespace AnantaDigital
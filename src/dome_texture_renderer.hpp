@@ -0,0 +1,107 @@
+#pragma once
+
+#include "interference_field.hpp"
+#include "format_handler.hpp"
+#include "worker_pool.hpp"
+#include <vector>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Проекция купола в кадр
+enum class DomeProjection {
+    FISHEYE,            // доммастер: зенит в центре, край круга — aperture/2 от зенита
+    EQUIRECTANGULAR     // азимут по ширине, полярный угол от зенита по высоте (вся сфера)
+};
+
+// Что из интерференции отображается цветом
+enum class DomeColorMode {
+    MAGNITUDE,          // |v| / reference, от черного через красный и желтый к белому
+    REAL_PART,          // Re v / reference, синий — белый — красный
+    PHASE               // arg v, циклическая палитра
+};
+
+// Параметры текстуры купола
+struct DomeTextureSettings {
+    DomeProjection projection = DomeProjection::FISHEYE;
+    DomeColorMode color_mode = DomeColorMode::MAGNITUDE;
+    uint32_t width = 1024;
+    uint32_t height = 1024;
+    double dome_radius = 10.0;          // радиус поверхности вокруг начала координат, м
+    double aperture = M_PI;             // угол обзора доммастера
+    double reference = 1.0;             // значение, которому соответствует край палитры
+    float fps = 30.0f;
+};
+
+// Визуализация интерференционного поля на поверхности купола.
+//
+// Точки поверхности для пикселей кадра считаются один раз при смене
+// параметров. Кадр идет полосами строк по kBandPixels точек: каждая полоса —
+// один calculateInterferenceBatch (плитки параллельно на pool, SIMD по
+// точкам; с деревом источников — через него), затем строки полосы параллельно
+// переводятся в цвет по таблице на 256 цветов (AVX2: 8 пикселей за шаг).
+//
+// Кадр — RGBA8 по строкам сверху вниз; пиксели вне круга доммастера
+// прозрачные черные. Последовательность кадров — VisualData с кадрами подряд
+// (depth = 0, PixelFormat::RGBA8), которую сохраняет FormatHandler; в quantumData —
+// число источников поля, сферическая геометрия и число цветов палитры.
+//
+// Рендерер хранит буферы полосы: один экземпляр — один поток вызовов.
+class DomeTextureRenderer {
+public:
+    static constexpr size_t kBandPixels = size_t(1) << 16;
+    static constexpr size_t kColormapSize = 256;
+
+private:
+    // Покрытая часть строки: точки [point, point + count) в пикселях [pixel, pixel + count)
+    struct RowSpan {
+        uint32_t pixel;
+        uint32_t point;
+        uint32_t count;
+    };
+
+    DomeTextureSettings settings_;
+    std::vector<double> x_, y_, z_;     // точки поверхности покрытых пикселей по строкам
+    std::vector<RowSpan> rows_;
+    std::vector<uint32_t> band_rows_;   // первая строка каждой полосы и конец последней
+    std::vector<uint32_t> colormap_;    // RGBA, R в младшем байте
+    std::vector<std::complex<double>> values_;
+
+public:
+    explicit DomeTextureRenderer(const DomeTextureSettings& settings = DomeTextureSettings{});
+
+    // Размеры меньше 1 пикселя и неположительные радиус и масштаб заменяются допустимыми
+    void setSettings(const DomeTextureSettings& settings);
+    const DomeTextureSettings& getSettings() const { return settings_; }
+
+    // Пикселей на поверхности купола
+    size_t getCoveredPixels() const { return x_.size(); }
+    size_t getFrameBytes() const { return size_t(settings_.width) * settings_.height * 4; }
+
+    // Точка поверхности для пикселя (px, py); false — пиксель вне купола
+    bool pixelPoint(uint32_t px, uint32_t py, Kernels::CartesianPoint<double>& point) const;
+
+    // Цвет значения интерференции (RGBA, R в младшем байте)
+    uint32_t colorFor(const std::complex<double>& value) const;
+
+    // Кадр во время time в rgba (getFrameBytes() байт)
+    void renderFrame(const InterferenceField& field, double time, uint8_t* rgba, WorkerPool* pool = nullptr);
+
+    // frame_count кадров с шагом 1/fps от start_time
+    FreeDomeVision::VisualData renderSequence(const InterferenceField& field, double start_time,
+                                              uint32_t frame_count, WorkerPool* pool = nullptr);
+
+private:
+    void buildGrid();
+    void buildColormap();
+
+    // Индекс палитры значения (до округления и ограничения)
+    float levelOf(const std::complex<double>& value) const;
+
+    // Строка row в цвет; values_ полосы начинаются с точки first_point
+    void colorRow(uint32_t row, size_t first_point, uint8_t* rgba) const;
+};
+
+} // namespace AnantaDigital
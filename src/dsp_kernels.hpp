@@ -0,0 +1,214 @@
+#pragma once
+
+#include "anantadigital_types.hpp"
+#include "sample_types.hpp"
+#include <complex>
+#include <cmath>
+#include <algorithm>
+
+// Горячие ядра DSP-тракта, шаблонные по типу отсчета (float или double).
+// Классы вызывают их с типом Sample; тесты сравнивают float и double
+// в пределах SamplePrecision<T>.
+namespace AnantaDigital::Kernels {
+
+// Скорость звука в воздухе, м/с
+constexpr double kSpeedOfSound = 343.0;
+
+template <typename T>
+struct CartesianPoint {
+    T x, y, z;
+};
+
+// Сферические координаты купола в декартовы (высота добавляется к z)
+template <typename T>
+inline CartesianPoint<T> toCartesian(const SphericalCoord& position) {
+    const T r = static_cast<T>(position.r);
+    const T theta = static_cast<T>(position.theta);
+    const T phi = static_cast<T>(position.phi);
+    const T sin_theta = std::sin(theta);
+    return CartesianPoint<T>{r * sin_theta * std::cos(phi),
+                             r * sin_theta * std::sin(phi),
+                             r * std::cos(theta) + static_cast<T>(position.height)};
+}
+
+template <typename T>
+inline T distance(const CartesianPoint<T>& a, const CartesianPoint<T>& b) {
+    const T dx = b.x - a.x;
+    const T dy = b.y - a.y;
+    const T dz = b.z - a.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Фазовая задержка exp(i·2π·f·(t - d/c)).
+// Временная часть f·t приводится к [0, 1) в double, иначе float теряет
+// точность уже через несколько секунд; пространственная часть — в T.
+template <typename T>
+inline std::complex<T> phaseDelay(T distance_m, double frequency, double time) {
+    double time_cycles = frequency * time;
+    time_cycles -= std::floor(time_cycles);
+    const T cycles = static_cast<T>(time_cycles) -
+                     static_cast<T>(frequency / kSpeedOfSound) * distance_m;
+    const T phase = static_cast<T>(2.0 * M_PI) * cycles;
+    return std::complex<T>(std::cos(phase), std::sin(phase));
+}
+
+// Затухание с расстоянием 1 / (1 + 0.1·d)
+template <typename T>
+inline T distanceAttenuation(T distance_m) {
+    return T(1) / (T(1) + distance_m * T(0.1));
+}
+
+// Вклад одного источника в точке наблюдения
+template <typename T>
+inline std::complex<T> sourceContribution(const std::complex<T>& amplitude, double frequency,
+                                          T distance_m, double time) {
+    return amplitude * phaseDelay<T>(distance_m, frequency, time) * distanceAttenuation<T>(distance_m);
+}
+
+// Преобразование суммарного сигнала по типу интерференции
+template <typename T>
+inline std::complex<T> applyInterferenceType(const std::complex<T>& signal, InterferenceFieldType type) {
+    switch (type) {
+        case InterferenceFieldType::CONSTRUCTIVE:
+            return signal;
+
+        case InterferenceFieldType::DESTRUCTIVE:
+            return -signal;
+
+        case InterferenceFieldType::PHASE_MODULATED: {
+            T phase_mod = std::sin(std::arg(signal) * T(2));
+            return signal * std::complex<T>(std::cos(phase_mod), std::sin(phase_mod));
+        }
+
+        case InterferenceFieldType::AMPLITUDE_MODULATED: {
+            T amp_mod = (T(1) + std::sin(std::arg(signal))) / T(2);
+            return signal * amp_mod;
+        }
+
+        case InterferenceFieldType::QUANTUM_ENTANGLED: {
+            T quantum_factor = std::abs(signal) * std::cos(std::arg(signal));
+            return signal * quantum_factor;
+        }
+
+        default:
+            return signal;
+    }
+}
+
+// Квантовая коррекция сигнала по сигналу обратной связи
+template <typename T>
+inline std::complex<T> quantumCorrection(const std::complex<T>& input, const std::complex<T>& feedback) {
+    const T input_amp = std::abs(input);
+    const T input_phase = std::arg(input);
+    const T feedback_amp = std::abs(feedback);
+    const T feedback_phase = std::arg(feedback);
+
+    // Коррекция амплитуды (не может быть отрицательной)
+    T corrected_amp = input_amp * (T(1) - T(0.1) * (feedback_amp - input_amp) / input_amp);
+    corrected_amp = std::max(T(0), corrected_amp);
+
+    // Коррекция фазы
+    const T corrected_phase = input_phase + T(0.1) * (feedback_phase - input_phase);
+
+    return std::polar(corrected_amp, corrected_phase);
+}
+
+// Собственная частота сферического купола: f = c/(2π)·sqrt(n(n+1))/R с поправкой на высоту
+template <typename T>
+inline T domeEigenFrequency(int n, T radius, T height) {
+    const T frequency = static_cast<T>(kSpeedOfSound / (2.0 * M_PI)) *
+                        std::sqrt(static_cast<T>(n) * (static_cast<T>(n) + T(1))) / radius;
+    const T height_factor = T(1) + (height / radius) * T(0.1);
+    return frequency * height_factor;
+}
+
+// Число коэффициентов сферических гармоник порядка до order включительно
+inline constexpr size_t sphericalHarmonicCount(int order) {
+    return static_cast<size_t>((order + 1) * (order + 1));
+}
+
+// Индекс ACN гармоники (l, m): l² + l + m
+inline constexpr size_t sphericalHarmonicIndex(int l, int m) {
+    return static_cast<size_t>(l * l + l + m);
+}
+
+// Вещественные ортонормированные сферические гармоники (N3D/√4π, без фазы
+// Кондона — Шортли) всех порядков до order в порядке ACN. theta — полярный
+// угол от зенита, phi — азимут. out — sphericalHarmonicCount(order) значений.
+template <typename T>
+inline void realSphericalHarmonics(int order, T theta, T phi, T* out) {
+    const T x = std::cos(theta);
+    const T s = std::sin(theta);
+    const T sqrt2 = std::sqrt(T(2));
+
+    // P_m^m по рекурсии, затем P_l^m по возрастанию l
+    T p_mm = T(1);
+    for (int m = 0; m <= order; ++m) {
+        if (m > 0) p_mm *= static_cast<T>(2 * m - 1) * s;
+
+        const T cos_m = std::cos(static_cast<T>(m) * phi);
+        const T sin_m = std::sin(static_cast<T>(m) * phi);
+
+        // K_l^m = sqrt((2l+1)/(4π) · (l-m)!/(l+m)!); отношение факториалов — по ходу l
+        T p_prev = T(0);
+        T p_l = p_mm;
+        T factorial_ratio = T(1);
+        for (int k = 2; k <= 2 * m; ++k) factorial_ratio /= static_cast<T>(k);
+
+        for (int l = m; l <= order; ++l) {
+            if (l == m + 1) {
+                p_prev = p_l;
+                p_l = x * static_cast<T>(2 * m + 1) * p_mm;
+            } else if (l > m + 1) {
+                const T p_next = (static_cast<T>(2 * l - 1) * x * p_l - static_cast<T>(l + m - 1) * p_prev) /
+                                 static_cast<T>(l - m);
+                p_prev = p_l;
+                p_l = p_next;
+            }
+            if (l > m) factorial_ratio *= static_cast<T>(l - m) / static_cast<T>(l + m);
+
+            const T k_lm = std::sqrt(static_cast<T>(2 * l + 1) / static_cast<T>(4.0 * M_PI) * factorial_ratio);
+            if (m == 0) {
+                out[sphericalHarmonicIndex(l, 0)] = k_lm * p_l;
+            } else {
+                out[sphericalHarmonicIndex(l, m)] = sqrt2 * k_lm * p_l * cos_m;
+                out[sphericalHarmonicIndex(l, -m)] = sqrt2 * k_lm * p_l * sin_m;
+            }
+        }
+    }
+}
+
+// Одна гармоника (l, m) в той же нормировке, что realSphericalHarmonics:
+// рекурсия только по столбцу m, без буфера на все порядки
+template <typename T>
+inline T realSphericalHarmonic(int l, int m, T theta, T phi) {
+    if (l < 0 || m < -l || m > l) return T(0);
+
+    const int am = m < 0 ? -m : m;
+    const T x = std::cos(theta);
+    const T s = std::sin(theta);
+
+    T p_mm = T(1);
+    for (int k = 1; k <= am; ++k) p_mm *= static_cast<T>(2 * k - 1) * s;
+
+    T p_prev = T(0);
+    T p_l = p_mm;
+    for (int k = am + 1; k <= l; ++k) {
+        const T p_next = k == am + 1 ? x * static_cast<T>(2 * am + 1) * p_mm
+                                     : (static_cast<T>(2 * k - 1) * x * p_l - static_cast<T>(k + am - 1) * p_prev) /
+                                           static_cast<T>(k - am);
+        p_prev = p_l;
+        p_l = p_next;
+    }
+
+    // (l-|m|)!/(l+|m|)!
+    T factorial_ratio = T(1);
+    for (int k = l - am + 1; k <= l + am; ++k) factorial_ratio /= static_cast<T>(k);
+    const T k_lm = std::sqrt(static_cast<T>(2 * l + 1) / static_cast<T>(4.0 * M_PI) * factorial_ratio);
+
+    if (m == 0) return k_lm * p_l;
+    const T angle = static_cast<T>(am) * phi;
+    return std::sqrt(T(2)) * k_lm * p_l * (m > 0 ? std::cos(angle) : std::sin(angle));
+}
+
+} // namespace AnantaDigital::Kernels
@@ -0,0 +1,573 @@
+#include "field_store.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace AnantaDigital {
+
+namespace {
+
+// Битовое представление double; -0.0 приводится к 0.0, чтобы ключи совпадали
+int64_t exactBits(double value) {
+    if (value == 0.0) value = 0.0;
+    int64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+size_t FieldStore::hashKey(const SpatialKey& key) {
+    // Смешивание в стиле splitmix64
+    uint64_t h = 0x9E3779B97F4A7C15ull;
+    for (int64_t part : {key.a, key.b, key.c, key.d}) {
+        h ^= static_cast<uint64_t>(part) + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+        h ^= h >> 31;
+    }
+    return static_cast<size_t>(h);
+}
+
+FieldStore::FieldStore()
+    : index_size_(0)
+    , merge_resolution_(0.0)
+    , capacity_(0)
+    , steal_policy_(VoiceStealPolicy::REJECT)
+    , victim_policy_(VoiceStealPolicy::QUIETEST)
+    , peak_size_(0)
+    , rejected_count_(0)
+    , stolen_count_(0) {
+}
+
+void FieldStore::reserve(size_t capacity) {
+    frequencies_.reserve(capacity);
+    amplitudes_.reserve(capacity);
+    phases_.reserve(capacity);
+    states_.reserve(capacity);
+    positions_.reserve(capacity);
+    sample_times_.reserve(capacity);
+    waveforms_.reserve(capacity);
+    priorities_.reserve(capacity);
+    dense_to_slot_.reserve(capacity);
+    dense_keys_.reserve(capacity);
+    slots_.reserve(capacity);
+    free_slots_.reserve(capacity);
+    victim_heap_.reserve(capacity);
+    heap_positions_.reserve(capacity);
+    indexReserve(capacity);
+}
+
+void FieldStore::setCapacity(size_t capacity, VoiceStealPolicy policy) {
+    capacity_ = capacity;
+    steal_policy_ = policy;
+    // Куча упорядочена по политике пула; при REJECT — по громкости для сокращения емкости
+    victim_policy_ = policy == VoiceStealPolicy::REJECT ? VoiceStealPolicy::QUIETEST : policy;
+    if (capacity_ == 0) {
+        victim_heap_.clear();
+        return;
+    }
+
+    reserve(capacity_);
+    rebuildVictimHeap();
+
+    // Поля сверх нового лимита вытесняются (при REJECT — самые тихие)
+    while (size() > capacity_) {
+        remove(handleAt(selectVictim(victim_policy_)));
+        ++stolen_count_;
+    }
+}
+
+PoolStatistics FieldStore::getStatistics() const {
+    PoolStatistics stats;
+    stats.capacity = capacity_;
+    stats.in_use = size();
+    stats.peak_in_use = peak_size_;
+    stats.rejected = rejected_count_;
+    stats.stolen = stolen_count_;
+    return stats;
+}
+
+void FieldStore::resetStatistics() {
+    peak_size_ = size();
+    rejected_count_ = 0;
+    stolen_count_ = 0;
+}
+
+size_t FieldStore::selectVictim(VoiceStealPolicy policy) const {
+    if (empty()) return SIZE_MAX;
+    if (victimHeapActive() && policy == victim_policy_) {
+        return slots_[victim_heap_.front()].dense_index;
+    }
+
+    size_t victim = 0;
+    VoiceKey victim_key = VoiceKey::of(amplitudes_[0], sample_times_[0], priorities_[0]);
+    for (size_t i = 1; i < size(); ++i) {
+        VoiceKey key = VoiceKey::of(amplitudes_[i], sample_times_[i], priorities_[i]);
+        if (preferVictim(policy, key, victim_key)) {
+            victim = i;
+            victim_key = key;
+        }
+    }
+    return victim;
+}
+
+void FieldStore::setMergeResolution(double resolution) {
+    resolution = std::max(0.0, resolution);
+    if (resolution == merge_resolution_) return;
+    merge_resolution_ = resolution;
+    rebuildSpatialIndex();
+}
+
+FieldStore::SpatialKey FieldStore::makeKey(const SphericalCoord& position) const {
+    if (merge_resolution_ <= 0.0) {
+        return SpatialKey{exactBits(position.r), exactBits(position.theta),
+                          exactBits(position.phi), exactBits(position.height)};
+    }
+
+    // Квантуем в декартовом пространстве купола, чтобы шаг был в метрах
+    double x = position.r * std::sin(position.theta) * std::cos(position.phi);
+    double y = position.r * std::sin(position.theta) * std::sin(position.phi);
+    double z = position.r * std::cos(position.theta) + position.height;
+
+    return SpatialKey{static_cast<int64_t>(std::floor(x / merge_resolution_)),
+                      static_cast<int64_t>(std::floor(y / merge_resolution_)),
+                      static_cast<int64_t>(std::floor(z / merge_resolution_)),
+                      0};
+}
+
+void FieldStore::writeDense(size_t dense_index, const QuantumSoundField& field) {
+    frequencies_[dense_index] = field.frequency;
+    amplitudes_[dense_index] = field.amplitude;
+    phases_[dense_index] = field.phase;
+    states_[dense_index] = field.quantum_state;
+    positions_[dense_index] = field.position;
+    sample_times_[dense_index] = field.sample_time;
+    waveforms_[dense_index] = field.waveform;
+    priorities_[dense_index] = field.priority;
+}
+
+FieldHandle FieldStore::insert(const QuantumSoundField& field) {
+    return insertSlot(field, false);
+}
+
+FieldHandle FieldStore::insertSlot(const QuantumSoundField& field, bool mergeable) {
+    if (full()) {
+        size_t victim = steal_policy_ == VoiceStealPolicy::REJECT ? SIZE_MAX : selectVictim(steal_policy_);
+        if (victim == SIZE_MAX ||
+            preferVictim(steal_policy_, VoiceKey::of(field),
+                         VoiceKey::of(amplitudes_[victim], sample_times_[victim], priorities_[victim]))) {
+            ++rejected_count_;
+            return FieldHandle::invalid();
+        }
+        remove(handleAt(victim));
+        ++stolen_count_;
+    }
+
+    uint32_t slot_index;
+    if (!free_slots_.empty()) {
+        slot_index = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot_index = static_cast<uint32_t>(slots_.size());
+        slots_.push_back(Slot{0, 0, UINT32_MAX, UINT32_MAX, false, false});
+        heap_positions_.push_back(UINT32_MAX);
+    }
+
+    size_t dense_index = frequencies_.size();
+    frequencies_.emplace_back();
+    amplitudes_.emplace_back();
+    phases_.emplace_back();
+    states_.emplace_back();
+    positions_.emplace_back();
+    sample_times_.emplace_back();
+    waveforms_.emplace_back();
+    priorities_.emplace_back();
+    dense_to_slot_.push_back(slot_index);
+    dense_keys_.push_back(makeKey(field.position));
+    writeDense(dense_index, field);
+
+    Slot& slot = slots_[slot_index];
+    slot.dense_index = static_cast<uint32_t>(dense_index);
+    slot.occupied = true;
+    slot.mergeable = mergeable;
+
+    indexInsert(dense_keys_[dense_index], slot_index);
+    if (victimHeapActive()) heapPush(slot_index);
+    peak_size_ = std::max(peak_size_, size());
+
+    return FieldHandle{slot_index, slot.generation};
+}
+
+FieldHandle FieldStore::insertOrMerge(const QuantumSoundField& field) {
+    // Сливаться можно только с полями, добавленными через insertOrMerge
+    size_t position = indexLookup(makeKey(field.position));
+    if (position != SIZE_MAX && index_table_[position].slot != UINT32_MAX) {
+        uint32_t slot_index = index_table_[position].slot;
+        FieldHandle handle{slot_index, slots_[slot_index].generation};
+        update(handle, field);
+        return handle;
+    }
+    return insertSlot(field, true);
+}
+
+FieldHandle FieldStore::find(const SphericalCoord& position) const {
+    uint32_t slot_index = indexFind(makeKey(position));
+    if (slot_index == UINT32_MAX) {
+        return FieldHandle::invalid();
+    }
+    return FieldHandle{slot_index, slots_[slot_index].generation};
+}
+
+bool FieldStore::update(FieldHandle handle, const QuantumSoundField& field) {
+    if (!contains(handle)) return false;
+
+    size_t dense_index = slots_[handle.index].dense_index;
+    SpatialKey new_key = makeKey(field.position);
+
+    if (!(new_key == dense_keys_[dense_index])) {
+        indexErase(dense_keys_[dense_index], handle.index);
+        dense_keys_[dense_index] = new_key;
+        indexInsert(new_key, handle.index);
+    }
+
+    writeDense(dense_index, field);
+    if (victimHeapActive()) heapFix(handle.index);
+    return true;
+}
+
+bool FieldStore::setAmplitude(FieldHandle handle, const std::complex<double>& amplitude) {
+    if (!contains(handle)) return false;
+    amplitudes_[slots_[handle.index].dense_index] = amplitude;
+    if (victimHeapActive()) heapFix(handle.index);
+    return true;
+}
+
+bool FieldStore::setFrequency(FieldHandle handle, double frequency) {
+    if (!contains(handle)) return false;
+    frequencies_[slots_[handle.index].dense_index] = frequency;
+    return true;
+}
+
+bool FieldStore::remove(FieldHandle handle) {
+    if (!contains(handle)) return false;
+
+    Slot& slot = slots_[handle.index];
+    size_t dense_index = slot.dense_index;
+    size_t last = frequencies_.size() - 1;
+
+    indexErase(dense_keys_[dense_index], handle.index);
+    if (victimHeapActive()) heapErase(handle.index);
+
+    if (dense_index != last) {
+        frequencies_[dense_index] = frequencies_[last];
+        amplitudes_[dense_index] = amplitudes_[last];
+        phases_[dense_index] = phases_[last];
+        states_[dense_index] = states_[last];
+        positions_[dense_index] = positions_[last];
+        sample_times_[dense_index] = sample_times_[last];
+        waveforms_[dense_index] = waveforms_[last];
+        priorities_[dense_index] = priorities_[last];
+        dense_keys_[dense_index] = dense_keys_[last];
+        dense_to_slot_[dense_index] = dense_to_slot_[last];
+        slots_[dense_to_slot_[dense_index]].dense_index = static_cast<uint32_t>(dense_index);
+    }
+
+    frequencies_.pop_back();
+    amplitudes_.pop_back();
+    phases_.pop_back();
+    states_.pop_back();
+    positions_.pop_back();
+    sample_times_.pop_back();
+    waveforms_.pop_back();
+    priorities_.pop_back();
+    dense_keys_.pop_back();
+    dense_to_slot_.pop_back();
+
+    slot.occupied = false;
+    ++slot.generation;
+    free_slots_.push_back(handle.index);
+    return true;
+}
+
+void FieldStore::clear() {
+    // Все поколения увеличиваются, чтобы старые дескрипторы стали недействительными
+    for (size_t i = 0; i < dense_to_slot_.size(); ++i) {
+        Slot& slot = slots_[dense_to_slot_[i]];
+        slot.occupied = false;
+        ++slot.generation;
+        free_slots_.push_back(dense_to_slot_[i]);
+    }
+
+    frequencies_.clear();
+    amplitudes_.clear();
+    phases_.clear();
+    states_.clear();
+    positions_.clear();
+    sample_times_.clear();
+    waveforms_.clear();
+    priorities_.clear();
+    dense_keys_.clear();
+    dense_to_slot_.clear();
+    victim_heap_.clear();
+    indexClear();
+}
+
+bool FieldStore::contains(FieldHandle handle) const {
+    return handle.index < slots_.size() &&
+           slots_[handle.index].occupied &&
+           slots_[handle.index].generation == handle.generation;
+}
+
+QuantumSoundField FieldStore::fieldAt(size_t dense_index) const {
+    QuantumSoundField field;
+    field.frequency = frequencies_[dense_index];
+    field.amplitude = amplitudes_[dense_index];
+    field.phase = phases_[dense_index];
+    field.quantum_state = states_[dense_index];
+    field.position = positions_[dense_index];
+    field.sample_time = sample_times_[dense_index];
+    field.waveform = waveforms_[dense_index];
+    field.priority = priorities_[dense_index];
+    return field;
+}
+
+FieldHandle FieldStore::handleAt(size_t dense_index) const {
+    uint32_t slot_index = dense_to_slot_[dense_index];
+    return FieldHandle{slot_index, slots_[slot_index].generation};
+}
+
+size_t FieldStore::denseIndex(FieldHandle handle) const {
+    if (!contains(handle)) return SIZE_MAX;
+    return slots_[handle.index].dense_index;
+}
+
+QuantumSoundField FieldStore::get(FieldHandle handle) const {
+    if (!contains(handle)) return QuantumSoundField{};
+    return fieldAt(slots_[handle.index].dense_index);
+}
+
+void FieldStore::rebuildSpatialIndex() {
+    indexClear();
+
+    // Сливаемые поля, попавшие в ячейку с другим сливаемым полем, сливаются
+    // с первым из них; несливаемые поля только переносятся в новые ячейки
+    size_t i = 0;
+    while (i < frequencies_.size()) {
+        SpatialKey key = makeKey(positions_[i]);
+        dense_keys_[i] = key;
+        uint32_t slot_index = dense_to_slot_[i];
+        if (slots_[slot_index].mergeable) {
+            size_t position = indexLookup(key);
+            if (position != SIZE_MAX && index_table_[position].slot != UINT32_MAX) {
+                // remove() переставит последнее поле на позицию i, поэтому индекс не растет
+                remove(handleAt(i));
+                continue;
+            }
+        }
+        indexInsert(key, slot_index);
+        ++i;
+    }
+}
+
+size_t FieldStore::indexLookup(const SpatialKey& key) const {
+    if (index_table_.empty()) return SIZE_MAX;
+
+    const size_t mask = index_table_.size() - 1;
+    for (size_t i = hashKey(key) & mask;; i = (i + 1) & mask) {
+        const IndexEntry& entry = index_table_[i];
+        if (entry.vacant()) return SIZE_MAX;
+        if (entry.key == key) return i;
+    }
+}
+
+uint32_t FieldStore::indexFind(const SpatialKey& key) const {
+    size_t position = indexLookup(key);
+    if (position == SIZE_MAX) return UINT32_MAX;
+    const IndexEntry& entry = index_table_[position];
+    return entry.slot != UINT32_MAX ? entry.slot : entry.fixed_slot;
+}
+
+void FieldStore::indexInsert(const SpatialKey& key, uint32_t slot_index) {
+    // Таблица растет только без заранее заданной емкости
+    if ((index_size_ + 1) * 2 > index_table_.size()) {
+        indexReserve(std::max<size_t>(16, index_size_ + 1) * 2);
+    }
+
+    const size_t mask = index_table_.size() - 1;
+    size_t i = hashKey(key) & mask;
+    for (;; i = (i + 1) & mask) {
+        IndexEntry& entry = index_table_[i];
+        if (entry.vacant()) {
+            entry.key = key;
+            ++index_size_;
+            break;
+        }
+        if (entry.key == key) break;
+    }
+
+    // Первое поле списка остается представителем ячейки, новое встает за ним
+    Slot& slot = slots_[slot_index];
+    uint32_t& head = slot.mergeable ? index_table_[i].slot : index_table_[i].fixed_slot;
+    if (head == UINT32_MAX) {
+        head = slot_index;
+        slot.cell_prev = UINT32_MAX;
+        slot.cell_next = UINT32_MAX;
+    } else {
+        slot.cell_prev = head;
+        slot.cell_next = slots_[head].cell_next;
+        if (slot.cell_next != UINT32_MAX) slots_[slot.cell_next].cell_prev = slot_index;
+        slots_[head].cell_next = slot_index;
+    }
+}
+
+void FieldStore::indexPlace(const IndexEntry& entry) {
+    const size_t mask = index_table_.size() - 1;
+    for (size_t i = hashKey(entry.key) & mask;; i = (i + 1) & mask) {
+        if (index_table_[i].vacant()) {
+            index_table_[i] = entry;
+            ++index_size_;
+            return;
+        }
+    }
+}
+
+void FieldStore::indexErase(const SpatialKey& key, uint32_t slot_index) {
+    size_t hole = indexLookup(key);
+    if (hole == SIZE_MAX) return;
+
+    // Поле выходит из списка ячейки; голову заменяет следующее поле того же ключа
+    Slot& slot = slots_[slot_index];
+    uint32_t& head = slot.mergeable ? index_table_[hole].slot : index_table_[hole].fixed_slot;
+    if (slot.cell_prev != UINT32_MAX) {
+        slots_[slot.cell_prev].cell_next = slot.cell_next;
+    } else if (head == slot_index) {
+        head = slot.cell_next;
+    } else {
+        return;
+    }
+    if (slot.cell_next != UINT32_MAX) slots_[slot.cell_next].cell_prev = slot.cell_prev;
+    slot.cell_prev = UINT32_MAX;
+    slot.cell_next = UINT32_MAX;
+
+    // В ячейке остались поля — запись индекса сохраняется
+    if (!index_table_[hole].vacant()) return;
+
+    // Обратный сдвиг: записи после дыры, которые могут в нее переехать, сдвигаются
+    const size_t mask = index_table_.size() - 1;
+    for (size_t i = (hole + 1) & mask;; i = (i + 1) & mask) {
+        IndexEntry& entry = index_table_[i];
+        if (entry.vacant()) break;
+        size_t home = hashKey(entry.key) & mask;
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            index_table_[hole] = entry;
+            hole = i;
+        }
+    }
+    index_table_[hole].slot = UINT32_MAX;
+    index_table_[hole].fixed_slot = UINT32_MAX;
+    --index_size_;
+}
+
+VoiceKey FieldStore::victimKey(uint32_t slot) const {
+    size_t dense_index = slots_[slot].dense_index;
+    return VoiceKey::of(amplitudes_[dense_index], sample_times_[dense_index], priorities_[dense_index]);
+}
+
+bool FieldStore::victimBefore(uint32_t a, uint32_t b) const {
+    return preferVictim(victim_policy_, victimKey(a), victimKey(b));
+}
+
+void FieldStore::heapPlace(size_t position, uint32_t slot) {
+    victim_heap_[position] = slot;
+    heap_positions_[slot] = static_cast<uint32_t>(position);
+}
+
+void FieldStore::heapSiftUp(size_t position) {
+    uint32_t slot = victim_heap_[position];
+    while (position > 0) {
+        size_t parent = (position - 1) / 2;
+        if (!victimBefore(slot, victim_heap_[parent])) break;
+        heapPlace(position, victim_heap_[parent]);
+        position = parent;
+    }
+    heapPlace(position, slot);
+}
+
+void FieldStore::heapSiftDown(size_t position) {
+    const size_t count = victim_heap_.size();
+    uint32_t slot = victim_heap_[position];
+    for (;;) {
+        size_t child = 2 * position + 1;
+        if (child >= count) break;
+        if (child + 1 < count && victimBefore(victim_heap_[child + 1], victim_heap_[child])) ++child;
+        if (!victimBefore(victim_heap_[child], slot)) break;
+        heapPlace(position, victim_heap_[child]);
+        position = child;
+    }
+    heapPlace(position, slot);
+}
+
+void FieldStore::heapPush(uint32_t slot) {
+    victim_heap_.push_back(slot);
+    heapSiftUp(victim_heap_.size() - 1);
+}
+
+void FieldStore::heapErase(uint32_t slot) {
+    size_t position = heap_positions_[slot];
+    heap_positions_[slot] = UINT32_MAX;
+    uint32_t last = victim_heap_.back();
+    victim_heap_.pop_back();
+    if (last == slot) return;
+
+    heapPlace(position, last);
+    heapFix(last);
+}
+
+void FieldStore::heapFix(uint32_t slot) {
+    size_t position = heap_positions_[slot];
+    heapSiftUp(position);
+    heapSiftDown(heap_positions_[slot]);
+}
+
+void FieldStore::rebuildVictimHeap() {
+    victim_heap_.assign(dense_to_slot_.begin(), dense_to_slot_.end());
+    for (size_t i = 0; i < victim_heap_.size(); ++i) {
+        heap_positions_[victim_heap_[i]] = static_cast<uint32_t>(i);
+    }
+    for (size_t i = victim_heap_.size() / 2; i-- > 0;) {
+        heapSiftDown(i);
+    }
+}
+
+void FieldStore::indexClear() {
+    for (IndexEntry& entry : index_table_) {
+        entry.slot = UINT32_MAX;
+        entry.fixed_slot = UINT32_MAX;
+    }
+    for (uint32_t slot_index : dense_to_slot_) {
+        slots_[slot_index].cell_prev = UINT32_MAX;
+        slots_[slot_index].cell_next = UINT32_MAX;
+    }
+    index_size_ = 0;
+}
+
+void FieldStore::indexReserve(size_t count) {
+    size_t table_size = 16;
+    while (table_size < count * 2) {
+        table_size <<= 1;
+    }
+    if (table_size <= index_table_.size()) return;
+
+    std::vector<IndexEntry> old_table;
+    old_table.swap(index_table_);
+    index_table_.assign(table_size, IndexEntry{SpatialKey{0, 0, 0, 0}, UINT32_MAX, UINT32_MAX});
+    index_size_ = 0;
+    for (const IndexEntry& entry : old_table) {
+        if (!entry.vacant()) {
+            indexPlace(entry);
+        }
+    }
+}
+
+} // namespace AnantaDigital
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "anantadigital_types.hpp"
+#include "voice_pool.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Дескриптор поля в хранилище: индекс слота и поколение.
+// После удаления поля слот переиспользуется с новым поколением,
+// поэтому старые дескрипторы становятся недействительными.
+struct FieldHandle {
+    uint32_t index;
+    uint32_t generation;
+
+    static FieldHandle invalid() { return FieldHandle{UINT32_MAX, 0}; }
+    bool isValid() const { return index != UINT32_MAX; }
+
+    bool operator==(const FieldHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const FieldHandle& other) const { return !(*this == other); }
+};
+
+// Плотное хранилище звуковых полей в виде структуры массивов (SoA).
+// Вставка, обновление и удаление — O(1); горячие параметры лежат
+// в непрерывных массивах для цикла синтеза. После setCapacity() хранилище
+// работает как пул фиксированного размера: память не выделяется, а при
+// заполнении поле вытесняется по VoiceStealPolicy. Кандидат на вытеснение
+// берется из кучи, поэтому вставка в полный пул стоит O(log n).
+class FieldStore {
+private:
+    // Квантованный пространственный ключ
+    struct SpatialKey {
+        int64_t a, b, c, d;
+        bool operator==(const SpatialKey& other) const {
+            return a == other.a && b == other.b && c == other.c && d == other.d;
+        }
+    };
+
+    static size_t hashKey(const SpatialKey& key);
+
+    // Запись пространственного индекса (открытая адресация, линейное пробирование).
+    // Поля одной ячейки связаны в два списка через слоты: сливаемые
+    // (insertOrMerge) и несливаемые (insert); запись хранит их головы.
+    struct IndexEntry {
+        SpatialKey key;
+        uint32_t slot;          // голова списка сливаемых полей
+        uint32_t fixed_slot;    // голова списка несливаемых полей
+
+        // Оба списка пусты — ячейка таблицы свободна
+        bool vacant() const { return slot == UINT32_MAX && fixed_slot == UINT32_MAX; }
+    };
+
+    struct Slot {
+        uint32_t dense_index;
+        uint32_t generation;
+        uint32_t cell_prev;     // соседи в списке ячейки индекса
+        uint32_t cell_next;
+        bool occupied;
+        bool mergeable;
+    };
+
+    // Горячие массивы (плотные, индекс 0..size-1)
+    std::vector<double> frequencies_;
+    std::vector<std::complex<double>> amplitudes_;
+    std::vector<double> phases_;
+    std::vector<QuantumSoundState> states_;
+    std::vector<SphericalCoord> positions_;
+
+    // Холодные массивы
+    std::vector<SampleTime> sample_times_;
+    std::vector<WaveformDescriptor> waveforms_;
+    std::vector<uint8_t> priorities_;
+
+    // Связь плотных индексов со слотами
+    std::vector<uint32_t> dense_to_slot_;
+    std::vector<SpatialKey> dense_keys_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+
+    // Пространственный индекс: ключ -> слот. Таблица заполнена не более чем
+    // наполовину и выделяется заранее в reserve()
+    std::vector<IndexEntry> index_table_;
+    size_t index_size_;
+    double merge_resolution_;
+
+    // Пул фиксированного размера
+    size_t capacity_;
+    VoiceStealPolicy steal_policy_;
+
+    // Куча кандидатов на вытеснение по victim_policy_ (слоты; вершина —
+    // первая жертва). Ведется, пока задана емкость
+    VoiceStealPolicy victim_policy_;
+    std::vector<uint32_t> victim_heap_;
+    std::vector<uint32_t> heap_positions_;     // слот -> позиция в куче
+    size_t peak_size_;
+    uint64_t rejected_count_;
+    uint64_t stolen_count_;
+
+public:
+    FieldStore();
+
+    // Предварительное выделение памяти
+    void reserve(size_t capacity);
+
+    // Ограничить хранилище capacity полями (0 — без ограничения) и выделить
+    // под них память. Если полей уже больше, лишние вытесняются по policy.
+    void setCapacity(size_t capacity, VoiceStealPolicy policy);
+    size_t getCapacity() const { return capacity_; }
+    VoiceStealPolicy getStealPolicy() const { return steal_policy_; }
+    bool full() const { return capacity_ > 0 && size() >= capacity_; }
+    PoolStatistics getStatistics() const;
+    void resetStatistics();
+
+    // Шаг квантования позиции в метрах. 0 — поля совпадают только при
+    // точном равенстве координат (поведение прежнего std::map).
+    // При изменении шага индекс перестраивается, совпавшие сливаемые поля сливаются.
+    void setMergeResolution(double resolution);
+    double getMergeResolution() const { return merge_resolution_; }
+
+    // Добавить поле без слияния. Такое поле не становится целью слияния
+    // для insertOrMerge. В заполненном пуле вытесняется поле,
+    // выбранное политикой; если новое поле само худший кандидат
+    // (или политика REJECT), возвращается недействительный дескриптор.
+    FieldHandle insert(const QuantumSoundField& field);
+
+    // Добавить поле или заменить сливаемое поле в той же (квантованной) позиции
+    FieldHandle insertOrMerge(const QuantumSoundField& field);
+
+    // Найти поле по позиции (сливаемое, если в ячейке есть и такие, и другие)
+    FieldHandle find(const SphericalCoord& position) const;
+
+    bool update(FieldHandle handle, const QuantumSoundField& field);
+    bool setAmplitude(FieldHandle handle, const std::complex<double>& amplitude);
+    bool setFrequency(FieldHandle handle, double frequency);
+
+    // Удаление переставляет последнее поле на место удаленного
+    bool remove(FieldHandle handle);
+    void clear();
+
+    bool contains(FieldHandle handle) const;
+    size_t size() const { return frequencies_.size(); }
+    bool empty() const { return frequencies_.empty(); }
+
+    // Доступ по плотному индексу (порядок меняется при удалении)
+    QuantumSoundField fieldAt(size_t dense_index) const;
+    FieldHandle handleAt(size_t dense_index) const;
+    size_t denseIndex(FieldHandle handle) const;
+    QuantumSoundField get(FieldHandle handle) const;
+
+    // Непрерывные массивы для цикла синтеза
+    const double* frequencies() const { return frequencies_.data(); }
+    const std::complex<double>* amplitudes() const { return amplitudes_.data(); }
+    const double* phases() const { return phases_.data(); }
+    const QuantumSoundState* states() const { return states_.data(); }
+    const SphericalCoord* positions() const { return positions_.data(); }
+    const SampleTime* sampleTimes() const { return sample_times_.data(); }
+    const WaveformDescriptor* waveforms() const { return waveforms_.data(); }
+    const uint8_t* priorities() const { return priorities_.data(); }
+
+    // Плотный индекс поля, которое политика вытеснит первым (SIZE_MAX, если пусто).
+    // Для политики пула — O(1) по куче, для остальных — перебор.
+    size_t selectVictim(VoiceStealPolicy policy) const;
+
+private:
+    FieldHandle insertSlot(const QuantumSoundField& field, bool mergeable);
+    SpatialKey makeKey(const SphericalCoord& position) const;
+    void writeDense(size_t dense_index, const QuantumSoundField& field);
+    void rebuildSpatialIndex();
+
+    size_t indexLookup(const SpatialKey& key) const;
+    uint32_t indexFind(const SpatialKey& key) const;
+    void indexInsert(const SpatialKey& key, uint32_t slot);
+    void indexPlace(const IndexEntry& entry);
+    void indexErase(const SpatialKey& key, uint32_t slot);
+    void indexClear();
+    void indexReserve(size_t count);
+
+    bool victimHeapActive() const { return capacity_ > 0; }
+    VoiceKey victimKey(uint32_t slot) const;
+    bool victimBefore(uint32_t a, uint32_t b) const;
+    void heapPush(uint32_t slot);
+    void heapErase(uint32_t slot);
+    void heapFix(uint32_t slot);
+    void heapSiftUp(size_t position);
+    void heapSiftDown(size_t position);
+    void heapPlace(size_t position, uint32_t slot);
+    void rebuildVictimHeap();
+};
+
+} // namespace AnantaDigital
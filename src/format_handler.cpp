@@ -106,6 +106,13 @@ bool FormatHandler::loadZELIM(const std::string& filename, VisualData& visualDat
     visualData.quantumData.geometryType = static_cast<QuantumGeometryType>(header.geometryType);
     visualData.quantumData.quantumStates = header.quantumStates;
     
+    // Формат пикселей есть только в версиях от 2
+    uint32_t pixelFormat = static_cast<uint32_t>(PixelFormat::UNSPECIFIED);
+    if (header.version >= kZELIMPixelFormatVersion) {
+        file.read(reinterpret_cast<char*>(&pixelFormat), sizeof(pixelFormat));
+    }
+    visualData.pixelFormat = static_cast<PixelFormat>(pixelFormat);
+    
     // Чтение визуальных данных
     visualData.data.resize(header.dataSize);
     file.read(reinterpret_cast<char*>(visualData.data.data()), header.dataSize);
@@ -121,7 +128,7 @@ bool FormatHandler::saveZELIM(const std::string& filename, const VisualData& vis
     
     ZELIMHeader header;
     memcpy(header.magic, "ZELIM", 5);
-    header.version = 1;
+    header.version = kZELIMPixelFormatVersion;
     header.width = visualData.width;
     header.height = visualData.height;
     header.depth = visualData.depth;
@@ -134,7 +141,9 @@ bool FormatHandler::saveZELIM(const std::string& filename, const VisualData& vis
     header.geometryType = static_cast<uint32_t>(visualData.quantumData.geometryType);
     header.quantumStates = visualData.quantumData.quantumStates;
     
+    const uint32_t pixelFormat = static_cast<uint32_t>(visualData.pixelFormat);
     file.write(reinterpret_cast<const char*>(&header), sizeof(ZELIMHeader));
+    file.write(reinterpret_cast<const char*>(&pixelFormat), sizeof(pixelFormat));
     file.write(reinterpret_cast<const char*>(visualData.data.data()), visualData.data.size());
     
     return true;
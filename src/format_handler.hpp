@@ -18,7 +18,15 @@ enum class QuantumGeometryType {
     QUANTUM_LATTICE = 5
 };
 
-// Структура для хранения визуальных данных
+// Раскладка пикселей VisualData::data
+enum class PixelFormat {
+    UNSPECIFIED = 0,    // раскладку знает только источник данных
+    RGBA8 = 1           // 4 байта на пиксель в порядке R, G, B, A
+};
+
+// Структура для хранения визуальных данных.
+// data — кадры подряд (frameCount), кадр — строки сверху вниз по width
+// пикселей в формате pixelFormat (для ZELIM сохраняется в заголовке).
 struct VisualData {
     std::vector<uint8_t> data;
     uint32_t width;
@@ -26,6 +34,7 @@ struct VisualData {
     uint32_t depth;
     uint32_t frameCount;
     float fps;
+    PixelFormat pixelFormat;
     
     // Квантовые данные для ZELIM формата
     struct QuantumData {
@@ -42,7 +51,8 @@ struct VisualData {
         std::vector<uint8_t> data;
     } zDepthData;
     
-    VisualData() : width(1920), height(1080), depth(0), frameCount(1), fps(30.0f) {
+    VisualData() : width(1920), height(1080), depth(0), frameCount(1), fps(30.0f),
+                   pixelFormat(PixelFormat::UNSPECIFIED) {
         quantumData.elementCount = 108;
         quantumData.geometryType = QuantumGeometryType::SPHERICAL;
         quantumData.quantumStates = 4;
@@ -70,6 +80,9 @@ struct ZELIMHeader {
     uint32_t quantumStates;   // Квантовые состояния
 };
 
+// Начиная с версии 2 за заголовком ZELIM следует формат пикселей (PixelFormat, uint32_t)
+constexpr uint32_t kZELIMPixelFormatVersion = 2;
+
 // BORANKO заголовок (2D графика с Z-глубиной)
 struct BORANKOHeader {
     char magic[7];          // "BORANKO"
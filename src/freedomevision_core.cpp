@@ -1,5 +1,9 @@
 #include "anantadigital_core.hpp"
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <chrono>
 
 namespace AnantaDigital {
 
@@ -16,13 +20,51 @@ AnantaDigitalCore::AnantaDigitalCore(double radius, double height)
     , quantum_feedback_system_(std::make_unique<Feedback::QuantumFeedbackSystem>(std::chrono::microseconds(50000), 0.7))
     , consciousness_hybrid_(nullptr)
     , consciousness_integration_(nullptr)
-    , dome_resonator_(std::make_unique<DomeAcousticResonator>(radius, height)) {
+    , dome_resonator_(std::make_unique<DomeAcousticResonator>(radius, height))
+    , peak_interference_fields_(0)
+    , rejected_interference_fields_(0)
+    , resonance_version_(0)
+    , input_analyzer_(2048, 512, WindowType::HANN)
+    , spectral_threshold_(0)
+    , spectral_active_(false)
+    , input_stream_rate_(0.0)
+    , output_stream_rate_(0.0)
+    , resampler_quality_(ResamplerQuality::STANDARD)
+    , random_seed_(PhiloxRandom::kDefaultSeed)
+    , next_field_stream_(kFieldRandomStreamBase)
+    , sample_rate_(44100.0)
+    , max_block_frames_(0)
+    , rt_prepared_(false)
+    , sample_clock_(0)
+    , snapshot_version_(0)
+    , snapshot_dirty_(true)
+    , speaker_mode_(SpeakerRenderMode::DIRECT)
+    , rt_snapshot_version_(0)
+    , rt_voice_count_(0)
+    , smoothing_seconds_(0.005)
+    , smoothing_shape_(RampShape::LINEAR)
+    , processing_threads_(1)
+    , graph_input_(nullptr)
+    , graph_frame_ready_{false, false}
+    , graph_mix_ready_{false, false} {
+    configureResamplersLocked();
+    buildProcessingGraphLocked();
 }
 
 AnantaDigitalCore::~AnantaDigitalCore() = default;
 
 bool AnantaDigitalCore::initialize() {
     if (is_initialized_) return true;
+    return initialize(PoolLimits{});
+}
+
+bool AnantaDigitalCore::initialize(const PoolLimits& limits) {
+    // Пулы полей, источников и интерференционных объектов выделяются сразу
+    {
+        std::lock_guard<std::mutex> lock(core_mutex_);
+        applyPoolLimitsLocked(limits);
+    }
+    if (is_initialized_) return true;
     
     // Initialize quantum feedback system
     if (quantum_feedback_system_) {
@@ -35,6 +77,7 @@ bool AnantaDigitalCore::initialize() {
     consciousness_integration_ = std::make_unique<Integration::ConsciousnessIntegration>();
     
     if (consciousness_hybrid_) {
+        consciousness_hybrid_->setRandomSeed(random_seed_, kConsciousnessRandomStream);
         consciousness_hybrid_->initialize();
     }
     
@@ -81,17 +124,47 @@ bool AnantaDigitalCore::isInitialized() const {
 }
 
 std::vector<double> AnantaDigitalCore::getProcessedSignal() const {
-    return output_buffer_;
+    OutputBlockView view = output_blocks_.acquire();
+    return std::vector<double>(view.begin(), view.end());
+}
+
+AnantaDigitalCore::OutputBlockView AnantaDigitalCore::acquireProcessedSignal() const {
+    return output_blocks_.acquire();
 }
 
 std::string AnantaDigitalCore::getVersion() const {
     return "2.1.0";
 }
 
+void AnantaDigitalCore::setRandomSeed(uint64_t seed) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    random_seed_ = seed;
+    
+    if (quantum_feedback_system_) {
+        quantum_feedback_system_->setRandomSeed(seed, kFeedbackRandomStream);
+    }
+    next_field_stream_ = kFieldRandomStreamBase;
+    for (auto& field : interference_fields_) {
+        if (field) field->setRandomSeed(seed, next_field_stream_);
+        ++next_field_stream_;
+    }
+}
+
 void AnantaDigitalCore::addInterferenceField(std::unique_ptr<InterferenceField> field) {
     std::lock_guard<std::mutex> lock(core_mutex_);
     if (field) {
+        if (pool_limits_.max_interference_fields > 0 &&
+            interference_fields_.size() >= pool_limits_.max_interference_fields) {
+            ++rejected_interference_fields_;
+            return;
+        }
+        field->setRandomSeed(random_seed_, next_field_stream_++);
+        field->setSourceCapacity(pool_limits_.max_sources_per_interference, pool_limits_.steal_policy);
+        field->setCullingThreshold(sourceCullingThresholdLocked());
         interference_fields_.push_back(std::move(field));
+        peak_interference_fields_ = std::max(peak_interference_fields_, interference_fields_.size());
+        snapshot_dirty_ = true;
+        publishSnapshotLocked();
     }
 }
 
@@ -99,6 +172,8 @@ void AnantaDigitalCore::removeInterferenceField(size_t field_index) {
     std::lock_guard<std::mutex> lock(core_mutex_);
     if (field_index < interference_fields_.size()) {
         interference_fields_.erase(interference_fields_.begin() + field_index);
+        snapshot_dirty_ = true;
+        publishSnapshotLocked();
     }
 }
 
@@ -111,38 +186,119 @@ QuantumSoundField AnantaDigitalCore::createQuantumSoundField(double frequency,
     field.phase = 0.0;
     field.quantum_state = state;
     field.position = position;
-    field.timestamp = std::chrono::high_resolution_clock::now();
+    field.sample_time = getSampleClock();
     
-    // Создаем простую волновую функцию
-    field.wave_function = [frequency](double r, double theta, double phi, double t) -> std::complex<double> {
-        double phase = 2.0 * M_PI * frequency * t - 2.0 * M_PI * r / 343.0;
-        return std::complex<double>(std::cos(phase), std::sin(phase));
-    };
+    // Простая волновая функция: плоская волна (evaluateWaveform)
+    field.waveform = WaveformDescriptor::planeWave(frequency);
     
     return field;
 }
 
-void AnantaDigitalCore::processSoundField(const QuantumSoundField& input_field) {
+FieldHandle AnantaDigitalCore::processSoundField(const QuantumSoundField& input_field) {
     std::lock_guard<std::mutex> lock(core_mutex_);
-    
+    FieldHandle handle = storeSoundFieldLocked(input_field, true);
+    publishSnapshotLocked();
+    return handle;
+}
+
+FieldHandle AnantaDigitalCore::storeSoundFieldLocked(const QuantumSoundField& input_field, bool merge,
+                                                     FieldHandle replace) {
     // Обрабатываем звуковое поле через квантовую систему обратной связи
-    if (quantum_feedback_system_) {
-        auto processed_amplitude = quantum_feedback_system_->processQuantumSignal(input_field.amplitude);
-        
-        QuantumSoundField processed_field = input_field;
-        processed_field.amplitude = processed_amplitude;
-        
-        // Добавляем в карту звуковых полей
-        sound_fields_[input_field.position] = processed_field;
+    if (!quantum_feedback_system_) {
+        return FieldHandle::invalid();
+    }
+    
+    // Обратная связь идет по часам отсчетов: результат при одном seed не зависит
+    // от скорости машины
+    const auto stream_time = std::chrono::microseconds(
+        static_cast<int64_t>(static_cast<double>(getSampleClock()) * 1e6 / sample_rate_));
+    auto processed_amplitude = quantum_feedback_system_->processQuantumSignal(input_field.amplitude, stream_time);
+    
+    QuantumSoundField processed_field = input_field;
+    processed_field.amplitude = processed_amplitude;
+    
+    snapshot_dirty_ = true;
+    if (replace.isValid() && sound_fields_.update(replace, processed_field)) {
+        return replace;
     }
+    
+    // Добавляем в хранилище; при merge поле в той же позиции заменяется
+    FieldHandle handle = merge ? sound_fields_.insertOrMerge(processed_field)
+                               : sound_fields_.insert(processed_field);
+    return handle;
+}
+
+bool AnantaDigitalCore::removeSoundField(FieldHandle handle) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    bool removed = sound_fields_.remove(handle);
+    if (removed) {
+        snapshot_dirty_ = true;
+        publishSnapshotLocked();
+    }
+    return removed;
+}
+
+void AnantaDigitalCore::setFieldMergeResolution(double resolution) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    sound_fields_.setMergeResolution(resolution);
+    snapshot_dirty_ = true;
+    publishSnapshotLocked();
+}
+
+size_t AnantaDigitalCore::getSoundFieldCount() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return sound_fields_.size();
+}
+
+size_t AnantaDigitalCore::getResonanceFieldCount() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return resonance_fields_.size();
+}
+
+uint64_t AnantaDigitalCore::getResonanceModelVersion() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return resonance_version_;
+}
+
+size_t AnantaDigitalCore::getInputFieldCount() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return input_fields_.size();
+}
+
+AnantaDigitalCore::PoolPressure AnantaDigitalCore::getPoolPressure() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    
+    PoolPressure pressure;
+    pressure.fields = sound_fields_.getStatistics();
+    
+    pressure.interference.capacity = pool_limits_.max_interference_fields;
+    pressure.interference.in_use = interference_fields_.size();
+    pressure.interference.peak_in_use = peak_interference_fields_;
+    pressure.interference.rejected = rejected_interference_fields_;
+    
+    for (const auto& field : interference_fields_) {
+        if (!field) continue;
+        PoolStatistics sources = field->getSourceStatistics();
+        pressure.sources.capacity += sources.capacity;
+        pressure.sources.in_use += sources.in_use;
+        pressure.sources.peak_in_use += sources.peak_in_use;
+        pressure.sources.rejected += sources.rejected;
+        pressure.sources.stolen += sources.stolen;
+    }
+    return pressure;
+}
+
+AnantaDigitalCore::FieldsView AnantaDigitalCore::viewOutputFields() const {
+    return FieldsView(core_mutex_, sound_fields_);
 }
 
 std::vector<QuantumSoundField> AnantaDigitalCore::getOutputFields() const {
     std::lock_guard<std::mutex> lock(core_mutex_);
     
     std::vector<QuantumSoundField> output_fields;
-    for (const auto& pair : sound_fields_) {
-        output_fields.push_back(pair.second);
+    output_fields.reserve(sound_fields_.size());
+    for (size_t i = 0; i < sound_fields_.size(); ++i) {
+        output_fields.push_back(sound_fields_.fieldAt(i));
     }
     
     return output_fields;
@@ -167,63 +323,913 @@ void AnantaDigitalCore::update(double dt) {
     if (dome_resonator_) {
         // Резонатор не требует постоянного обновления
     }
+    
+    publishSnapshotLocked();
 }
 
 void AnantaDigitalCore::processInterferenceField(const std::vector<double>& input_signal) {
     // Обрабатываем входной сигнал через интерференционные поля
     if (input_signal.empty()) return;
     
-    // Создаем квантовое звуковое поле из входного сигнала
-    double avg_frequency = 440.0; // Базовая частота
-    SphericalCoord center_pos = {dome_radius_/2, M_PI/2, 0.0, dome_height_/2};
+    // Преобразователь частоты и анализатор перестраиваются под core_mutex_
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    if (!analyzeInput(input_signal)) return;
+    storeInputPeaksLocked(input_analyzer_.getPeaks());
+    publishSnapshotLocked();
+}
+
+bool AnantaDigitalCore::analyzeInput(const std::vector<double>& input_signal) {
+    // Потоковый анализ STFT; поля обновляются только по завершенному кадру
+    analysis_buffer_.assign(input_signal.begin(), input_signal.end());
+    if (!input_resampler_.isPassthrough()) {
+        resample_buffer_.resize(input_resampler_.getMaxOutputFrames(analysis_buffer_.size()));
+        size_t frames = input_resampler_.process(analysis_buffer_.data(), analysis_buffer_.size(),
+                                                 resample_buffer_.data());
+        analysis_buffer_.assign(resample_buffer_.begin(), resample_buffer_.begin() + frames);
+    }
+    return analyzeSamplesLocked(analysis_buffer_.data(), analysis_buffer_.size());
+}
+
+bool AnantaDigitalCore::analyzeSamplesLocked(const float* samples, size_t count) {
+    input_analyzer_.setSampleRate(sample_rate_);
+    return input_analyzer_.process(samples, count) > 0;
+}
+
+bool AnantaDigitalCore::analyzeBlockInput() {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    if (rt_input_.capacity() == 0) return false;
     
-    QuantumSoundField input_field = createQuantumSoundField(avg_frequency, center_pos, QuantumSoundState::COHERENT);
+    // Отсчеты блоков уже на частоте обработки: преобразователь входа не нужен
+    analysis_buffer_.resize(rt_input_.capacity());
+    const size_t count = rt_input_.read(analysis_buffer_.data(), analysis_buffer_.size());
+    if (count == 0 || !analyzeSamplesLocked(analysis_buffer_.data(), count)) return false;
     
-    // Обрабатываем через систему
-    processSoundField(input_field);
+    storeInputPeaksLocked(input_analyzer_.getPeaks());
+    publishSnapshotLocked();
+    return true;
+}
+
+void AnantaDigitalCore::storeInputPeaksLocked(const std::vector<SpectralPeak>& peaks) {
+    const size_t slots = std::max<size_t>(1, input_analyzer_.getMaxPeaks());
+    
+    // Пик k занимает k-ю позицию на кольце в центре купола; поле в той же
+    // позиции обновляется на месте, поэтому фаза синтеза не прерывается
+    for (size_t k = 0; k < peaks.size(); ++k) {
+        double phi = 2.0 * M_PI * static_cast<double>(k) / static_cast<double>(slots);
+        SphericalCoord position = {dome_radius_/2, M_PI/2, phi, dome_height_/2};
+        
+        QuantumSoundField input_field = createQuantumSoundField(peaks[k].frequency, position, QuantumSoundState::COHERENT);
+        input_field.amplitude = std::complex<double>(peaks[k].amplitude, 0.0);
+        input_field.phase = peaks[k].phase;
+        
+        if (k < input_fields_.size()) {
+            input_fields_[k] = storeSoundFieldLocked(input_field, false, input_fields_[k]);
+        } else {
+            input_fields_.push_back(storeSoundFieldLocked(input_field, false));
+        }
+    }
+    
+    // Пики, пропавшие из спектра, удаляются
+    while (input_fields_.size() > peaks.size()) {
+        sound_fields_.remove(input_fields_.back());
+        input_fields_.pop_back();
+        snapshot_dirty_ = true;
+    }
 }
 
 void AnantaDigitalCore::processDomeResonance() {
     if (!dome_resonator_) return;
     
-    // Обрабатываем резонанс купола
-    auto eigen_frequencies = dome_resonator_->calculateEigenFrequencies();
+    // resonance_version_ пишется под core_mutex_, поэтому версию сверяет
+    // processDomeResonanceLocked уже под блокировкой
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    processDomeResonanceLocked();
+    publishSnapshotLocked();
+}
+
+void AnantaDigitalCore::processDomeResonanceLocked() {
+    if (!dome_resonator_) return;
+    
+    uint64_t version = dome_resonator_->getModelVersion();
+    if (version == resonance_version_) return;
+    
+    for (FieldHandle handle : resonance_fields_) {
+        sound_fields_.remove(handle);
+    }
+    resonance_fields_.clear();
     
-    // Создаем резонансные поля для каждой собственной частоты
-    for (double freq : eigen_frequencies) {
-        if (freq > 20.0 && freq < 20000.0) { // Только в слышимом диапазоне
-            SphericalCoord pos = {dome_radius_/2, M_PI/2, 0.0, dome_height_/2};
-            QuantumSoundField resonance_field = createQuantumSoundField(freq, pos, QuantumSoundState::COHERENT);
-            processSoundField(resonance_field);
+    const auto& modes = dome_resonator_->getResonanceModes();
+    
+    int total_degeneracy = 0;
+    for (const auto& mode : modes) {
+        total_degeneracy += mode.degeneracy;
+    }
+    
+    // Создаем резонансное поле для каждой моды в слышимом диапазоне.
+    // Моды разнесены по высоте оболочки купола, чтобы не сливаться друг с другом.
+    for (size_t k = 0; k < modes.size(); ++k) {
+        const ResonanceMode& mode = modes[k];
+        if (mode.frequency <= 20.0 || mode.frequency >= 20000.0) continue;
+        
+        double theta = (M_PI / 2.0) * static_cast<double>(k + 1) / static_cast<double>(modes.size() + 1);
+        SphericalCoord pos = {dome_radius_, theta, 0.0, 0.0};
+        QuantumSoundField resonance_field = createQuantumSoundField(mode.frequency, pos, QuantumSoundState::COHERENT);
+        
+        // Вклад моды пропорционален ее кратности и отражающей способности материала
+        double weight = static_cast<double>(mode.degeneracy) / std::max(1, total_degeneracy);
+        resonance_field.amplitude *= weight * (1.0 - std::min(1.0, std::max(0.0, mode.absorption)));
+        
+        FieldHandle handle = storeSoundFieldLocked(resonance_field, false);
+        if (handle.isValid()) {
+            resonance_fields_.push_back(handle);
         }
     }
+    
+    resonance_version_ = version;
+    snapshot_dirty_ = true;
 }
 
 void AnantaDigitalCore::generateOutput() {
-    // Генерируем выходной сигнал
-    auto output_fields = getOutputFields();
+    // Генерируем выходной сигнал: все поля смешиваются в один блок,
+    // фаза каждого поля продолжается с предыдущего вызова
+    render_buffer_.resize(kOutputBlockFrames);
+    generateOutput(render_buffer_.data(), kOutputBlockFrames);
     
-    // Конвертируем в буфер для вывода
-    output_buffer_.clear();
-    output_buffer_.reserve(output_fields.size() * 1024);
+    // Публикуем блок в свободный буфер; закрепленные читателями буферы не трогаются
+    double* block = output_blocks_.beginWrite(kOutputBlockFrames);
+    if (block) {
+        std::copy(render_buffer_.begin(), render_buffer_.end(), block);
+        output_blocks_.publish();
+    }
+}
+
+void AnantaDigitalCore::generateOutput(float* out, size_t frames) {
+    if (!out || frames == 0) return;
     
-    for (const auto& field : output_fields) {
-        // Генерируем синусоидальный сигнал
-        for (int i = 0; i < 1024; ++i) {
-            double t = static_cast<double>(i) / 44100.0; // 44.1 kHz
-            double sample = std::real(field.amplitude) * std::sin(2.0 * M_PI * field.frequency * t + field.phase);
-            output_buffer_.push_back(sample);
+    // Синтез тоже под core_mutex_: setStreamSampleRates() перестраивает
+    // преобразователь выхода, а граф обработки рендерит тот же банк
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    output_bank_.setSampleRate(sample_rate_);
+    syncOscillatorBank();
+    renderOutputBank(out, frames);
+}
+
+void AnantaDigitalCore::advanceOutput(size_t frames) {
+    if (frames == 0) return;
+    
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    output_bank_.setSampleRate(sample_rate_);
+    syncOscillatorBank();
+    
+    // Преобразователь выхода хранит историю отсчетов, ее без синтеза не продвинуть
+    if (!output_resampler_.isPassthrough()) {
+        render_buffer_.resize(kOutputBlockFrames);
+        for (size_t offset = 0; offset < frames; offset += kOutputBlockFrames) {
+            renderOutputBank(render_buffer_.data(), std::min(kOutputBlockFrames, frames - offset));
+        }
+        return;
+    }
+    
+    // Перекрытие пути БПФ без синтеза устаревает; render() заполнит его заново.
+    // Время синтеза не измеряется, поэтому предел голосов не меняется
+    if (output_spectral_.isPrimed()) output_spectral_.reset();
+    output_bank_.advance(frames);
+    sample_clock_.fetch_add(frames, std::memory_order_relaxed);
+}
+
+void AnantaDigitalCore::renderOutputBank(float* out, size_t frames) {
+    const auto start = std::chrono::steady_clock::now();
+    size_t rendered = frames;
+    
+    // Путь БПФ продолжает фазы банка; при возврате к осцилляторам перекрытие забывается,
+    // при следующем включении render() заполнит его заново
+    const bool spectral = spectral_active_.load(std::memory_order_relaxed);
+    if (!spectral && output_spectral_.isPrimed()) output_spectral_.reset();
+    auto renderBank = [&](float* destination, size_t count) {
+        if (spectral) {
+            output_spectral_.render(output_bank_, destination, count);
+        } else {
+            output_bank_.render(destination, count);
         }
+    };
+    
+    if (output_resampler_.isPassthrough()) {
+        renderBank(out, frames);
+    } else {
+        // Поля синтезируются на частоте обработки и приводятся к частоте выхода;
+        // часы отсчетов идут в отсчетах частоты обработки
+        rendered = 0;
+        output_resampler_.pull(out, frames, [&](float* destination, size_t count) {
+            renderBank(destination, count);
+            rendered += count;
+        });
     }
+    sample_clock_.fetch_add(rendered, std::memory_order_relaxed);
+    
+    // Предел голосов следующего блока по времени синтеза этого
+    const double render_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    output_budget_.update(output_voices_.cpu_budget, static_cast<double>(rendered) / sample_rate_,
+                          render_seconds, output_bank_.size(), output_voices_.field_ids.size());
+}
+
+void AnantaDigitalCore::setParameterSmoothing(double seconds, RampShape shape) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    smoothing_seconds_ = std::max(0.0, seconds);
+    smoothing_shape_ = shape;
+    snapshot_dirty_ = true;
+    publishSnapshotLocked();
+}
+
+void AnantaDigitalCore::setStreamSampleRates(double input_rate, double output_rate, ResamplerQuality quality) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    input_stream_rate_ = input_rate > 0.0 ? input_rate : 0.0;
+    output_stream_rate_ = output_rate > 0.0 ? output_rate : 0.0;
+    resampler_quality_ = quality;
+    configureResamplersLocked();
+}
+
+double AnantaDigitalCore::getInputSampleRate() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return input_resampler_.getInputRate();
+}
+
+double AnantaDigitalCore::getOutputSampleRate() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return output_resampler_.getOutputRate();
+}
+
+double AnantaDigitalCore::getInputLatency() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return input_resampler_.getLatencySeconds();
+}
+
+double AnantaDigitalCore::getOutputLatency() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return output_resampler_.getLatencySeconds();
+}
+
+void AnantaDigitalCore::configureResamplersLocked() {
+    const double input_rate = input_stream_rate_ > 0.0 ? input_stream_rate_ : sample_rate_;
+    const double output_rate = output_stream_rate_ > 0.0 ? output_stream_rate_ : sample_rate_;
+    input_resampler_.configure(input_rate, sample_rate_, resampler_quality_);
+    input_resampler_.prepare(kOutputBlockFrames);
+    output_resampler_.configure(sample_rate_, output_rate, resampler_quality_);
+    output_resampler_.prepare(kOutputBlockFrames);
 }
 
 void AnantaDigitalCore::processAudioSignal(const std::vector<double>& input_signal) {
     if (input_signal.empty()) return;
     
-    // Обрабатываем аудио сигнал
-    processInterferenceField(input_signal);
-    processDomeResonance();
-    generateOutput();
+    // Блок графа целиком под core_mutex_: узлы вызывают только *Locked-методы
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    graph_input_ = &input_signal;
+    processing_graph_.execute(processing_pool_.get());
+    graph_input_ = nullptr;
+}
+
+void AnantaDigitalCore::setProcessingThreads(size_t threads) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    threads = std::max<size_t>(1, threads);
+    if (threads == processing_threads_) return;
+    processing_threads_ = threads;
+    processing_pool_ = threads > 1 ? std::make_unique<WorkerPool>(threads) : nullptr;
+}
+
+void AnantaDigitalCore::setPipelinedProcessing(bool pipelined) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    processing_graph_.setPipelined(pipelined);
+    processing_graph_.compile();
+}
+
+void AnantaDigitalCore::buildProcessingGraphLocked() {
+    // Буферы конвейерных портов выделяются здесь, а не в блоке
+    for (size_t slot = 0; slot < 2; ++slot) {
+        graph_peaks_[slot].reserve(input_analyzer_.getMaxPeaks());
+        graph_mix_[slot].resize(kOutputBlockFrames);
+    }
+    
+    processing_graph_.clear();
+    processing_graph_.addNode({"analysis", {"input"}, {}, {"peaks"}, [this](const GraphContext& context) {
+        const size_t slot = context.writeSlot();
+        graph_frame_ready_[slot] = graph_input_ && analyzeInput(*graph_input_);
+        if (graph_frame_ready_[slot]) {
+            graph_peaks_[slot].assign(input_analyzer_.getPeaks().begin(), input_analyzer_.getPeaks().end());
+        }
+    }});
+    
+    processing_graph_.addNode({"feedback", {}, {"peaks"}, {"input_fields"}, [this](const GraphContext& context) {
+        const size_t slot = context.readSlot();
+        if (!graph_frame_ready_[slot]) return;
+        storeInputPeaksLocked(graph_peaks_[slot]);
+        graph_frame_ready_[slot] = false;
+    }});
+    
+    processing_graph_.addNode({"resonance", {"input_fields"}, {}, {"resonance_fields"},
+                               [this](const GraphContext&) { processDomeResonanceLocked(); }});
+    
+    processing_graph_.addNode({"mixing", {"resonance_fields"}, {}, {"mix"}, [this](const GraphContext& context) {
+        publishSnapshotLocked();
+        
+        const size_t slot = context.writeSlot();
+        output_bank_.setSampleRate(sample_rate_);
+        syncOscillatorBank();
+        renderOutputBank(graph_mix_[slot].data(), kOutputBlockFrames);
+        graph_mix_ready_[slot] = true;
+    }});
+    
+    // Публикуем блок в свободный буфер; закрепленные читателями буферы не трогаются
+    processing_graph_.addNode({"output", {}, {"mix"}, {"output"}, [this](const GraphContext& context) {
+        const size_t slot = context.readSlot();
+        if (!graph_mix_ready_[slot]) return;
+        double* block = output_blocks_.beginWrite(kOutputBlockFrames);
+        if (block) {
+            std::copy(graph_mix_[slot].begin(), graph_mix_[slot].end(), block);
+            output_blocks_.publish();
+        }
+        graph_mix_ready_[slot] = false;
+    }});
+    
+    processing_graph_.compile();
+}
+
+void AnantaDigitalCore::prepareBlockProcessing(double sample_rate, size_t max_block_frames) {
+    // Вызывать до запуска аудио-потока или после его остановки
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    
+    rt_prepared_.store(false, std::memory_order_release);
+    
+    sample_rate_ = sample_rate > 0.0 ? sample_rate : 44100.0;
+    max_block_frames_ = std::max<size_t>(1, max_block_frames);
+    configureResamplersLocked();
+    
+    // Все выделения памяти делаем здесь, а не в аудио-потоке
+    rt_bank_.clear();
+    rt_bank_.reserve(kMaxRealtimeFields);
+    rt_bank_.setSampleRate(sample_rate_);
+    rt_binding_.prepare(rt_bank_.capacity());
+    rt_budget_.reset();
+    rt_voice_count_.store(0, std::memory_order_relaxed);
+    rt_snapshot_version_ = 0;
+    rt_input_.reset(std::max(8 * max_block_frames_, 4 * kOutputBlockFrames));
+    
+    if (getSpeakerCount() > 0) {
+        prepareSpeakerRendererLocked();
+    }
+    
+    snapshot_dirty_ = true;
+    publishSnapshotLocked();
+    rt_prepared_.store(true, std::memory_order_release);
+}
+
+void AnantaDigitalCore::prepareSpeakerRendering(const std::vector<SphericalCoord>& speakers) {
+    // Вызывать до запуска аудио-потока или после его остановки
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    
+    const bool prepared = rt_prepared_.exchange(false, std::memory_order_acq_rel);
+    speaker_renderer_.setSpeakers(speakers);
+    speaker_mode_ = SpeakerRenderMode::DIRECT;
+    prepareSpeakerRendererLocked();
+    
+    // Новый снимок несет геометрию источников для новой расстановки
+    snapshot_dirty_ = true;
+    rt_snapshot_version_ = 0;
+    publishSnapshotLocked();
+    rt_prepared_.store(prepared, std::memory_order_release);
+}
+
+void AnantaDigitalCore::prepareAmbisonicRendering(const std::vector<SphericalCoord>& speakers, int order,
+                                                  AmbisonicDecoder decoder) {
+    // Вызывать до запуска аудио-потока или после его остановки
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    
+    const bool prepared = rt_prepared_.exchange(false, std::memory_order_acq_rel);
+    ambisonic_renderer_.setOrder(order);
+    ambisonic_renderer_.setSpeakers(speakers, decoder);
+    speaker_mode_ = SpeakerRenderMode::AMBISONIC;
+    prepareSpeakerRendererLocked();
+    
+    // Новый снимок несет коэффициенты кодирования для нового порядка и расстановки
+    snapshot_dirty_ = true;
+    rt_snapshot_version_ = 0;
+    publishSnapshotLocked();
+    rt_prepared_.store(prepared, std::memory_order_release);
+}
+
+void AnantaDigitalCore::prepareSpeakerRendererLocked() {
+    const size_t block = std::max<size_t>(1, max_block_frames_);
+    if (speaker_mode_ == SpeakerRenderMode::AMBISONIC) {
+        ambisonic_renderer_.prepare(block, kMaxRealtimeFields);
+    } else {
+        // Наибольшая задержка — от самого дальнего громкоговорителя через весь купол
+        double extent = 0.0;
+        for (const auto& speaker : speaker_renderer_.getSpeakers()) {
+            auto point = Kernels::toCartesian<double>(speaker);
+            extent = std::max(extent, std::sqrt(point.x * point.x + point.y * point.y + point.z * point.z));
+        }
+        double max_delay = (extent + dome_radius_ + dome_height_) / Kernels::kSpeedOfSound;
+        speaker_renderer_.prepare(sample_rate_, block, kMaxRealtimeFields, max_delay);
+    }
+    
+    rt_source_buffer_.assign(kSpeakerSourceGroup * block, 0.0f);
+    rt_source_ptrs_.resize(kSpeakerSourceGroup);
+    for (size_t j = 0; j < kSpeakerSourceGroup; ++j) {
+        rt_source_ptrs_[j] = rt_source_buffer_.data() + j * block;
+    }
+    rt_output_ptrs_.assign(getSpeakerCount(), nullptr);
+    
+    // Строка геометрии затухающего голоса — stride значений или каналы шины
+    const size_t row = std::max(speaker_renderer_.getStride(), ambisonic_renderer_.getChannelCount());
+    rt_fading_gains_.assign(kMaxRealtimeFields * row, 0.0f);
+    rt_fading_delays_.assign(kMaxRealtimeFields * row, 0.0f);
+    if (is_initialized_) reserveSnapshotsLocked();
+}
+
+InterferenceFieldType AnantaDigitalCore::interferenceTypeAtLocked(const SphericalCoord& position) const {
+    // Ближайшее по центру интерференционное поле, в радиус которого попадает позиция
+    InterferenceFieldType type = InterferenceFieldType::CONSTRUCTIVE;
+    double nearest = std::numeric_limits<double>::max();
+    const auto point = Kernels::toCartesian<double>(position);
+    for (const auto& field : interference_fields_) {
+        if (!field) continue;
+        double distance = Kernels::distance(point, Kernels::toCartesian<double>(field->getCenter()));
+        if (distance <= field->getRadius() && distance < nearest) {
+            nearest = distance;
+            type = field->getType();
+        }
+    }
+    return type;
+}
+
+void AnantaDigitalCore::setCulling(const CullingSettings& settings) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    culler_.setSettings(settings);
+    output_budget_.reset();
+    
+    for (auto& field : interference_fields_) {
+        if (field) field->setCullingThreshold(sourceCullingThresholdLocked());
+    }
+    snapshot_dirty_ = true;
+    publishSnapshotLocked();
+}
+
+double AnantaDigitalCore::sourceCullingThresholdLocked() const {
+    const CullingSettings& culling = culler_.getSettings();
+    return culling.enabled ? std::pow(10.0, culling.threshold_db / 20.0) : 0.0;
+}
+
+void AnantaDigitalCore::setSpectralSynthesisThreshold(size_t partials) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    spectral_threshold_ = partials;
+}
+
+size_t AnantaDigitalCore::getSpectralSynthesisThreshold() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return spectral_threshold_;
+}
+
+CullingSettings AnantaDigitalCore::getCulling() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return culler_.getSettings();
+}
+
+CullingStatistics AnantaDigitalCore::getCullingStatistics() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return culler_.getStatistics();
+}
+
+size_t AnantaDigitalCore::collectRetiredSnapshots() {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return snapshots_.collect();
+}
+
+void AnantaDigitalCore::publishSnapshotLocked() {
+    if (!snapshot_dirty_) return;
+    
+    // Снимок собирается в управляющем потоке в свободный снимок пула;
+    // массивы только меняют размер в пределах зарезервированной памяти
+    RenderSnapshot* snapshot = snapshots_.allocate();
+    snapshot->version = ++snapshot_version_;
+    
+    collectVoicesLocked(*snapshot);
+    const size_t count = snapshot->field_ids.size();
+    snapshot->ramp_frames = smoothing_seconds_ * sample_rate_;
+    snapshot->ramp_shape = smoothing_shape_;
+    
+    // Геометрия источников многоканального рендера считается здесь, а не в аудио-потоке
+    snapshot->speaker_stride = 0;
+    snapshot->speaker_gains.clear();
+    snapshot->speaker_delays.clear();
+    snapshot->hoa_channels = 0;
+    snapshot->hoa_gains.clear();
+    const size_t stride = speaker_renderer_.getStride();
+    if (speaker_mode_ == SpeakerRenderMode::AMBISONIC) {
+        const size_t channels = ambisonic_renderer_.getChannelCount();
+        snapshot->hoa_channels = channels;
+        snapshot->hoa_gains.resize(count * channels);
+        for (size_t i = 0; i < count; ++i) {
+            const SphericalCoord& position = snapshot->positions[i];
+            ambisonic_renderer_.computeSourceEncoding(position, 1.0, interferenceTypeAtLocked(position),
+                                                      snapshot->hoa_gains.data() + i * channels);
+        }
+    } else if (stride > 0) {
+        snapshot->speaker_stride = stride;
+        snapshot->speaker_gains.resize(count * stride);
+        snapshot->speaker_delays.resize(count * stride);
+        for (size_t i = 0; i < count; ++i) {
+            const SphericalCoord& position = snapshot->positions[i];
+            speaker_renderer_.computeSourceGeometry(position, 1.0, interferenceTypeAtLocked(position),
+                                                    snapshot->speaker_gains.data() + i * stride,
+                                                    snapshot->speaker_delays.data() + i * stride);
+        }
+    }
+    
+    snapshots_.publish(snapshot);
+    snapshot_dirty_ = false;
+}
+
+void AnantaDigitalCore::applyPoolLimitsLocked(const PoolLimits& limits) {
+    pool_limits_ = limits;
+    sound_fields_.setCapacity(limits.max_fields, limits.steal_policy);
+    interference_fields_.reserve(limits.max_interference_fields);
+    for (auto& field : interference_fields_) {
+        if (field) field->setSourceCapacity(limits.max_sources_per_interference, limits.steal_policy);
+    }
+    resonance_fields_.reserve(limits.max_fields);
+    input_fields_.reserve(input_analyzer_.getMaxPeaks());
+    reserveSnapshotsLocked();
+    snapshot_dirty_ = true;
+    publishSnapshotLocked();
+}
+
+void AnantaDigitalCore::reserveSnapshotsLocked() {
+    const size_t voices = pool_limits_.max_fields;
+    const size_t speaker_values = voices * speaker_renderer_.getStride();
+    const size_t hoa_values = voices * ambisonic_renderer_.getChannelCount();
+    auto reserve = [&](RenderSnapshot& snapshot) {
+        snapshot.field_ids.reserve(voices);
+        snapshot.frequencies.reserve(voices);
+        snapshot.amplitudes.reserve(voices);
+        snapshot.phases.reserve(voices);
+        snapshot.positions.reserve(voices);
+        snapshot.speaker_gains.reserve(speaker_values);
+        snapshot.speaker_delays.reserve(speaker_values);
+        snapshot.hoa_gains.reserve(hoa_values);
+    };
+    
+    snapshots_.preallocate(kSnapshotPool, reserve);
+    reserve(output_voices_);
+    
+    // Банк и привязка generateOutput() и узла mixing тоже не растут в обработке
+    output_bank_.reserve(voices);
+    output_binding_.prepare(std::max(voices, output_binding_.ids.size()));
+    culler_.reserve(voices);
+}
+
+void AnantaDigitalCore::collectVoicesLocked(RenderSnapshot& voices) {
+    const size_t count = sound_fields_.size();
+    culler_.reserve(count);
+    culler_.plan(sound_fields_.frequencies(), sound_fields_.amplitudes(), sound_fields_.positions(), count);
+    
+    const auto& planned = culler_.getVoices();
+    voices.field_ids.resize(planned.size());
+    voices.frequencies.resize(planned.size());
+    voices.amplitudes.resize(planned.size());
+    voices.phases.resize(planned.size());
+    voices.positions.resize(planned.size());
+    for (size_t i = 0; i < planned.size(); ++i) {
+        const AudibilityCuller::Voice& voice = planned[i];
+        FieldHandle handle = sound_fields_.handleAt(voice.field);
+        voices.field_ids[i] = (static_cast<uint64_t>(handle.generation) << 32) | handle.index;
+        voices.frequencies[i] = voice.frequency;
+        voices.amplitudes[i] = voice.amplitude;
+        voices.phases[i] = sound_fields_.phases()[voice.field];
+        voices.positions[i] = voice.position;
+    }
+    voices.cpu_budget = culler_.getSettings().cpu_budget;
+}
+
+void AnantaDigitalCore::VoiceBinding::prepare(size_t capacity) {
+    // Идентификаторы звучащих голосов сохраняются: рост привязки посреди потока
+    // не должен перезапускать голоса. Таблица фаз заполняется заново в bindVoices
+    ids.resize(capacity, 0);
+    previous.resize(capacity, UINT32_MAX);
+    
+    // Размер таблицы фаз — степень двойки не меньше удвоенной емкости банка
+    size_t lookup_size = 1;
+    while (lookup_size < capacity * 2) {
+        lookup_size <<= 1;
+    }
+    lookup_keys.assign(lookup_size, UINT64_MAX);
+    lookup_indices.assign(lookup_size, 0);
+    lookup_phases.assign(lookup_size, 0.0);
+    lookup_amplitudes.assign(lookup_size, 0.0f);
+    lookup_frequencies.assign(lookup_size, 0.0f);
+    lookup_ramps.assign(lookup_size, ParameterRamp::hold(0.0f));
+    lookup_claimed.assign(lookup_size, 0);
+}
+
+void AnantaDigitalCore::bindVoices(OscillatorBank& bank, VoiceBinding& binding, const RenderSnapshot& voices,
+                                   size_t count, double ramp_frames, RampShape shape) {
+    // Запоминаем состояние текущих осцилляторов по идентификатору поля
+    const size_t mask = binding.lookup_keys.size() - 1;
+    std::fill(binding.lookup_keys.begin(), binding.lookup_keys.end(), UINT64_MAX);
+    for (size_t i = 0; i < bank.size(); ++i) {
+        size_t slot = static_cast<size_t>(binding.ids[i] * 0x9E3779B97F4A7C15ull) & mask;
+        while (binding.lookup_keys[slot] != UINT64_MAX) {
+            slot = (slot + 1) & mask;
+        }
+        binding.lookup_keys[slot] = binding.ids[i];
+        binding.lookup_indices[slot] = static_cast<uint32_t>(i);
+        binding.lookup_phases[slot] = bank.getPhase(i);
+        binding.lookup_amplitudes[slot] = static_cast<float>(bank.getAmplitude(i));
+        binding.lookup_frequencies[slot] = static_cast<float>(bank.getFrequency(i));
+        binding.lookup_ramps[slot] = bank.getAmplitudeRamp(i);
+        binding.lookup_claimed[slot] = 0;
+    }
+    
+    // Новые поля начинают со своей фазы и нулевой амплитуды, существующие
+    // продолжают прежнюю фазу; амплитуда идет к значению голоса по рампе
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t id = voices.field_ids[i];
+        double phase = voices.phases[i];
+        double amplitude = ramp_frames >= 1.0 ? 0.0 : voices.amplitudes[i];
+        uint32_t previous = UINT32_MAX;
+        size_t slot = static_cast<size_t>(id * 0x9E3779B97F4A7C15ull) & mask;
+        while (binding.lookup_keys[slot] != UINT64_MAX) {
+            if (binding.lookup_keys[slot] == id) {
+                phase = binding.lookup_phases[slot];
+                amplitude = binding.lookup_amplitudes[slot];
+                previous = binding.lookup_indices[slot];
+                binding.lookup_claimed[slot] = 1;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+        
+        if (i < bank.size()) {
+            bank.setFrequency(i, voices.frequencies[i]);
+            if (binding.ids[i] != id) bank.setAmplitude(i, amplitude);
+            bank.setPhase(i, phase);
+        } else {
+            bank.addOscillator(voices.frequencies[i], amplitude, phase);
+        }
+        bank.setAmplitudeTarget(i, voices.amplitudes[i], ramp_frames, shape);
+        binding.ids[i] = id;
+        binding.previous[i] = previous;
+    }
+    
+    // Пропавшие голоса затухают вместо обрыва; начатое затухание продолжается
+    // со своей рампой, поэтому частые снимки не растягивают его
+    size_t fading = count;
+    const size_t limit = std::min(bank.capacity(), binding.ids.size());
+    for (size_t slot = 0; ramp_frames >= 1.0 && slot <= mask && fading < limit; ++slot) {
+        if (binding.lookup_keys[slot] == UINT64_MAX || binding.lookup_claimed[slot]) continue;
+        const ParameterRamp& ramp = binding.lookup_ramps[slot];
+        const bool fading_out = ramp.active() && ramp.target == 0.0f;
+        if (!fading_out && binding.lookup_amplitudes[slot] == 0.0f) continue;
+        
+        if (fading < bank.size()) {
+            bank.setFrequency(fading, binding.lookup_frequencies[slot]);
+            bank.setPhase(fading, binding.lookup_phases[slot]);
+        } else {
+            bank.addOscillator(binding.lookup_frequencies[slot], 0.0, binding.lookup_phases[slot]);
+        }
+        bank.setAmplitude(fading, binding.lookup_amplitudes[slot]);
+        if (fading_out) {
+            bank.setAmplitudeRamp(fading, ramp);
+        } else {
+            bank.setAmplitudeTarget(fading, 0.0, ramp_frames, shape);
+        }
+        binding.ids[fading] = binding.lookup_keys[slot];
+        binding.previous[fading] = binding.lookup_indices[slot];
+        ++fading;
+    }
+    
+    while (bank.size() > fading) {
+        bank.removeOscillator(bank.size() - 1);
+    }
+}
+
+template <typename MoveVoice>
+void AnantaDigitalCore::dropFadedVoices(OscillatorBank& bank, VoiceBinding& binding, size_t count, MoveVoice&& move) {
+    for (size_t i = bank.size(); i > count; --i) {
+        const size_t index = i - 1;
+        if (bank.getAmplitude(index) != 0.0 || bank.getAmplitudeRamp(index).active()) continue;
+        
+        // Удаление переставляет последний осциллятор на место удаленного
+        const size_t last = bank.size() - 1;
+        binding.ids[index] = binding.ids[last];
+        bank.removeOscillator(index);
+        if (last != index) move(last, index);
+    }
+}
+
+void AnantaDigitalCore::dropFadedRealtimeVoices() {
+    const size_t count = rt_voice_count_.load(std::memory_order_relaxed);
+    const bool ambisonic = speaker_mode_ == SpeakerRenderMode::AMBISONIC;
+    dropFadedVoices(rt_bank_, rt_binding_, count, [&](size_t from, size_t to) {
+        if (ambisonic) {
+            ambisonic_renderer_.moveSource(from, to);
+        } else {
+            speaker_renderer_.moveSource(from, to);
+        }
+    });
+    
+    if (ambisonic) {
+        ambisonic_renderer_.setSourceCount(std::min(ambisonic_renderer_.getSourceCount(), rt_bank_.size()));
+    } else {
+        speaker_renderer_.setSourceCount(std::min(speaker_renderer_.getSourceCount(), rt_bank_.size()));
+    }
+}
+
+void AnantaDigitalCore::applySnapshot(const RenderSnapshot& snapshot) {
+    // Голоса упорядочены по уровню: бюджет CPU отбрасывает самые тихие
+    const size_t count = std::min({snapshot.field_ids.size(), rt_bank_.capacity(), rt_budget_.getLimit()});
+    bindVoices(rt_bank_, rt_binding_, snapshot, count, snapshot.ramp_frames, snapshot.ramp_shape);
+    rt_voice_count_.store(count, std::memory_order_relaxed);
+    
+    // Геометрия источников громкоговорителей, если снимок построен для текущей расстановки.
+    // Затухающие голоса (индексы от count) не входят в снимок: их геометрия
+    // переносится с прежних индексов до того, как снимок перезапишет строки
+    const size_t voices = rt_bank_.size();
+    const size_t stride = speaker_renderer_.getStride();
+    if (speaker_mode_ == SpeakerRenderMode::AMBISONIC) {
+        const size_t channels = ambisonic_renderer_.getChannelCount();
+        const bool matches = snapshot.hoa_channels == channels && ambisonic_renderer_.getSpeakerCount() > 0 &&
+                             snapshot.hoa_gains.size() / channels >= count &&
+                             rt_fading_gains_.size() >= (voices - count) * channels;
+        if (matches) {
+            for (size_t i = count; i < voices; ++i) {
+                ambisonic_renderer_.getSourceEncoding(rt_binding_.previous[i],
+                                                      rt_fading_gains_.data() + (i - count) * channels);
+            }
+            for (size_t i = 0; i < count; ++i) {
+                ambisonic_renderer_.setSourceEncoding(i, snapshot.hoa_gains.data() + i * channels);
+            }
+            for (size_t i = count; i < voices; ++i) {
+                ambisonic_renderer_.setSourceEncoding(i, rt_fading_gains_.data() + (i - count) * channels);
+            }
+        }
+        ambisonic_renderer_.setSourceCount(matches ? voices : 0);
+    } else {
+        const bool matches = stride > 0 && snapshot.speaker_stride == stride &&
+                             snapshot.speaker_gains.size() / stride >= count &&
+                             rt_fading_gains_.size() >= (voices - count) * stride;
+        if (matches) {
+            for (size_t i = count; i < voices; ++i) {
+                speaker_renderer_.getSourceGeometry(rt_binding_.previous[i],
+                                                    rt_fading_gains_.data() + (i - count) * stride,
+                                                    rt_fading_delays_.data() + (i - count) * stride);
+            }
+            for (size_t i = 0; i < count; ++i) {
+                speaker_renderer_.setSourceGeometry(i, snapshot.speaker_gains.data() + i * stride,
+                                                    snapshot.speaker_delays.data() + i * stride);
+            }
+            for (size_t i = count; i < voices; ++i) {
+                speaker_renderer_.setSourceGeometry(i, rt_fading_gains_.data() + (i - count) * stride,
+                                                    rt_fading_delays_.data() + (i - count) * stride);
+            }
+        }
+        speaker_renderer_.setSourceCount(matches ? voices : 0);
+    }
+}
+
+void AnantaDigitalCore::syncOscillatorBank() {
+    collectVoicesLocked(output_voices_);
+    const size_t count = std::min(output_voices_.field_ids.size(), output_budget_.getLimit());
+    if (output_binding_.ids.size() < count) {
+        output_binding_.prepare(std::max(count, output_binding_.ids.size() * 2));
+    }
+    bindVoices(output_bank_, output_binding_, output_voices_, count, smoothing_seconds_ * output_bank_.getSampleRate(),
+               smoothing_shape_);
+    
+    // Гистерезис, чтобы число голосов у порога не переключало путь каждый блок
+    bool spectral = spectral_active_.load(std::memory_order_relaxed);
+    if (spectral_threshold_ == 0) {
+        spectral = false;
+    } else if (count >= spectral_threshold_) {
+        spectral = true;
+    } else if (count < spectral_threshold_ - spectral_threshold_ / 8) {
+        spectral = false;
+    }
+    spectral_active_.store(spectral, std::memory_order_relaxed);
+}
+
+void AnantaDigitalCore::updateVoiceBudget(size_t frames, double render_seconds) {
+    const RenderSnapshot* snapshot = snapshots_.current();
+    if (!snapshot) return;
+    
+    // Новый предел применяется к текущему снимку сразу, без ожидания следующего
+    if (rt_budget_.update(snapshot->cpu_budget, static_cast<double>(frames) / sample_rate_, render_seconds,
+                          rt_bank_.size(), std::min(snapshot->field_ids.size(), rt_bank_.capacity()))) {
+        applySnapshot(*snapshot);
+    }
+}
+
+void AnantaDigitalCore::processBlock(const float* in, float* out, size_t frames) {
+    if (!out || frames == 0) return;
+    
+    if (!rt_prepared_.load(std::memory_order_acquire)) {
+        std::memset(out, 0, frames * sizeof(float));
+        return;
+    }
+    
+    // Вход только копируется: анализ и поля входа — в управляющем потоке
+    if (in) rt_input_.write(in, frames);
+    
+    acquireSnapshot();
+    const auto start = std::chrono::steady_clock::now();
+    rt_bank_.render(out, frames);
+    dropFadedRealtimeVoices();
+    sample_clock_.fetch_add(frames, std::memory_order_relaxed);
+    updateVoiceBudget(frames, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+void AnantaDigitalCore::acquireSnapshot() {
+    // Последний опубликованный снимок забирается без блокировок
+    const RenderSnapshot* snapshot = snapshots_.acquire();
+    if (snapshot && snapshot->version != rt_snapshot_version_) {
+        applySnapshot(*snapshot);
+        rt_snapshot_version_ = snapshot->version;
+    }
+}
+
+template <typename RenderChunk>
+void AnantaDigitalCore::renderSpeakerBlock(size_t frames, RenderChunk&& render_chunk) {
+    acquireSnapshot();
+    const auto start = std::chrono::steady_clock::now();
+    
+    // Блок длиннее подготовленного обрабатывается частями
+    const bool ambisonic = speaker_mode_ == SpeakerRenderMode::AMBISONIC;
+    const size_t block = ambisonic ? ambisonic_renderer_.getMaxBlockFrames() : speaker_renderer_.getMaxBlockFrames();
+    const size_t sources = ambisonic ? ambisonic_renderer_.getSourceCount() : speaker_renderer_.getSourceCount();
+    for (size_t offset = 0; offset < frames; offset += block) {
+        const size_t chunk = std::min(block, frames - offset);
+        
+        // Голоса рендерятся группами в небольшой буфер и сразу уходят в рендер
+        if (ambisonic) ambisonic_renderer_.clearBus();
+        for (size_t first = 0; first < sources; first += kSpeakerSourceGroup) {
+            const size_t group = std::min(kSpeakerSourceGroup, sources - first);
+            rt_bank_.renderRange(rt_source_buffer_.data(), block, first, group, chunk);
+            if (ambisonic) {
+                ambisonic_renderer_.encodeSources(first, rt_source_ptrs_.data(), group, chunk);
+            } else {
+                speaker_renderer_.writeSources(first, rt_source_ptrs_.data(), group, chunk);
+            }
+        }
+        
+        // Голоса без геометрии не слышны, но продвигаются вместе с остальными
+        if (rt_bank_.size() > sources) {
+            rt_bank_.renderRange(nullptr, 0, sources, rt_bank_.size() - sources, chunk);
+        }
+        render_chunk(offset, chunk);
+    }
+    dropFadedRealtimeVoices();
+    sample_clock_.fetch_add(frames, std::memory_order_relaxed);
+    updateVoiceBudget(frames, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+void AnantaDigitalCore::processBlockMultichannel(const float* in, float* const* outputs, size_t frames) {
+    if (!outputs || frames == 0) return;
+    
+    const size_t channels = getSpeakerCount();
+    if (!rt_prepared_.load(std::memory_order_acquire) || channels == 0) {
+        for (size_t s = 0; s < channels; ++s) {
+            if (outputs[s]) std::memset(outputs[s], 0, frames * sizeof(float));
+        }
+        return;
+    }
+    
+    if (in) rt_input_.write(in, frames);
+    renderSpeakerBlock(frames, [&](size_t offset, size_t chunk) {
+        for (size_t s = 0; s < channels; ++s) {
+            rt_output_ptrs_[s] = outputs[s] ? outputs[s] + offset : nullptr;
+        }
+        if (speaker_mode_ == SpeakerRenderMode::AMBISONIC) {
+            ambisonic_renderer_.decode(chunk, rt_output_ptrs_.data());
+        } else {
+            speaker_renderer_.mixTo(chunk, rt_output_ptrs_.data());
+        }
+    });
+}
+
+void AnantaDigitalCore::processBlockInterleaved(const float* in, float* out, size_t frames) {
+    if (!out || frames == 0) return;
+    
+    const size_t channels = getSpeakerCount();
+    if (!rt_prepared_.load(std::memory_order_acquire) || channels == 0) {
+        std::memset(out, 0, frames * channels * sizeof(float));
+        return;
+    }
+    
+    if (in) rt_input_.write(in, frames);
+    renderSpeakerBlock(frames, [&](size_t offset, size_t chunk) {
+        if (speaker_mode_ == SpeakerRenderMode::AMBISONIC) {
+            ambisonic_renderer_.decodeInterleaved(chunk, out + offset * channels);
+        } else {
+            speaker_renderer_.mixToInterleaved(chunk, out + offset * channels);
+        }
+    });
 }
 
 AnantaDigitalCore::SystemStatistics AnantaDigitalCore::getStatistics() const {
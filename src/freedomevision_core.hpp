@@ -6,6 +6,19 @@
 #include "consciousness_integration.hpp"
 #include "interference_field.hpp"
 #include "dome_acoustic_resonator.hpp"
+#include "oscillator_bank.hpp"
+#include "field_store.hpp"
+#include "render_snapshot.hpp"
+#include "spectral_analyzer.hpp"
+#include "speaker_renderer.hpp"
+#include "ambisonic_renderer.hpp"
+#include "resampler.hpp"
+#include "output_view.hpp"
+#include "processing_graph.hpp"
+#include "audibility_culler.hpp"
+#include "spectral_synthesizer.hpp"
+#include "worker_pool.hpp"
+#include <atomic>
 
 // Forward declarations
 namespace AnantaDigital::Feedback {
@@ -19,14 +32,25 @@ namespace AnantaDigital {
     class InterferenceField;
     class DomeAcousticResonator;
 
+    // Способ многоканального рендера на громкоговорители купола
+    enum class SpeakerRenderMode {
+        DIRECT,     // SpeakerRenderer: задержка и затухание для каждой пары поле–громкоговоритель
+        AMBISONIC   // AmbisonicRenderer: шина сферических гармоник и матрица декодирования
+    };
+
     // Основной класс AnantaDigital
     class AnantaDigitalCore {
     private:
         std::vector<std::unique_ptr<InterferenceField>> interference_fields_;
         std::unique_ptr<DomeAcousticResonator> dome_resonator_;
-        std::map<SphericalCoord, QuantumSoundField> sound_fields_;
+        FieldStore sound_fields_;
         mutable std::mutex core_mutex_;
         
+        // Лимиты пулов (initialize()); пулы выделяются заранее и не растут
+        PoolLimits pool_limits_;
+        size_t peak_interference_fields_;
+        uint64_t rejected_interference_fields_;
+        
         // Параметры системы
         double dome_radius_;
         double dome_height_;
@@ -38,19 +62,170 @@ namespace AnantaDigital {
         std::unique_ptr<Consciousness::ConsciousnessHybrid> consciousness_hybrid_;
         std::unique_ptr<Integration::ConsciousnessIntegration> consciousness_integration_;
         
-        // Буферы обработки
+        // Буферы обработки. Готовые блоки выхода публикуются в output_blocks_,
+        // потребители читают их на месте без копирования.
         std::vector<double> processing_buffer_;
-        std::vector<double> output_buffer_;
+        PublishedBuffers<double> output_blocks_;
+        std::vector<float> render_buffer_;
+        
+        // Резонансные поля купола, построенные по версии resonance_version_ модели резонатора
+        std::vector<FieldHandle> resonance_fields_;
+        uint64_t resonance_version_;
+        
+        // Анализ входного сигнала: пики спектра становятся полями input_fields_
+        SpectralAnalyzer input_analyzer_;
+        std::vector<float> analysis_buffer_;
+        std::vector<FieldHandle> input_fields_;
+        
+        // Голоса синтеза (SoA) и их привязка к осцилляторам банка: при смене состава
+        // и порядка голосов фаза и амплитуда продолжаются по идентификатору поля.
+        // Голоса пропавших полей затухают после голосов снимка и затем удаляются.
+        struct VoiceBinding {
+            std::vector<uint64_t> ids;              // идентификатор поля каждого осциллятора
+            std::vector<uint32_t> previous;         // индекс осциллятора до bindVoices (UINT32_MAX — новый)
+            std::vector<uint64_t> lookup_keys;      // открытая адресация: id -> состояние осциллятора
+            std::vector<uint32_t> lookup_indices;
+            std::vector<double> lookup_phases;
+            std::vector<float> lookup_amplitudes;
+            std::vector<float> lookup_frequencies;
+            std::vector<ParameterRamp> lookup_ramps;
+            std::vector<uint8_t> lookup_claimed;    // голос есть в новом снимке
+            
+            // Емкость capacity голосов; идентификаторы первых голосов сохраняются
+            void prepare(size_t capacity);
+        };
+        
+        // Отбор слышимых полей и укрупнение дальних (под core_mutex_)
+        AudibilityCuller culler_;
+        
+        // Синтез полей для generateOutput(); фаза сохраняется между вызовами
+        static constexpr size_t kOutputBlockFrames = 1024;
+        OscillatorBank output_bank_;
+        VoiceBinding output_binding_;
+        RenderSnapshot output_voices_;      // голоса последнего отбора
+        VoiceBudget output_budget_;
+        
+        // Синтез output_bank_ обратным БПФ, когда голосов не меньше порога;
+        // обратно к осцилляторам — ниже 7/8 порога. 0 — только осцилляторы.
+        SpectralSynthesizer output_spectral_;
+        size_t spectral_threshold_;
+        std::atomic<bool> spectral_active_;
+        
+        // Частоты внешних потоков: вход processAudioSignal() приводится к sample_rate_,
+        // выход generateOutput() — от sample_rate_ к частоте устройства
+        PolyphaseResampler input_resampler_;
+        PolyphaseResampler output_resampler_;
+        double input_stream_rate_;      // 0 — совпадает с sample_rate_
+        double output_stream_rate_;
+        ResamplerQuality resampler_quality_;
+        std::vector<float> resample_buffer_;
+        
+        // Seed случайных обновлений; каждая подсистема получает свой поток Philox
+        static constexpr uint64_t kFeedbackRandomStream = 0;
+        static constexpr uint64_t kConsciousnessRandomStream = 1;
+        static constexpr uint64_t kFieldRandomStreamBase = 16;
+        uint64_t random_seed_;
+        uint64_t next_field_stream_;
+        
+        // Состояние блочной обработки в реальном времени.
+        // Все массивы выделяются в prepareBlockProcessing() и не растут в processBlock().
+        static constexpr size_t kMaxRealtimeFields = 4096;
+        double sample_rate_;
+        size_t max_block_frames_;
+        OscillatorBank rt_bank_;
+        std::atomic<bool> rt_prepared_;
+        
+        // Часы отсчетов: растут на длину каждого отрендеренного блока,
+        // задают sample_time новых полей
+        std::atomic<uint64_t> sample_clock_;
+        
+        // Снимки параметров для аудио-потока (RCU): управляющий поток публикует,
+        // аудио-поток забирает в начале блока без блокировок. Одновременно заняты
+        // не больше трех снимков (текущий, опубликованный, отработанный), четвертый
+        // заполняется; после initialize() снимки переиспользуются без выделений.
+        static constexpr size_t kSnapshotPool = 4;
+        SnapshotExchange<RenderSnapshot> snapshots_;
+        uint64_t snapshot_version_;     // под core_mutex_
+        bool snapshot_dirty_;           // под core_mutex_
+        
+        // Многоканальный рендер: каждый голос rt_bank_ — источник рендера громкоговорителей.
+        // Сигналы голосов берутся из rt_bank_ группами по kSpeakerSourceGroup и сразу
+        // пишутся в линии задержки SpeakerRenderer или прибавляются к шине Ambisonics
+        static constexpr size_t kSpeakerSourceGroup = 64;
+        SpeakerRenderer speaker_renderer_;
+        AmbisonicRenderer ambisonic_renderer_;
+        SpeakerRenderMode speaker_mode_;               // какой из рендеров активен
+        std::vector<float> rt_source_buffer_;          // kSpeakerSourceGroup × max_block_frames_
+        std::vector<float> rt_fading_gains_;           // геометрия затухающих голосов при смене снимка
+        std::vector<float> rt_fading_delays_;
+        std::vector<const float*> rt_source_ptrs_;
+        std::vector<float*> rt_output_ptrs_;
+        
+        // Вход processBlock*(): аудио-поток пишет, analyzeBlockInput() читает
+        SampleRing<float> rt_input_;
+        
+        // Состояние, принадлежащее только аудио-потоку
+        uint64_t rt_snapshot_version_;
+        VoiceBinding rt_binding_;
+        VoiceBudget rt_budget_;
+        std::atomic<size_t> rt_voice_count_;        // голосов в rt_bank_ (для наблюдения)
+        
+        // Сглаживание амплитуд полей при смене снимка (под core_mutex_)
+        double smoothing_seconds_;
+        RampShape smoothing_shape_;
+        
+        // Граф processAudioSignal() выполняется под core_mutex_. Порты "peaks" и "mix"
+        // конвейерные: их данные лежат в двух буферах, узлы выбирают буфер по блоку.
+        ProcessingGraph processing_graph_;
+        std::unique_ptr<WorkerPool> processing_pool_;
+        size_t processing_threads_;
+        const std::vector<double>* graph_input_;        // вход текущего блока
+        std::vector<SpectralPeak> graph_peaks_[2];
+        bool graph_frame_ready_[2];
+        std::vector<float> graph_mix_[2];
+        bool graph_mix_ready_[2];
 
     public:
+        // Закрепленный блок выхода generateOutput(); пока view жив, блок не переписывается
+        using OutputBlockView = PublishedBuffers<double>::View;
+        
+        // Согласованный вид на поля без копирования. Держит core_mutex_,
+        // поэтому его следует освобождать сразу после чтения.
+        class FieldsView {
+        private:
+            std::unique_lock<std::mutex> lock_;
+            const FieldStore* store_;
+            
+        public:
+            FieldsView(std::mutex& mutex, const FieldStore& store) : lock_(mutex), store_(&store) {}
+            
+            size_t size() const { return store_->size(); }
+            ConstSpan<double> frequencies() const { return ConstSpan<double>(store_->frequencies(), size()); }
+            ConstSpan<std::complex<double>> amplitudes() const { return ConstSpan<std::complex<double>>(store_->amplitudes(), size()); }
+            ConstSpan<double> phases() const { return ConstSpan<double>(store_->phases(), size()); }
+            ConstSpan<QuantumSoundState> states() const { return ConstSpan<QuantumSoundState>(store_->states(), size()); }
+            ConstSpan<SphericalCoord> positions() const { return ConstSpan<SphericalCoord>(store_->positions(), size()); }
+            ConstSpan<SampleTime> sampleTimes() const { return ConstSpan<SampleTime>(store_->sampleTimes(), size()); }
+            ConstSpan<WaveformDescriptor> waveforms() const { return ConstSpan<WaveformDescriptor>(store_->waveforms(), size()); }
+            FieldHandle handleAt(size_t index) const { return store_->handleAt(index); }
+        };
+        
         AnantaDigitalCore(double radius, double height);
         ~AnantaDigitalCore();
         
-        // Инициализация системы
+        // Инициализация системы. Повторный initialize(limits) применяет
+        // новые лимиты к уже выделенным пулам, initialize() оставляет прежние.
         bool initialize();
+        bool initialize(const PoolLimits& limits);
         void shutdown();
         bool isInitialized() const;
         
+        // Seed всех стохастических обновлений: при одинаковом seed и порядке
+        // вызовов результат воспроизводится бит в бит. Вызывать до initialize(),
+        // чтобы seed получила и гибридная система сознания.
+        void setRandomSeed(uint64_t seed);
+        uint64_t getRandomSeed() const { return random_seed_; }
+        
         // Управление интерференционными полями
         void addInterferenceField(std::unique_ptr<InterferenceField> field);
         void removeInterferenceField(size_t field_index);
@@ -60,26 +235,165 @@ namespace AnantaDigital {
                                                   const SphericalCoord& position,
                                                   QuantumSoundState state);
         
-        // Обработка звукового поля
-        void processSoundField(const QuantumSoundField& input_field);
+        // Обработка звукового поля. Поле в той же позиции заменяется,
+        // возвращается дескриптор поля в хранилище.
+        FieldHandle processSoundField(const QuantumSoundField& input_field);
         
-        // Получение результирующего звукового поля
+        // Удаление звукового поля по дескриптору
+        bool removeSoundField(FieldHandle handle);
+        
+        // Шаг (м), с которым близкие по позиции поля сливаются в одно; 0 — точное совпадение
+        void setFieldMergeResolution(double resolution);
+        size_t getSoundFieldCount() const;
+        size_t getResonanceFieldCount() const;
+        // Версия модели резонатора, по которой построены резонансные поля
+        uint64_t getResonanceModelVersion() const;
+        size_t getInputFieldCount() const;
+        
+        // Давление на пулы: поля ядра, источники всех интерференционных полей
+        // (суммарно) и сами интерференционные поля
+        struct PoolPressure {
+            PoolStatistics fields;
+            PoolStatistics sources;
+            PoolStatistics interference;
+        };
+        PoolPressure getPoolPressure() const;
+        const PoolLimits& getPoolLimits() const { return pool_limits_; }
+        
+        // Получение результирующего звукового поля (копия всех полей)
         std::vector<QuantumSoundField> getOutputFields() const;
         
-        // Получение обработанного сигнала
+        // Вид на поля без копирования и выделения памяти
+        FieldsView viewOutputFields() const;
+        
+        // Получение обработанного сигнала (копия последнего блока)
         std::vector<double> getProcessedSignal() const;
         
+        // Последний блок generateOutput() без копирования и выделения памяти;
+        // безопасно из любых потоков-потребителей (метры, визуализация, сеть)
+        OutputBlockView acquireProcessedSignal() const;
+        uint64_t getDroppedOutputBlocks() const { return output_blocks_.droppedCount(); }
+        
         // Обновление системы
         void update(double dt);
         
-        // Внутренние методы
+        // Внутренние методы. processInterferenceField анализирует вход STFT
+        // и заменяет поля входа пиками последнего кадра спектра.
         void processInterferenceField(const std::vector<double>& input_signal);
         void processDomeResonance();
         void generateOutput();
         
-        // Обработка аудио сигнала
+        // Рендер смеси всех полей прямо в буфер вызывающей стороны (frames отсчетов)
+        void generateOutput(float* out, size_t frames);
+        
+        // Продвигает голоса, фазы и часы отсчетов на frames отсчетов так же, как
+        // generateOutput(out, frames), но без синтеза (офлайн-рендер догоняет начало фрагмента)
+        void advanceOutput(size_t frames);
+        
+        // Обработка аудио сигнала: один блок графа обработки.
+        // Узлы: analysis (STFT входа) → feedback (пики через систему обратной связи
+        // в поля входа) → resonance (поля резонатора) → mixing (синтез блока) → output
+        // (публикация блока). Без конвейера узлы идут цепочкой; параллельно работают
+        // только analysis и output с конвейером (setPipelinedProcessing) — каждый
+        // над буфером другого блока. Интерференционные поля блок не продвигает,
+        // как и до графа: их продвигает только update(dt).
         void processAudioSignal(const std::vector<double>& input_signal);
         
+        // Потоки графа обработки, включая вызывающий (0 и 1 — только вызывающий)
+        void setProcessingThreads(size_t threads);
+        size_t getProcessingThreads() const { return processing_threads_; }
+        
+        // Конвейер: анализ и публикация выхода работают с данными предыдущего блока
+        // параллельно с остальными стадиями; задержка входа до выхода растет на два блока
+        void setPipelinedProcessing(bool pipelined);
+        bool isPipelinedProcessing() const { return processing_graph_.isPipelined(); }
+        
+        // Граф обработки (для просмотра узлов и порядка выполнения)
+        const ProcessingGraph& getProcessingGraph() const { return processing_graph_; }
+        
+        // Подготовка к блочной обработке (вызывать вне аудио-потока)
+        void prepareBlockProcessing(double sample_rate, size_t max_block_frames);
+        
+        // Блочная обработка для аудио-callback: без выделения памяти,
+        // без блокирующих захватов мьютекса и без ввода-вывода.
+        // Результат записывается в память вызывающей стороны (frames отсчетов).
+        // in — моно вход на частоте обработки (может быть nullptr); он только
+        // копируется для analyzeBlockInput() и в синтез блока не попадает.
+        void processBlock(const float* in, float* out, size_t frames);
+        
+        // Анализ входа processBlock*() вне аудио-потока: накопленные отсчеты проходят
+        // тот же STFT, что вход processAudioSignal(), пики становятся полями входа.
+        // Анализатор у двух путей общий, поэтому вход следует подавать одним из них.
+        // true — завершен хотя бы один кадр STFT.
+        bool analyzeBlockInput();
+        
+        // Отсчеты входа, отброшенные из-за того, что analyzeBlockInput() вызывался редко
+        uint64_t getDroppedInputFrames() const { return rt_input_.droppedCount(); }
+        
+        // Расстановка громкоговорителей купола для многоканального рендера
+        // (вне аудио-потока, после prepareBlockProcessing)
+        void prepareSpeakerRendering(const std::vector<SphericalCoord>& speakers);
+        
+        // То же через шину Ambisonics порядка order: источники кодируются в шину,
+        // шина декодируется на громкоговорители (без задержек распространения).
+        // Стоимость растет как (источники + громкоговорители) × (order + 1)².
+        void prepareAmbisonicRendering(const std::vector<SphericalCoord>& speakers, int order = 3,
+                                       AmbisonicDecoder decoder = AmbisonicDecoder::ALLRAD);
+        
+        SpeakerRenderMode getSpeakerRenderMode() const { return speaker_mode_; }
+        size_t getSpeakerCount() const {
+            return speaker_mode_ == SpeakerRenderMode::AMBISONIC ? ambisonic_renderer_.getSpeakerCount()
+                                                                 : speaker_renderer_.getSpeakerCount();
+        }
+        
+        // Многоканальная блочная обработка: в режиме DIRECT — задержка, затухание и вес
+        // интерференции для каждой пары поле–громкоговоритель, в режиме AMBISONIC —
+        // кодирование в шину и декодирование. outputs[s] — планарный буфер
+        // громкоговорителя s; чередующийся вариант пишет out[t·N + s].
+        void processBlockMultichannel(const float* in, float* const* outputs, size_t frames);
+        void processBlockInterleaved(const float* in, float* out, size_t frames);
+        
+        // Переход амплитуд полей к новым значениям: за seconds (для ONE_POLE —
+        // постоянная времени) внутри блока, без ступенек на границах блоков.
+        // 0 — мгновенно. Новые поля нарастают от нуля.
+        void setParameterSmoothing(double seconds, RampShape shape = RampShape::LINEAR);
+        double getSmoothingTime() const { return smoothing_seconds_; }
+        RampShape getSmoothingShape() const { return smoothing_shape_; }
+        
+        // Отбор слышимых полей перед синтезом: порог уровня у слушателя, маскировка
+        // в критических полосах, слияние дальних полей и бюджет CPU (см. AudibilityCuller).
+        // Порог действует и на источники интерференционных полей.
+        void setCulling(const CullingSettings& settings);
+        CullingSettings getCulling() const;
+        CullingStatistics getCullingStatistics() const;
+        
+        // Синтез generateOutput() обратным БПФ от partials голосов и больше
+        // (см. SpectralSynthesizer); переключение без разрыва фазы. 0 — выключено.
+        void setSpectralSynthesisThreshold(size_t partials);
+        size_t getSpectralSynthesisThreshold() const;
+        bool isSpectralSynthesisActive() const { return spectral_active_.load(std::memory_order_relaxed); }
+        
+        // Голосов в банке аудио-потока сейчас (после бюджета CPU)
+        size_t getRealtimeVoiceCount() const { return rt_voice_count_.load(std::memory_order_relaxed); }
+        
+        // Освободить снимки, отработанные аудио-потоком (вне аудио-потока)
+        size_t collectRetiredSnapshots();
+        
+        // Частоты потоков processAudioSignal() и generateOutput(), если они отличаются
+        // от частоты обработки getSampleRate() (вне аудио-потока)
+        void setStreamSampleRates(double input_rate, double output_rate,
+                                  ResamplerQuality quality = ResamplerQuality::STANDARD);
+        double getInputSampleRate() const;
+        double getOutputSampleRate() const;
+        
+        // Задержка преобразователей частоты, с
+        double getInputLatency() const;
+        double getOutputLatency() const;
+        
+        double getSampleRate() const { return sample_rate_; }
+        size_t getMaxBlockFrames() const { return max_block_frames_; }
+        SampleTime getSampleClock() const { return sample_clock_.load(std::memory_order_relaxed); }
+        
         // Получение версии
         std::string getVersion() const;
         
@@ -92,6 +406,89 @@ namespace AnantaDigital {
         };
         
         SystemStatistics getStatistics() const;
+        
+    private:
+        // Добавляет поле через систему обратной связи (core_mutex_ уже захвачен).
+        // Если replace действителен, поле обновляется на месте (дескриптор и фаза сохраняются).
+        FieldHandle storeSoundFieldLocked(const QuantumSoundField& input_field, bool merge,
+                                          FieldHandle replace = FieldHandle::invalid());
+        
+        // Публикует снимок параметров, если они изменились (под core_mutex_)
+        void publishSnapshotLocked();
+        
+        // Применяет лимиты пулов: лишние поля и источники вытесняются по
+        // политике, лишние интерференционные поля остаются, но новые
+        // отклоняются, пока их число не опустится ниже лимита (под core_mutex_)
+        void applyPoolLimitsLocked(const PoolLimits& limits);
+        
+        // Резервирует память свободных снимков и отбора под лимит полей
+        // и текущую расстановку громкоговорителей (под core_mutex_)
+        void reserveSnapshotsLocked();
+        
+        // Порог отбора для источников интерференционных полей (под core_mutex_)
+        double sourceCullingThresholdLocked() const;
+        
+        // Отбирает голоса из полей хранилища в voices (под core_mutex_)
+        void collectVoicesLocked(RenderSnapshot& voices);
+        
+        // Переносит первые count голосов в bank: фаза и амплитуда продолжаются
+        // по идентификатору поля, амплитуды идут к новым значениям по рампе.
+        // Голоса, которых нет среди count, затухают до нуля за ту же рампу
+        // в индексах от count (пока хватает емкости).
+        // Не выделяет память, если емкость банка и привязки достаточна.
+        static void bindVoices(OscillatorBank& bank, VoiceBinding& binding, const RenderSnapshot& voices,
+                               size_t count, double ramp_frames, RampShape shape);
+        
+        // Удаляет затухшие голоса после первых count (аудио-поток); move(from, to)
+        // вызывается, когда последний голос переезжает на место удаленного
+        template <typename MoveVoice>
+        static void dropFadedVoices(OscillatorBank& bank, VoiceBinding& binding, size_t count, MoveVoice&& move);
+        
+        // Переносит снимок в rt_bank_ в пределах бюджета голосов (аудио-поток)
+        void applySnapshot(const RenderSnapshot& snapshot);
+        
+        // Удаляет затухшие голоса rt_bank_ вместе с их источниками рендера (аудио-поток)
+        void dropFadedRealtimeVoices();
+        
+        // Пересматривает предел голосов по времени синтеза блока (аудио-поток)
+        void updateVoiceBudget(size_t frames, double render_seconds);
+        
+        // Забирает последний снимок и применяет его, если версия изменилась (аудио-поток)
+        void acquireSnapshot();
+        
+        // Перестраивает преобразователи после смены частот (под core_mutex_)
+        void configureResamplersLocked();
+        
+        // Выделяет буферы многоканального рендера (под core_mutex_)
+        void prepareSpeakerRendererLocked();
+        
+        // Тип интерференционного поля, в которое попадает позиция (под core_mutex_)
+        InterferenceFieldType interferenceTypeAtLocked(const SphericalCoord& position) const;
+        
+        // Рендер источников в многоканальный выход одним из двух способов (аудио-поток)
+        template <typename RenderChunk>
+        void renderSpeakerBlock(size_t frames, RenderChunk&& render_chunk);
+        
+        // Анализ блока входа; true — завершен кадр STFT (под core_mutex_)
+        bool analyzeInput(const std::vector<double>& input_signal);
+        
+        // STFT отсчетов на частоте обработки (под core_mutex_)
+        bool analyzeSamplesLocked(const float* samples, size_t count);
+        
+        // Пики спектра становятся полями входа (под core_mutex_)
+        void storeInputPeaksLocked(const std::vector<SpectralPeak>& peaks);
+        
+        // Перестраивает поля резонатора, если изменилась его модель (под core_mutex_)
+        void processDomeResonanceLocked();
+        
+        // Синтез полей output_bank_ в out с приведением к частоте выхода (под core_mutex_)
+        void renderOutputBank(float* out, size_t frames);
+        
+        // Пересобирает граф обработки под текущие интерференционные поля (под core_mutex_)
+        void buildProcessingGraphLocked();
+        
+        // Переносит отобранные голоса в output_bank_ (под core_mutex_)
+        void syncOscillatorBank();
     };
 
     // Включение новых модулей
@@ -8,6 +8,8 @@
 #include <mutex>
 #include <thread>
 #include <chrono>
+#include <cstdint>
+#include <type_traits>
 
 namespace AnantaDigital {
 
@@ -48,17 +50,53 @@ namespace AnantaDigital {
         }
     };
 
-    // Комплексное звуковое поле с квантовыми свойствами
+    // Время в отсчетах тактовой частоты дискретизации ядра
+    using SampleTime = uint64_t;
+
+    // Модель волновой функции поля
+    enum class WaveformType : uint8_t {
+        NONE,               // Нулевая волновая функция
+        PLANE_WAVE,         // exp(i(2πf·t - 2π·r/c))
+        SPHERICAL_WAVE,     // Плоская волна с затуханием 1/(1 + 0.1·r)
+        STANDING_WAVE,      // cos(2π·r/c)·exp(i·2πf·t)
+        CALLABLE            // Произвольная функция из WaveFunctionRegistry (медленный путь)
+    };
+
+    // Компактное описание волновой функции: тип и параметры вместо std::function.
+    // Тривиально копируется; вычисляется evaluateWaveform() (waveform.hpp).
+    struct WaveformDescriptor {
+        WaveformType type = WaveformType::NONE;
+        uint32_t callable_id = 0;   // идентификатор в WaveFunctionRegistry для CALLABLE
+        double frequency = 0.0;
+        
+        static WaveformDescriptor planeWave(double frequency) {
+            return WaveformDescriptor{WaveformType::PLANE_WAVE, 0, frequency};
+        }
+        static WaveformDescriptor sphericalWave(double frequency) {
+            return WaveformDescriptor{WaveformType::SPHERICAL_WAVE, 0, frequency};
+        }
+        static WaveformDescriptor standingWave(double frequency) {
+            return WaveformDescriptor{WaveformType::STANDING_WAVE, 0, frequency};
+        }
+    };
+
+    // Комплексное звуковое поле с квантовыми свойствами.
+    // Тривиально копируется: массивы полей можно копировать memcpy,
+    // сериализовать и хранить в виде структуры массивов.
     struct QuantumSoundField {
-        std::complex<double> amplitude;
-        double phase;
-        double frequency;
-        QuantumSoundState quantum_state;
-        SphericalCoord position;
-        std::chrono::high_resolution_clock::time_point timestamp;
+        std::complex<double> amplitude{0.0, 0.0};
+        double phase = 0.0;
+        double frequency = 0.0;
+        QuantumSoundState quantum_state = QuantumSoundState::COHERENT;
+        SphericalCoord position{0.0, 0.0, 0.0, 0.0};
+        SampleTime sample_time = 0;     // момент создания по часам отсчетов ядра
+        uint8_t priority = 0;           // важность при вытеснении из заполненного пула
         
         // Квантовая волновая функция
-        std::function<std::complex<double>(double, double, double, double)> wave_function;
+        WaveformDescriptor waveform;
     };
 
+    static_assert(std::is_trivially_copyable<QuantumSoundField>::value,
+                  "QuantumSoundField must stay trivially copyable");
+
 } // namespace AnantaDigital
@@ -1,50 +1,409 @@
 #include "interference_field.hpp"
+#include "dsp_kernels.hpp"
+#include "sin_cycles.hpp"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 
 namespace AnantaDigital {
 
+namespace {
+
+constexpr size_t kBatchTile = InterferenceField::kBatchTile;
+
+// Случайных чисел за один вызов генератора в updateQuantumState (четное)
+constexpr size_t kRandomChunk = 64;
+
+// Источники пакетного расчета в SoA
+struct BatchSources {
+    std::vector<float> x, y, z;
+    std::vector<float> frequency;
+    std::vector<double> frequency_exact;    // временная фаза приводится в double
+    std::vector<float> wave_number;         // f/c, циклов на метр
+    std::vector<float> amplitude_re, amplitude_im;
+    std::vector<float> magnitude;
+    
+    size_t size() const { return x.size(); }
+};
+
+// Плитка точек наблюдения и накопители интерференции
+struct alignas(32) BatchTile {
+    float x[kBatchTile], y[kBatchTile], z[kBatchTile];
+    float dt[kBatchTile];                   // время точки минус время плитки
+    float re[kBatchTile], im[kBatchTile];
+};
+
+// Вклад источника s во все точки плитки; phase — временная фаза источника
+// на время плитки в циклах. Вклады тише threshold обнуляются.
+#if defined(__AVX2__)
+
+void accumulateSource(const BatchSources& sources, size_t s, float phase, float threshold, BatchTile& tile) {
+    const __m256 sx = _mm256_set1_ps(sources.x[s]);
+    const __m256 sy = _mm256_set1_ps(sources.y[s]);
+    const __m256 sz = _mm256_set1_ps(sources.z[s]);
+    const __m256 frequency = _mm256_set1_ps(sources.frequency[s]);
+    const __m256 wave_number = _mm256_set1_ps(sources.wave_number[s]);
+    const __m256 amplitude_re = _mm256_set1_ps(sources.amplitude_re[s]);
+    const __m256 amplitude_im = _mm256_set1_ps(sources.amplitude_im[s]);
+    const __m256 magnitude = _mm256_set1_ps(sources.magnitude[s]);
+    const __m256 threshold_v = _mm256_set1_ps(threshold);
+    const __m256 phase_v = _mm256_set1_ps(phase);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 quarter = _mm256_set1_ps(0.25f);
+    const __m256 decay = _mm256_set1_ps(0.1f);
+    
+    for (size_t p = 0; p < kBatchTile; p += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_load_ps(tile.x + p), sx);
+        __m256 dy = _mm256_sub_ps(_mm256_load_ps(tile.y + p), sy);
+        __m256 dz = _mm256_sub_ps(_mm256_load_ps(tile.z + p), sz);
+        __m256 distance = _mm256_sqrt_ps(
+            _mm256_fmadd_ps(dx, dx, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dz, dz))));
+        __m256 attenuation = _mm256_div_ps(one, _mm256_fmadd_ps(distance, decay, one));
+        attenuation = _mm256_and_ps(attenuation,
+                                    _mm256_cmp_ps(_mm256_mul_ps(magnitude, attenuation), threshold_v, _CMP_GE_OQ));
+        
+        __m256 cycles = _mm256_fnmadd_ps(wave_number, distance,
+                                         _mm256_fmadd_ps(frequency, _mm256_load_ps(tile.dt + p), phase_v));
+        __m256 sine = _mm256_mul_ps(attenuation, Kernels::sinCyclesAvx2(cycles));
+        __m256 cosine = _mm256_mul_ps(attenuation, Kernels::sinCyclesAvx2(_mm256_add_ps(cycles, quarter)));
+        
+        __m256 re = _mm256_load_ps(tile.re + p);
+        __m256 im = _mm256_load_ps(tile.im + p);
+        re = _mm256_fmadd_ps(amplitude_re, cosine, _mm256_fnmadd_ps(amplitude_im, sine, re));
+        im = _mm256_fmadd_ps(amplitude_re, sine, _mm256_fmadd_ps(amplitude_im, cosine, im));
+        _mm256_store_ps(tile.re + p, re);
+        _mm256_store_ps(tile.im + p, im);
+    }
+}
+
+#else
+
+void accumulateSource(const BatchSources& sources, size_t s, float phase, float threshold, BatchTile& tile) {
+    const float sx = sources.x[s], sy = sources.y[s], sz = sources.z[s];
+    const float frequency = sources.frequency[s];
+    const float wave_number = sources.wave_number[s];
+    const float amplitude_re = sources.amplitude_re[s];
+    const float amplitude_im = sources.amplitude_im[s];
+    const float magnitude = sources.magnitude[s];
+    
+    for (size_t p = 0; p < kBatchTile; ++p) {
+        const float dx = tile.x[p] - sx, dy = tile.y[p] - sy, dz = tile.z[p] - sz;
+        const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        float attenuation = 1.0f / (1.0f + distance * 0.1f);
+        if (!(magnitude * attenuation >= threshold)) attenuation = 0.0f;
+        
+        const float cycles = phase + frequency * tile.dt[p] - wave_number * distance;
+        const float sine = attenuation * Kernels::sinCycles(cycles);
+        const float cosine = attenuation * Kernels::sinCycles(cycles + 0.25f);
+        tile.re[p] += amplitude_re * cosine - amplitude_im * sine;
+        tile.im[p] += amplitude_re * sine + amplitude_im * cosine;
+    }
+}
+
+#endif
+
+} // namespace
+
 InterferenceField::InterferenceField(InterferenceFieldType type, SphericalCoord center, double radius)
     : type_(type)
     , center_position_(center)
-    , field_radius_(radius) {
+    , field_radius_(radius)
+    , source_capacity_(0)
+    , steal_policy_(VoiceStealPolicy::REJECT)
+    , peak_sources_(0)
+    , rejected_sources_(0)
+    , stolen_sources_(0)
+    , culling_threshold_(0.0)
+    , tree_dirty_(true)
+    , tree_error_bound_(0.0) {
 }
 
-void InterferenceField::addSourceField(const QuantumSoundField& field) {
+bool InterferenceField::addSourceField(const QuantumSoundField& field) {
     std::lock_guard<std::mutex> lock(field_mutex_);
+    
+    if (source_capacity_ > 0 && source_fields_.size() >= source_capacity_) {
+        if (steal_policy_ == VoiceStealPolicy::REJECT || source_fields_.empty()) {
+            ++rejected_sources_;
+            return false;
+        }
+        
+        const size_t victim = stealVictimLocked();
+        if (preferVictim(steal_policy_, VoiceKey::of(field), VoiceKey::of(source_fields_[victim]))) {
+            ++rejected_sources_;
+            return false;
+        }
+        
+        source_fields_[victim] = field;
+        storeSourcePositionLocked(victim);
+        tree_dirty_ = true;
+        ++stolen_sources_;
+        return true;
+    }
+    
     source_fields_.push_back(field);
+    source_x_.emplace_back();
+    source_y_.emplace_back();
+    source_z_.emplace_back();
+    storeSourcePositionLocked(source_fields_.size() - 1);
+    tree_dirty_ = true;
+    peak_sources_ = std::max(peak_sources_, source_fields_.size());
+    return true;
 }
 
-std::complex<double> InterferenceField::calculateInterference(const SphericalCoord& position, double time) const {
+void InterferenceField::storeSourcePositionLocked(size_t index) {
+    const auto position = Kernels::toCartesian<Sample>(source_fields_[index].position);
+    source_x_[index] = position.x;
+    source_y_[index] = position.y;
+    source_z_[index] = position.z;
+}
+
+size_t InterferenceField::stealVictimLocked() const {
+    size_t victim = 0;
+    for (size_t i = 1; i < source_fields_.size(); ++i) {
+        if (preferVictim(steal_policy_, VoiceKey::of(source_fields_[i]), VoiceKey::of(source_fields_[victim]))) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+void InterferenceField::eraseSourceLocked(size_t index) {
+    source_fields_.erase(source_fields_.begin() + index);
+    for (auto* column : {&source_x_, &source_y_, &source_z_}) {
+        column->erase(column->begin() + index);
+    }
+    tree_dirty_ = true;
+}
+
+void InterferenceField::setSourceCapacity(size_t capacity, VoiceStealPolicy policy) {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    source_capacity_ = capacity;
+    steal_policy_ = policy;
+    if (capacity == 0) return;
+    
+    if (steal_policy_ == VoiceStealPolicy::REJECT) {
+        source_capacity_ = std::max(capacity, source_fields_.size());
+    }
+    while (source_fields_.size() > source_capacity_) {
+        eraseSourceLocked(stealVictimLocked());
+        ++stolen_sources_;
+    }
+    
+    source_fields_.reserve(source_capacity_);
+    for (auto* column : {&source_x_, &source_y_, &source_z_}) {
+        column->reserve(source_capacity_);
+    }
+}
+
+PoolStatistics InterferenceField::getSourceStatistics() const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    PoolStatistics stats;
+    stats.capacity = source_capacity_;
+    stats.in_use = source_fields_.size();
+    stats.peak_in_use = peak_sources_;
+    stats.rejected = rejected_sources_;
+    stats.stolen = stolen_sources_;
+    return stats;
+}
+
+void InterferenceField::setCullingThreshold(double threshold) {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    culling_threshold_ = threshold > 0.0 ? threshold : 0.0;
+}
+
+void InterferenceField::setTreeAcceleration(double error_bound) {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    tree_error_bound_ = error_bound > 0.0 ? error_bound : 0.0;
+    if (tree_error_bound_ > 0.0) {
+        source_tree_.setErrorBound(tree_error_bound_);
+    } else {
+        source_tree_.clear();
+    }
+    tree_dirty_ = true;
+}
+
+void InterferenceField::rebuildSourceTree(WorkerPool* pool) {
     std::lock_guard<std::mutex> lock(field_mutex_);
+    tree_dirty_ = true;
+    treeReadyLocked(pool);
+}
+
+OctreeStatistics InterferenceField::getTreeStatistics() const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    return source_tree_.getStatistics();
+}
+
+bool InterferenceField::treeReadyLocked(WorkerPool* pool) const {
+    if (tree_error_bound_ <= 0.0 || source_fields_.size() < kTreeMinSources) return false;
+    if (!tree_dirty_) return true;
     
+    std::vector<SourceOctree::Source> sources(source_fields_.size());
+    for (size_t i = 0; i < source_fields_.size(); ++i) {
+        const QuantumSoundField& field = source_fields_[i];
+        sources[i] = {Kernels::toCartesian<double>(field.position), field.amplitude, field.frequency};
+    }
+    source_tree_.build(sources.data(), sources.size(), pool);
+    tree_dirty_ = false;
+    return true;
+}
+
+std::vector<QuantumSoundField> InterferenceField::getSourceFields() const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    return source_fields_;
+}
+
+std::complex<double> InterferenceField::calculateInterference(const SphericalCoord& position, double time) const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    return interferenceAtLocked(Kernels::toCartesian<double>(position), time);
+}
+
+std::complex<double> InterferenceField::calculateInterference(const Kernels::CartesianPoint<double>& position,
+                                                              double time) const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    return interferenceAtLocked(position, time);
+}
+
+std::complex<double> InterferenceField::interferenceAtLocked(const Kernels::CartesianPoint<double>& point,
+                                                             double time) const {
     if (source_fields_.empty()) {
         return std::complex<double>(0.0, 0.0);
     }
     
-    std::complex<double> total_interference(0.0, 0.0);
+    if (treeReadyLocked()) {
+        return Kernels::applyInterferenceType(source_tree_.evaluate(point, time, culling_threshold_), type_);
+    }
+    
+    const Kernels::CartesianPoint<Sample> observer{static_cast<Sample>(point.x), static_cast<Sample>(point.y),
+                                                   static_cast<Sample>(point.z)};
     
-    for (const auto& source : source_fields_) {
-        // Вычисляем расстояние от источника до точки наблюдения
-        double distance = calculateDistance(source.position, position);
-        
-        // Вычисляем фазовую задержку
-        auto phase_delay = calculatePhaseDelay(distance, source.frequency, time);
-        
-        // Применяем амплитуду и фазу
-        std::complex<double> field_contribution = source.amplitude * phase_delay;
+    // Накопление ведется в точности Sample (float в сборке ENABLE_FLOAT32_DSP)
+    ComplexSample total_interference(0, 0);
+    
+    for (size_t i = 0; i < source_fields_.size(); ++i) {
+        const QuantumSoundField& source = source_fields_[i];
         
-        // Применяем затухание с расстоянием
-        double attenuation = 1.0 / (1.0 + distance * 0.1);
-        field_contribution *= attenuation;
+        // Расстояние от кэшированной позиции источника до точки наблюдения
+        Sample distance = Kernels::distance(Kernels::CartesianPoint<Sample>{source_x_[i], source_y_[i], source_z_[i]},
+                                            observer);
+        if (culling_threshold_ > 0.0 &&
+            std::abs(source.amplitude) * Kernels::distanceAttenuation<double>(distance) < culling_threshold_) {
+            continue;
+        }
         
-        // Добавляем к общей интерференции
-        total_interference += field_contribution;
+        // Фазовая задержка, амплитуда и затухание с расстоянием
+        total_interference += Kernels::sourceContribution<Sample>(
+            ComplexSample(source.amplitude), source.frequency, distance, time);
     }
     
     // Применяем тип интерференции
-    return applyInterferenceType(total_interference, type_);
+    return std::complex<double>(Kernels::applyInterferenceType(total_interference, type_));
+}
+
+void InterferenceField::calculateInterferenceBatch(const ObserverBatch& observers, std::complex<double>* out,
+                                                   WorkerPool* pool) const {
+    if (!out || observers.count == 0) return;
+    const bool cartesian = observers.x && observers.y && observers.z;
+    if (!cartesian && (!observers.r || !observers.theta || !observers.phi)) {
+        std::fill(out, out + observers.count, std::complex<double>(0.0, 0.0));
+        return;
+    }
+    
+    auto observerAt = [&](size_t i) {
+        if (cartesian) return Kernels::CartesianPoint<double>{observers.x[i], observers.y[i], observers.z[i]};
+        const SphericalCoord position{observers.r[i], observers.theta[i], observers.phi[i],
+                                      observers.height ? observers.height[i] : 0.0};
+        return Kernels::toCartesian<double>(position);
+    };
+    const size_t tiles = (observers.count + kBatchTile - 1) / kBatchTile;
+    
+    // Дерево: обход на точку под мьютексом, плитками между потоками
+    {
+        std::lock_guard<std::mutex> lock(field_mutex_);
+        if (treeReadyLocked(pool)) {
+            auto processTile = [&](size_t index, size_t) {
+                const size_t begin = index * kBatchTile;
+                const size_t end = std::min(observers.count, begin + kBatchTile);
+                for (size_t i = begin; i < end; ++i) {
+                    const double time = observers.time ? observers.time[i] : observers.common_time;
+                    const auto total = source_tree_.evaluate(observerAt(i), time, culling_threshold_);
+                    out[i] = Kernels::applyInterferenceType(total, type_);
+                }
+            };
+            if (pool && tiles > 1) {
+                pool->run(tiles, processTile);
+            } else {
+                for (size_t index = 0; index < tiles; ++index) processTile(index, 0);
+            }
+            return;
+        }
+    }
+    
+    // Снимок источников под одним захватом; дальше мьютекс не нужен
+    BatchSources sources;
+    float threshold = 0.0f;
+    {
+        std::lock_guard<std::mutex> lock(field_mutex_);
+        const size_t count = source_fields_.size();
+        for (auto* column : {&sources.x, &sources.y, &sources.z, &sources.frequency, &sources.wave_number,
+                             &sources.amplitude_re, &sources.amplitude_im, &sources.magnitude}) {
+            column->resize(count);
+        }
+        sources.frequency_exact.resize(count);
+        for (size_t s = 0; s < count; ++s) {
+            const QuantumSoundField& source = source_fields_[s];
+            sources.x[s] = static_cast<float>(source_x_[s]);
+            sources.y[s] = static_cast<float>(source_y_[s]);
+            sources.z[s] = static_cast<float>(source_z_[s]);
+            sources.frequency[s] = static_cast<float>(source.frequency);
+            sources.frequency_exact[s] = source.frequency;
+            sources.wave_number[s] = static_cast<float>(source.frequency / Kernels::kSpeedOfSound);
+            sources.amplitude_re[s] = static_cast<float>(source.amplitude.real());
+            sources.amplitude_im[s] = static_cast<float>(source.amplitude.imag());
+            sources.magnitude[s] = static_cast<float>(std::abs(source.amplitude));
+        }
+        threshold = static_cast<float>(culling_threshold_);
+    }
+    
+    auto processTile = [&](size_t index, size_t) {
+        BatchTile tile;
+        const size_t begin = index * kBatchTile;
+        const size_t count = std::min(kBatchTile, observers.count - begin);
+        const double tile_time = observers.time ? observers.time[begin] : observers.common_time;
+        
+        // Хвост последней плитки — нулевые точки, их результат отбрасывается
+        for (size_t p = 0; p < kBatchTile; ++p) {
+            tile.re[p] = tile.im[p] = 0.0f;
+            if (p >= count) {
+                tile.x[p] = tile.y[p] = tile.z[p] = tile.dt[p] = 0.0f;
+                continue;
+            }
+            const size_t i = begin + p;
+            const auto point = observerAt(i);
+            tile.x[p] = static_cast<float>(point.x);
+            tile.y[p] = static_cast<float>(point.y);
+            tile.z[p] = static_cast<float>(point.z);
+            tile.dt[p] = observers.time ? static_cast<float>(observers.time[i] - tile_time) : 0.0f;
+        }
+        
+        for (size_t s = 0; s < sources.size(); ++s) {
+            double phase = sources.frequency_exact[s] * tile_time;
+            phase -= std::floor(phase);
+            accumulateSource(sources, s, static_cast<float>(phase), threshold, tile);
+        }
+        
+        for (size_t p = 0; p < count; ++p) {
+            const ComplexSample total(tile.re[p], tile.im[p]);
+            out[begin + p] = std::complex<double>(Kernels::applyInterferenceType(total, type_));
+        }
+    };
+    
+    if (pool && tiles > 1) {
+        pool->run(tiles, processTile);
+    } else {
+        for (size_t index = 0; index < tiles; ++index) {
+            processTile(index, 0);
+        }
+    }
 }
 
 QuantumSoundField InterferenceField::quantumSuperposition(const std::vector<QuantumSoundField>& fields) const {
@@ -54,7 +413,6 @@ QuantumSoundField InterferenceField::quantumSuperposition(const std::vector<Quan
     
     QuantumSoundField result;
     result.quantum_state = QuantumSoundState::SUPERPOSITION;
-    result.timestamp = std::chrono::high_resolution_clock::now();
     
     // Вычисляем средневзвешенную позицию
     double total_weight = 0.0;
@@ -91,6 +449,12 @@ QuantumSoundField InterferenceField::quantumSuperposition(const std::vector<Quan
     result.amplitude = total_amplitude / static_cast<double>(fields.size());
     result.frequency = total_frequency / static_cast<double>(fields.size());
     result.phase = std::arg(result.amplitude);
+    result.waveform = WaveformDescriptor::planeWave(result.frequency);
+    
+    // Суперпозиция существует с момента появления последнего из полей
+    for (const auto& field : fields) {
+        result.sample_time = std::max(result.sample_time, field.sample_time);
+    }
     
     return result;
 }
@@ -98,40 +462,53 @@ QuantumSoundField InterferenceField::quantumSuperposition(const std::vector<Quan
 void InterferenceField::updateQuantumState(double dt) {
     std::lock_guard<std::mutex> lock(field_mutex_);
     
-    for (auto& field : source_fields_) {
-        // Обновляем квантовое состояние
-        switch (field.quantum_state) {
-            case QuantumSoundState::COHERENT:
-                // Когерентное состояние остается стабильным
-                break;
+    // Одно равномерное число на поле, пакетами по kRandomChunk на стеке.
+    // Пакет четного размера продолжает ту же последовательность Philox.
+    double random_chunk[kRandomChunk];
+    for (size_t base = 0; base < source_fields_.size(); base += kRandomChunk) {
+        const size_t count = std::min(kRandomChunk, source_fields_.size() - base);
+        rng_.fillUniform(random_chunk, count);
+        
+        for (size_t i = 0; i < count; ++i) {
+            QuantumSoundField& field = source_fields_[base + i];
+            const double random_value = random_chunk[i];
+            
+            // Обновляем квантовое состояние
+            switch (field.quantum_state) {
+                case QuantumSoundState::COHERENT:
+                    // Когерентное состояние остается стабильным
+                    break;
                 
-            case QuantumSoundState::SUPERPOSITION:
-                // Суперпозиция может коллапсировать
-                if (std::rand() % 100 < 5) { // 5% вероятность коллапса
-                    field.quantum_state = QuantumSoundState::COLLAPSED;
-                }
-                break;
+                case QuantumSoundState::SUPERPOSITION:
+                    // Суперпозиция может коллапсировать
+                    if (random_value < 0.05) { // 5% вероятность коллапса
+                        field.quantum_state = QuantumSoundState::COLLAPSED;
+                    }
+                    break;
                 
-            case QuantumSoundState::ENTANGLED:
-                // Запутанное состояние может распутаться
-                if (std::rand() % 100 < 2) { // 2% вероятность распутывания
-                    field.quantum_state = QuantumSoundState::COHERENT;
-                }
-                break;
+                case QuantumSoundState::ENTANGLED:
+                    // Запутанное состояние может распутаться
+                    if (random_value < 0.02) { // 2% вероятность распутывания
+                        field.quantum_state = QuantumSoundState::COHERENT;
+                    }
+                    break;
                 
-            case QuantumSoundState::COLLAPSED:
-                // Коллапсированное состояние может вернуться к когерентному
-                if (std::rand() % 100 < 10) { // 10% вероятность восстановления
-                    field.quantum_state = QuantumSoundState::COHERENT;
-                }
-                break;
+                case QuantumSoundState::COLLAPSED:
+                    // Коллапсированное состояние может вернуться к когерентному
+                    if (random_value < 0.10) { // 10% вероятность восстановления
+                        field.quantum_state = QuantumSoundState::COHERENT;
+                    }
+                    break;
+            }
         }
-        
-        // Обновляем временную метку
-        field.timestamp = std::chrono::high_resolution_clock::now();
     }
 }
 
+void InterferenceField::setRandomSeed(uint64_t seed, uint64_t stream) {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    rng_.seed(seed, stream);
+}
+
 void InterferenceField::createQuantumEntanglement(size_t field1_idx, size_t field2_idx) {
     std::lock_guard<std::mutex> lock(field_mutex_);
     
@@ -154,70 +531,173 @@ void InterferenceField::removeSourceField(size_t index) {
     std::lock_guard<std::mutex> lock(field_mutex_);
     
     if (index < source_fields_.size()) {
-        source_fields_.erase(source_fields_.begin() + index);
+        eraseSourceLocked(index);
+    }
+}
+
+bool InterferenceField::moveSourceField(size_t index, const SphericalCoord& position) {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    if (index >= source_fields_.size()) return false;
+    
+    source_fields_[index].position = position;
+    storeSourcePositionLocked(index);
+    
+    // Внутри листа дерево обновляется на месте, иначе перестраивается при расчете
+    if (!tree_dirty_ && !source_tree_.moveSource(index, Kernels::toCartesian<double>(position))) {
+        tree_dirty_ = true;
     }
+    return true;
 }
 
 void InterferenceField::clearSourceFields() {
     std::lock_guard<std::mutex> lock(field_mutex_);
     source_fields_.clear();
+    source_x_.clear();
+    source_y_.clear();
+    source_z_.clear();
+    tree_dirty_ = true;
 }
 
 double InterferenceField::calculateDistance(const SphericalCoord& pos1, const SphericalCoord& pos2) const {
     // Преобразуем сферические координаты в декартовы для вычисления расстояния
-    double x1 = pos1.r * std::sin(pos1.theta) * std::cos(pos1.phi);
-    double y1 = pos1.r * std::sin(pos1.theta) * std::sin(pos1.phi);
-    double z1 = pos1.r * std::cos(pos1.theta) + pos1.height;
+    return Kernels::distance(Kernels::toCartesian<Sample>(pos1), Kernels::toCartesian<Sample>(pos2));
+}
+
+std::complex<double> InterferenceField::calculatePhaseDelay(double distance, double frequency, double time) const {
+    // Вычисляем фазовую задержку с учетом времени распространения (343 м/с - скорость звука)
+    return std::complex<double>(Kernels::phaseDelay<Sample>(static_cast<Sample>(distance), frequency, time));
+}
+
+std::complex<double> InterferenceField::applyInterferenceType(const std::complex<double>& signal, InterferenceFieldType type) const {
+    return std::complex<double>(Kernels::applyInterferenceType(ComplexSample(signal), type));
+}
+
+InterferenceStream::InterferenceStream()
+    : type_(InterferenceFieldType::CONSTRUCTIVE)
+    , sample_rate_(48000.0)
+    , start_time_(0.0)
+    , position_(0)
+    , source_count_(0)
+    , sum_re_(kChunkFrames * kLanes, Sample(0))
+    , sum_im_(kChunkFrames * kLanes, Sample(0)) {
+}
+
+void InterferenceStream::prepare(const InterferenceField& field, const SphericalCoord& listener, double start_time,
+                                 double sample_rate) {
+    const auto point = Kernels::toCartesian<double>(listener);
+    prepare(field, point, start_time, sample_rate);
+}
+
+void InterferenceStream::prepare(const InterferenceField& field, const Kernels::CartesianPoint<double>& listener,
+                                 double start_time, double sample_rate) {
+    type_ = field.getType();
+    sample_rate_ = sample_rate > 0.0 ? sample_rate : 48000.0;
+    start_time_ = start_time;
+    position_ = 0;
     
-    double x2 = pos2.r * std::sin(pos2.theta) * std::cos(pos2.phi);
-    double y2 = pos2.r * std::sin(pos2.theta) * std::sin(pos2.phi);
-    double z2 = pos2.r * std::cos(pos2.theta) + pos2.height;
+    frequencies_.clear();
+    constant_re_.clear();
+    constant_im_.clear();
+    rotation_re_.clear();
+    rotation_im_.clear();
     
-    double dx = x2 - x1;
-    double dy = y2 - y1;
-    double dz = z2 - z1;
+    const double threshold = field.getCullingThreshold();
+    for (const QuantumSoundField& source : field.getSourceFields()) {
+        const double distance = Kernels::distance(Kernels::toCartesian<double>(source.position), listener);
+        const double attenuation = Kernels::distanceAttenuation(distance);
+        if (threshold > 0.0 && std::abs(source.amplitude) * attenuation < threshold) continue;
+        
+        // Постоянная часть: a·A(d)·e^{-i2π·f·d/c}, задержка приводится в циклах
+        double delay = source.frequency * distance / Kernels::kSpeedOfSound;
+        delay -= std::floor(delay);
+        const std::complex<double> constant = source.amplitude * attenuation * std::polar(1.0, -2.0 * M_PI * delay);
+        const double step = 2.0 * M_PI * source.frequency / sample_rate_;
+        
+        frequencies_.push_back(source.frequency);
+        constant_re_.push_back(constant.real());
+        constant_im_.push_back(constant.imag());
+        rotation_re_.push_back(static_cast<Sample>(std::cos(step)));
+        rotation_im_.push_back(static_cast<Sample>(std::sin(step)));
+    }
+    source_count_ = frequencies_.size();
     
-    return std::sqrt(dx*dx + dy*dy + dz*dz);
+    // Дополнение до kLanes нулевыми источниками
+    const size_t padded = (source_count_ + kLanes - 1) / kLanes * kLanes;
+    frequencies_.resize(padded, 0.0);
+    constant_re_.resize(padded, 0.0);
+    constant_im_.resize(padded, 0.0);
+    rotation_re_.resize(padded, Sample(1));
+    rotation_im_.resize(padded, Sample(0));
+    phasor_re_.assign(padded, Sample(0));
+    phasor_im_.assign(padded, Sample(0));
+    reanchor();
 }
 
-std::complex<double> InterferenceField::calculatePhaseDelay(double distance, double frequency, double time) const {
-    // Вычисляем фазовую задержку с учетом времени распространения
-    double phase = 2.0 * M_PI * frequency * (time - distance / 343.0); // 343 м/с - скорость звука
-    return std::complex<double>(std::cos(phase), std::sin(phase));
+void InterferenceStream::reanchor() {
+    const double time = getTime();
+    for (size_t s = 0; s < frequencies_.size(); ++s) {
+        double cycles = frequencies_[s] * time;
+        cycles -= std::floor(cycles);
+        const double angle = 2.0 * M_PI * cycles;
+        const double c = std::cos(angle), sn = std::sin(angle);
+        phasor_re_[s] = static_cast<Sample>(constant_re_[s] * c - constant_im_[s] * sn);
+        phasor_im_[s] = static_cast<Sample>(constant_re_[s] * sn + constant_im_[s] * c);
+    }
 }
 
-std::complex<double> InterferenceField::applyInterferenceType(const std::complex<double>& signal, InterferenceFieldType type) const {
-    switch (type) {
-        case InterferenceFieldType::CONSTRUCTIVE:
-            return signal; // Конструктивная интерференция - без изменений
-            
-        case InterferenceFieldType::DESTRUCTIVE:
-            return -signal; // Деструктивная интерференция - инверсия фазы
-            
-        case InterferenceFieldType::PHASE_MODULATED:
-            // Фазово-модулированная интерференция
-            {
-                double phase_mod = std::sin(std::arg(signal) * 2.0);
-                return signal * std::complex<double>(std::cos(phase_mod), std::sin(phase_mod));
-            }
-            
-        case InterferenceFieldType::AMPLITUDE_MODULATED:
-            // Амплитудно-модулированная интерференция
-            {
-                double amp_mod = (1.0 + std::sin(std::arg(signal))) / 2.0;
-                return signal * amp_mod;
-            }
-            
-        case InterferenceFieldType::QUANTUM_ENTANGLED:
-            // Квантово-запутанная интерференция
-            {
-                double quantum_factor = std::abs(signal) * std::cos(std::arg(signal));
-                return signal * quantum_factor;
+void InterferenceStream::render(std::complex<double>* out, size_t frames) {
+    if (!out) return;
+    
+    size_t written = 0;
+    while (written < frames) {
+        // Отрезок не пересекает границу точного пересчета
+        const size_t until_anchor = kReanchorFrames - static_cast<size_t>(position_ % kReanchorFrames);
+        const size_t count = std::min({kChunkFrames, until_anchor, frames - written});
+        renderChunk(out + written, count);
+        position_ += count;
+        written += count;
+        if (position_ % kReanchorFrames == 0) reanchor();
+    }
+}
+
+void InterferenceStream::renderChunk(std::complex<double>* out, size_t count) {
+    // Частичные суммы по kLanes независимым дорожкам: внутренний цикл
+    // без зависимостей между дорожками векторизуется
+    std::fill(sum_re_.begin(), sum_re_.begin() + count * kLanes, Sample(0));
+    std::fill(sum_im_.begin(), sum_im_.begin() + count * kLanes, Sample(0));
+    
+    for (size_t group = 0; group < frequencies_.size(); group += kLanes) {
+        Sample re[kLanes], im[kLanes], rotation_re[kLanes], rotation_im[kLanes];
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            re[lane] = phasor_re_[group + lane];
+            im[lane] = phasor_im_[group + lane];
+            rotation_re[lane] = rotation_re_[group + lane];
+            rotation_im[lane] = rotation_im_[group + lane];
+        }
+        for (size_t t = 0; t < count; ++t) {
+            Sample* sum_re = sum_re_.data() + t * kLanes;
+            Sample* sum_im = sum_im_.data() + t * kLanes;
+            for (size_t lane = 0; lane < kLanes; ++lane) {
+                sum_re[lane] += re[lane];
+                sum_im[lane] += im[lane];
+                const Sample next_re = re[lane] * rotation_re[lane] - im[lane] * rotation_im[lane];
+                im[lane] = re[lane] * rotation_im[lane] + im[lane] * rotation_re[lane];
+                re[lane] = next_re;
             }
-            
-        default:
-            return signal;
+        }
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            phasor_re_[group + lane] = re[lane];
+            phasor_im_[group + lane] = im[lane];
+        }
+    }
+    
+    for (size_t t = 0; t < count; ++t) {
+        ComplexSample total(0, 0);
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            total += ComplexSample(sum_re_[t * kLanes + lane], sum_im_[t * kLanes + lane]);
+        }
+        out[t] = std::complex<double>(Kernels::applyInterferenceType(total, type_));
     }
 }
 
-} // namespace AnantaDigital
\ No newline at end of file
+} // namespace AnantaDigital
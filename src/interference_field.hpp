@@ -1,38 +1,127 @@
 #pragma once
 
 #include "anantadigital_types.hpp"
+#include "dsp_kernels.hpp"
+#include "philox_random.hpp"
+#include "source_octree.hpp"
+#include "voice_pool.hpp"
+#include "worker_pool.hpp"
 #include <vector>
 #include <memory>
 #include <mutex>
 #include <complex>
 #include <cmath>
+#include <cstdint>
 
 namespace AnantaDigital {
 
+// Точки наблюдения пакетного расчета в SoA: сферические координаты купола
+// и время каждой точки. height и time могут быть nullptr: высота 0, время common_time.
+// Заданные x, y, z (декартовы, м) используются вместо сферических координат.
+struct ObserverBatch {
+    const double* x = nullptr;
+    const double* y = nullptr;
+    const double* z = nullptr;
+    const double* r = nullptr;
+    const double* theta = nullptr;
+    const double* phi = nullptr;
+    const double* height = nullptr;
+    const double* time = nullptr;
+    double common_time = 0.0;
+    size_t count = 0;
+};
+
 // Интерференционное поле
 class InterferenceField {
 private:
     InterferenceFieldType type_;
     std::vector<QuantumSoundField> source_fields_;
+    
+    // Декартовы позиции источников (SoA, параллельно source_fields_): пересчитываются
+    // при добавлении, замене и перемещении источника, а не при каждом расчете
+    std::vector<Sample> source_x_, source_y_, source_z_;
+    
     SphericalCoord center_position_;
     double field_radius_;
     mutable std::mutex field_mutex_;
+    
+    // Случайные переходы состояний: свой генератор у каждого поля
+    PhiloxRandom rng_;
+    
+    // Пул источников: 0 — без ограничения
+    size_t source_capacity_;
+    VoiceStealPolicy steal_policy_;
+    size_t peak_sources_;
+    uint64_t rejected_sources_;
+    uint64_t stolen_sources_;
+    
+    // Источники тише порога в точке наблюдения не вычисляются
+    double culling_threshold_;
+    
+    // Октодерево источников: перестраивается лениво при расчете после изменения
+    // набора источников, перемещение внутри листа обновляет его на месте
+    mutable SourceOctree source_tree_;
+    mutable bool tree_dirty_;
+    double tree_error_bound_;       // 0 — без дерева
 
 public:
     InterferenceField(InterferenceFieldType type, SphericalCoord center, double radius);
     
-    // Добавить источник звукового поля
-    void addSourceField(const QuantumSoundField& field);
+    // Добавить источник звукового поля. В заполненном пуле источник,
+    // выбранный политикой, заменяется на месте; false — источник отклонен.
+    bool addSourceField(const QuantumSoundField& field);
+    
+    // Ограничить число источников и выделить под них память заранее. Лишние
+    // источники вытесняются по политике (считаются в stolen); при REJECT
+    // емкость не опускается ниже числа имеющихся источников.
+    void setSourceCapacity(size_t capacity, VoiceStealPolicy policy);
+    PoolStatistics getSourceStatistics() const;
+    
+    // Порог |a|·1/(1 + 0.1·d), ниже которого вклад источника в точке наблюдения
+    // не вычисляется (0 — все источники)
+    void setCullingThreshold(double threshold);
+    double getCullingThreshold() const { return culling_threshold_; }
+    
+    // Источников, начиная с которого работает дерево
+    static constexpr size_t kTreeMinSources = 256;
+    
+    // Ускорение октодеревом (см. SourceOctree) с относительной ошибкой дальних
+    // узлов error_bound; 0 — точный перебор источников
+    void setTreeAcceleration(double error_bound);
+    double getTreeAcceleration() const { return tree_error_bound_; }
+    
+    // Перестроить дерево сейчас (разложения параллельно на pool), а не при первом расчете
+    void rebuildSourceTree(WorkerPool* pool = nullptr);
+    OctreeStatistics getTreeStatistics() const;
     
     // Вычислить результирующую интерференцию в точке
     std::complex<double> calculateInterference(const SphericalCoord& position, double time) const;
     
+    // То же для точки в декартовых координатах (без тригонометрии на точку)
+    std::complex<double> calculateInterference(const Kernels::CartesianPoint<double>& position, double time) const;
+    
+    // Точек в плитке пакетного расчета
+    static constexpr size_t kBatchTile = 256;
+    
+    // Интерференция в observers.count точках (out — столько же значений).
+    // Источники копируются в SoA под одним захватом мьютекса; точки идут плитками
+    // по kBatchTile, каждая плитка проходит все источники в кэше L1 (SIMD по точкам),
+    // плитки делятся между потоками pool. Расчет во float32 с полиномиальным
+    // синусом: ошибка на источник — SamplePrecision<float>::interferenceBound
+    // плюс ε·f·Δt, где Δt — разброс времени внутри плитки. С деревом точки
+    // считаются обходом дерева под мьютексом, плитки так же делятся между потоками.
+    void calculateInterferenceBatch(const ObserverBatch& observers, std::complex<double>* out,
+                                    WorkerPool* pool = nullptr) const;
+    
     // Квантовая суперпозиция полей
     QuantumSoundField quantumSuperposition(const std::vector<QuantumSoundField>& fields) const;
     
     // Обновить поле с учетом квантовых эффектов
     void updateQuantumState(double dt);
     
+    // Seed и поток генератора переходов (воспроизводимые обновления)
+    void setRandomSeed(uint64_t seed, uint64_t stream = 0);
+    
     // Создать квантовую запутанность между полями
     void createQuantumEntanglement(size_t field1_idx, size_t field2_idx);
     
@@ -42,6 +131,12 @@ public:
     double getRadius() const { return field_radius_; }
     size_t getSourceFieldCount() const { return source_fields_.size(); }
     
+    // Копия источников
+    std::vector<QuantumSoundField> getSourceFields() const;
+    
+    // Переместить источник; false — нет такого источника
+    bool moveSourceField(size_t index, const SphericalCoord& position);
+    
     // Удалить источник поля
     void removeSourceField(size_t index);
     
@@ -49,10 +144,80 @@ public:
     void clearSourceFields();
     
 private:
+    // Пересчитать декартову позицию источника index (под field_mutex_)
+    void storeSourcePositionLocked(size_t index);
+    
+    // Источник, который политика steal_policy_ вытесняет первым, и удаление
+    // источника вместе с его позицией (под field_mutex_)
+    size_t stealVictimLocked() const;
+    void eraseSourceLocked(size_t index);
+    
+    // Дерево используется и перестроено при необходимости (под field_mutex_)
+    bool treeReadyLocked(WorkerPool* pool = nullptr) const;
+    
+    // Интерференция в точке наблюдения (под field_mutex_)
+    std::complex<double> interferenceAtLocked(const Kernels::CartesianPoint<double>& point, double time) const;
+    
     // Приватные методы
     double calculateDistance(const SphericalCoord& pos1, const SphericalCoord& pos2) const;
     std::complex<double> calculatePhaseDelay(double distance, double frequency, double time) const;
     std::complex<double> applyInterferenceType(const std::complex<double>& signal, InterferenceFieldType type) const;
 };
 
+// Интерференция поля в неподвижной точке на последовательных отсчетах времени.
+//
+// Вклад источника a·A(d)·e^{i2π(f·t - f·d/c)} в неподвижной точке — фазор,
+// который за отсчет поворачивается на e^{i2πf/fs}. prepare() один раз считает
+// постоянную часть и поворот каждого источника, render() продвигает фазоры
+// комплексным умножением: без тригонометрии на отсчет. Каждые kReanchorFrames
+// отсчетов фазоры пересчитываются точно от абсолютного времени (в double),
+// поэтому дрейф модуля и фазы ограничен ошибкой kReanchorFrames умножений.
+//
+// Источники снимаются в prepare(): изменения поля после него не видны до
+// следующего prepare(). Порог отбора поля действует так же, как в calculateInterference.
+class InterferenceStream {
+public:
+    static constexpr size_t kLanes = 8;                 // источников в шаге, массивы дополняются
+    static constexpr size_t kChunkFrames = 64;          // отсчетов на проход по источникам
+    static constexpr size_t kReanchorFrames = 1024;     // отсчетов между точными пересчетами
+
+private:
+    InterferenceFieldType type_;
+    double sample_rate_;
+    double start_time_;
+    uint64_t position_;                 // отсчетов от start_time_
+    size_t source_count_;
+    
+    // Источники в SoA: частота, постоянная часть вклада, поворот за отсчет, текущий фазор
+    std::vector<double> frequencies_;
+    std::vector<double> constant_re_, constant_im_;
+    std::vector<Sample> rotation_re_, rotation_im_;
+    std::vector<Sample> phasor_re_, phasor_im_;
+    std::vector<Sample> sum_re_, sum_im_;   // kChunkFrames × kLanes частичных сумм
+    
+public:
+    InterferenceStream();
+    
+    // Снять источники field для слушателя в listener, начиная со времени start_time
+    void prepare(const InterferenceField& field, const SphericalCoord& listener, double start_time,
+                 double sample_rate);
+    void prepare(const InterferenceField& field, const Kernels::CartesianPoint<double>& listener,
+                 double start_time, double sample_rate);
+    
+    // Следующие frames отсчетов интерференции (как calculateInterference в моменты
+    // start_time + n/sample_rate)
+    void render(std::complex<double>* out, size_t frames);
+    
+    // Время следующего отсчета
+    double getTime() const { return start_time_ + static_cast<double>(position_) / sample_rate_; }
+    size_t getSourceCount() const { return source_count_; }
+    
+private:
+    // Точные фазоры на текущий отсчет
+    void reanchor();
+    
+    // count ≤ kChunkFrames отсчетов
+    void renderChunk(std::complex<double>* out, size_t count);
+};
+
 } // namespace AnantaDigital
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "multi_venue_engine.hpp"
+#include <chrono>
+#include <ctime>
+
+namespace AnantaDigital {
+
+MultiVenueEngine::MultiVenueEngine(size_t worker_count, bool pin_threads)
+    : pool_(worker_count, pin_threads)
+    , sample_rate_(44100.0)
+    , max_block_frames_(0) {
+}
+
+size_t MultiVenueEngine::addVenue(std::unique_ptr<AnantaDigitalCore> core) {
+    if (!core) return venues_.size();
+
+    venues_.push_back(std::move(core));
+    counters_.push_back(std::make_unique<VenueCounters>());
+
+    if (max_block_frames_ > 0) {
+        venues_.back()->prepareBlockProcessing(sample_rate_, max_block_frames_);
+    }
+    return venues_.size() - 1;
+}
+
+AnantaDigitalCore* MultiVenueEngine::getVenue(size_t index) {
+    return index < venues_.size() ? venues_[index].get() : nullptr;
+}
+
+void MultiVenueEngine::prepare(double sample_rate, size_t max_block_frames) {
+    sample_rate_ = sample_rate;
+    max_block_frames_ = max_block_frames;
+    for (auto& venue : venues_) {
+        venue->prepareBlockProcessing(sample_rate, max_block_frames);
+    }
+    resetStatistics();
+}
+
+void MultiVenueEngine::processBlock(const float* const* inputs, float* const* outputs, size_t frames) {
+    if (!outputs || venues_.empty()) return;
+
+    pool_.run(venues_.size(), [&](size_t venue, size_t worker) {
+        uint64_t start = threadCpuTimeNs();
+        venues_[venue]->processBlock(inputs ? inputs[venue] : nullptr, outputs[venue], frames);
+        uint64_t elapsed = threadCpuTimeNs() - start;
+
+        VenueCounters& counters = *counters_[venue];
+        counters.blocks.fetch_add(1, std::memory_order_relaxed);
+        counters.last_ns.store(elapsed, std::memory_order_relaxed);
+        counters.total_ns.fetch_add(elapsed, std::memory_order_relaxed);
+        if (elapsed > counters.peak_ns.load(std::memory_order_relaxed)) {
+            counters.peak_ns.store(elapsed, std::memory_order_relaxed);
+        }
+        counters.last_worker.store(worker, std::memory_order_relaxed);
+    });
+}
+
+MultiVenueEngine::VenueStatistics MultiVenueEngine::getVenueStatistics(size_t index) const {
+    VenueStatistics stats{};
+    if (index >= venues_.size()) return stats;
+
+    const VenueCounters& counters = *counters_[index];
+    stats.blocks = counters.blocks.load(std::memory_order_relaxed);
+    stats.last_cpu_us = counters.last_ns.load(std::memory_order_relaxed) / 1000.0;
+    stats.peak_cpu_us = counters.peak_ns.load(std::memory_order_relaxed) / 1000.0;
+    stats.average_cpu_us = stats.blocks > 0
+        ? counters.total_ns.load(std::memory_order_relaxed) / 1000.0 / stats.blocks
+        : 0.0;
+    stats.last_worker = counters.last_worker.load(std::memory_order_relaxed);
+    stats.home_worker = pool_.homeWorker(index, venues_.size());
+
+    // Доля длительности блока, занятая куполом
+    if (max_block_frames_ > 0 && sample_rate_ > 0.0) {
+        double block_us = 1e6 * static_cast<double>(max_block_frames_) / sample_rate_;
+        stats.cpu_load = stats.average_cpu_us / block_us;
+    }
+    return stats;
+}
+
+void MultiVenueEngine::resetStatistics() {
+    for (auto& counters : counters_) {
+        counters->blocks.store(0, std::memory_order_relaxed);
+        counters->last_ns.store(0, std::memory_order_relaxed);
+        counters->total_ns.store(0, std::memory_order_relaxed);
+        counters->peak_ns.store(0, std::memory_order_relaxed);
+        counters->last_worker.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t MultiVenueEngine::threadCpuTimeNs() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+} // namespace AnantaDigital
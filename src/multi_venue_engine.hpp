@@ -0,0 +1,71 @@
+#pragma once
+
+#include "anantadigital_core.hpp"
+#include "worker_pool.hpp"
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+namespace AnantaDigital {
+
+// Пакетный движок для нескольких площадок (куполов) в одной стойке.
+// Владеет N экземплярами AnantaDigitalCore и обрабатывает их все за блок
+// на фиксированном пуле потоков: каждый купол по умолчанию закреплен за
+// своим потоком, незанятые потоки крадут работу, блок завершается одним барьером.
+class MultiVenueEngine {
+public:
+    // Статистика одного купола
+    struct VenueStatistics {
+        uint64_t blocks;            // обработано блоков
+        double last_cpu_us;         // процессорное время последнего блока, мкс
+        double average_cpu_us;      // среднее процессорное время блока, мкс
+        double peak_cpu_us;         // максимум процессорного времени блока, мкс
+        double cpu_load;            // доля длительности блока (среднее)
+        size_t last_worker;         // поток, обработавший последний блок
+        size_t home_worker;         // поток по умолчанию (подсказка привязки)
+    };
+
+private:
+    // Счетчики пишет рабочий поток, читают любые потоки; у каждого купола
+    // свой блок в куче, поэтому добавление купола не трогает чужие счетчики
+    struct alignas(64) VenueCounters {
+        std::atomic<uint64_t> blocks{0};
+        std::atomic<uint64_t> last_ns{0};
+        std::atomic<uint64_t> total_ns{0};
+        std::atomic<uint64_t> peak_ns{0};
+        std::atomic<size_t> last_worker{0};
+    };
+
+    std::vector<std::unique_ptr<AnantaDigitalCore>> venues_;
+    std::vector<std::unique_ptr<VenueCounters>> counters_;
+    WorkerPool pool_;
+    double sample_rate_;
+    size_t max_block_frames_;
+
+public:
+    // worker_count — размер пула (0 — по числу ядер), pin_threads — привязка потоков к ядрам
+    explicit MultiVenueEngine(size_t worker_count = 0, bool pin_threads = true);
+
+    // Добавить купол (вне аудио-потока); возвращает индекс
+    size_t addVenue(std::unique_ptr<AnantaDigitalCore> core);
+    size_t getVenueCount() const { return venues_.size(); }
+    AnantaDigitalCore* getVenue(size_t index);
+
+    // Подготовить все купола к блочной обработке
+    void prepare(double sample_rate, size_t max_block_frames);
+
+    // Обработать блок всех куполов: inputs[i]/outputs[i] — буферы купола i
+    // (inputs может быть nullptr). Без выделения памяти.
+    void processBlock(const float* const* inputs, float* const* outputs, size_t frames);
+
+    VenueStatistics getVenueStatistics(size_t index) const;
+    void resetStatistics();
+
+    size_t getWorkerCount() const { return pool_.getWorkerCount(); }
+
+private:
+    static uint64_t threadCpuTimeNs();
+};
+
+} // namespace AnantaDigital
@@ -0,0 +1,109 @@
+#include "offline_renderer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace AnantaDigital {
+
+namespace {
+
+size_t roundUpToHop(size_t frames) {
+    return (frames + OfflineRenderer::kHopFrames - 1) / OfflineRenderer::kHopFrames * OfflineRenderer::kHopFrames;
+}
+
+} // namespace
+
+OfflineRenderer::OfflineRenderer(CoreFactory factory, size_t worker_count)
+    : factory_(std::move(factory))
+    , pool_(worker_count, false) {
+    setSettings(OfflineRenderSettings{});
+}
+
+void OfflineRenderer::setSettings(const OfflineRenderSettings& settings) {
+    settings_ = settings;
+    if (!(settings_.sample_rate > 0.0)) settings_.sample_rate = 48000.0;
+    settings_.chunk_frames = roundUpToHop(std::max<size_t>(1, settings_.chunk_frames));
+    settings_.warmup_frames = roundUpToHop(settings_.warmup_frames);
+}
+
+OfflineRenderReport OfflineRenderer::render(const std::vector<float>& input, std::vector<float>& output) {
+    output.resize(input.size());
+    return render(input.data(), output.data(), input.size());
+}
+
+OfflineRenderReport OfflineRenderer::render(const float* in, float* out, size_t frames) {
+    OfflineRenderReport report;
+    report.workers = pool_.getWorkerCount();
+    if (!out || frames == 0) return report;
+
+    // Границы фрагментов лежат на сетке шагов, как у последовательной обработки
+    const size_t chunk_frames = settings_.chunk_frames;
+    const size_t chunks = (frames + chunk_frames - 1) / chunk_frames;
+
+    std::vector<size_t> processed(chunks, 0);
+    std::vector<size_t> advanced(chunks, 0);
+    const auto start = std::chrono::steady_clock::now();
+
+    pool_.run(chunks, [&](size_t chunk, size_t) {
+        const size_t emit_begin = chunk * chunk_frames;
+        const size_t emit_end = std::min(frames, emit_begin + chunk_frames);
+        const size_t begin = emit_begin - std::min(settings_.warmup_frames, emit_begin);
+        renderChunk(in, begin, emit_begin, emit_end, out);
+        processed[chunk] = emit_end - begin;
+        advanced[chunk] = begin;
+    });
+
+    report.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report.frames = frames;
+    report.chunks = chunks;
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        report.processed_frames += processed[chunk];
+        report.advanced_frames += advanced[chunk];
+    }
+    report.audio_seconds = static_cast<double>(frames) / settings_.sample_rate;
+    report.real_time_factor = report.wall_seconds > 0.0 ? report.audio_seconds / report.wall_seconds : 0.0;
+    return report;
+}
+
+void OfflineRenderer::renderChunk(const float* in, size_t begin, size_t emit_begin, size_t emit_end,
+                                  float* out) const {
+    std::unique_ptr<AnantaDigitalCore> core = factory_ ? factory_() : nullptr;
+    if (!core) {
+        std::fill(out + emit_begin, out + emit_end, 0.0f);
+        return;
+    }
+
+    core->setRandomSeed(settings_.seed);
+    core->initialize();
+    core->prepareBlockProcessing(settings_.sample_rate, kHopFrames);
+    core->setStreamSampleRates(0.0, 0.0);
+
+    std::vector<double> hop_input(kHopFrames);
+    std::vector<float> hop_output(kHopFrames);
+
+    for (size_t position = 0; position < emit_end; position += kHopFrames) {
+        const size_t count = std::min(kHopFrames, emit_end - position);
+        hop_input.resize(count);
+        for (size_t t = 0; t < count; ++t) {
+            hop_input[t] = in ? in[position + t] : 0.0;
+        }
+
+        core->processInterferenceField(hop_input);
+        core->processDomeResonance();
+
+        // До разгона ядро только догоняет состояние последовательной обработки
+        if (position < begin) {
+            core->advanceOutput(count);
+            continue;
+        }
+        core->generateOutput(hop_output.data(), count);
+
+        // Выход разгона отбрасывается
+        for (size_t t = 0; t < count; ++t) {
+            const size_t frame = position + t;
+            if (frame >= emit_begin) out[frame] = hop_output[t];
+        }
+    }
+}
+
+} // namespace AnantaDigital
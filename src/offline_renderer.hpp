@@ -0,0 +1,79 @@
+#pragma once
+
+#include "anantadigital_core.hpp"
+#include "worker_pool.hpp"
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+namespace AnantaDigital {
+
+// Параметры офлайн-рендера
+struct OfflineRenderSettings {
+    double sample_rate = 48000.0;       // частота входа и выхода (частота обработки ядра)
+    size_t chunk_frames = 1 << 19;      // длина фрагмента (округляется до kHopFrames)
+    size_t warmup_frames = 8192;        // синтез перед фрагментом (округляется до kHopFrames)
+    uint64_t seed = PhiloxRandom::kDefaultSeed;
+};
+
+// Итог офлайн-рендера
+struct OfflineRenderReport {
+    size_t frames = 0;                  // выходных отсчетов
+    size_t chunks = 0;
+    size_t workers = 0;
+    size_t processed_frames = 0;        // синтезировано, с учетом разгона
+    size_t advanced_frames = 0;         // пройдено без синтеза до начала фрагментов
+    double audio_seconds = 0.0;
+    double wall_seconds = 0.0;
+    double real_time_factor = 0.0;      // длительность звука / время рендера
+};
+
+// Офлайн-рендер быстрее реального времени: вход делится на фрагменты,
+// каждый обрабатывается своим экземпляром AnantaDigitalCore на пуле потоков.
+//
+// Ядро обрабатывает вход шагами по kHopFrames, как последовательные вызовы
+// processAudioSignal(): анализ STFT, резонанс купола, синтез kHopFrames отсчетов.
+// Фаза голоса зависит от всей истории его частоты, поэтому ядро фрагмента
+// проходит вход с нулевого отсчета: до начала разгона — анализ, поля и фазы
+// без синтеза (advanceOutput()), за warmup_frames до границы — с синтезом,
+// выход разгона отбрасывается. Все ядра получают один seed, обратная связь
+// идет по часам отсчетов, поэтому к границе фрагмента ядро приходит в том же
+// состоянии, что и последовательная обработка: фрагменты стыкуются встык и
+// совпадают с ней отсчет в отсчет, при любом числе потоков и скорости машины.
+//
+// Исключения: путь синтеза БПФ (setSpectralSynthesisThreshold) заполняет
+// перекрытие заново после разгона, а бюджет CPU голосов зависит от времени
+// синтеза — с ними результат воспроизводим лишь приблизительно.
+class OfflineRenderer {
+public:
+    static constexpr size_t kHopFrames = 1024;
+
+    // Создает и настраивает ядро фрагмента. initialize() вызывает рендерер
+    // после setRandomSeed(), чтобы seed получили все подсистемы.
+    using CoreFactory = std::function<std::unique_ptr<AnantaDigitalCore>()>;
+
+private:
+    CoreFactory factory_;
+    OfflineRenderSettings settings_;
+    WorkerPool pool_;
+
+public:
+    // worker_count — размер пула (0 — по числу ядер)
+    explicit OfflineRenderer(CoreFactory factory, size_t worker_count = 0);
+
+    void setSettings(const OfflineRenderSettings& settings);
+    const OfflineRenderSettings& getSettings() const { return settings_; }
+    size_t getWorkerCount() const { return pool_.getWorkerCount(); }
+
+    // Обработать frames отсчетов in (nullptr — тишина) в out (frames отсчетов)
+    OfflineRenderReport render(const float* in, float* out, size_t frames);
+    OfflineRenderReport render(const std::vector<float>& input, std::vector<float>& output);
+
+private:
+    // Ядро проходит отсчеты [0, emit_end): до begin без синтеза, с begin
+    // с синтезом; выход с позиции emit_begin пишется в out
+    void renderChunk(const float* in, size_t begin, size_t emit_begin, size_t emit_end, float* out) const;
+};
+
+} // namespace AnantaDigital
@@ -0,0 +1,467 @@
+#include "oscillator_bank.hpp"
+#include "sin_cycles.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaDigital {
+
+namespace {
+
+using namespace Kernels;
+
+// Фазы переякориваются каждые kChunkFrames отсчетов, чтобы ошибка float не накапливалась
+constexpr size_t kChunkFrames = 64;
+// Осцилляторы обрабатываются плитками, которые помещаются в кэш L1
+constexpr size_t kTileOscillators = 512;
+
+size_t roundUpToLanes(size_t count) {
+    return (count + OscillatorBank::kLaneWidth - 1) / OscillatorBank::kLaneWidth * OscillatorBank::kLaneWidth;
+}
+
+#if defined(__AVX2__)
+
+inline float horizontalSum(__m256 v) {
+    __m128 low = _mm256_castps256_ps128(v);
+    __m128 high = _mm256_extractf128_ps(v, 1);
+    __m128 sum = _mm_add_ps(low, high);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55));
+    return _mm_cvtss_f32(sum);
+}
+
+// Сумма amp·sin(2π(phase + offset·inc)) по count осцилляторам (count кратно 8)
+float mixSample(const float* phases, const float* increments, const float* amplitudes,
+                size_t count, float offset) {
+    const __m256 offset_v = _mm256_set1_ps(offset);
+    __m256 acc = _mm256_setzero_ps();
+    for (size_t k = 0; k < count; k += 8) {
+        __m256 x = _mm256_fmadd_ps(offset_v, _mm256_loadu_ps(increments + k), _mm256_loadu_ps(phases + k));
+        acc = _mm256_fmadd_ps(_mm256_loadu_ps(amplitudes + k), sinCyclesAvx2(x), acc);
+    }
+    return horizontalSum(acc);
+}
+
+// То же с рампами амплитуд: после отсчета amp ← clamp(amp·mul + bias, low, high)
+float mixSampleRamped(const float* phases, const float* increments, float* amplitudes,
+                      const float* multipliers, const float* biases, const float* lows, const float* highs,
+                      size_t count, float offset) {
+    const __m256 offset_v = _mm256_set1_ps(offset);
+    __m256 acc = _mm256_setzero_ps();
+    for (size_t k = 0; k < count; k += 8) {
+        __m256 x = _mm256_fmadd_ps(offset_v, _mm256_loadu_ps(increments + k), _mm256_loadu_ps(phases + k));
+        __m256 amplitude = _mm256_loadu_ps(amplitudes + k);
+        acc = _mm256_fmadd_ps(amplitude, sinCyclesAvx2(x), acc);
+        amplitude = _mm256_fmadd_ps(amplitude, _mm256_loadu_ps(multipliers + k), _mm256_loadu_ps(biases + k));
+        amplitude = _mm256_min_ps(_mm256_max_ps(amplitude, _mm256_loadu_ps(lows + k)), _mm256_loadu_ps(highs + k));
+        _mm256_storeu_ps(amplitudes + k, amplitude);
+    }
+    return horizontalSum(acc);
+}
+
+// Сигнал одного осциллятора с амплитудой по отсчетам: out[i] = amps[i]·sin(2π(phase + i·inc))
+void renderSingleScaled(float* out, float phase, float increment, const float* amplitudes, size_t frames) {
+    const __m256 lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 phase_v = _mm256_set1_ps(phase);
+    const __m256 increment_v = _mm256_set1_ps(increment);
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        __m256 offset = _mm256_add_ps(lane, _mm256_set1_ps(static_cast<float>(i)));
+        __m256 x = _mm256_fmadd_ps(offset, increment_v, phase_v);
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(amplitudes + i), sinCyclesAvx2(x)));
+    }
+    for (; i < frames; ++i) {
+        out[i] = amplitudes[i] * sinCycles(phase + static_cast<float>(i) * increment);
+    }
+}
+
+// Сигнал одного осциллятора: out[i] = amp·sin(2π(phase + i·inc)), i < frames
+void renderSingle(float* out, float phase, float increment, float amplitude, size_t frames) {
+    const __m256 lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 phase_v = _mm256_set1_ps(phase);
+    const __m256 increment_v = _mm256_set1_ps(increment);
+    const __m256 amplitude_v = _mm256_set1_ps(amplitude);
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        __m256 offset = _mm256_add_ps(lane, _mm256_set1_ps(static_cast<float>(i)));
+        __m256 x = _mm256_fmadd_ps(offset, increment_v, phase_v);
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(amplitude_v, sinCyclesAvx2(x)));
+    }
+    for (; i < frames; ++i) {
+        out[i] = amplitude * sinCycles(phase + static_cast<float>(i) * increment);
+    }
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+float mixSample(const float* phases, const float* increments, const float* amplitudes,
+                size_t count, float offset) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (size_t k = 0; k < count; k += 8) {
+        float32x4_t x0 = vfmaq_n_f32(vld1q_f32(phases + k), vld1q_f32(increments + k), offset);
+        float32x4_t x1 = vfmaq_n_f32(vld1q_f32(phases + k + 4), vld1q_f32(increments + k + 4), offset);
+        acc0 = vfmaq_f32(acc0, vld1q_f32(amplitudes + k), sinCyclesNeon(x0));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(amplitudes + k + 4), sinCyclesNeon(x1));
+    }
+    return vaddvq_f32(vaddq_f32(acc0, acc1));
+}
+
+float mixSampleRamped(const float* phases, const float* increments, float* amplitudes,
+                      const float* multipliers, const float* biases, const float* lows, const float* highs,
+                      size_t count, float offset) {
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (size_t k = 0; k < count; k += 4) {
+        float32x4_t x = vfmaq_n_f32(vld1q_f32(phases + k), vld1q_f32(increments + k), offset);
+        float32x4_t amplitude = vld1q_f32(amplitudes + k);
+        acc = vfmaq_f32(acc, amplitude, sinCyclesNeon(x));
+        amplitude = vfmaq_f32(vld1q_f32(biases + k), amplitude, vld1q_f32(multipliers + k));
+        amplitude = vminq_f32(vmaxq_f32(amplitude, vld1q_f32(lows + k)), vld1q_f32(highs + k));
+        vst1q_f32(amplitudes + k, amplitude);
+    }
+    return vaddvq_f32(acc);
+}
+
+void renderSingleScaled(float* out, float phase, float increment, const float* amplitudes, size_t frames) {
+    const float lanes[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    const float32x4_t lane = vld1q_f32(lanes);
+    const float32x4_t phase_v = vdupq_n_f32(phase);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        float32x4_t offset = vaddq_f32(lane, vdupq_n_f32(static_cast<float>(i)));
+        float32x4_t x = vfmaq_n_f32(phase_v, offset, increment);
+        vst1q_f32(out + i, vmulq_f32(sinCyclesNeon(x), vld1q_f32(amplitudes + i)));
+    }
+    for (; i < frames; ++i) {
+        out[i] = amplitudes[i] * sinCycles(phase + static_cast<float>(i) * increment);
+    }
+}
+
+void renderSingle(float* out, float phase, float increment, float amplitude, size_t frames) {
+    const float lanes[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    const float32x4_t lane = vld1q_f32(lanes);
+    const float32x4_t phase_v = vdupq_n_f32(phase);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        float32x4_t offset = vaddq_f32(lane, vdupq_n_f32(static_cast<float>(i)));
+        float32x4_t x = vfmaq_n_f32(phase_v, offset, increment);
+        vst1q_f32(out + i, vmulq_n_f32(sinCyclesNeon(x), amplitude));
+    }
+    for (; i < frames; ++i) {
+        out[i] = amplitude * sinCycles(phase + static_cast<float>(i) * increment);
+    }
+}
+
+#else
+
+float mixSample(const float* phases, const float* increments, const float* amplitudes,
+                size_t count, float offset) {
+    float acc = 0.0f;
+    for (size_t k = 0; k < count; ++k) {
+        acc += amplitudes[k] * sinCycles(phases[k] + offset * increments[k]);
+    }
+    return acc;
+}
+
+float mixSampleRamped(const float* phases, const float* increments, float* amplitudes,
+                      const float* multipliers, const float* biases, const float* lows, const float* highs,
+                      size_t count, float offset) {
+    float acc = 0.0f;
+    for (size_t k = 0; k < count; ++k) {
+        acc += amplitudes[k] * sinCycles(phases[k] + offset * increments[k]);
+        amplitudes[k] = std::min(std::max(amplitudes[k] * multipliers[k] + biases[k], lows[k]), highs[k]);
+    }
+    return acc;
+}
+
+void renderSingleScaled(float* out, float phase, float increment, const float* amplitudes, size_t frames) {
+    for (size_t i = 0; i < frames; ++i) {
+        out[i] = amplitudes[i] * sinCycles(phase + static_cast<float>(i) * increment);
+    }
+}
+
+void renderSingle(float* out, float phase, float increment, float amplitude, size_t frames) {
+    for (size_t i = 0; i < frames; ++i) {
+        out[i] = amplitude * sinCycles(phase + static_cast<float>(i) * increment);
+    }
+}
+
+#endif
+
+} // namespace
+
+OscillatorBank::OscillatorBank(double sample_rate)
+    : ramping_(0)
+    , size_(0)
+    , sample_rate_(sample_rate > 0.0 ? sample_rate : 44100.0) {
+}
+
+void OscillatorBank::reserve(size_t capacity) {
+    size_t padded = roundUpToLanes(capacity);
+    if (padded <= frequencies_.size()) return;
+
+    // Хвост заполняется нулями: нулевая амплитуда не влияет на сумму
+    frequencies_.resize(padded, 0.0f);
+    increments_.resize(padded, 0.0f);
+    phases_.resize(padded, 0.0f);
+    amplitudes_.resize(padded, 0.0f);
+    
+    const ParameterRamp hold = ParameterRamp::hold(0.0f);
+    ramp_targets_.resize(padded, hold.target);
+    ramp_multipliers_.resize(padded, hold.multiplier);
+    ramp_biases_.resize(padded, hold.bias);
+    ramp_lows_.resize(padded, hold.low);
+    ramp_highs_.resize(padded, hold.high);
+    ramp_remaining_.resize(padded, 0);
+}
+
+void OscillatorBank::setSampleRate(double sample_rate) {
+    if (sample_rate <= 0.0) return;
+    sample_rate_ = sample_rate;
+    for (size_t k = 0; k < size_; ++k) {
+        increments_[k] = static_cast<float>(frequencies_[k] / sample_rate_);
+    }
+}
+
+size_t OscillatorBank::addOscillator(double frequency, double amplitude, double phase) {
+    if (size_ >= capacity()) {
+        reserve(std::max<size_t>(kLaneWidth, capacity() * 2));
+    }
+
+    size_t index = size_++;
+    setFrequency(index, frequency);
+    setAmplitude(index, amplitude);
+    setPhase(index, phase);
+    return index;
+}
+
+void OscillatorBank::removeOscillator(size_t index) {
+    if (index >= size_) return;
+
+    if (ramp_remaining_[index] > 0) --ramping_;
+
+    size_t last = --size_;
+    if (index != last) {
+        frequencies_[index] = frequencies_[last];
+        increments_[index] = increments_[last];
+        phases_[index] = phases_[last];
+        amplitudes_[index] = amplitudes_[last];
+        storeRamp(index, loadRamp(last));
+    }
+
+    frequencies_[last] = 0.0f;
+    increments_[last] = 0.0f;
+    phases_[last] = 0.0f;
+    amplitudes_[last] = 0.0f;
+    storeRamp(last, ParameterRamp::hold(0.0f));
+}
+
+void OscillatorBank::clear() {
+    std::fill(frequencies_.begin(), frequencies_.end(), 0.0f);
+    std::fill(increments_.begin(), increments_.end(), 0.0f);
+    std::fill(phases_.begin(), phases_.end(), 0.0f);
+    std::fill(amplitudes_.begin(), amplitudes_.end(), 0.0f);
+    for (size_t k = 0; k < ramp_targets_.size(); ++k) {
+        storeRamp(k, ParameterRamp::hold(0.0f));
+    }
+    ramping_ = 0;
+    size_ = 0;
+}
+
+void OscillatorBank::setFrequency(size_t index, double frequency) {
+    if (index >= size_) return;
+    frequencies_[index] = static_cast<float>(frequency);
+    increments_[index] = static_cast<float>(frequency / sample_rate_);
+}
+
+void OscillatorBank::setAmplitude(size_t index, double amplitude) {
+    if (index >= size_) return;
+    if (ramp_remaining_[index] > 0) --ramping_;
+    amplitudes_[index] = static_cast<float>(amplitude);
+    storeRamp(index, ParameterRamp::hold(amplitudes_[index]));
+}
+
+void OscillatorBank::setAmplitudeTarget(size_t index, double amplitude, double frames, RampShape shape) {
+    if (index >= size_) return;
+    const float target = static_cast<float>(amplitude);
+    if (target == ramp_targets_[index] && (ramp_remaining_[index] > 0 || amplitudes_[index] == target)) return;
+
+    if (ramp_remaining_[index] > 0) --ramping_;
+    ParameterRamp ramp = ParameterRamp::plan(amplitudes_[index], target, frames, shape);
+    if (!ramp.active()) amplitudes_[index] = target;
+    storeRamp(index, ramp);
+    if (ramp.active()) ++ramping_;
+}
+
+void OscillatorBank::setAmplitudeRamp(size_t index, const ParameterRamp& ramp) {
+    if (index >= size_) return;
+    if (ramp_remaining_[index] > 0) --ramping_;
+    if (!ramp.active()) amplitudes_[index] = ramp.target;
+    storeRamp(index, ramp);
+    if (ramp.active()) ++ramping_;
+}
+
+void OscillatorBank::storeRamp(size_t index, const ParameterRamp& ramp) {
+    ramp_targets_[index] = ramp.target;
+    ramp_multipliers_[index] = ramp.multiplier;
+    ramp_biases_[index] = ramp.bias;
+    ramp_lows_[index] = ramp.low;
+    ramp_highs_[index] = ramp.high;
+    ramp_remaining_[index] = ramp.remaining;
+}
+
+ParameterRamp OscillatorBank::loadRamp(size_t index) const {
+    ParameterRamp ramp;
+    ramp.target = ramp_targets_[index];
+    ramp.multiplier = ramp_multipliers_[index];
+    ramp.bias = ramp_biases_[index];
+    ramp.low = ramp_lows_[index];
+    ramp.high = ramp_highs_[index];
+    ramp.remaining = ramp_remaining_[index];
+    return ramp;
+}
+
+void OscillatorBank::advanceAmplitude(size_t index, float* out, size_t frames) {
+    // Та же рекурсия, что в mixSampleRamped
+    float amplitude = amplitudes_[index];
+    const float multiplier = ramp_multipliers_[index];
+    const float bias = ramp_biases_[index];
+    const float low = ramp_lows_[index];
+    const float high = ramp_highs_[index];
+    for (size_t i = 0; i < frames; ++i) {
+        if (out) out[i] = amplitude;
+        amplitude = std::min(std::max(amplitude * multiplier + bias, low), high);
+    }
+    amplitudes_[index] = amplitude;
+}
+
+void OscillatorBank::finishRamps(size_t first, size_t last, size_t frames) {
+    for (size_t k = first; k < last; ++k) {
+        uint32_t remaining = ramp_remaining_[k];
+        if (remaining == 0) continue;
+        if (remaining <= frames) {
+            // Рампа закончилась внутри блока: значение фиксируется точно на цели
+            amplitudes_[k] = ramp_targets_[k];
+            storeRamp(k, ParameterRamp::hold(ramp_targets_[k]));
+            --ramping_;
+        } else {
+            ramp_remaining_[k] = remaining - static_cast<uint32_t>(frames);
+        }
+    }
+}
+
+void OscillatorBank::setPhase(size_t index, double phase) {
+    if (index >= size_) return;
+    double cycles = phase / (2.0 * M_PI);
+    phases_[index] = static_cast<float>(cycles - std::floor(cycles));
+}
+
+double OscillatorBank::getPhase(size_t index) const {
+    return static_cast<double>(phases_[index]) * 2.0 * M_PI;
+}
+
+void OscillatorBank::render(float* out, size_t frames) {
+    std::fill(out, out + frames, 0.0f);
+    renderAdd(out, frames);
+}
+
+void OscillatorBank::renderAdd(float* out, size_t frames) {
+    if (!out || size_ == 0) return;
+
+    const size_t active = roundUpToLanes(size_);
+
+    for (size_t start = 0; start < frames; start += kChunkFrames) {
+        const size_t chunk = std::min(kChunkFrames, frames - start);
+
+        if (ramping_ == 0) {
+            for (size_t tile = 0; tile < active; tile += kTileOscillators) {
+                const size_t count = std::min(kTileOscillators, active - tile);
+                for (size_t i = 0; i < chunk; ++i) {
+                    out[start + i] += mixSample(phases_.data() + tile, increments_.data() + tile,
+                                                amplitudes_.data() + tile, count, static_cast<float>(i));
+                }
+            }
+        } else {
+            // Амплитуды меняются по отсчетам вместе с синтезом
+            for (size_t tile = 0; tile < active; tile += kTileOscillators) {
+                const size_t count = std::min(kTileOscillators, active - tile);
+                for (size_t i = 0; i < chunk; ++i) {
+                    out[start + i] += mixSampleRamped(phases_.data() + tile, increments_.data() + tile,
+                                                      amplitudes_.data() + tile, ramp_multipliers_.data() + tile,
+                                                      ramp_biases_.data() + tile, ramp_lows_.data() + tile,
+                                                      ramp_highs_.data() + tile, count, static_cast<float>(i));
+                }
+            }
+            finishRamps(0, size_, chunk);
+        }
+
+        // Продвигаем фазы на длину фрагмента и возвращаем их в [0, 1)
+        const float advance = static_cast<float>(chunk);
+        for (size_t k = 0; k < size_; ++k) {
+            float phase = phases_[k] + advance * increments_[k];
+            phases_[k] = phase - std::floor(phase);
+        }
+    }
+}
+
+void OscillatorBank::advance(size_t frames) {
+    for (size_t start = 0; start < frames; start += kChunkFrames) {
+        const size_t chunk = std::min(kChunkFrames, frames - start);
+
+        if (ramping_ > 0) {
+            for (size_t k = 0; k < size_; ++k) {
+                if (ramp_remaining_[k] > 0) advanceAmplitude(k, nullptr, chunk);
+            }
+            finishRamps(0, size_, chunk);
+        }
+
+        const float advance = static_cast<float>(chunk);
+        for (size_t k = 0; k < size_; ++k) {
+            float phase = phases_[k] + advance * increments_[k];
+            phases_[k] = phase - std::floor(phase);
+        }
+    }
+}
+
+void OscillatorBank::renderEach(float* out, size_t stride, size_t count, size_t frames) {
+    if (!out) return;
+    count = std::min(count, size_);
+
+    // Осцилляторы независимы: остальные продвигаются так же, как попавшие в out
+    renderRange(out, stride, 0, count, frames);
+    renderRange(nullptr, 0, count, size_ - count, frames);
+}
+
+void OscillatorBank::renderRange(float* out, size_t stride, size_t first, size_t count, size_t frames) {
+    if (first >= size_) return;
+    const size_t last = first + std::min(count, size_ - first);
+
+    for (size_t start = 0; start < frames; start += kChunkFrames) {
+        const size_t chunk = std::min(kChunkFrames, frames - start);
+
+        if (out) {
+            for (size_t k = first; k < last; ++k) {
+                float* signal = out + (k - first) * stride + start;
+                if (ramp_remaining_[k] > 0) {
+                    float amplitudes[kChunkFrames];
+                    advanceAmplitude(k, amplitudes, chunk);
+                    renderSingleScaled(signal, phases_[k], increments_[k], amplitudes, chunk);
+                } else {
+                    renderSingle(signal, phases_[k], increments_[k], amplitudes_[k], chunk);
+                }
+            }
+        } else if (ramping_ > 0) {
+            for (size_t k = first; k < last; ++k) {
+                if (ramp_remaining_[k] > 0) advanceAmplitude(k, nullptr, chunk);
+            }
+        }
+        if (ramping_ > 0) finishRamps(first, last, chunk);
+
+        const float advance = static_cast<float>(chunk);
+        for (size_t k = first; k < last; ++k) {
+            float phase = phases_[k] + advance * increments_[k];
+            phases_[k] = phase - std::floor(phase);
+        }
+    }
+}
+
+} // namespace AnantaDigital
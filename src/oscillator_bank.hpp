@@ -0,0 +1,116 @@
+#pragma once
+
+#include "parameter_ramp.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Банк синусоидальных осцилляторов в виде структуры массивов (SoA).
+// Фаза хранится в циклах [0, 1) и продолжается между блоками,
+// поэтому на границах блоков не возникает щелчков.
+// Синтез выполняется ядрами AVX2/NEON (со скалярным запасным вариантом).
+//
+// Амплитуды можно менять плавно (setAmplitudeTarget): переход идет по отсчетам
+// внутри блока любой длины, рекурсия рампы считается в том же SIMD-цикле,
+// что и синтез. Пока рамп нет, используется обычный путь без лишних загрузок.
+class OscillatorBank {
+public:
+    // Ширина SIMD-регистра в отсчетах float; массивы дополняются до кратной длины
+    static constexpr size_t kLaneWidth = 8;
+
+private:
+    std::vector<float> frequencies_;  // частота, Гц
+    std::vector<float> increments_;   // приращение фазы, циклов за отсчет
+    std::vector<float> phases_;       // текущая фаза, циклы
+    std::vector<float> amplitudes_;   // амплитуда
+    
+    // Рампы амплитуд (SoA, см. ParameterRamp); неподвижные: множитель 1, смещение 0
+    std::vector<float> ramp_targets_;
+    std::vector<float> ramp_multipliers_;
+    std::vector<float> ramp_biases_;
+    std::vector<float> ramp_lows_;
+    std::vector<float> ramp_highs_;
+    std::vector<uint32_t> ramp_remaining_;
+    size_t ramping_;                  // число осцилляторов с активной рампой
+    
+    size_t size_;
+    double sample_rate_;
+
+public:
+    explicit OscillatorBank(double sample_rate = 44100.0);
+
+    // Предварительное выделение памяти (вызывать вне аудио-потока)
+    void reserve(size_t capacity);
+    size_t capacity() const { return frequencies_.size(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Частота дискретизации; приращения фаз пересчитываются
+    void setSampleRate(double sample_rate);
+    double getSampleRate() const { return sample_rate_; }
+
+    // Добавить осциллятор (фаза в радианах), возвращает индекс.
+    // Если емкость исчерпана, память выделяется заново — в аудио-потоке
+    // следует проверять size() < capacity().
+    size_t addOscillator(double frequency, double amplitude, double phase = 0.0);
+
+    // Удаление переставляет последний осциллятор на место удаленного
+    void removeOscillator(size_t index);
+    void clear();
+
+    // Изменение параметров без разрыва фазы; setAmplitude отменяет рампу
+    void setFrequency(size_t index, double frequency);
+    void setAmplitude(size_t index, double amplitude);
+    void setPhase(size_t index, double phase);
+
+    // Плавный переход амплитуды за frames отсчетов, начиная со следующего отсчета
+    void setAmplitudeTarget(size_t index, double amplitude, double frames, RampShape shape = RampShape::LINEAR);
+    double getAmplitudeTarget(size_t index) const { return ramp_targets_[index]; }
+    bool isRamping() const { return ramping_ > 0; }
+    
+    // Состояние рампы целиком: перенос осциллятора на другой индекс без перезапуска перехода
+    ParameterRamp getAmplitudeRamp(size_t index) const { return loadRamp(index); }
+    void setAmplitudeRamp(size_t index, const ParameterRamp& ramp);
+    size_t getRampingCount() const { return ramping_; }
+
+    // Непрерывные массивы параметров (фаза — в циклах [0, 1))
+    const float* frequencies() const { return frequencies_.data(); }
+    const float* amplitudes() const { return amplitudes_.data(); }
+    const float* phases() const { return phases_.data(); }
+
+    double getFrequency(size_t index) const { return frequencies_[index]; }
+    double getAmplitude(size_t index) const { return amplitudes_[index]; }
+    double getPhase(size_t index) const;
+
+    // Смешать все осцилляторы в out (перезапись) и продвинуть фазы
+    void render(float* out, size_t frames);
+
+    // То же, но с добавлением к содержимому out
+    void renderAdd(float* out, size_t frames);
+
+    // Продвинуть фазы и рампы на frames отсчетов без синтеза (так же, как render)
+    void advance(size_t frames);
+
+    // Раздельные сигналы первых count осцилляторов: осциллятор k пишется
+    // в out + k·stride (frames отсчетов). Фазы продвигаются у всех осцилляторов.
+    void renderEach(float* out, size_t stride, size_t count, size_t frames);
+
+    // Раздельные сигналы осцилляторов [first, first + count): осциллятор k пишется
+    // в out + (k − first)·stride; out == nullptr — только продвинуть. Фазы и рампы
+    // продвигаются только у этих осцилляторов, поэтому банк можно рендерить группами.
+    void renderRange(float* out, size_t stride, size_t first, size_t count, size_t frames);
+
+private:
+    void storeRamp(size_t index, const ParameterRamp& ramp);
+    ParameterRamp loadRamp(size_t index) const;
+
+    // Амплитуда осциллятора index на frames отсчетов вперед (значения — в out, если не nullptr)
+    void advanceAmplitude(size_t index, float* out, size_t frames);
+
+    // Завершение рамп осцилляторов [first, last), закончившихся за последние frames отсчетов
+    void finishRamps(size_t first, size_t last, size_t frames);
+};
+
+} // namespace AnantaDigital
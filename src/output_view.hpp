@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Непрерывный диапазон только для чтения (аналог std::span из C++20)
+template <typename T>
+class ConstSpan {
+private:
+    const T* data_;
+    size_t size_;
+
+public:
+    ConstSpan() : data_(nullptr), size_(0) {}
+    ConstSpan(const T* data, size_t size) : data_(data), size_(size) {}
+
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const T& operator[](size_t index) const { return data_[index]; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+};
+
+// Публикация блоков одним писателем для нескольких читателей без копирования.
+//
+// Писатель заполняет свободный буфер и публикует его атомарной заменой
+// индекса. Читатель закрепляет опубликованный буфер (счетчик читателей)
+// и читает его на месте, пока держит View; писатель никогда не пишет
+// в закрепленный или опубликованный буфер, поэтому разорванных чтений нет.
+// Если все буферы заняты читателями, блок пропускается (droppedCount()).
+template <typename T, size_t BufferCount = 4>
+class PublishedBuffers {
+    static_assert(BufferCount >= 2, "PublishedBuffers needs at least two buffers");
+
+private:
+    struct alignas(64) Slot {
+        std::vector<T> data;
+        uint64_t sequence = 0;
+        mutable std::atomic<uint32_t> readers{0};
+    };
+
+    std::array<Slot, BufferCount> slots_;
+    std::atomic<int> published_;
+    int writing_;
+    std::atomic<uint64_t> sequence_;
+    std::atomic<uint64_t> dropped_;
+
+public:
+    // Закрепленный блок; освобождается в деструкторе
+    class View {
+    private:
+        const Slot* slot_;
+
+    public:
+        View() : slot_(nullptr) {}
+        explicit View(const Slot* slot) : slot_(slot) {}
+        ~View() { release(); }
+
+        View(const View&) = delete;
+        View& operator=(const View&) = delete;
+        View(View&& other) noexcept : slot_(other.slot_) { other.slot_ = nullptr; }
+        View& operator=(View&& other) noexcept {
+            if (this != &other) {
+                release();
+                slot_ = other.slot_;
+                other.slot_ = nullptr;
+            }
+            return *this;
+        }
+
+        bool valid() const { return slot_ != nullptr; }
+        explicit operator bool() const { return valid(); }
+
+        ConstSpan<T> span() const {
+            return slot_ ? ConstSpan<T>(slot_->data.data(), slot_->data.size()) : ConstSpan<T>();
+        }
+        const T* data() const { return slot_ ? slot_->data.data() : nullptr; }
+        size_t size() const { return slot_ ? slot_->data.size() : 0; }
+        const T& operator[](size_t index) const { return slot_->data[index]; }
+        const T* begin() const { return data(); }
+        const T* end() const { return data() + size(); }
+
+        // Номер блока (растет с каждой публикацией)
+        uint64_t sequence() const { return slot_ ? slot_->sequence : 0; }
+
+        void release() {
+            if (slot_) {
+                slot_->readers.fetch_sub(1, std::memory_order_release);
+                slot_ = nullptr;
+            }
+        }
+    };
+
+    PublishedBuffers()
+        : published_(-1)
+        , writing_(-1)
+        , sequence_(0)
+        , dropped_(0) {
+    }
+
+    PublishedBuffers(const PublishedBuffers&) = delete;
+    PublishedBuffers& operator=(const PublishedBuffers&) = delete;
+
+    // Писатель: выделить память под блоки size элементов в свободных буферах
+    void reserve(size_t size) {
+        const int current = published_.load(std::memory_order_seq_cst);
+        for (size_t i = 0; i < BufferCount; ++i) {
+            if (static_cast<int>(i) == current) continue;
+            if (slots_[i].readers.load(std::memory_order_seq_cst) != 0) continue;
+            slots_[i].data.reserve(size);
+        }
+    }
+
+    // Писатель: получить буфер для следующего блока или nullptr, если все заняты.
+    // Память выделяется только при росте size.
+    T* beginWrite(size_t size) {
+        const int current = published_.load(std::memory_order_seq_cst);
+        for (size_t i = 0; i < BufferCount; ++i) {
+            if (static_cast<int>(i) == current) continue;
+            if (slots_[i].readers.load(std::memory_order_seq_cst) != 0) continue;
+            writing_ = static_cast<int>(i);
+            slots_[i].data.resize(size);
+            return slots_[i].data.data();
+        }
+        writing_ = -1;
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // Писатель: опубликовать буфер, полученный в beginWrite()
+    void publish() {
+        if (writing_ < 0) return;
+        slots_[writing_].sequence = sequence_.fetch_add(1, std::memory_order_relaxed) + 1;
+        published_.store(writing_, std::memory_order_seq_cst);
+        writing_ = -1;
+    }
+
+    // Читатель: закрепить последний опубликованный блок (без блокировок и выделений)
+    View acquire() const {
+        for (;;) {
+            const int index = published_.load(std::memory_order_seq_cst);
+            if (index < 0) return View();
+
+            const Slot& slot = slots_[index];
+            slot.readers.fetch_add(1, std::memory_order_seq_cst);
+            // Если писатель успел сменить блок, буфер может переписываться — повторяем
+            if (published_.load(std::memory_order_seq_cst) == index) {
+                return View(&slot);
+            }
+            slot.readers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    uint64_t publishedCount() const { return sequence_.load(std::memory_order_relaxed); }
+    uint64_t droppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+};
+
+// Поток отсчетов от одного писателя к одному читателю без блокировок (SPSC).
+// Емкость — степень двойки; reset() вызывается, пока ни писатель, ни читатель
+// не работают. Не поместившиеся отсчеты писатель отбрасывает (droppedCount()).
+template <typename T>
+class SampleRing {
+private:
+    std::vector<T> data_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_;  // пишет писатель
+    alignas(64) std::atomic<size_t> tail_;  // пишет читатель
+    std::atomic<uint64_t> dropped_;
+
+public:
+    SampleRing()
+        : mask_(0)
+        , head_(0)
+        , tail_(0)
+        , dropped_(0) {
+    }
+
+    SampleRing(const SampleRing&) = delete;
+    SampleRing& operator=(const SampleRing&) = delete;
+
+    // Емкость не меньше capacity отсчетов; содержимое сбрасывается
+    void reset(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        data_.assign(size, T());
+        mask_ = size - 1;
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return data_.size(); }
+
+    // Писатель: дописать count отсчетов (без выделений памяти); возвращает записанное
+    size_t write(const T* samples, size_t count) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t written = std::min(count, data_.size() - (head - tail));
+        for (size_t i = 0; i < written; ++i) {
+            data_[(head + i) & mask_] = samples[i];
+        }
+        head_.store(head + written, std::memory_order_release);
+        if (written < count) dropped_.fetch_add(count - written, std::memory_order_relaxed);
+        return written;
+    }
+
+    // Читатель: забрать до max_count отсчетов в out; возвращает прочитанное
+    size_t read(T* out, size_t max_count) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t count = std::min(max_count, head - tail);
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = data_[(tail + i) & mask_];
+        }
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t available() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    uint64_t droppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+};
+
+} // namespace AnantaDigital
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+namespace AnantaDigital {
+
+// Форма перехода параметра к новому значению
+enum class RampShape {
+    LINEAR,         // постоянная скорость, ровно за заданное число отсчетов
+    EXPONENTIAL,    // постоянное отношение соседних отсчетов (линейно в дБ)
+    ONE_POLE        // однополюсное сглаживание, постоянная времени — заданное число отсчетов
+};
+
+// Переход параметра как рекурсия на отсчет: v ← clamp(v·multiplier + bias, low, high).
+// Все три формы сводятся к ней, поэтому банк параметров обновляется одним
+// SIMD-выражением без ветвлений. Граница со стороны target не дает проскочить
+// цель; через remaining отсчетов значение становится ровно target.
+struct ParameterRamp {
+    float target = 0.0f;
+    float multiplier = 1.0f;
+    float bias = 0.0f;
+    float low = -std::numeric_limits<float>::infinity();
+    float high = std::numeric_limits<float>::infinity();
+    uint32_t remaining = 0;
+
+    bool active() const { return remaining > 0; }
+
+    // Неподвижный параметр
+    static ParameterRamp hold(float value) {
+        ParameterRamp ramp;
+        ramp.target = value;
+        return ramp;
+    }
+
+    // Переход от current к target за frames отсчетов (для ONE_POLE — постоянная времени)
+    static ParameterRamp plan(float current, float target, double frames, RampShape shape) {
+        if (!(frames >= 1.0) || current == target) return hold(target);
+
+        ParameterRamp ramp;
+        ramp.target = target;
+        if (target > current) {
+            ramp.high = target;
+        } else {
+            ramp.low = target;
+        }
+
+        // Экспоненциальный переход между значениями разного знака невозможен
+        if (shape == RampShape::EXPONENTIAL && !(current * target > 0.0f) &&
+            current != 0.0f && target != 0.0f) {
+            shape = RampShape::LINEAR;
+        }
+
+        switch (shape) {
+            case RampShape::EXPONENTIAL: {
+                // Ноль заменяется уровнем -80 дБ от ненулевого конца. Из нуля
+                // умножение не выводит, поэтому граница со стороны начала
+                // поднимает первый шаг до этого уровня.
+                const float floor_level = 1e-4f * std::max(std::abs(current), std::abs(target));
+                double from = current != 0.0f ? current : std::copysign(floor_level, target);
+                double to = target != 0.0f ? target : std::copysign(floor_level, current);
+                double steps = frames;
+                if (current == 0.0f) {
+                    if (target > 0.0f) {
+                        ramp.low = floor_level;
+                    } else {
+                        ramp.high = -floor_level;
+                    }
+                    steps = std::max(1.0, frames - 1.0);
+                }
+                ramp.multiplier = static_cast<float>(std::pow(to / from, 1.0 / steps));
+                ramp.remaining = static_cast<uint32_t>(std::min(frames, 4294967295.0));
+                break;
+            }
+            case RampShape::ONE_POLE: {
+                // Через ln(10⁴)·τ остаток шага ниже -80 дБ
+                double pole = std::exp(-1.0 / frames);
+                ramp.multiplier = static_cast<float>(pole);
+                ramp.bias = static_cast<float>(target * (1.0 - pole));
+                ramp.remaining = static_cast<uint32_t>(std::min(std::ceil(frames * 9.2103), 4294967295.0));
+                break;
+            }
+            case RampShape::LINEAR:
+            default:
+                ramp.bias = static_cast<float>((static_cast<double>(target) - current) / frames);
+                ramp.remaining = static_cast<uint32_t>(std::min(std::ceil(frames), 4294967295.0));
+                break;
+        }
+        return ramp;
+    }
+
+    // Значение на следующем отсчете
+    float step(float value) const {
+        return std::min(std::max(value * multiplier + bias, low), high);
+    }
+
+    // Значения frames отсчетов, начиная с value (out может быть nullptr).
+    // Возвращает значение после блока; по окончании рампа становится неподвижной.
+    float advance(float value, float* out, size_t frames) {
+        size_t i = 0;
+        for (; i < frames && remaining > 0; ++i) {
+            if (out) out[i] = value;
+            value = --remaining > 0 ? step(value) : target;
+        }
+        if (remaining == 0) {
+            *this = hold(target);
+            value = target;
+            if (out) std::fill(out + i, out + frames, value);
+        }
+        return value;
+    }
+};
+
+} // namespace AnantaDigital
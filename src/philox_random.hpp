@@ -0,0 +1,179 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Счетчиковый генератор Philox4x32-10 (Salmon et al., Random123).
+//
+// Каждый блок из четырех 32-битных слов — чистая функция (ключ, поток, счетчик),
+// поэтому у генератора нет общего состояния: экземпляр принадлежит одному
+// объекту, любой диапазон счетчиков можно вычислить независимо, и результат
+// для заданного seed не зависит от числа потоков и порядка их работы.
+class PhiloxRandom {
+public:
+    using Block = std::array<uint32_t, 4>;
+
+    static constexpr uint64_t kDefaultSeed = 0x414E414E5441ULL;
+
+    explicit PhiloxRandom(uint64_t seed = kDefaultSeed, uint64_t stream = 0)
+        : seed_(seed)
+        , stream_(stream)
+        , counter_(0)
+        , buffer_{}
+        , buffered_(4)
+        , normal_ready_(false)
+        , normal_spare_(0.0) {
+    }
+
+    // Новый seed и поток; счетчик начинается заново
+    void seed(uint64_t seed, uint64_t stream = 0) {
+        seed_ = seed;
+        stream_ = stream;
+        setCounter(0);
+    }
+
+    uint64_t getSeed() const { return seed_; }
+    uint64_t getStream() const { return stream_; }
+
+    // Позиция в последовательности (номер следующего блока)
+    uint64_t getCounter() const { return counter_; }
+    void setCounter(uint64_t counter) {
+        counter_ = counter;
+        buffered_ = 4;
+        normal_ready_ = false;
+    }
+
+    // Блок с номером counter; не меняет состояние генератора
+    Block block(uint64_t counter) const {
+        return generate(counter, stream_, seed_);
+    }
+
+    static Block generate(uint64_t counter, uint64_t stream, uint64_t seed) {
+        uint32_t c0 = static_cast<uint32_t>(counter);
+        uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+        uint32_t c2 = static_cast<uint32_t>(stream);
+        uint32_t c3 = static_cast<uint32_t>(stream >> 32);
+        uint32_t k0 = static_cast<uint32_t>(seed);
+        uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+
+        for (int round = 0; round < 10; ++round) {
+            const uint64_t p0 = static_cast<uint64_t>(kMultiplier0) * c0;
+            const uint64_t p1 = static_cast<uint64_t>(kMultiplier1) * c2;
+            const uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            const uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            c1 = static_cast<uint32_t>(p1);
+            c3 = static_cast<uint32_t>(p0);
+            c0 = n0;
+            c2 = n2;
+            k0 += kWeyl0;
+            k1 += kWeyl1;
+        }
+        return Block{c0, c1, c2, c3};
+    }
+
+    uint32_t nextU32() {
+        if (buffered_ == 4) {
+            buffer_ = block(counter_++);
+            buffered_ = 0;
+        }
+        return buffer_[buffered_++];
+    }
+
+    // Равномерное [0, 1) с 53 битами мантиссы
+    double uniform() {
+        const uint32_t high = nextU32();
+        const uint32_t low = nextU32();
+        return toUniform(high, low);
+    }
+
+    // Нормальное распределение (Бокс — Мюллер, вторая величина сохраняется)
+    double normal(double mean = 0.0, double stddev = 1.0) {
+        if (normal_ready_) {
+            normal_ready_ = false;
+            return mean + stddev * normal_spare_;
+        }
+        double z0, z1;
+        boxMuller(uniform(), uniform(), z0, z1);
+        normal_spare_ = z1;
+        normal_ready_ = true;
+        return mean + stddev * z0;
+    }
+
+    // Пакетная генерация: каждый блок дает две равномерные величины.
+    // Начинается с границы блока, поэтому out[i] зависит только от
+    // счетчика и i — результат совпадает с fillUniformAt() для любой части.
+    void fillUniform(double* out, size_t count) {
+        fillUniformAt(counter_, out, count);
+        counter_ += (count + 1) / 2;
+        buffered_ = 4;
+        normal_ready_ = false;
+    }
+
+    void fillNormal(double* out, size_t count, double mean = 0.0, double stddev = 1.0) {
+        fillNormalAt(counter_, out, count, mean, stddev);
+        counter_ += (count + 1) / 2;
+        buffered_ = 4;
+        normal_ready_ = false;
+    }
+
+    // Без изменения состояния: значения начиная с блока first_counter.
+    // Диапазон можно разбить между потоками: части [0, n) и [n, m)
+    // (n четное) вычисляются вызовами с first_counter и first_counter + n/2.
+    void fillUniformAt(uint64_t first_counter, double* out, size_t count) const {
+        size_t i = 0;
+        for (uint64_t counter = first_counter; i + 1 < count; ++counter, i += 2) {
+            const Block b = block(counter);
+            out[i] = toUniform(b[0], b[1]);
+            out[i + 1] = toUniform(b[2], b[3]);
+        }
+        if (i < count) {
+            const Block b = block(first_counter + i / 2);
+            out[i] = toUniform(b[0], b[1]);
+        }
+    }
+
+    void fillNormalAt(uint64_t first_counter, double* out, size_t count,
+                      double mean = 0.0, double stddev = 1.0) const {
+        size_t i = 0;
+        for (uint64_t counter = first_counter; i < count; ++counter, i += 2) {
+            const Block b = block(counter);
+            double z0, z1;
+            boxMuller(toUniform(b[0], b[1]), toUniform(b[2], b[3]), z0, z1);
+            out[i] = mean + stddev * z0;
+            if (i + 1 < count) out[i + 1] = mean + stddev * z1;
+        }
+    }
+
+private:
+    static constexpr uint32_t kMultiplier0 = 0xD2511F53u;
+    static constexpr uint32_t kMultiplier1 = 0xCD9E8D57u;
+    static constexpr uint32_t kWeyl0 = 0x9E3779B9u;
+    static constexpr uint32_t kWeyl1 = 0xBB67AE85u;
+
+    static double toUniform(uint32_t high, uint32_t low) {
+        const uint64_t bits = (static_cast<uint64_t>(high >> 5) << 26) | (low >> 6);
+        return static_cast<double>(bits) * (1.0 / 9007199254740992.0);
+    }
+
+    static void boxMuller(double u0, double u1, double& z0, double& z1) {
+        // 1 - u0 лежит в (0, 1], логарифм конечен
+        const double radius = std::sqrt(-2.0 * std::log(1.0 - u0));
+        const double angle = 2.0 * M_PI * u1;
+        z0 = radius * std::cos(angle);
+        z1 = radius * std::sin(angle);
+    }
+
+    uint64_t seed_;
+    uint64_t stream_;
+    uint64_t counter_;
+    Block buffer_;
+    size_t buffered_;
+    bool normal_ready_;
+    double normal_spare_;
+};
+
+} // namespace AnantaDigital
@@ -0,0 +1,199 @@
+#include "processing_graph.hpp"
+#include <algorithm>
+#include <unordered_map>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace AnantaDigital {
+
+namespace {
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+} // namespace
+
+ProcessingGraph::ProcessingGraph()
+    : compiled_(false)
+    , pipelined_(false)
+    , block_(0)
+    , depth_(0)
+    , ready_head_(0)
+    , ready_tail_(0)
+    , completed_(0) {
+}
+
+size_t ProcessingGraph::addNode(NodeSpec spec) {
+    Node node;
+    node.spec = std::move(spec);
+    node.predecessors = 0;
+    node.depth = 0;
+    nodes_.push_back(std::move(node));
+    compiled_ = false;
+    return nodes_.size() - 1;
+}
+
+void ProcessingGraph::clear() {
+    nodes_.clear();
+    order_.clear();
+    compiled_ = false;
+    depth_ = 0;
+}
+
+void ProcessingGraph::setPipelined(bool pipelined) {
+    if (pipelined_ == pipelined) return;
+    pipelined_ = pipelined;
+    compiled_ = false;
+}
+
+size_t ProcessingGraph::findNode(const std::string& name) const {
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].spec.name == name) return i;
+    }
+    return nodes_.size();
+}
+
+bool ProcessingGraph::compile() {
+    compiled_ = false;
+    order_.clear();
+    depth_ = 0;
+
+    // Производитель каждого порта
+    std::unordered_map<std::string, uint32_t> producers;
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+        nodes_[i].successors.clear();
+        nodes_[i].predecessors = 0;
+        nodes_[i].depth = 0;
+        for (const auto& port : nodes_[i].spec.outputs) {
+            if (!producers.emplace(port, i).second) return false;
+        }
+    }
+
+    // Ребра внутри блока; конвейерные входы в конвейерном режиме ребер не дают
+    auto connect = [&](uint32_t consumer, const std::string& port) {
+        auto producer = producers.find(port);
+        if (producer == producers.end() || producer->second == consumer) return;
+        auto& successors = nodes_[producer->second].successors;
+        if (std::find(successors.begin(), successors.end(), consumer) != successors.end()) return;
+        successors.push_back(consumer);
+        ++nodes_[consumer].predecessors;
+    };
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+        for (const auto& port : nodes_[i].spec.inputs) connect(i, port);
+        if (!pipelined_) {
+            for (const auto& port : nodes_[i].spec.pipelined_inputs) connect(i, port);
+        }
+    }
+
+    // Алгоритм Кана; при равенстве сохраняется порядок добавления
+    std::vector<uint32_t> remaining(nodes_.size());
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+        remaining[i] = nodes_[i].predecessors;
+        if (remaining[i] == 0) order_.push_back(i);
+    }
+    for (size_t k = 0; k < order_.size(); ++k) {
+        const Node& node = nodes_[order_[k]];
+        depth_ = std::max(depth_, node.depth + 1);
+        for (uint32_t successor : node.successors) {
+            nodes_[successor].depth = std::max(nodes_[successor].depth, node.depth + 1);
+            if (--remaining[successor] == 0) order_.push_back(successor);
+        }
+    }
+    if (order_.size() != nodes_.size()) {
+        order_.clear();
+        depth_ = 0;
+        return false;
+    }
+
+    pending_.reset(new std::atomic<uint32_t>[nodes_.size()]);
+    ready_.reset(new std::atomic<int32_t>[nodes_.size()]);
+    compiled_ = true;
+    return true;
+}
+
+void ProcessingGraph::execute(WorkerPool* pool) {
+    if (!compiled_ && !compile()) return;
+
+    if (!pool || pool->getWorkerCount() == 1 || depth_ == nodes_.size()) {
+        // Цепочка без параллельных ветвей или без пула — по топологическому порядку
+        for (uint32_t node : order_) {
+            runNode(node, 0);
+        }
+    } else {
+        // Очередь готовых узлов: каждый узел попадает в нее ровно один раз за блок
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            pending_[i].store(nodes_[i].predecessors, std::memory_order_relaxed);
+            ready_[i].store(-1, std::memory_order_relaxed);
+        }
+        ready_head_.store(0, std::memory_order_relaxed);
+        ready_tail_.store(0, std::memory_order_relaxed);
+        completed_.store(0, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < nodes_.size(); ++i) {
+            if (nodes_[i].predecessors == 0) {
+                ready_[ready_tail_.fetch_add(1, std::memory_order_relaxed)].store(
+                    static_cast<int32_t>(i), std::memory_order_relaxed);
+            }
+        }
+
+        const size_t workers = std::min(pool->getWorkerCount(), nodes_.size());
+        pool->run(workers, [this](size_t, size_t worker) { workerLoop(worker); });
+    }
+
+    ++block_;
+}
+
+void ProcessingGraph::runNode(uint32_t node, size_t worker) {
+    const NodeSpec& spec = nodes_[node].spec;
+    if (spec.process) {
+        spec.process(GraphContext{block_, worker, pipelined_});
+    }
+}
+
+void ProcessingGraph::workerLoop(size_t worker) {
+    const size_t total = nodes_.size();
+    uint32_t spins = 0;
+
+    while (completed_.load(std::memory_order_acquire) < total) {
+        // Взять следующий готовый узел
+        size_t head = ready_head_.load(std::memory_order_acquire);
+        int32_t node = -1;
+        if (head < ready_tail_.load(std::memory_order_acquire)) {
+            node = ready_[head].load(std::memory_order_acquire);
+            if (node >= 0 && !ready_head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel,
+                                                                std::memory_order_acquire)) {
+                node = -1;
+            }
+        }
+
+        if (node < 0) {
+            if (++spins < 2000) {
+                cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        spins = 0;
+
+        runNode(static_cast<uint32_t>(node), worker);
+
+        // Преемники, у которых готовы все входы, ставятся в очередь
+        for (uint32_t successor : nodes_[node].successors) {
+            if (pending_[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                ready_[ready_tail_.fetch_add(1, std::memory_order_acq_rel)].store(
+                    static_cast<int32_t>(successor), std::memory_order_release);
+            }
+        }
+        completed_.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+} // namespace AnantaDigital
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "worker_pool.hpp"
+#include <vector>
+#include <string>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Контекст выполнения узла в блоке
+struct GraphContext {
+    uint64_t block;         // номер блока
+    size_t worker;          // поток пула, выполняющий узел
+    bool pipelined;         // конвейерный режим
+
+    // Буфер, в который узел пишет выход этого блока
+    size_t writeSlot() const { return static_cast<size_t>(block & 1); }
+
+    // Буфер входа, объявленного конвейерным: в конвейерном режиме — выход
+    // предыдущего блока, иначе — этого
+    size_t readSlot() const { return static_cast<size_t>((pipelined ? block + 1 : block) & 1); }
+};
+
+// Граф обработки блока с объявленными входами и выходами узлов.
+//
+// Порты — имена данных. Узел, читающий порт, выполняется после узла, который
+// его пишет; порты без производителя — внешние входы. compile() упорядочивает
+// узлы топологически, execute() выполняет блок: без пула — в этом порядке,
+// с пулом — динамически, узел запускается, как только готовы его входы, поэтому
+// независимые ветви идут параллельно. Результат от расписания не зависит.
+//
+// Конвейерные входы (pipelined_inputs) в конвейерном режиме читают выход
+// производителя за предыдущий блок: зависимость внутри блока снимается, стадии
+// перекрываются, задержка растет на блок. Данные таких портов хранятся
+// в двух буферах, которые узлы выбирают по GraphContext.
+//
+// После compile() execute() не выделяет память.
+class ProcessingGraph {
+public:
+    using NodeFunction = std::function<void(const GraphContext& context)>;
+
+    struct NodeSpec {
+        std::string name;
+        std::vector<std::string> inputs;
+        std::vector<std::string> pipelined_inputs;
+        std::vector<std::string> outputs;
+        NodeFunction process;
+    };
+
+private:
+    struct Node {
+        NodeSpec spec;
+        std::vector<uint32_t> successors;
+        uint32_t predecessors;
+        uint32_t depth;         // длина самой длинной цепочки предшественников
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> order_;       // топологический порядок
+    bool compiled_;
+    bool pipelined_;
+    uint64_t block_;
+    uint32_t depth_;
+
+    // Состояние динамического расписания (одно выполнение за раз)
+    std::unique_ptr<std::atomic<uint32_t>[]> pending_;
+    std::unique_ptr<std::atomic<int32_t>[]> ready_;
+    std::atomic<size_t> ready_head_;
+    std::atomic<size_t> ready_tail_;
+    std::atomic<size_t> completed_;
+
+public:
+    ProcessingGraph();
+
+    // Добавить узел; возвращает индекс. Граф нужно заново скомпилировать.
+    size_t addNode(NodeSpec spec);
+
+    // Удалить все узлы (номер блока сохраняется — двойные буферы не сбиваются)
+    void clear();
+
+    // Конвейерный режим меняет зависимости, граф компилируется заново
+    void setPipelined(bool pipelined);
+    bool isPipelined() const { return pipelined_; }
+
+    // Топологическая сортировка; false — цикл или порт с двумя производителями
+    bool compile();
+    bool isCompiled() const { return compiled_; }
+
+    // Выполнить блок (pool == nullptr — в вызывающем потоке)
+    void execute(WorkerPool* pool = nullptr);
+
+    size_t getNodeCount() const { return nodes_.size(); }
+    const std::string& getNodeName(size_t index) const { return nodes_[index].spec.name; }
+    const std::vector<uint32_t>& getExecutionOrder() const { return order_; }
+    uint64_t getBlockCount() const { return block_; }
+
+    // Число узлов на самой длинной цепочке зависимостей внутри блока
+    size_t getCriticalPathLength() const { return depth_; }
+
+    // Индекс узла по имени; getNodeCount(), если узла нет
+    size_t findNode(const std::string& name) const;
+
+private:
+    void runNode(uint32_t node, size_t worker);
+    void workerLoop(size_t worker);
+};
+
+} // namespace AnantaDigital
@@ -1,25 +1,23 @@
 #include "quantum_feedback_system.hpp"
+#include "dsp_kernels.hpp"
 #include <algorithm>
 #include <cmath>
-#include <random>
 
 namespace AnantaDigital::Feedback {
 
 QuantumFeedbackSystem::QuantumFeedbackSystem(std::chrono::microseconds delay, double threshold)
     : feedback_delay_(delay)
     , coherence_threshold_(threshold)
-    , last_feedback_(std::chrono::high_resolution_clock::now()) {
+    , last_feedback_(0) {
     feedback_buffer_.reserve(1024); // Предварительное выделение памяти
 }
 
-std::complex<double> QuantumFeedbackSystem::processQuantumSignal(const std::complex<double>& input) {
+std::complex<double> QuantumFeedbackSystem::processQuantumSignal(const std::complex<double>& input,
+                                                                std::chrono::microseconds stream_time) {
     std::lock_guard<std::mutex> lock(feedback_mutex_);
     
-    auto now = std::chrono::high_resolution_clock::now();
-    auto time_since_last = std::chrono::duration_cast<std::chrono::microseconds>(now - last_feedback_);
-    
-    // Проверяем, прошло ли достаточно времени для обратной связи
-    if (time_since_last >= feedback_delay_) {
+    // Проверяем, прошло ли достаточно времени сигнала для обратной связи
+    if (stream_time - last_feedback_ >= feedback_delay_) {
         // Вычисляем сигнал обратной связи
         auto feedback_signal = calculateFeedbackSignal(input);
         
@@ -34,7 +32,7 @@ std::complex<double> QuantumFeedbackSystem::processQuantumSignal(const std::comp
             feedback_buffer_.erase(feedback_buffer_.begin());
         }
         
-        last_feedback_ = now;
+        last_feedback_ = stream_time;
         return corrected_signal;
     }
     
@@ -57,10 +55,15 @@ void QuantumFeedbackSystem::setCoherenceThreshold(double threshold) {
     coherence_threshold_ = std::max(0.0, std::min(1.0, threshold));
 }
 
+void QuantumFeedbackSystem::setRandomSeed(uint64_t seed, uint64_t stream) {
+    std::lock_guard<std::mutex> lock(feedback_mutex_);
+    rng_.seed(seed, stream);
+}
+
 void QuantumFeedbackSystem::reset() {
     std::lock_guard<std::mutex> lock(feedback_mutex_);
     feedback_buffer_.clear();
-    last_feedback_ = std::chrono::high_resolution_clock::now();
+    last_feedback_ = std::chrono::microseconds(0);
 }
 
 bool QuantumFeedbackSystem::isCoherent() const {
@@ -85,11 +88,7 @@ std::complex<double> QuantumFeedbackSystem::calculateFeedbackSignal(const std::c
     double phase = std::arg(input);
     
     // Квантовая неопределенность
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::normal_distribution<double> noise(0.0, 0.1);
-    
-    double quantum_noise = noise(gen);
+    double quantum_noise = rng_.normal(0.0, 0.1);
     
     // Вычисляем обратную связь с учетом квантовых эффектов
     double feedback_amplitude = amplitude * (1.0 + quantum_noise);
@@ -100,23 +99,8 @@ std::complex<double> QuantumFeedbackSystem::calculateFeedbackSignal(const std::c
 
 std::complex<double> QuantumFeedbackSystem::applyQuantumCorrection(const std::complex<double>& input, 
                                                                   const std::complex<double>& feedback) const {
-    // Применяем квантовую коррекцию к входному сигналу
-    
-    double input_amp = std::abs(input);
-    double input_phase = std::arg(input);
-    
-    double feedback_amp = std::abs(feedback);
-    double feedback_phase = std::arg(feedback);
-    
-    // Квантовая коррекция амплитуды
-    double corrected_amp = input_amp * (1.0 - 0.1 * (feedback_amp - input_amp) / input_amp);
-    corrected_amp = std::max(0.0, corrected_amp); // Не может быть отрицательной
-    
-    // Квантовая коррекция фазы
-    double phase_diff = feedback_phase - input_phase;
-    double corrected_phase = input_phase + 0.1 * phase_diff;
-    
-    return std::polar(corrected_amp, corrected_phase);
+    // Применяем квантовую коррекцию к входному сигналу в точности Sample
+    return std::complex<double>(Kernels::quantumCorrection(ComplexSample(input), ComplexSample(feedback)));
 }
 
 double QuantumFeedbackSystem::calculatePhaseVariance() const {
@@ -5,6 +5,7 @@
 #include <chrono>
 #include <functional>
 #include <mutex>
+#include "philox_random.hpp"
 
 namespace AnantaDigital::Feedback {
 
@@ -15,13 +16,20 @@ private:
     double coherence_threshold_;
     std::vector<std::complex<double>> feedback_buffer_;
     mutable std::mutex feedback_mutex_;
-    std::chrono::high_resolution_clock::time_point last_feedback_;
+    std::chrono::microseconds last_feedback_;   // время сигнала последней обратной связи
+    
+    // Квантовый шум обратной связи (под feedback_mutex_)
+    mutable PhiloxRandom rng_;
 
 public:
     QuantumFeedbackSystem(std::chrono::microseconds delay, double threshold);
     
-    // Обработка квантового сигнала
-    std::complex<double> processQuantumSignal(const std::complex<double>& input);
+    // Обработка квантового сигнала. stream_time — время обработанного сигнала
+    // (по часам отсчетов, а не по настенным): обратная связь срабатывает раз в
+    // feedback_delay_ времени сигнала, поэтому при одном seed результат не
+    // зависит от скорости машины и пауз между вызовами
+    std::complex<double> processQuantumSignal(const std::complex<double>& input,
+                                              std::chrono::microseconds stream_time);
     
     // Получение обратной связи
     std::vector<std::complex<double>> getFeedback() const;
@@ -29,6 +37,7 @@ public:
     // Установка параметров
     void setFeedbackDelay(std::chrono::microseconds delay);
     void setCoherenceThreshold(double threshold);
+    void setRandomSeed(uint64_t seed, uint64_t stream = 0);
     
     // Получение параметров
     std::chrono::microseconds getFeedbackDelay() const { return feedback_delay_; }
@@ -0,0 +1,140 @@
+#include "real_fft.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaDigital {
+
+namespace {
+
+// Комплексное умножение без проверок NaN/Inf из std::complex::operator*
+inline std::complex<float> multiply(std::complex<float> a, std::complex<float> b) {
+    return std::complex<float>(a.real() * b.real() - a.imag() * b.imag(),
+                               a.real() * b.imag() + a.imag() * b.real());
+}
+
+} // namespace
+
+RealFFT::RealFFT(size_t size)
+    : size_(4) {
+    while (size_ < size) {
+        size_ <<= 1;
+    }
+
+    const size_t half = size_ / 2;
+
+    twiddles_.resize(half / 2);
+    for (size_t k = 0; k < twiddles_.size(); ++k) {
+        double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(half);
+        twiddles_[k] = std::complex<float>(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+
+    split_.resize(half);
+    for (size_t k = 0; k < half; ++k) {
+        double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(size_);
+        split_[k] = std::complex<float>(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+
+    size_t bits = 0;
+    while ((size_t(1) << bits) < half) {
+        ++bits;
+    }
+    bit_reverse_.resize(half);
+    for (size_t i = 0; i < half; ++i) {
+        uint32_t reversed = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            reversed |= static_cast<uint32_t>((i >> b) & 1u) << (bits - 1 - b);
+        }
+        bit_reverse_[i] = reversed;
+    }
+}
+
+void RealFFT::complexTransform(std::complex<float>* data, bool inverse) const {
+    const size_t count = size_ / 2;
+
+    for (size_t i = 0; i < count; ++i) {
+        size_t j = bit_reverse_[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    // Итеративные бабочки radix-2; обратное преобразование — с сопряженными множителями
+    for (size_t length = 2; length <= count; length <<= 1) {
+        const size_t half = length / 2;
+        const size_t stride = count / length;
+        for (size_t start = 0; start < count; start += length) {
+            for (size_t j = 0; j < half; ++j) {
+                std::complex<float> w = twiddles_[j * stride];
+                if (inverse) {
+                    w = std::conj(w);
+                }
+                std::complex<float> u = data[start + j];
+                std::complex<float> v = multiply(data[start + j + half], w);
+                data[start + j] = u + v;
+                data[start + j + half] = u - v;
+            }
+        }
+    }
+}
+
+void RealFFT::forward(float* data) const {
+    // Четные и нечетные отсчеты — вещественная и мнимая части комплексного сигнала N/2
+    auto* z = reinterpret_cast<std::complex<float>*>(data);
+    complexTransform(z, false);
+
+    const size_t half = size_ / 2;
+    const std::complex<float> z0 = z[0];
+    data[0] = z0.real() + z0.imag();
+    data[1] = z0.real() - z0.imag();
+
+    // Разделение спектра: X[k] = Fe[k] + W^k·Fo[k], X[N/2-k] = conj(Fe[k] - W^k·Fo[k])
+    for (size_t k = 1; k <= half / 2; ++k) {
+        const std::complex<float> a = z[k];
+        const std::complex<float> b = std::conj(z[half - k]);
+        const std::complex<float> even = 0.5f * (a + b);
+        const std::complex<float> diff = 0.5f * (a - b);
+        const std::complex<float> odd(diff.imag(), -diff.real());   // diff / i
+        const std::complex<float> t = multiply(split_[k], odd);
+        z[k] = even + t;
+        if (k != half - k) {
+            z[half - k] = std::conj(even - t);
+        }
+    }
+}
+
+void RealFFT::inverse(float* data) const {
+    auto* z = reinterpret_cast<std::complex<float>*>(data);
+    const size_t half = size_ / 2;
+
+    const float dc = data[0];
+    const float nyquist = data[1];
+    z[0] = std::complex<float>(0.5f * (dc + nyquist), 0.5f * (dc - nyquist));
+
+    // Обратное разделение: Z[k] = Fe[k] + i·Fo[k], Z[N/2-k] = conj(Fe[k] - i·Fo[k])
+    for (size_t k = 1; k <= half / 2; ++k) {
+        const std::complex<float> a = z[k];
+        const std::complex<float> b = std::conj(z[half - k]);
+        const std::complex<float> even = 0.5f * (a + b);
+        const std::complex<float> odd = multiply(0.5f * (a - b), std::conj(split_[k]));
+        const std::complex<float> i_odd(-odd.imag(), odd.real());
+        z[k] = even + i_odd;
+        if (k != half - k) {
+            z[half - k] = std::conj(even - i_odd);
+        }
+    }
+
+    complexTransform(z, true);
+
+    const float scale = 1.0f / static_cast<float>(half);
+    for (size_t i = 0; i < size_; ++i) {
+        data[i] *= scale;
+    }
+}
+
+std::complex<float> RealFFT::bin(const float* packed, size_t k, size_t size) {
+    if (k == 0) return std::complex<float>(packed[0], 0.0f);
+    if (k == size / 2) return std::complex<float>(packed[1], 0.0f);
+    return std::complex<float>(packed[2 * k], packed[2 * k + 1]);
+}
+
+} // namespace AnantaDigital
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Вещественное БПФ размера N (степень двойки) на месте.
+// Вычисляется как комплексное БПФ размера N/2 с последующим разделением
+// спектра; таблицы поворотных множителей и перестановки строятся один раз
+// в конструкторе, forward()/inverse() не выделяют память.
+//
+// Упакованный формат спектра (N чисел float):
+//   data[0] — Re X[0], data[1] — Re X[N/2],
+//   data[2k], data[2k+1] — Re и Im X[k] для k = 1..N/2-1.
+class RealFFT {
+private:
+    size_t size_;                                   // N
+    std::vector<std::complex<float>> twiddles_;     // exp(-2πik/(N/2)), k < N/4
+    std::vector<std::complex<float>> split_;        // exp(-2πik/N), k < N/2
+    std::vector<uint32_t> bit_reverse_;             // перестановка для N/2 точек
+
+public:
+    // size округляется вверх до степени двойки (не меньше 4)
+    explicit RealFFT(size_t size = 1024);
+
+    size_t size() const { return size_; }
+
+    // Прямое преобразование: N отсчетов -> упакованный спектр
+    void forward(float* data) const;
+
+    // Обратное преобразование: упакованный спектр -> N отсчетов.
+    // Нормировано так, что inverse(forward(x)) == x.
+    void inverse(float* data) const;
+
+    // Комплексный отсчет k (0..N/2) из упакованного спектра
+    static std::complex<float> bin(const float* packed, size_t k, size_t size);
+
+private:
+    void complexTransform(std::complex<float>* data, bool inverse) const;
+};
+
+} // namespace AnantaDigital
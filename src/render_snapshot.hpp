@@ -0,0 +1,183 @@
+#pragma once
+
+#include "anantadigital_types.hpp"
+#include "parameter_ramp.hpp"
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Неизменяемый снимок параметров рендера, публикуемый управляющим потоком.
+// Аудио-поток только читает его и никогда не освобождает.
+struct RenderSnapshot {
+    uint64_t version = 0;
+
+    // Голоса (SoA), при включенном отборе — по убыванию уровня; field_ids —
+    // стабильные идентификаторы для сохранения фазы (у скопления — самого громкого поля)
+    std::vector<uint64_t> field_ids;
+    std::vector<double> frequencies;
+    std::vector<double> amplitudes;
+    std::vector<double> phases;
+    std::vector<SphericalCoord> positions;
+
+    // Переход амплитуд к значениям снимка, отсчетов
+    double ramp_frames = 0.0;
+    RampShape ramp_shape = RampShape::LINEAR;
+
+    // Доля длительности блока на синтез; 0 — без бюджета голосов
+    double cpu_budget = 0.0;
+
+    // Геометрия источников для SpeakerRenderer: источник × speaker_stride
+    size_t speaker_stride = 0;
+    std::vector<float> speaker_gains;
+    std::vector<float> speaker_delays;
+
+    // Коэффициенты кодирования источников в шину Ambisonics: источник × hoa_channels
+    size_t hoa_channels = 0;
+    std::vector<float> hoa_gains;
+};
+
+// Обмен снимками в стиле RCU между одним писателем (управляющий поток)
+// и одним читателем (аудио-поток).
+//
+// Писатель публикует новый снимок атомарной заменой указателя. Читатель
+// в начале блока забирает последний опубликованный снимок, а прежний
+// возвращает писателю через очередь без блокировок. Освобождение памяти
+// происходит только в collect(), то есть вне аудио-потока.
+//
+// После preallocate() отработанные снимки не освобождаются, а возвращаются
+// в список свободных писателя: allocate() берет снимок оттуда вместе с уже
+// выделенной памятью его массивов. Без preallocate() снимки освобождаются.
+template <typename T, size_t RetireCapacity = 64>
+class SnapshotExchange {
+private:
+    std::atomic<T*> pending_;     // опубликован, но еще не забран читателем
+    T* current_;                  // принадлежит читателю
+
+    // Очередь SPSC: читатель кладет отработанные снимки, писатель освобождает
+    std::array<T*, RetireCapacity> retired_;
+    std::atomic<size_t> retire_head_;   // пишет читатель
+    std::atomic<size_t> retire_tail_;   // пишет писатель
+
+    // Свободные снимки (принадлежат писателю); емкость задает preallocate()
+    std::vector<T*> free_;
+
+public:
+    SnapshotExchange()
+        : pending_(nullptr)
+        , current_(nullptr)
+        , retired_{}
+        , retire_head_(0)
+        , retire_tail_(0) {
+    }
+
+    ~SnapshotExchange() {
+        collect();
+        delete pending_.exchange(nullptr);
+        delete current_;
+        for (T* snapshot : free_) {
+            delete snapshot;
+        }
+    }
+
+    SnapshotExchange(const SnapshotExchange&) = delete;
+    SnapshotExchange& operator=(const SnapshotExchange&) = delete;
+
+    // Писатель: держать не меньше count свободных снимков; init готовит
+    // каждый свободный снимок (например, резервирует память массивов)
+    template <typename Init>
+    void preallocate(size_t count, Init&& init) {
+        collect();
+        free_.reserve(std::max(count, free_.capacity()));
+        while (free_.size() < count) {
+            free_.push_back(new T());
+        }
+        for (T* snapshot : free_) {
+            init(*snapshot);
+        }
+    }
+
+    // Писатель: снимок для заполнения — свободный, если есть, иначе новый.
+    // Содержимое свободного снимка остается от прежнего использования.
+    T* allocate() {
+        if (free_.empty()) return new T();
+        T* snapshot = free_.back();
+        free_.pop_back();
+        return snapshot;
+    }
+
+    // Писатель: опубликовать снимок (владение передается обмену)
+    void publish(T* snapshot) {
+        T* unread = pending_.exchange(snapshot, std::memory_order_acq_rel);
+        // Снимок, который читатель так и не увидел, возвращается сразу
+        recycle(unread);
+        collect();
+    }
+
+    // Писатель: вернуть снимки, которые читатель больше не использует
+    size_t collect() {
+        size_t freed = 0;
+        size_t tail = retire_tail_.load(std::memory_order_relaxed);
+        const size_t head = retire_head_.load(std::memory_order_acquire);
+        while (tail != head) {
+            recycle(retired_[tail % RetireCapacity]);
+            retired_[tail % RetireCapacity] = nullptr;
+            ++tail;
+            ++freed;
+        }
+        retire_tail_.store(tail, std::memory_order_release);
+        return freed;
+    }
+
+    // Читатель: забрать последний снимок (без блокировок и выделений памяти).
+    // Если очередь возврата переполнена, остается текущий снимок.
+    const T* acquire() {
+        if (pending_.load(std::memory_order_relaxed) == nullptr) {
+            return current_;
+        }
+
+        const size_t head = retire_head_.load(std::memory_order_relaxed);
+        const size_t tail = retire_tail_.load(std::memory_order_acquire);
+        if (current_ && head - tail >= RetireCapacity) {
+            return current_;
+        }
+
+        T* fresh = pending_.exchange(nullptr, std::memory_order_acq_rel);
+        if (fresh) {
+            if (current_) {
+                retired_[head % RetireCapacity] = current_;
+                retire_head_.store(head + 1, std::memory_order_release);
+            }
+            current_ = fresh;
+        }
+        return current_;
+    }
+
+    // Читатель: текущий снимок без проверки новых
+    const T* current() const { return current_; }
+
+    // Число снимков, ожидающих освобождения
+    size_t retiredCount() const {
+        return retire_head_.load(std::memory_order_acquire) - retire_tail_.load(std::memory_order_acquire);
+    }
+
+    // Писатель: свободных снимков сейчас
+    size_t freeCount() const { return free_.size(); }
+
+private:
+    // Список свободных не растет: сверх емкости снимок освобождается
+    void recycle(T* snapshot) {
+        if (!snapshot) return;
+        if (free_.size() < free_.capacity()) {
+            free_.push_back(snapshot);
+        } else {
+            delete snapshot;
+        }
+    }
+};
+
+} // namespace AnantaDigital
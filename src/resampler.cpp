@@ -0,0 +1,315 @@
+#include "resampler.hpp"
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace AnantaDigital {
+
+namespace {
+
+struct QualitySettings {
+    size_t taps;            // отводов на фазу при L >= M
+    double attenuation_db;  // подавление в полосе задерживания
+};
+
+QualitySettings settingsFor(ResamplerQuality quality) {
+    switch (quality) {
+        case ResamplerQuality::FAST: return {24, 60.0};
+        case ResamplerQuality::HIGH: return {128, 120.0};
+        case ResamplerQuality::STANDARD:
+        default: return {64, 96.0};
+    }
+}
+
+// Модифицированная функция Бесселя I0 (ряд)
+double besselI0(double x) {
+    double sum = 1.0, term = 1.0;
+    const double half_sq = 0.25 * x * x;
+    for (int k = 1; k < 64; ++k) {
+        term *= half_sq / (static_cast<double>(k) * k);
+        sum += term;
+        if (term < sum * 1e-17) break;
+    }
+    return sum;
+}
+
+#if defined(__AVX2__)
+
+float dot(const float* a, const float* b, size_t count) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    for (; i < count; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+float dot(const float* a, const float* b, size_t count) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (size_t i = 0; i < count; i += 8) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    return vaddvq_f32(vaddq_f32(acc0, acc1));
+}
+
+#else
+
+float dot(const float* a, const float* b, size_t count) {
+    float acc = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+}
+
+#endif
+
+} // namespace
+
+PolyphaseResampler::PolyphaseResampler()
+    : input_rate_(44100.0)
+    , output_rate_(44100.0)
+    , quality_(ResamplerQuality::STANDARD)
+    , max_input_frames_(0)
+    , fill_(0)
+    , position_(0)
+    , phase_(0) {
+    table_ = filterTable(1, 1, quality_);
+}
+
+void PolyphaseResampler::rationalRatio(double input_rate, double output_rate, uint32_t max_terms,
+                                       uint32_t& interpolation, uint32_t& decimation) {
+    interpolation = decimation = 1;
+    if (!(input_rate > 0.0) || !(output_rate > 0.0) || max_terms == 0) return;
+
+    // Целые частоты сокращаются точно
+    if (input_rate == std::floor(input_rate) && output_rate == std::floor(output_rate) &&
+        input_rate < 4294967296.0 && output_rate < 4294967296.0) {
+        uint64_t a = static_cast<uint64_t>(output_rate);
+        uint64_t b = static_cast<uint64_t>(input_rate);
+        uint64_t x = a, y = b;
+        while (y != 0) {
+            uint64_t r = x % y;
+            x = y;
+            y = r;
+        }
+        if (a / x <= max_terms && b / x <= max_terms) {
+            interpolation = static_cast<uint32_t>(a / x);
+            decimation = static_cast<uint32_t>(b / x);
+            return;
+        }
+    }
+
+    // Иначе — последняя подходящая дробь цепной дроби, умещающаяся в max_terms
+    const double ratio = output_rate / input_rate;
+    double value = ratio;
+    uint64_t h_prev = 1, h = static_cast<uint64_t>(std::floor(value));
+    uint64_t k_prev = 0, k = 1;
+    for (int iteration = 0; iteration < 64; ++iteration) {
+        double fraction = value - std::floor(value);
+        if (fraction < 1e-12) break;
+        value = 1.0 / fraction;
+        uint64_t a = static_cast<uint64_t>(std::floor(value));
+        uint64_t h_next = a * h + h_prev;
+        uint64_t k_next = a * k + k_prev;
+        if (h_next > max_terms || k_next > max_terms) break;
+        h_prev = h;
+        h = h_next;
+        k_prev = k;
+        k = k_next;
+    }
+    interpolation = static_cast<uint32_t>(std::max<uint64_t>(1, std::min<uint64_t>(h, max_terms)));
+    decimation = static_cast<uint32_t>(std::max<uint64_t>(1, k));
+}
+
+std::shared_ptr<const PolyphaseResampler::FilterTable> PolyphaseResampler::filterTable(
+    uint32_t interpolation, uint32_t decimation, ResamplerQuality quality) {
+    interpolation = std::max<uint32_t>(1, interpolation);
+    decimation = std::max<uint32_t>(1, decimation);
+    if (interpolation == decimation) interpolation = decimation = 1;
+
+    // Таблицы живут, пока ими пользуется хотя бы один экземпляр
+    static std::mutex cache_mutex;
+    static std::map<std::tuple<uint32_t, uint32_t, int>, std::weak_ptr<const FilterTable>> cache;
+    const auto key = std::make_tuple(interpolation, decimation, static_cast<int>(quality));
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (auto cached = cache[key].lock()) return cached;
+
+    auto table = std::make_shared<FilterTable>();
+    table->interpolation = interpolation;
+    table->decimation = decimation;
+
+    if (interpolation == 1 && decimation == 1) {
+        table->taps = 1;
+        table->coefficients.assign(1, 1.0f);
+    } else {
+        const QualitySettings settings = settingsFor(quality);
+        const double L = interpolation;
+        const double factor = std::max(1.0, static_cast<double>(decimation) / L);
+
+        // При понижении частоты фильтр удлиняется, чтобы сохранить ширину перехода
+        size_t taps = static_cast<size_t>(std::ceil(settings.taps * factor));
+        taps = std::min<size_t>(1024, taps);
+        // Шаг окна (M/L отсчетов) не должен превышать его длину
+        taps = std::max<size_t>(taps, static_cast<size_t>(std::ceil(factor)) + 1);
+        taps = (taps + 7) & ~static_cast<size_t>(7);
+        const size_t length = taps * interpolation;
+
+        // Переход по Кайзеру заканчивается на частоте Найквиста меньшей из частот
+        const double nyquist = 0.5 / std::max(L, static_cast<double>(decimation));
+        const double transition = (settings.attenuation_db - 8.0) / (14.36 * static_cast<double>(length));
+        const double cutoff = std::max(0.5 * nyquist, nyquist - 0.5 * transition);
+        const double beta = 0.1102 * (settings.attenuation_db - 8.7);
+        const double center = 0.5 * static_cast<double>(length - 1);
+        const double normalization = besselI0(beta);
+
+        std::vector<double> prototype(length);
+        for (size_t n = 0; n < length; ++n) {
+            const double x = static_cast<double>(n) - center;
+            const double arg = 2.0 * cutoff * x;
+            const double sinc = std::abs(arg) < 1e-12 ? 1.0 : std::sin(M_PI * arg) / (M_PI * arg);
+            const double ratio = x / center;
+            const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) / normalization;
+            prototype[n] = 2.0 * cutoff * sinc * window;
+        }
+
+        // Фаза p: h[p + j·L], j = 0..taps-1, в обратном порядке; сумма фазы — 1
+        table->taps = taps;
+        table->coefficients.assign(interpolation * taps, 0.0f);
+        for (uint32_t p = 0; p < interpolation; ++p) {
+            double sum = 0.0;
+            for (size_t j = 0; j < taps; ++j) sum += prototype[p + j * interpolation];
+            const double scale = std::abs(sum) > 1e-12 ? 1.0 / sum : L;
+            for (size_t j = 0; j < taps; ++j) {
+                table->coefficients[p * taps + (taps - 1 - j)] =
+                    static_cast<float>(prototype[p + j * interpolation] * scale);
+            }
+        }
+    }
+
+    cache[key] = table;
+    return table;
+}
+
+void PolyphaseResampler::configure(double input_rate, double output_rate, ResamplerQuality quality) {
+    input_rate_ = input_rate > 0.0 ? input_rate : 44100.0;
+    output_rate_ = output_rate > 0.0 ? output_rate : input_rate_;
+    quality_ = quality;
+
+    uint32_t interpolation, decimation;
+    rationalRatio(input_rate_, output_rate_, kMaxPhases, interpolation, decimation);
+    table_ = filterTable(interpolation, decimation, quality_);
+
+    if (max_input_frames_ > 0) {
+        prepare(max_input_frames_);
+    }
+}
+
+void PolyphaseResampler::prepare(size_t max_input_frames) {
+    max_input_frames_ = std::max<size_t>(1, max_input_frames);
+    buffer_.assign(table_->taps + max_input_frames_, 0.0f);
+    reset();
+}
+
+void PolyphaseResampler::reset() {
+    // Окно начинается с taps - 1 нулей: первый выходной отсчет соответствует первому входному
+    std::fill(buffer_.begin(), buffer_.end(), 0.0f);
+    fill_ = buffer_.empty() ? 0 : table_->taps - 1;
+    position_ = 0;
+    phase_ = 0;
+}
+
+double PolyphaseResampler::getLatencyFrames() const {
+    if (isPassthrough()) return 0.0;
+    const double length = static_cast<double>(table_->taps) * table_->interpolation;
+    return (length - 1.0) / (2.0 * table_->interpolation);
+}
+
+double PolyphaseResampler::getLatencySeconds() const {
+    return getLatencyFrames() / input_rate_;
+}
+
+size_t PolyphaseResampler::getMaxOutputFrames(size_t frames) const {
+    const uint64_t pending = static_cast<uint64_t>(frames) + table_->taps;
+    return static_cast<size_t>(pending * table_->interpolation / table_->decimation) + 1;
+}
+
+size_t PolyphaseResampler::getRequiredInputFrames(size_t frames) const {
+    if (frames == 0) return 0;
+    const uint64_t steps = phase_ + static_cast<uint64_t>(frames - 1) * table_->decimation;
+    const uint64_t needed = position_ + steps / table_->interpolation + table_->taps;
+    return needed > fill_ ? static_cast<size_t>(needed - fill_) : 0;
+}
+
+size_t PolyphaseResampler::produce(float* out, size_t max_frames) {
+    const size_t taps = table_->taps;
+    const uint32_t interpolation = table_->interpolation;
+    const uint32_t decimation = table_->decimation;
+    const float* coefficients = table_->coefficients.data();
+    const float* window = buffer_.data();
+
+    size_t count = 0;
+    if (interpolation == 1 && decimation == 1) {
+        count = std::min(max_frames, fill_ - position_);
+        std::memcpy(out, window + position_, count * sizeof(float));
+        position_ += count;
+        return count;
+    }
+
+    while (count < max_frames && position_ + taps <= fill_) {
+        out[count++] = dot(coefficients + static_cast<size_t>(phase_) * taps, window + position_, taps);
+        phase_ += decimation;
+        position_ += phase_ / interpolation;
+        phase_ %= interpolation;
+    }
+    return count;
+}
+
+void PolyphaseResampler::compact() {
+    // Непрочитанный хвост переносится в начало буфера
+    if (position_ == 0) return;
+    const size_t remaining = fill_ - position_;
+    std::memmove(buffer_.data(), buffer_.data() + position_, remaining * sizeof(float));
+    position_ = 0;
+    fill_ = remaining;
+}
+
+size_t PolyphaseResampler::process(const float* in, size_t frames, float* out) {
+    if (!in || !out || max_input_frames_ == 0) return 0;
+
+    size_t produced = 0;
+    size_t consumed = 0;
+    while (consumed < frames) {
+        compact();
+        const size_t chunk = std::min(frames - consumed, buffer_.size() - fill_);
+        std::memcpy(buffer_.data() + fill_, in + consumed, chunk * sizeof(float));
+        fill_ += chunk;
+        consumed += chunk;
+        produced += produce(out + produced, SIZE_MAX);
+    }
+    return produced;
+}
+
+} // namespace AnantaDigital
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Длина фильтра и подавление вне полосы
+enum class ResamplerQuality {
+    FAST,       // 24 отвода на фазу, ~60 дБ, полоса до 0.7 частоты Найквиста
+    STANDARD,   // 64 отвода на фазу, ~96 дБ, полоса до 0.8
+    HIGH        // 128 отводов на фазу, ~120 дБ, полоса до 0.88
+};
+
+// Потоковый полифазный преобразователь частоты дискретизации.
+//
+// Отношение частот приводится к несократимой дроби L/M (не более kMaxPhases
+// фаз; иначе — ближайшая подходящая дробь). Прототип — sinc с окном Кайзера,
+// срез на частоте Найквиста меньшей из частот; таблица L фаз строится один
+// раз на отношение и качество и разделяется всеми экземплярами.
+//
+// Каждый выходной отсчет — скалярное произведение фазы фильтра на окно
+// входа (AVX2/NEON). После prepare() методы обработки не выделяют память.
+class PolyphaseResampler {
+public:
+    static constexpr uint32_t kMaxPhases = 4096;
+
+    // Таблица коэффициентов: phases × taps (taps дополнено до кратного 8,
+    // коэффициенты фазы записаны в обратном порядке)
+    struct FilterTable {
+        uint32_t interpolation;     // L
+        uint32_t decimation;        // M
+        size_t taps;
+        std::vector<float> coefficients;
+    };
+
+private:
+    std::shared_ptr<const FilterTable> table_;
+    double input_rate_;
+    double output_rate_;
+    ResamplerQuality quality_;
+
+    // Окно входа: последние taps - 1 отсчетов и новый блок
+    std::vector<float> buffer_;
+    size_t max_input_frames_;
+    size_t fill_;               // заполнено отсчетов в buffer_
+    size_t position_;           // начало окна следующего выходного отсчета
+    uint32_t phase_;            // фаза следующего выходного отсчета, 0..L-1
+
+public:
+    PolyphaseResampler();
+
+    // Отношение частот и качество (вне аудио-потока; затем prepare())
+    void configure(double input_rate, double output_rate, ResamplerQuality quality = ResamplerQuality::STANDARD);
+    void prepare(size_t max_input_frames);
+    void reset();
+
+    double getInputRate() const { return input_rate_; }
+    double getOutputRate() const { return output_rate_; }
+    ResamplerQuality getQuality() const { return quality_; }
+    uint32_t getInterpolation() const { return table_ ? table_->interpolation : 1; }
+    uint32_t getDecimation() const { return table_ ? table_->decimation : 1; }
+    size_t getTapsPerPhase() const { return table_ ? table_->taps : 0; }
+
+    // true, если частоты совпадают и отсчеты копируются без фильтра
+    bool isPassthrough() const { return getInterpolation() == getDecimation(); }
+
+    // Групповая задержка фильтра в отсчетах входа
+    double getLatencyFrames() const;
+    double getLatencySeconds() const;
+
+    // Наибольшее число выходных отсчетов для frames входных
+    size_t getMaxOutputFrames(size_t frames) const;
+
+    // Сколько входных отсчетов нужно, чтобы получить frames выходных (с учетом накопленных)
+    size_t getRequiredInputFrames(size_t frames) const;
+
+    // Push: принять frames отсчетов, записать в out все готовые выходные
+    // (out вмещает getMaxOutputFrames(frames)). Возвращает их число.
+    size_t process(const float* in, size_t frames, float* out);
+
+    // Pull: получить ровно frames выходных отсчетов; недостающий вход
+    // запрашивается у fill(float* destination, size_t count)
+    template <typename Fill>
+    void pull(float* out, size_t frames, Fill&& fill) {
+        size_t produced = 0;
+        while (true) {
+            produced += produce(out + produced, frames - produced);
+            if (produced == frames || max_input_frames_ == 0) break;
+            compact();
+            size_t count = std::min(getRequiredInputFrames(frames - produced), buffer_.size() - fill_);
+            fill(buffer_.data() + fill_, count);
+            fill_ += count;
+        }
+    }
+
+    // Общая таблица для отношения L/M (строится при первом запросе)
+    static std::shared_ptr<const FilterTable> filterTable(uint32_t interpolation, uint32_t decimation,
+                                                          ResamplerQuality quality);
+
+    // Приближение output_rate / input_rate несократимой дробью L/M, L, M <= max_terms
+    static void rationalRatio(double input_rate, double output_rate, uint32_t max_terms,
+                              uint32_t& interpolation, uint32_t& decimation);
+
+private:
+    size_t produce(float* out, size_t max_frames);
+    void compact();
+};
+
+} // namespace AnantaDigital
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <complex>
+#include <limits>
+
+namespace AnantaDigital {
+
+// Точность отсчетов DSP-тракта. По умолчанию double; сборка с
+// ENABLE_FLOAT32_DSP (определение ANANTADIGITAL_FLOAT32) переводит
+// горячие ядра на float32 — вдвое шире SIMD и вдвое меньше трафик памяти.
+// Публичный интерфейс классов при этом остается в double.
+#if defined(ANANTADIGITAL_FLOAT32)
+using Sample = float;
+#else
+using Sample = double;
+#endif
+
+using ComplexSample = std::complex<Sample>;
+
+// Документированные границы ошибки ядер для типа отсчета T
+template <typename T>
+struct SamplePrecision {
+    // Машинный эпсилон типа
+    static constexpr double epsilon = std::numeric_limits<T>::epsilon();
+
+    // Относительная ошибка амплитуды интерференции от одного источника:
+    // фаза теряет ε·(f·d/c + 1) циклов, плюс ошибка тригонометрии и затухания
+    static double interferenceBound(double frequency, double distance) {
+        const double delay_cycles = frequency * distance / 343.0;
+        return 2.0 * 3.14159265358979323846 * epsilon * (delay_cycles + 1.0) + 16.0 * epsilon;
+    }
+
+    // Относительная ошибка скалярных ядер (расстояние, коррекция, частоты мод)
+    static constexpr double scalarBound = 64.0 * epsilon;
+};
+
+} // namespace AnantaDigital
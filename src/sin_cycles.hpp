@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// Полиномиальный sin(2πx) для фазы x в циклах: скалярный и SIMD-варианты
+// с одинаковой ошибкой (< 1e-7). cos(2πx) = sin(2π(x + 0.25)).
+namespace AnantaDigital::Kernels {
+
+inline constexpr float kTwoPi = 6.28318530717958647692f;
+
+// Коэффициенты ряда Тейлора для sin(w), w в [0, π/2]; ошибка < 1e-7
+inline constexpr float kSin3 = -1.0f / 6.0f;
+inline constexpr float kSin5 = 1.0f / 120.0f;
+inline constexpr float kSin7 = -1.0f / 5040.0f;
+inline constexpr float kSin9 = 1.0f / 362880.0f;
+inline constexpr float kSin11 = -1.0f / 39916800.0f;
+
+// sin(2πx) для фазы x в циклах: приведение к [-0.5, 0.5], затем отражение к [0, 0.25]
+inline float sinCycles(float x) {
+    float y = x - std::floor(x + 0.5f);
+    float a = std::abs(y);
+    a = std::min(a, 0.5f - a);
+    float w = a * kTwoPi;
+    float w2 = w * w;
+    float p = w * (1.0f + w2 * (kSin3 + w2 * (kSin5 + w2 * (kSin7 + w2 * (kSin9 + w2 * kSin11)))));
+    return y < 0.0f ? -p : p;
+}
+
+#if defined(__AVX2__)
+
+inline __m256 sinCyclesAvx2(__m256 x) {
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    __m256 y = _mm256_sub_ps(x, _mm256_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    __m256 sign = _mm256_and_ps(y, sign_mask);
+    __m256 a = _mm256_andnot_ps(sign_mask, y);
+    a = _mm256_min_ps(a, _mm256_sub_ps(_mm256_set1_ps(0.5f), a));
+    __m256 w = _mm256_mul_ps(a, _mm256_set1_ps(kTwoPi));
+    __m256 w2 = _mm256_mul_ps(w, w);
+    __m256 p = _mm256_set1_ps(kSin11);
+    p = _mm256_fmadd_ps(p, w2, _mm256_set1_ps(kSin9));
+    p = _mm256_fmadd_ps(p, w2, _mm256_set1_ps(kSin7));
+    p = _mm256_fmadd_ps(p, w2, _mm256_set1_ps(kSin5));
+    p = _mm256_fmadd_ps(p, w2, _mm256_set1_ps(kSin3));
+    p = _mm256_fmadd_ps(p, w2, _mm256_set1_ps(1.0f));
+    p = _mm256_mul_ps(p, w);
+    return _mm256_xor_ps(p, sign);
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+inline float32x4_t sinCyclesNeon(float32x4_t x) {
+    const uint32x4_t sign_mask = vdupq_n_u32(0x80000000u);
+    float32x4_t y = vsubq_f32(x, vrndnq_f32(x));
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(y), sign_mask);
+    float32x4_t a = vabsq_f32(y);
+    a = vminq_f32(a, vsubq_f32(vdupq_n_f32(0.5f), a));
+    float32x4_t w = vmulq_n_f32(a, kTwoPi);
+    float32x4_t w2 = vmulq_f32(w, w);
+    float32x4_t p = vdupq_n_f32(kSin11);
+    p = vfmaq_f32(vdupq_n_f32(kSin9), p, w2);
+    p = vfmaq_f32(vdupq_n_f32(kSin7), p, w2);
+    p = vfmaq_f32(vdupq_n_f32(kSin5), p, w2);
+    p = vfmaq_f32(vdupq_n_f32(kSin3), p, w2);
+    p = vfmaq_f32(vdupq_n_f32(1.0f), p, w2);
+    p = vmulq_f32(p, w);
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(p), sign));
+}
+
+#endif
+
+} // namespace AnantaDigital::Kernels
@@ -0,0 +1,473 @@
+#include "source_octree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AnantaDigital {
+
+namespace {
+
+constexpr double kSqrt3 = 1.7320508075688772;
+constexpr uint32_t kNoParent = std::numeric_limits<uint32_t>::max();
+constexpr size_t kMaxHarmonics = Kernels::sphericalHarmonicCount(SourceOctree::kMaxOrder);
+constexpr size_t kStackSize = 8 * (SourceOctree::kMaxDepth + 1);
+
+// Прямой вклад источника (корень, деление, sin/cos) против коэффициента разложения
+constexpr size_t kDirectCost = 4;
+
+// Сферические функции Бесселя j_l(x), l = 0..order. При x > order — рекурсия
+// вверх, иначе вниз (Миллер) с нормировкой по j_0 или j_1.
+void sphericalBesselJ(int order, double x, double* out) {
+    if (x < 1e-8) {
+        // j_l(x) ≈ x^l / (2l + 1)!!
+        double term = 1.0;
+        for (int l = 0; l <= order; ++l) {
+            out[l] = term;
+            term *= x / (2 * l + 3);
+        }
+        return;
+    }
+
+    const double j0 = std::sin(x) / x;
+    const double j1 = std::sin(x) / (x * x) - std::cos(x) / x;
+    if (x > order) {
+        out[0] = j0;
+        if (order >= 1) out[1] = j1;
+        for (int l = 1; l < order; ++l) {
+            out[l + 1] = (2 * l + 1) / x * out[l] - out[l - 1];
+        }
+        return;
+    }
+
+    const int start = order + 32;
+    double next = 0.0, current = 1e-30;
+    for (int l = start; l > 0; --l) {
+        const double previous = (2 * l + 1) / x * current - next;
+        next = current;
+        current = previous;
+        if (l - 1 <= order) out[l - 1] = current;
+        if (std::abs(current) > 1e200) {
+            // Пересчет масштаба, уже записанные значения тоже
+            current *= 1e-200;
+            next *= 1e-200;
+            for (int k = l - 1; k <= order; ++k) out[k] *= 1e-200;
+        }
+    }
+    const double scale = std::abs(j0) >= std::abs(j1) ? j0 / out[0] : j1 / out[1];
+    for (int l = 0; l <= order; ++l) out[l] *= scale;
+}
+
+// Сферические функции Неймана y_l(x), рекурсия вверх
+void sphericalBesselY(int order, double x, double* out) {
+    out[0] = -std::cos(x) / x;
+    if (order >= 1) out[1] = -std::cos(x) / (x * x) - std::sin(x) / x;
+    for (int l = 1; l < order; ++l) {
+        out[l + 1] = (2 * l + 1) / x * out[l] - out[l - 1];
+    }
+}
+
+// Направление точки из центра: полярный угол и азимут
+void directionAngles(double dx, double dy, double dz, double length, double& theta, double& phi) {
+    if (length <= 0.0) {
+        theta = phi = 0.0;
+        return;
+    }
+    theta = std::acos(std::clamp(dz / length, -1.0, 1.0));
+    phi = std::atan2(dy, dx);
+}
+
+int octant(const Kernels::CartesianPoint<double>& p, const Kernels::CartesianPoint<double>& center) {
+    return (p.x >= center.x ? 1 : 0) | (p.y >= center.y ? 2 : 0) | (p.z >= center.z ? 4 : 0);
+}
+
+} // namespace
+
+SourceOctree::SourceOctree(double error_bound)
+    : error_bound_(1e-2) {
+    setErrorBound(error_bound);
+}
+
+void SourceOctree::setErrorBound(double error_bound) {
+    // Перестройка дерева применяет новую границу
+    error_bound_ = std::clamp(error_bound, 1e-12, 0.5);
+}
+
+void SourceOctree::clear() {
+    sources_.clear();
+    nodes_.clear();
+    order_.clear();
+    scratch_.clear();
+    leaf_of_.clear();
+    statistics_ = OctreeStatistics{};
+}
+
+void SourceOctree::build(const Source* sources, size_t count, WorkerPool* pool) {
+    clear();
+    if (!sources || count == 0) return;
+
+    sources_.assign(sources, sources + count);
+    order_.resize(count);
+    scratch_.resize(count);
+    leaf_of_.resize(count);
+    for (size_t i = 0; i < count; ++i) order_[i] = static_cast<uint32_t>(i);
+
+    // Корень — куб вокруг ограничивающего параллелепипеда
+    Kernels::CartesianPoint<double> low = sources_[0].position, high = sources_[0].position;
+    for (const Source& source : sources_) {
+        low.x = std::min(low.x, source.position.x);
+        low.y = std::min(low.y, source.position.y);
+        low.z = std::min(low.z, source.position.z);
+        high.x = std::max(high.x, source.position.x);
+        high.y = std::max(high.y, source.position.y);
+        high.z = std::max(high.z, source.position.z);
+    }
+    Node root;
+    root.center = {0.5 * (low.x + high.x), 0.5 * (low.y + high.y), 0.5 * (low.z + high.z)};
+    root.half = std::max({high.x - low.x, high.y - low.y, high.z - low.z, 1e-6}) * 0.5 * (1.0 + 1e-9);
+    root.begin = 0;
+    root.end = static_cast<uint32_t>(count);
+    root.first_child = 0;
+    root.child_count = 0;
+    root.parent = kNoParent;
+    root.order = -1;
+    nodes_.push_back(std::move(root));
+    if (pool && pool->getWorkerCount() > 1) {
+        buildSubtrees(*pool);
+    } else {
+        split(nodes_, 0, 0);
+    }
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+        const Node& node = nodes_[i];
+        if (node.child_count > 0) continue;
+        for (uint32_t k = node.begin; k < node.end; ++k) leaf_of_[order_[k]] = i;
+    }
+
+    // Разложения внутренних узлов независимы
+    std::vector<uint32_t> internal;
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].child_count > 0) internal.push_back(i);
+    }
+    auto expandNode = [&](size_t task, size_t) { expand(nodes_[internal[task]]); };
+    if (pool && internal.size() > 1) {
+        for (size_t begin = 0; begin < internal.size(); begin += WorkerPool::kMaxTasks) {
+            const size_t tasks = std::min(WorkerPool::kMaxTasks, internal.size() - begin);
+            pool->run(tasks, [&](size_t task, size_t worker) { expandNode(begin + task, worker); });
+        }
+    } else {
+        for (size_t task = 0; task < internal.size(); ++task) expandNode(task, 0);
+    }
+
+    statistics_.nodes = nodes_.size();
+    for (const Node& node : nodes_) statistics_.multipole_groups += node.groups.size();
+}
+
+void SourceOctree::buildSubtrees(WorkerPool& pool) {
+    // Верхние уровни — последовательно в ширину, пока поддеревьев мало для пула
+    struct Pending { uint32_t node; int depth; };
+    std::vector<Pending> frontier{{0, 0}}, next;
+    const size_t target = 4 * pool.getWorkerCount();
+    while (!frontier.empty() && frontier.size() < target) {
+        next.clear();
+        for (const Pending& pending : frontier) {
+            if (!splittable(nodes_[pending.node], pending.depth)) continue;
+            partition(nodes_, pending.node);
+            const Node& node = nodes_[pending.node];
+            for (uint32_t c = node.first_child; c < node.first_child + node.child_count; ++c) {
+                next.push_back({c, pending.depth + 1});
+            }
+        }
+        frontier.swap(next);
+    }
+    if (frontier.empty()) return;
+
+    // Поддеревья строятся в свои массивы узлов (корень — копия узла фронта):
+    // диапазоны order_ и scratch_ у них не пересекаются
+    std::vector<std::vector<Node>> subtrees(frontier.size());
+    for (size_t begin = 0; begin < frontier.size(); begin += WorkerPool::kMaxTasks) {
+        const size_t tasks = std::min(WorkerPool::kMaxTasks, frontier.size() - begin);
+        pool.run(tasks, [&](size_t task, size_t) {
+            const Pending& pending = frontier[begin + task];
+            std::vector<Node>& local = subtrees[begin + task];
+            local.push_back(nodes_[pending.node]);
+            split(local, 0, pending.depth);
+        });
+    }
+
+    // Сшивка: локальный узел i > 0 получает индекс offset + i - 1
+    for (size_t t = 0; t < frontier.size(); ++t) {
+        std::vector<Node>& local = subtrees[t];
+        const uint32_t root = frontier[t].node;
+        if (local[0].child_count == 0) continue;
+        const uint32_t offset = static_cast<uint32_t>(nodes_.size()) - 1;
+        nodes_[root].first_child = local[0].first_child + offset;
+        nodes_[root].child_count = local[0].child_count;
+        for (size_t i = 1; i < local.size(); ++i) {
+            Node& node = local[i];
+            node.parent = node.parent == 0 ? root : node.parent + offset;
+            if (node.child_count > 0) node.first_child += offset;
+            nodes_.push_back(std::move(node));
+        }
+    }
+}
+
+bool SourceOctree::splittable(const Node& node, int depth) const {
+    return node.end - node.begin > kLeafSources && depth < kMaxDepth;
+}
+
+void SourceOctree::split(std::vector<Node>& nodes, uint32_t index, int depth) {
+    if (!splittable(nodes[index], depth)) return;
+
+    partition(nodes, index);
+    const uint32_t first_child = nodes[index].first_child;
+    const uint32_t child_count = nodes[index].child_count;
+    for (uint32_t c = first_child; c < first_child + child_count; ++c) {
+        split(nodes, c, depth + 1);
+    }
+}
+
+void SourceOctree::partition(std::vector<Node>& nodes, uint32_t index) {
+    const uint32_t begin = nodes[index].begin, end = nodes[index].end;
+
+    // Раскладка диапазона по октантам подсчетом
+    const Kernels::CartesianPoint<double> center = nodes[index].center;
+    const double half = nodes[index].half * 0.5;
+    uint32_t counts[8] = {};
+    for (uint32_t i = begin; i < end; ++i) {
+        ++counts[octant(sources_[order_[i]].position, center)];
+    }
+    uint32_t offsets[8];
+    uint32_t offset = begin;
+    for (int o = 0; o < 8; ++o) {
+        offsets[o] = offset;
+        offset += counts[o];
+    }
+    {
+        uint32_t cursor[8];
+        std::copy(offsets, offsets + 8, cursor);
+        for (uint32_t i = begin; i < end; ++i) {
+            const uint32_t s = order_[i];
+            scratch_[cursor[octant(sources_[s].position, center)]++] = s;
+        }
+    }
+    std::copy(scratch_.begin() + begin, scratch_.begin() + end, order_.begin() + begin);
+
+    const uint32_t first_child = static_cast<uint32_t>(nodes.size());
+    uint32_t child_count = 0;
+    for (int o = 0; o < 8; ++o) {
+        if (counts[o] == 0) continue;
+        Node child;
+        child.center = {center.x + ((o & 1) ? half : -half),
+                        center.y + ((o & 2) ? half : -half),
+                        center.z + ((o & 4) ? half : -half)};
+        child.half = half;
+        child.begin = offsets[o];
+        child.end = offsets[o] + counts[o];
+        child.first_child = 0;
+        child.child_count = 0;
+        child.parent = index;
+        child.order = -1;
+        nodes.push_back(std::move(child));
+        ++child_count;
+    }
+    nodes[index].first_child = first_child;
+    nodes[index].child_count = child_count;
+}
+
+int SourceOctree::orderFor(double wave_number, double radius) const {
+    // Полоса kρ плюс запас на точность, и не меньше сходимости ряда при D ≥ 2ρ
+    const double x = wave_number * radius;
+    const double digits = std::log10(1.0 / error_bound_);
+    const double bandwidth = std::ceil(x + 1.8 * std::pow(digits, 2.0 / 3.0) * std::cbrt(x));
+    const double geometric = std::ceil(std::log(error_bound_) / std::log(0.5));
+    const double order = std::max(bandwidth, geometric);
+    return order > kMaxOrder ? -1 : static_cast<int>(order);
+}
+
+void SourceOctree::expand(Node& node) const {
+    node.groups.clear();
+    node.residual.clear();
+    node.order = -1;
+
+    // Источники узла по частотам
+    std::vector<uint32_t> members(order_.begin() + node.begin, order_.begin() + node.end);
+    std::sort(members.begin(), members.end(), [&](uint32_t a, uint32_t b) {
+        return sources_[a].frequency < sources_[b].frequency;
+    });
+
+    // Сначала план: какие частоты выгодно свернуть в разложения
+    struct Run { size_t begin, end; double wave_number; int order; };
+    std::vector<Run> runs;
+    const double radius = node.half * kSqrt3;
+    size_t coefficients = 0, residual = 0;
+    for (size_t begin = 0; begin < members.size();) {
+        const double frequency = sources_[members[begin]].frequency;
+        size_t end = begin + 1;
+        while (end < members.size() && sources_[members[end]].frequency == frequency) ++end;
+
+        const double wave_number = 2.0 * M_PI * frequency / Kernels::kSpeedOfSound;
+        int order = wave_number > 0.0 ? orderFor(wave_number, radius) : -1;
+        if (order >= 0 && (end - begin) * kDirectCost > Kernels::sphericalHarmonicCount(order)) {
+            coefficients += Kernels::sphericalHarmonicCount(order);
+        } else {
+            order = -1;
+            residual += end - begin;
+        }
+        runs.push_back({begin, end, wave_number, order});
+        begin = end;
+    }
+
+    // Если остаток дороже разложений, дальний узел выгоднее раскрыть до потомков
+    if (coefficients == 0 || residual * kDirectCost > coefficients) return;
+
+    for (const Run& run : runs) {
+        if (run.order < 0) {
+            node.residual.insert(node.residual.end(), members.begin() + run.begin, members.begin() + run.end);
+            continue;
+        }
+        Group group;
+        group.frequency = sources_[members[run.begin]].frequency;
+        group.wave_number = run.wave_number;
+        group.count = static_cast<uint32_t>(run.end - run.begin);
+        group.order = run.order;
+        group.coefficients.assign(Kernels::sphericalHarmonicCount(run.order), std::complex<double>(0.0, 0.0));
+        for (size_t i = run.begin; i < run.end; ++i) {
+            addToGroup(group, node, sources_[members[i]], 1.0);
+        }
+        node.order = std::max(node.order, run.order);
+        node.groups.push_back(std::move(group));
+    }
+}
+
+void SourceOctree::addToGroup(Group& group, const Node& node, const Source& source, double sign) const {
+    // M_lm += a·j_l(k|δ|)·Y_lm(δ̂), δ — смещение источника от центра узла
+    const double dx = source.position.x - node.center.x;
+    const double dy = source.position.y - node.center.y;
+    const double dz = source.position.z - node.center.z;
+    const double length = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    double bessel[kMaxOrder + 1];
+    double harmonics[kMaxHarmonics];
+    double theta, phi;
+    directionAngles(dx, dy, dz, length, theta, phi);
+    sphericalBesselJ(group.order, group.wave_number * length, bessel);
+    Kernels::realSphericalHarmonics(group.order, theta, phi, harmonics);
+
+    const std::complex<double> amplitude = sign * source.amplitude;
+    for (int l = 0; l <= group.order; ++l) {
+        const std::complex<double> radial = amplitude * bessel[l];
+        for (int m = -l; m <= l; ++m) {
+            const size_t index = Kernels::sphericalHarmonicIndex(l, m);
+            group.coefficients[index] += radial * harmonics[index];
+        }
+    }
+}
+
+bool SourceOctree::moveSource(size_t index, const Kernels::CartesianPoint<double>& position) {
+    if (index >= sources_.size()) return false;
+
+    // Предки листа содержат его куб, поэтому их порядки разложений остаются верны
+    const Node& leaf = nodes_[leaf_of_[index]];
+    if (std::abs(position.x - leaf.center.x) > leaf.half || std::abs(position.y - leaf.center.y) > leaf.half ||
+        std::abs(position.z - leaf.center.z) > leaf.half) {
+        return false;
+    }
+
+    Source moved = sources_[index];
+    moved.position = position;
+    for (uint32_t n = leaf.parent; n != kNoParent; n = nodes_[n].parent) {
+        Node& node = nodes_[n];
+        for (Group& group : node.groups) {
+            if (group.frequency != moved.frequency) continue;
+            addToGroup(group, node, sources_[index], -1.0);
+            addToGroup(group, node, moved, 1.0);
+            break;
+        }
+    }
+    sources_[index] = moved;
+    return true;
+}
+
+std::complex<double> SourceOctree::evaluate(const Kernels::CartesianPoint<double>& observer, double time,
+                                            double threshold, OctreeStatistics* statistics) const {
+    std::complex<double> total(0.0, 0.0);
+    if (nodes_.empty()) return total;
+
+    size_t direct_sources = 0, multipole_evaluations = 0, aggregated_sources = 0;
+    auto direct = [&](uint32_t s) {
+        const Source& source = sources_[s];
+        const double distance = Kernels::distance(source.position, observer);
+        ++direct_sources;
+        if (threshold > 0.0 && std::abs(source.amplitude) * Kernels::distanceAttenuation(distance) < threshold) {
+            return;
+        }
+        total += Kernels::sourceContribution<double>(source.amplitude, source.frequency, distance, time);
+    };
+
+    uint32_t stack[kStackSize];
+    size_t top = 0;
+    stack[top++] = 0;
+    double harmonics[kMaxHarmonics];
+    double bessel_j[kMaxOrder + 1], bessel_y[kMaxOrder + 1];
+
+    while (top > 0) {
+        const Node& node = nodes_[stack[--top]];
+        if (node.child_count == 0) {
+            for (uint32_t i = node.begin; i < node.end; ++i) direct(order_[i]);
+            continue;
+        }
+
+        // Дальний узел: ряд сходится (D ≥ 2ρ) и s(d) ≈ s(D) с заданной точностью;
+        // узел без разложений раскрывается
+        const double dx = observer.x - node.center.x;
+        const double dy = observer.y - node.center.y;
+        const double dz = observer.z - node.center.z;
+        const double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        const double radius = node.half * kSqrt3;
+        const double gap = distance - radius;
+        const bool far = distance >= 2.0 * radius && 10.0 * radius <= error_bound_ * (gap + 10.0) * gap;
+        if (!far || node.groups.empty()) {
+            for (uint32_t c = node.first_child; c < node.first_child + node.child_count; ++c) {
+                stack[top++] = c;
+            }
+            continue;
+        }
+
+        double theta, phi;
+        directionAngles(dx, dy, dz, distance, theta, phi);
+        Kernels::realSphericalHarmonics(node.order, theta, phi, harmonics);
+        const double screening = 10.0 * distance / (distance + 10.0);
+
+        for (const Group& group : node.groups) {
+            // e^{-ik|D - δ|}/|D - δ| = -4πik·Σ_l conj(h_l(kD))·Σ_m Y_lm(û)·j_l(k|δ|)·Y_lm(δ̂)
+            const double x = group.wave_number * distance;
+            sphericalBesselJ(group.order, x, bessel_j);
+            sphericalBesselY(group.order, x, bessel_y);
+            std::complex<double> sum(0.0, 0.0);
+            for (int l = 0; l <= group.order; ++l) {
+                std::complex<double> angular(0.0, 0.0);
+                for (int m = -l; m <= l; ++m) {
+                    const size_t index = Kernels::sphericalHarmonicIndex(l, m);
+                    angular += group.coefficients[index] * harmonics[index];
+                }
+                sum += std::complex<double>(bessel_j[l], -bessel_y[l]) * angular;
+            }
+
+            double time_cycles = group.frequency * time;
+            time_cycles -= std::floor(time_cycles);
+            total += std::complex<double>(0.0, -4.0 * M_PI * group.wave_number * screening) * sum *
+                     std::polar(1.0, 2.0 * M_PI * time_cycles);
+            ++multipole_evaluations;
+            aggregated_sources += group.count;
+        }
+        for (uint32_t s : node.residual) direct(s);
+    }
+
+    if (statistics) {
+        statistics->direct_sources += direct_sources;
+        statistics->multipole_evaluations += multipole_evaluations;
+        statistics->aggregated_sources += aggregated_sources;
+    }
+    return total;
+}
+
+} // namespace AnantaDigital
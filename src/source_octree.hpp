@@ -0,0 +1,119 @@
+#pragma once
+
+#include "dsp_kernels.hpp"
+#include "worker_pool.hpp"
+#include <vector>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Размер дерева и счетчики вычислений в точках
+struct OctreeStatistics {
+    size_t nodes = 0;                   // узлов в дереве
+    size_t multipole_groups = 0;        // разложений в дереве
+    size_t direct_sources = 0;          // источников, посчитанных напрямую
+    size_t multipole_evaluations = 0;   // разложений, посчитанных вместо источников
+    size_t aggregated_sources = 0;      // источников внутри них
+};
+
+// Октодерево источников интерференционного поля с дальним полем по Барнсу — Хату.
+//
+// Вклад источника a·A(d)·e^{i2π(f·t - f·d/c)}, A(d) = 1/(1 + 0.1·d) = s(d)/d,
+// s(d) = 10·d/(d + 10). Множитель e^{-ikd}/d — функция Грина уравнения
+// Гельмгольца, поэтому источники одной частоты в узле сворачиваются в
+// мультипольное разложение M_lm = Σ a·j_l(kρ)·Y_lm(δ̂) вокруг центра узла
+// (теорема сложения), а медленный множитель s(d) берется в центре узла.
+// У узла по разложению на частоту, если источников этой частоты достаточно,
+// чтобы разложение было дешевле прямого счета; редкие частоты дальнего узла
+// считаются напрямую, а узел, где их большинство, раскрывается до потомков.
+//
+// Узел в точке на расстоянии D считается дальним, если D ≥ 2ρ (ρ — полудиагональ
+// куба узла) и ошибка s(d) ≈ s(D) не больше error_bound; порядок разложения
+// выбирается по kρ и error_bound. Ошибка вклада дальнего узла — порядка
+// error_bound·Σ|a|·A(d) его источников. Порог отбора в дальних узлах не применяется.
+//
+// Частоты сравниваются точно: ускоряются установки, где много источников
+// звучат на общих частотах (моды резонатора, массивы громкоговорителей).
+class SourceOctree {
+public:
+    static constexpr size_t kLeafSources = 32;
+    static constexpr int kMaxOrder = 30;
+    static constexpr int kMaxDepth = 16;
+
+    struct Source {
+        Kernels::CartesianPoint<double> position;
+        std::complex<double> amplitude;
+        double frequency;
+    };
+
+private:
+    // Разложение источников одной частоты в узле
+    struct Group {
+        double frequency;
+        double wave_number;
+        uint32_t count;
+        int order;
+        std::vector<std::complex<double>> coefficients;     // (order + 1)² в порядке ACN
+    };
+
+    struct Node {
+        Kernels::CartesianPoint<double> center;
+        double half;                    // половина ребра куба
+        uint32_t begin, end;            // диапазон order_
+        uint32_t first_child;           // непустые потомки подряд
+        uint32_t child_count;           // 0 — лист
+        uint32_t parent;
+        int order;                      // наибольший порядок разложений узла
+        std::vector<Group> groups;
+        std::vector<uint32_t> residual; // источники без разложения (кроме листьев)
+    };
+
+    std::vector<Source> sources_;
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> order_;       // индексы источников в порядке обхода дерева
+    std::vector<uint32_t> scratch_;     // буфер раскладки по октантам, параллельно order_
+    std::vector<uint32_t> leaf_of_;     // лист каждого источника
+    double error_bound_;
+    OctreeStatistics statistics_;
+
+public:
+    explicit SourceOctree(double error_bound = 1e-2);
+
+    void setErrorBound(double error_bound);
+    double getErrorBound() const { return error_bound_; }
+
+    // Построить дерево. С pool верхние уровни делятся последовательно,
+    // затем поддеревья и разложения узлов строятся параллельно
+    void build(const Source* sources, size_t count, WorkerPool* pool = nullptr);
+    void clear();
+
+    size_t size() const { return sources_.size(); }
+    bool empty() const { return sources_.empty(); }
+
+    // Переместить источник. Внутри своего листа разложения предков обновляются
+    // на месте (они линейны по источникам); false — источник вышел из листа,
+    // нужна перестройка.
+    bool moveSource(size_t index, const Kernels::CartesianPoint<double>& position);
+
+    // Сумма вкладов источников в точке до преобразования типа интерференции.
+    // Источники тише threshold (|a|·A(d)) в ближних узлах пропускаются.
+    // statistics (если задан) накапливает счетчики вычисления.
+    std::complex<double> evaluate(const Kernels::CartesianPoint<double>& observer, double time,
+                                  double threshold = 0.0, OctreeStatistics* statistics = nullptr) const;
+
+    // Размер дерева (счетчики вычислений — нулевые)
+    const OctreeStatistics& getStatistics() const { return statistics_; }
+
+private:
+    bool splittable(const Node& node, int depth) const;
+    void partition(std::vector<Node>& nodes, uint32_t node);
+    void split(std::vector<Node>& nodes, uint32_t node, int depth);
+    void buildSubtrees(WorkerPool& pool);
+    void expand(Node& node) const;
+    int orderFor(double wave_number, double radius) const;
+    void addToGroup(Group& group, const Node& node, const Source& source, double sign) const;
+};
+
+} // namespace AnantaDigital
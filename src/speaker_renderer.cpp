@@ -0,0 +1,261 @@
+#include "speaker_renderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace AnantaDigital {
+
+namespace {
+
+size_t roundUpToLanes(size_t count) {
+    return (count + SpeakerRenderer::kLaneWidth - 1) / SpeakerRenderer::kLaneWidth * SpeakerRenderer::kLaneWidth;
+}
+
+#if defined(__AVX2__)
+
+// Сумма по источникам для kLaneWidth каналов в каждом отсчете блока
+void mixLanes(float* mix, size_t stride, size_t frames, const float* lines, size_t line_length,
+              size_t sources, const float* gains, const int32_t* delays, const float* fractions,
+              size_t write_position) {
+    const __m256i mask = _mm256_set1_epi32(static_cast<int32_t>(line_length - 1));
+    const __m256i one = _mm256_set1_epi32(1);
+    for (size_t t = 0; t < frames; ++t) {
+        const __m256i position = _mm256_set1_epi32(static_cast<int32_t>(write_position + t));
+        __m256 acc = _mm256_setzero_ps();
+        for (size_t j = 0; j < sources; ++j) {
+            const size_t row = j * stride;
+            const float* line = lines + j * line_length;
+            __m256i index0 = _mm256_and_si256(_mm256_sub_epi32(position, _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(delays + row))), mask);
+            __m256i index1 = _mm256_and_si256(_mm256_sub_epi32(index0, one), mask);
+            __m256 x0 = _mm256_i32gather_ps(line, index0, 4);
+            __m256 x1 = _mm256_i32gather_ps(line, index1, 4);
+            __m256 y = _mm256_fmadd_ps(_mm256_loadu_ps(fractions + row), _mm256_sub_ps(x1, x0), x0);
+            acc = _mm256_fmadd_ps(_mm256_loadu_ps(gains + row), y, acc);
+        }
+        _mm256_storeu_ps(mix + t * stride, acc);
+    }
+}
+
+#else
+
+void mixLanes(float* mix, size_t stride, size_t frames, const float* lines, size_t line_length,
+              size_t sources, const float* gains, const int32_t* delays, const float* fractions,
+              size_t write_position) {
+    const size_t mask = line_length - 1;
+    for (size_t t = 0; t < frames; ++t) {
+        float acc[SpeakerRenderer::kLaneWidth] = {};
+        for (size_t j = 0; j < sources; ++j) {
+            const size_t row = j * stride;
+            const float* line = lines + j * line_length;
+            for (size_t lane = 0; lane < SpeakerRenderer::kLaneWidth; ++lane) {
+                size_t index0 = (write_position + t - static_cast<size_t>(delays[row + lane])) & mask;
+                size_t index1 = (index0 - 1) & mask;
+                float y = line[index0] + fractions[row + lane] * (line[index1] - line[index0]);
+                acc[lane] += gains[row + lane] * y;
+            }
+        }
+        std::memcpy(mix + t * stride, acc, sizeof(acc));
+    }
+}
+
+#endif
+
+} // namespace
+
+SpeakerRenderer::SpeakerRenderer()
+    : stride_(0)
+    , sample_rate_(48000.0)
+    , max_block_frames_(0)
+    , max_sources_(0)
+    , source_count_(0)
+    , delay_length_(0)
+    , write_position_(0)
+    , max_delay_samples_(0.0f) {
+}
+
+void SpeakerRenderer::setSpeakers(const std::vector<SphericalCoord>& speakers) {
+    speakers_ = speakers;
+    stride_ = roundUpToLanes(speakers_.size());
+
+    speaker_points_.clear();
+    speaker_points_.reserve(speakers_.size());
+    for (const auto& speaker : speakers_) {
+        speaker_points_.push_back(Kernels::toCartesian<double>(speaker));
+    }
+
+    // Геометрия зависит от расстановки, источники нужно задать заново
+    max_sources_ = 0;
+    source_count_ = 0;
+}
+
+void SpeakerRenderer::prepare(double sample_rate, size_t max_block_frames, size_t max_sources,
+                              double max_delay_seconds) {
+    sample_rate_ = sample_rate > 0.0 ? sample_rate : 48000.0;
+    max_block_frames_ = std::max<size_t>(1, max_block_frames);
+    max_sources_ = max_sources;
+    source_count_ = 0;
+
+    // Линия задержки вмещает максимальную задержку, блок и отсчет интерполяции
+    const size_t max_delay = static_cast<size_t>(std::ceil(std::max(0.0, max_delay_seconds) * sample_rate_));
+    delay_length_ = 1;
+    while (delay_length_ < max_delay + max_block_frames_ + 2) {
+        delay_length_ <<= 1;
+    }
+    max_delay_samples_ = static_cast<float>(delay_length_ - max_block_frames_ - 2);
+    write_position_ = 0;
+
+    delay_lines_.assign(max_sources_ * delay_length_, 0.0f);
+    gains_.assign(max_sources_ * stride_, 0.0f);
+    integer_delays_.assign(max_sources_ * stride_, 0);
+    fractions_.assign(max_sources_ * stride_, 0.0f);
+    mix_.assign(max_block_frames_ * stride_, 0.0f);
+}
+
+void SpeakerRenderer::computeSourceGeometry(const SphericalCoord& position, double gain, InterferenceFieldType type,
+                                            float* gains, float* delays) const {
+    const auto source = Kernels::toCartesian<double>(position);
+    for (size_t s = 0; s < speakers_.size(); ++s) {
+        double distance = Kernels::distance(source, speaker_points_[s]);
+
+        // Затухание и вес типа интерференции — как в calculateInterference
+        double attenuation = Kernels::distanceAttenuation(distance);
+        auto weighted = Kernels::applyInterferenceType(std::complex<double>(gain * attenuation, 0.0), type);
+
+        gains[s] = static_cast<float>(std::real(weighted));
+        delays[s] = std::min(static_cast<float>(distance / Kernels::kSpeedOfSound * sample_rate_), max_delay_samples_);
+    }
+
+    // Дополнительные каналы SIMD-шага молчат
+    for (size_t s = speakers_.size(); s < stride_; ++s) {
+        gains[s] = 0.0f;
+        delays[s] = 0.0f;
+    }
+}
+
+void SpeakerRenderer::setSourceGeometry(size_t source, const float* gains, const float* delays) {
+    if (source >= max_sources_) return;
+
+    const size_t row = source * stride_;
+    for (size_t s = 0; s < stride_; ++s) {
+        float delay = std::min(std::max(0.0f, delays[s]), max_delay_samples_);
+        float whole = std::floor(delay);
+        gains_[row + s] = gains[s];
+        integer_delays_[row + s] = static_cast<int32_t>(whole);
+        fractions_[row + s] = delay - whole;
+    }
+}
+
+void SpeakerRenderer::getSourceGeometry(size_t source, float* gains, float* delays) const {
+    if (source >= max_sources_) {
+        std::fill(gains, gains + stride_, 0.0f);
+        std::fill(delays, delays + stride_, 0.0f);
+        return;
+    }
+
+    const size_t row = source * stride_;
+    for (size_t s = 0; s < stride_; ++s) {
+        gains[s] = gains_[row + s];
+        delays[s] = static_cast<float>(integer_delays_[row + s]) + fractions_[row + s];
+    }
+}
+
+void SpeakerRenderer::moveSource(size_t from, size_t to) {
+    if (from >= max_sources_ || to >= max_sources_ || from == to) return;
+
+    std::copy_n(gains_.data() + from * stride_, stride_, gains_.data() + to * stride_);
+    std::copy_n(integer_delays_.data() + from * stride_, stride_, integer_delays_.data() + to * stride_);
+    std::copy_n(fractions_.data() + from * stride_, stride_, fractions_.data() + to * stride_);
+    std::copy_n(delay_lines_.data() + from * delay_length_, delay_length_, delay_lines_.data() + to * delay_length_);
+}
+
+void SpeakerRenderer::setSource(size_t source, const SphericalCoord& position, double gain, InterferenceFieldType type) {
+    if (source >= max_sources_) return;
+
+    // Задержки считаются прямо в строку fractions_ и раскладываются на месте
+    const size_t row = source * stride_;
+    computeSourceGeometry(position, gain, type, gains_.data() + row, fractions_.data() + row);
+    setSourceGeometry(source, gains_.data() + row, fractions_.data() + row);
+}
+
+void SpeakerRenderer::setSourceCount(size_t count) {
+    source_count_ = std::min(count, max_sources_);
+}
+
+void SpeakerRenderer::reset() {
+    std::fill(delay_lines_.begin(), delay_lines_.end(), 0.0f);
+    write_position_ = 0;
+}
+
+void SpeakerRenderer::writeSources(size_t first, const float* const* sources, size_t count, size_t frames) {
+    frames = std::min(frames, max_block_frames_);
+    if (first >= source_count_ || delay_length_ == 0) return;
+    count = std::min(count, source_count_ - first);
+
+    const size_t head = std::min(frames, delay_length_ - write_position_);
+    for (size_t j = 0; j < count; ++j) {
+        float* line = delay_lines_.data() + (first + j) * delay_length_;
+        const float* source = sources ? sources[j] : nullptr;
+        if (source) {
+            std::memcpy(line + write_position_, source, head * sizeof(float));
+            std::memcpy(line, source + head, (frames - head) * sizeof(float));
+        } else {
+            std::fill(line + write_position_, line + write_position_ + head, 0.0f);
+            std::fill(line, line + (frames - head), 0.0f);
+        }
+    }
+}
+
+void SpeakerRenderer::mix(size_t frames) {
+    for (size_t group = 0; group < stride_; group += kLaneWidth) {
+        mixLanes(mix_.data() + group, stride_, frames, delay_lines_.data(), delay_length_, source_count_,
+                 gains_.data() + group, integer_delays_.data() + group, fractions_.data() + group,
+                 write_position_);
+    }
+    write_position_ = (write_position_ + frames) & (delay_length_ - 1);
+}
+
+void SpeakerRenderer::mixTo(size_t frames, float* const* outputs) {
+    frames = std::min(frames, max_block_frames_);
+    if (!outputs || frames == 0 || delay_length_ == 0) return;
+
+    mix(frames);
+
+    for (size_t s = 0; s < speakers_.size(); ++s) {
+        float* output = outputs[s];
+        if (!output) continue;
+        for (size_t t = 0; t < frames; ++t) {
+            output[t] = mix_[t * stride_ + s];
+        }
+    }
+}
+
+void SpeakerRenderer::mixToInterleaved(size_t frames, float* output) {
+    frames = std::min(frames, max_block_frames_);
+    if (!output || frames == 0 || delay_length_ == 0) return;
+
+    mix(frames);
+
+    const size_t channels = speakers_.size();
+    for (size_t t = 0; t < frames; ++t) {
+        std::memcpy(output + t * channels, mix_.data() + t * stride_, channels * sizeof(float));
+    }
+}
+
+void SpeakerRenderer::render(const float* const* sources, size_t frames, float* const* outputs) {
+    if (!outputs) return;
+    writeSources(0, sources, source_count_, frames);
+    mixTo(frames, outputs);
+}
+
+void SpeakerRenderer::renderInterleaved(const float* const* sources, size_t frames, float* output) {
+    if (!output) return;
+    writeSources(0, sources, source_count_, frames);
+    mixToInterleaved(frames, output);
+}
+
+} // namespace AnantaDigital
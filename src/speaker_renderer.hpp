@@ -0,0 +1,109 @@
+#pragma once
+
+#include "anantadigital_types.hpp"
+#include "dsp_kernels.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Рендер моно-источников на N громкоговорителей купола.
+//
+// Для каждой пары источник–громкоговоритель по геометрии купола вычисляются
+// задержка распространения (в отсчетах, дробная), затухание с расстоянием и
+// весовой множитель типа интерференции — теми же ядрами, что и
+// InterferenceField::calculateInterference. Каждый источник пишется в свою
+// линию задержки; выход громкоговорителя — сумма дробно задержанных
+// (линейная интерполяция) сигналов источников.
+//
+// Внутренний цикл векторизован по громкоговорителям: за шаг обрабатываются
+// kLaneWidth каналов (AVX2 gather), выход накапливается в чередующемся буфере.
+// После prepare() методы рендера не выделяют память.
+class SpeakerRenderer {
+public:
+    // Число каналов в SIMD-шаге; массивы геометрии дополняются до кратной длины
+    static constexpr size_t kLaneWidth = 8;
+
+private:
+    std::vector<SphericalCoord> speakers_;
+    std::vector<Kernels::CartesianPoint<double>> speaker_points_;
+    size_t stride_;                         // число каналов, дополненное до kLaneWidth
+
+    double sample_rate_;
+    size_t max_block_frames_;
+    size_t max_sources_;
+    size_t source_count_;
+
+    // Линии задержки источников: max_sources_ × delay_length_ (степень двойки)
+    std::vector<float> delay_lines_;
+    size_t delay_length_;
+    size_t write_position_;
+    float max_delay_samples_;
+
+    // Геометрия: max_sources_ × stride_
+    std::vector<float> gains_;
+    std::vector<int32_t> integer_delays_;
+    std::vector<float> fractions_;
+
+    // Накопитель выхода: max_block_frames_ × stride_ (чередующийся)
+    std::vector<float> mix_;
+
+public:
+    SpeakerRenderer();
+
+    // Расстановка громкоговорителей (вне аудио-потока; затем вызвать prepare())
+    void setSpeakers(const std::vector<SphericalCoord>& speakers);
+    const std::vector<SphericalCoord>& getSpeakers() const { return speakers_; }
+    size_t getSpeakerCount() const { return speakers_.size(); }
+    size_t getStride() const { return stride_; }
+
+    // Выделение памяти под max_sources источников и задержки до max_delay_seconds
+    void prepare(double sample_rate, size_t max_block_frames, size_t max_sources, double max_delay_seconds);
+    size_t getMaxSources() const { return max_sources_; }
+    size_t getMaxBlockFrames() const { return max_block_frames_; }
+
+    // Геометрия источника в позиции position: gains и delays (в отсчетах) длиной getStride().
+    // Только читает расстановку, поэтому может вызываться из управляющего потока.
+    void computeSourceGeometry(const SphericalCoord& position, double gain, InterferenceFieldType type,
+                               float* gains, float* delays) const;
+
+    // Загрузить готовую геометрию источника (аудио-поток, без выделений)
+    void setSourceGeometry(size_t source, const float* gains, const float* delays);
+
+    // Текущая геометрия источника в том же виде, что принимает setSourceGeometry()
+    void getSourceGeometry(size_t source, float* gains, float* delays) const;
+
+    // Перенести геометрию и линию задержки источника from в индекс to
+    void moveSource(size_t from, size_t to);
+
+    // Вычислить и загрузить геометрию источника
+    void setSource(size_t source, const SphericalCoord& position, double gain = 1.0,
+                   InterferenceFieldType type = InterferenceFieldType::CONSTRUCTIVE);
+
+    void setSourceCount(size_t count);
+    size_t getSourceCount() const { return source_count_; }
+
+    // Обнулить линии задержки
+    void reset();
+
+    // sources[j] — frames отсчетов источника j (nullptr — тишина), frames <= max_block_frames.
+    // Планарный выход: outputs[s] — буфер громкоговорителя s.
+    void render(const float* const* sources, size_t frames, float* const* outputs);
+
+    // Чередующийся выход: output[t·N + s], N — число громкоговорителей
+    void renderInterleaved(const float* const* sources, size_t frames, float* output);
+
+    // Рендер группами: writeSources() пишет источники [first, first + count) в их
+    // линии задержки (sources[j] — сигнал источника first + j), затем mixTo() или
+    // mixToInterleaved() смешивает все getSourceCount() источников блока.
+    // Так сигналы источников не нужно держать в памяти все сразу.
+    void writeSources(size_t first, const float* const* sources, size_t count, size_t frames);
+    void mixTo(size_t frames, float* const* outputs);
+    void mixToInterleaved(size_t frames, float* output);
+
+private:
+    void mix(size_t frames);
+};
+
+} // namespace AnantaDigital
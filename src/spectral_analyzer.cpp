@@ -0,0 +1,218 @@
+#include "spectral_analyzer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace AnantaDigital {
+
+std::shared_ptr<const std::vector<float>> getCachedWindow(WindowType type, size_t size) {
+    static std::mutex cache_mutex;
+    static std::map<std::pair<WindowType, size_t>, std::shared_ptr<const std::vector<float>>> cache;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto& entry = cache[std::make_pair(type, size)];
+    if (entry) return entry;
+
+    // Периодические окна: сумма перекрытий постоянна при шаге N/4
+    auto window = std::make_shared<std::vector<float>>(size);
+    for (size_t n = 0; n < size; ++n) {
+        double x = 2.0 * M_PI * static_cast<double>(n) / static_cast<double>(size);
+        double value;
+        switch (type) {
+            case WindowType::HAMMING:
+                value = 0.54 - 0.46 * std::cos(x);
+                break;
+            case WindowType::BLACKMAN:
+                value = 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2.0 * x);
+                break;
+            case WindowType::HANN:
+            default:
+                value = 0.5 - 0.5 * std::cos(x);
+                break;
+        }
+        (*window)[n] = static_cast<float>(value);
+    }
+
+    entry = window;
+    return entry;
+}
+
+SpectralAnalyzer::SpectralAnalyzer(size_t fft_size, size_t hop_size, WindowType window)
+    : fft_(fft_size)
+    , hop_size_(std::min(std::max<size_t>(1, hop_size), fft_.size()))
+    , window_type_(window)
+    , window_(getCachedWindow(window, fft_.size()))
+    , sample_rate_(44100.0)
+    , fill_(0)
+    , output_position_(0)
+    , synthesis_gain_(1.0f)
+    , amplitude_scale_(1.0f)
+    , max_peaks_(32)
+    , relative_threshold_(1e-6)
+    , absolute_threshold_(0.0)
+    , min_frequency_(20.0)
+    , frame_count_(0) {
+    const size_t size = fft_.size();
+    input_.assign(size, 0.0f);
+    frame_.assign(size, 0.0f);
+    overlap_.assign(size, 0.0f);
+    output_.assign(hop_size_, 0.0f);
+    power_.assign(size / 2 + 1, 0.0f);
+    peaks_.reserve(max_peaks_);
+
+    double window_sum = 0.0;
+    double window_energy = 0.0;
+    for (float w : *window_) {
+        window_sum += w;
+        window_energy += static_cast<double>(w) * w;
+    }
+    amplitude_scale_ = static_cast<float>(2.0 / window_sum);
+    synthesis_gain_ = static_cast<float>(static_cast<double>(hop_size_) / window_energy);
+
+    setPeakThreshold(-60.0, -100.0);
+    reset();
+}
+
+void SpectralAnalyzer::setSampleRate(double sample_rate) {
+    if (sample_rate > 0.0) {
+        sample_rate_ = sample_rate;
+    }
+}
+
+void SpectralAnalyzer::setMaxPeaks(size_t max_peaks) {
+    max_peaks_ = max_peaks;
+    peaks_.clear();
+    peaks_.reserve(max_peaks_);
+}
+
+void SpectralAnalyzer::setPeakThreshold(double relative_db, double absolute_db) {
+    relative_threshold_ = std::pow(10.0, relative_db / 10.0);
+    // Мощность отсчета для синусоиды с амплитудой a равна (a / amplitude_scale_)^2
+    double amplitude = std::pow(10.0, absolute_db / 20.0) / amplitude_scale_;
+    absolute_threshold_ = amplitude * amplitude;
+}
+
+void SpectralAnalyzer::reset() {
+    std::fill(input_.begin(), input_.end(), 0.0f);
+    std::fill(overlap_.begin(), overlap_.end(), 0.0f);
+    std::fill(output_.begin(), output_.end(), 0.0f);
+    // Первый кадр завершается через hop_size отсчетов (начало дополнено нулями)
+    fill_ = fft_.size() - hop_size_;
+    output_position_ = 0;
+    frame_count_ = 0;
+    peaks_.clear();
+}
+
+size_t SpectralAnalyzer::process(const float* in, float* out, size_t frames) {
+    const size_t size = fft_.size();
+    size_t completed = 0;
+
+    // Инвариант: size - fill_ == hop_size_ - output_position_
+    while (frames > 0) {
+        const size_t count = std::min(frames, size - fill_);
+
+        std::memcpy(input_.data() + fill_, in, count * sizeof(float));
+        if (out) {
+            std::memcpy(out, output_.data() + output_position_, count * sizeof(float));
+            out += count;
+        }
+        fill_ += count;
+        output_position_ += count;
+        in += count;
+        frames -= count;
+
+        if (fill_ == size) {
+            processFrame(out != nullptr);
+            std::memmove(input_.data(), input_.data() + hop_size_, (size - hop_size_) * sizeof(float));
+            fill_ = size - hop_size_;
+            output_position_ = 0;
+            ++completed;
+        }
+    }
+
+    return completed;
+}
+
+void SpectralAnalyzer::processFrame(bool synthesize) {
+    const size_t size = fft_.size();
+    const float* window = window_->data();
+
+    for (size_t n = 0; n < size; ++n) {
+        frame_[n] = input_[n] * window[n];
+    }
+    fft_.forward(frame_.data());
+    extractPeaks();
+    ++frame_count_;
+
+    if (!synthesize) return;
+
+    if (spectrum_processor_) {
+        spectrum_processor_(frame_.data(), size);
+    }
+    fft_.inverse(frame_.data());
+
+    // Overlap-add с синтезирующим окном; первые hop_size отсчетов готовы
+    for (size_t n = 0; n < size; ++n) {
+        overlap_[n] += frame_[n] * window[n] * synthesis_gain_;
+    }
+    std::memcpy(output_.data(), overlap_.data(), hop_size_ * sizeof(float));
+    std::memmove(overlap_.data(), overlap_.data() + hop_size_, (size - hop_size_) * sizeof(float));
+    std::fill(overlap_.end() - hop_size_, overlap_.end(), 0.0f);
+}
+
+void SpectralAnalyzer::extractPeaks() {
+    const size_t size = fft_.size();
+    const size_t bins = size / 2;
+    const float* spectrum = frame_.data();
+
+    power_[0] = spectrum[0] * spectrum[0];
+    power_[bins] = spectrum[1] * spectrum[1];
+    for (size_t k = 1; k < bins; ++k) {
+        power_[k] = spectrum[2 * k] * spectrum[2 * k] + spectrum[2 * k + 1] * spectrum[2 * k + 1];
+    }
+
+    peaks_.clear();
+    if (max_peaks_ == 0) return;
+
+    const double bin_width = sample_rate_ / static_cast<double>(size);
+    const size_t first = std::max<size_t>(1, static_cast<size_t>(std::ceil(min_frequency_ / bin_width)));
+    if (first + 1 >= bins) return;
+
+    float strongest = 0.0f;
+    for (size_t k = first; k < bins; ++k) {
+        strongest = std::max(strongest, power_[k]);
+    }
+    const float threshold = static_cast<float>(std::max(absolute_threshold_, strongest * relative_threshold_));
+
+    for (size_t k = first; k < bins; ++k) {
+        const float p = power_[k];
+        if (p <= threshold || p <= power_[k - 1] || p < power_[k + 1]) continue;
+
+        // Параболическая интерполяция логарифма модуля по трем отсчетам
+        const double a = 0.5 * std::log(static_cast<double>(power_[k - 1]) + 1e-30);
+        const double b = 0.5 * std::log(static_cast<double>(p));
+        const double c = 0.5 * std::log(static_cast<double>(power_[k + 1]) + 1e-30);
+        const double denominator = a - 2.0 * b + c;
+        const double delta = denominator < 0.0 ? std::min(0.5, std::max(-0.5, 0.5 * (a - c) / denominator)) : 0.0;
+
+        SpectralPeak peak;
+        peak.frequency = (static_cast<double>(k) + delta) * bin_width;
+        peak.amplitude = std::exp(b - 0.25 * (a - c) * delta) * amplitude_scale_;
+        peak.phase = std::atan2(spectrum[2 * k + 1], spectrum[2 * k]);
+
+        // Держим не более max_peaks_ сильнейших пиков, по убыванию амплитуды
+        if (peaks_.size() == max_peaks_) {
+            if (peak.amplitude <= peaks_.back().amplitude) continue;
+            peaks_.back() = peak;
+        } else {
+            peaks_.push_back(peak);
+        }
+        for (size_t i = peaks_.size() - 1; i > 0 && peaks_[i].amplitude > peaks_[i - 1].amplitude; --i) {
+            std::swap(peaks_[i], peaks_[i - 1]);
+        }
+    }
+}
+
+} // namespace AnantaDigital
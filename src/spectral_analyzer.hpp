@@ -0,0 +1,109 @@
+#pragma once
+
+#include "real_fft.hpp"
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Оконные функции анализа
+enum class WindowType {
+    HANN,
+    HAMMING,
+    BLACKMAN
+};
+
+// Общий кэш окон: одно окно данного типа и размера на процесс.
+// Вызывать вне аудио-потока (первый запрос строит окно под мьютексом).
+std::shared_ptr<const std::vector<float>> getCachedWindow(WindowType type, size_t size);
+
+// Спектральный пик кадра
+struct SpectralPeak {
+    double frequency;   // Гц (параболическая интерполяция между отсчетами)
+    double amplitude;   // оценка амплитуды синусоиды
+    double phase;       // фаза в отсчете максимума, радианы
+};
+
+// Потоковый анализ STFT с перекрытием.
+//
+// Входной поток режется на кадры fft_size с шагом hop_size, каждый кадр
+// взвешивается кэшированным окном и преобразуется вещественным БПФ на месте.
+// Из спектра извлекаются до max_peaks самых сильных пиков. Если задан
+// выходной буфер, кадры собираются обратно методом overlap-add (задержка
+// fft_size отсчетов); перед синтезом спектр можно изменить обработчиком.
+// После конструктора process() не выделяет память.
+class SpectralAnalyzer {
+public:
+    // Обработчик упакованного спектра (формат RealFFT) перед синтезом
+    using SpectrumProcessor = std::function<void(float* spectrum, size_t fft_size)>;
+
+private:
+    RealFFT fft_;
+    size_t hop_size_;
+    WindowType window_type_;
+    std::shared_ptr<const std::vector<float>> window_;
+    double sample_rate_;
+
+    // Потоковое состояние
+    std::vector<float> input_;          // скользящее окно входа, fft_size
+    size_t fill_;                       // заполнено отсчетов в input_
+    std::vector<float> frame_;          // рабочий кадр / спектр
+    std::vector<float> overlap_;        // накопитель overlap-add, fft_size
+    std::vector<float> output_;         // готовые отсчеты выхода, hop_size
+    size_t output_position_;
+    float synthesis_gain_;              // нормировка суммы перекрытий окна
+    float amplitude_scale_;             // 2 / сумма окна
+
+    // Пики последнего кадра
+    std::vector<float> power_;
+    std::vector<SpectralPeak> peaks_;
+    size_t max_peaks_;
+    double relative_threshold_;         // доля мощности сильнейшего отсчета
+    double absolute_threshold_;         // минимальная мощность отсчета
+    double min_frequency_;
+    size_t frame_count_;
+
+    SpectrumProcessor spectrum_processor_;
+
+public:
+    // fft_size округляется до степени двойки, hop_size ограничивается [1, fft_size]
+    explicit SpectralAnalyzer(size_t fft_size = 2048, size_t hop_size = 512,
+                              WindowType window = WindowType::HANN);
+
+    void setSampleRate(double sample_rate);
+    double getSampleRate() const { return sample_rate_; }
+
+    // Параметры поиска пиков: порог относительно сильнейшего пика (дБ)
+    // и абсолютный порог амплитуды (дБ полной шкалы)
+    void setMaxPeaks(size_t max_peaks);
+    void setPeakThreshold(double relative_db, double absolute_db = -100.0);
+    void setMinFrequency(double frequency) { min_frequency_ = frequency; }
+    size_t getMaxPeaks() const { return max_peaks_; }
+
+    void setSpectrumProcessor(SpectrumProcessor processor) { spectrum_processor_ = std::move(processor); }
+
+    // Обработать frames отсчетов; возвращает число завершенных кадров.
+    // out (может быть nullptr) получает сигнал overlap-add с задержкой fft_size.
+    size_t process(const float* in, float* out, size_t frames);
+    size_t process(const float* in, size_t frames) { return process(in, nullptr, frames); }
+
+    // Сбросить потоковое состояние
+    void reset();
+
+    // Пики последнего завершенного кадра, по убыванию амплитуды
+    const std::vector<SpectralPeak>& getPeaks() const { return peaks_; }
+
+    size_t getFFTSize() const { return fft_.size(); }
+    size_t getHopSize() const { return hop_size_; }
+    WindowType getWindowType() const { return window_type_; }
+    size_t getLatency() const { return fft_.size(); }
+    size_t getFrameCount() const { return frame_count_; }
+
+private:
+    void processFrame(bool synthesize);
+    void extractPeaks();
+};
+
+} // namespace AnantaDigital
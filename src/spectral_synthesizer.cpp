@@ -0,0 +1,173 @@
+#include "spectral_synthesizer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaDigital {
+
+namespace {
+
+size_t frameSizeFor(size_t frame_size) {
+    size_t size = 64;
+    while (size < frame_size) {
+        size <<= 1;
+    }
+    return size;
+}
+
+// Σ cos(2πxm/N) по m = -(N/2-1)..N/2-1 (ядро Дирихле)
+double dirichlet(double x, size_t size) {
+    const double n = static_cast<double>(size);
+    const double denominator = std::sin(M_PI * x / n);
+    if (std::abs(denominator) < 1e-12) return n - 1.0;
+    return std::sin(M_PI * x * (n - 1.0) / n) / denominator;
+}
+
+} // namespace
+
+SpectralSynthesizer::SpectralSynthesizer(size_t frame_size)
+    : fft_(frameSizeFor(frame_size))
+    , frame_size_(fft_.size())
+    , hop_size_(fft_.size() / 4)
+    , ready_position_(fft_.size() / 4)
+    , primed_(false) {
+    // Спектр окна Ханна в системе отсчета центра кадра вещественен:
+    // W(δ) = e^{-iπδ}·R(δ), R(δ) = 0.5·D(δ) + 0.25·D(δ - 1) + 0.25·D(δ + 1)
+    const double center = static_cast<double>(kKernelTaps / 2 - 1);
+    kernel_.resize((kKernelRows + 1) * kKernelTaps);
+    for (size_t row = 0; row <= kKernelRows; ++row) {
+        const double fraction = static_cast<double>(row) / kKernelRows;
+        for (size_t t = 0; t < kKernelTaps; ++t) {
+            const double delta = static_cast<double>(t) - center - fraction;
+            const double r = 0.5 * dirichlet(delta, frame_size_) + 0.25 * dirichlet(delta - 1.0, frame_size_) +
+                             0.25 * dirichlet(delta + 1.0, frame_size_);
+            // e^{-iπδ} = e^{iπb}·(-1)^floor(b)·(-1)^(t - center)
+            kernel_[row * kKernelTaps + t] = static_cast<float>((t - kKernelTaps / 2 + 1) % 2 == 0 ? r : -r);
+        }
+    }
+
+    spectrum_.assign(frame_size_ + 2, 0.0f);
+    taps_.assign(kKernelTaps, 0.0f);
+    overlap_.assign(frame_size_, 0.0f);
+    ready_.assign(hop_size_, 0.0f);
+}
+
+void SpectralSynthesizer::synthesizeFrame(const OscillatorBank& bank, double lead) {
+    std::fill(spectrum_.begin(), spectrum_.end(), 0.0f);
+
+    const long half = static_cast<long>(frame_size_ / 2);
+    const long taps = static_cast<long>(kKernelTaps);
+    const double bins_per_hz = static_cast<double>(frame_size_) / bank.getSampleRate();
+    const double lead_seconds = lead / bank.getSampleRate();
+    const float* frequencies = bank.frequencies();
+    const float* amplitudes = bank.amplitudes();
+    const float* phases = bank.phases();
+
+    for (size_t i = 0; i < bank.size(); ++i) {
+        const double b = frequencies[i] * bins_per_hz;
+        if (amplitudes[i] == 0.0f || !(b > 0.0) || b >= static_cast<double>(half)) continue;
+
+        // a·sin(2πft + φ) = Re{a·e^{i(φ - π/2)}·e^{i2πft}}; e^{iπb}·(-1)^floor(b) — сдвиг ядра
+        // к началу кадра. Угол приводится в циклах, пока он точен в double.
+        const double whole = std::floor(b);
+        double cycles = phases[i] + frequencies[i] * lead_seconds - 0.25 + 0.5 * (b + whole);
+        cycles -= std::floor(cycles);
+        const float angle = static_cast<float>(2.0 * M_PI * cycles);
+        const float base_re = 0.5f * amplitudes[i] * std::cos(angle);
+        const float base_im = 0.5f * amplitudes[i] * std::sin(angle);
+
+        // Ядро для дробной части b — между двумя соседними строками таблицы
+        const double position = (b - whole) * kKernelRows;
+        const size_t row = std::min(static_cast<size_t>(position), kKernelRows - 1);
+        const float weight = static_cast<float>(position - static_cast<double>(row));
+        const float* lower = kernel_.data() + row * kKernelTaps;
+        const float* upper = lower + kKernelTaps;
+        for (size_t t = 0; t < kKernelTaps; ++t) {
+            taps_[t] = lower[t] + weight * (upper[t] - lower[t]);
+        }
+
+        const long first = static_cast<long>(whole) - taps / 2 + 1;
+        if (first > 0 && first + taps < half) {
+            float* bins = spectrum_.data() + 2 * first;
+            for (size_t t = 0; t < kKernelTaps; ++t) {
+                bins[2 * t] += base_re * taps_[t];
+                bins[2 * t + 1] += base_im * taps_[t];
+            }
+            continue;
+        }
+
+        // У краев спектра бины за пределами 0..N/2 отражаются сопряженными
+        // (спектр вещественного сигнала), бины 0 и N/2 вещественны
+        for (long t = 0; t < taps; ++t) {
+            const long q = first + t;
+            const float re = base_re * taps_[t];
+            const float im = base_im * taps_[t];
+            if (q > 0 && q < half) {
+                spectrum_[2 * q] += re;
+                spectrum_[2 * q + 1] += im;
+            } else if (q == 0) {
+                spectrum_[0] += 2.0f * re;
+            } else if (q == half) {
+                spectrum_[1] += 2.0f * re;
+            } else {
+                const long mirror = q < 0 ? -q : 2 * half - q;
+                spectrum_[2 * mirror] += re;
+                spectrum_[2 * mirror + 1] -= im;
+            }
+        }
+    }
+
+    fft_.inverse(spectrum_.data());
+}
+
+void SpectralSynthesizer::accumulateFrame(size_t offset) {
+    // Окна Ханна с шагом N/4 в сумме дают 2
+    const float gain = 2.0f * static_cast<float>(hop_size_) / static_cast<float>(frame_size_);
+    for (size_t n = offset; n < frame_size_; ++n) {
+        overlap_[n - offset] += gain * spectrum_[n];
+    }
+}
+
+void SpectralSynthesizer::prime(const OscillatorBank& bank) {
+    std::fill(overlap_.begin(), overlap_.end(), 0.0f);
+    ready_position_ = hop_size_;
+
+    // Хвосты кадров, начавшихся за 1..3 шага до текущего отсчета
+    for (size_t back = frame_size_ / hop_size_ - 1; back > 0; --back) {
+        synthesizeFrame(bank, -static_cast<double>(back * hop_size_));
+        accumulateFrame(back * hop_size_);
+    }
+    primed_ = true;
+}
+
+void SpectralSynthesizer::reset() {
+    std::fill(overlap_.begin(), overlap_.end(), 0.0f);
+    ready_position_ = hop_size_;
+    primed_ = false;
+}
+
+void SpectralSynthesizer::render(OscillatorBank& bank, float* out, size_t frames) {
+    if (!out || frames == 0) return;
+    if (!primed_) prime(bank);
+
+    size_t written = 0;
+    while (written < frames) {
+        if (ready_position_ >= hop_size_) {
+            // Кадр начинается с текущего отсчета банка; первые hop_size_ отсчетов
+            // перекрытия после него окончательны
+            synthesizeFrame(bank, 0.0);
+            accumulateFrame(0);
+            std::copy(overlap_.begin(), overlap_.begin() + hop_size_, ready_.begin());
+            std::copy(overlap_.begin() + hop_size_, overlap_.end(), overlap_.begin());
+            std::fill(overlap_.end() - hop_size_, overlap_.end(), 0.0f);
+            ready_position_ = 0;
+        }
+
+        const size_t count = std::min(hop_size_ - ready_position_, frames - written);
+        std::copy(ready_.begin() + ready_position_, ready_.begin() + ready_position_ + count, out + written);
+        bank.advance(count);
+        ready_position_ += count;
+        written += count;
+    }
+}
+
+} // namespace AnantaDigital
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "oscillator_bank.hpp"
+#include "real_fft.hpp"
+#include <vector>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Аддитивный синтез обратным БПФ (FFT⁻¹) для больших банков осцилляторов.
+//
+// Каждый кадр длиной N — это сумма синусоид банка под окном Ханна. Спектр
+// кадра строится прямо в частотной области: синусоида частоты f дает ядро
+// окна W(k - b), b = f·N/fs, из kKernelTaps бинов вокруг b. Ядра заранее
+// сведены в таблицу по дробной части b (kKernelRows строк, линейная
+// интерполяция между соседними), так что партиал — это два прохода
+// по kKernelTaps отсчетам. Затем обратное БПФ и сложение с перекрытием
+// с шагом N/4 (сумма окон Ханна постоянна).
+// Стоимость кадра — O(партиалы·ядро + N log N) вместо O(партиалы·N) у банка.
+//
+// Параметры партиалов (частота, амплитуда, фаза, рампы) остаются в
+// OscillatorBank: render() берет их на начало каждого кадра и продвигает фазы
+// банка так же, как OscillatorBank::render(). Поэтому с синтезом банком можно
+// переключаться в любой момент без разрыва фазы; prime() заполняет перекрытие
+// кадрами, начавшимися до текущего отсчета, и первый блок выходит без нарастания.
+//
+// Частота и амплитуда внутри кадра постоянны: изменения сглаживаются окнами
+// на длине N, рампы короче кадра растягиваются. Погрешность усечения ядра —
+// около -60 дБ к уровню партиала.
+class SpectralSynthesizer {
+public:
+    static constexpr size_t kKernelTaps = 16;           // бинов ядра на партиал
+    static constexpr size_t kKernelRows = 256;          // строк таблицы на бин
+
+private:
+    RealFFT fft_;
+    size_t frame_size_;
+    size_t hop_size_;
+
+    // Строка r — ядро для дробной части b, равной r/kKernelRows: отсчет t — вклад
+    // в бин floor(b) - kKernelTaps/2 + 1 + t без множителя e^{iπb}·(-1)^floor(b)
+    std::vector<float> kernel_;
+    std::vector<float> spectrum_;       // упакованный спектр, затем кадр во времени
+    std::vector<float> taps_;           // ядро текущего партиала
+    std::vector<float> overlap_;        // сумма кадров; [0] — начало следующего кадра
+    std::vector<float> ready_;          // готовые отсчеты текущего шага
+    size_t ready_position_;             // hop_size_ — готовых отсчетов нет
+    bool primed_;
+
+public:
+    // frame_size округляется вверх до степени двойки (не меньше 64)
+    explicit SpectralSynthesizer(size_t frame_size = 2048);
+
+    size_t getFrameSize() const { return frame_size_; }
+    size_t getHopSize() const { return hop_size_; }
+
+    // Заполнить перекрытие кадрами, начавшимися до текущего отсчета банка
+    // (вне аудио-потока или при переключении на этот путь)
+    void prime(const OscillatorBank& bank);
+    bool isPrimed() const { return primed_; }
+
+    // Забыть перекрытие: следующий render() начнет с prime()
+    void reset();
+
+    // Синтез frames отсчетов банка в out (перезапись); фазы и рампы банка продвигаются
+    void render(OscillatorBank& bank, float* out, size_t frames);
+
+private:
+    // Кадр партиалов банка, начинающийся через lead отсчетов от текущего
+    // отсчета банка, — в spectrum_ (N отсчетов во времени)
+    void synthesizeFrame(const OscillatorBank& bank, double lead);
+
+    // Прибавить кадр с отсчета offset к перекрытию
+    void accumulateFrame(size_t offset);
+};
+
+} // namespace AnantaDigital
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "anantadigital_types.hpp"
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Что делать, когда пул полей заполнен
+enum class VoiceStealPolicy {
+    REJECT,             // Новое поле отклоняется
+    QUIETEST,           // Вытесняется самое тихое поле
+    OLDEST,             // Вытесняется самое старое поле (по sample_time)
+    LOWEST_PRIORITY     // Вытесняется поле с наименьшим priority, среди равных — самое тихое
+};
+
+// Лимиты пулов, задаваемые в AnantaDigitalCore::initialize().
+// Вся память выделяется заранее; на пути обработки пулы не растут.
+struct PoolLimits {
+    size_t max_fields = 4096;                   // поля FieldStore ядра
+    size_t max_sources_per_interference = 256;  // источники одного InterferenceField
+    size_t max_interference_fields = 64;        // объекты InterferenceField
+    VoiceStealPolicy steal_policy = VoiceStealPolicy::QUIETEST;
+};
+
+// Давление на пул
+struct PoolStatistics {
+    size_t capacity = 0;        // 0 — без ограничения
+    size_t in_use = 0;
+    size_t peak_in_use = 0;
+    uint64_t rejected = 0;      // отклонено из-за нехватки места
+    uint64_t stolen = 0;        // вытеснено новыми полями
+
+    double pressure() const {
+        return capacity > 0 ? static_cast<double>(in_use) / static_cast<double>(capacity) : 0.0;
+    }
+};
+
+// Признаки поля для выбора жертвы
+struct VoiceKey {
+    double level;
+    SampleTime start;
+    uint8_t priority;
+
+    static VoiceKey of(const std::complex<double>& amplitude, SampleTime start, uint8_t priority) {
+        return VoiceKey{std::norm(amplitude), start, priority};
+    }
+    static VoiceKey of(const QuantumSoundField& field) {
+        return of(field.amplitude, field.sample_time, field.priority);
+    }
+};
+
+// true, если candidate лучше подходит для вытеснения, чем current
+inline bool preferVictim(VoiceStealPolicy policy, const VoiceKey& candidate, const VoiceKey& current) {
+    switch (policy) {
+        case VoiceStealPolicy::QUIETEST:
+            return candidate.level < current.level;
+        case VoiceStealPolicy::OLDEST:
+            return candidate.start < current.start;
+        case VoiceStealPolicy::LOWEST_PRIORITY:
+            if (candidate.priority != current.priority) return candidate.priority < current.priority;
+            return candidate.level < current.level;
+        case VoiceStealPolicy::REJECT:
+        default:
+            return false;
+    }
+}
+
+} // namespace AnantaDigital
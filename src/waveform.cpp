@@ -0,0 +1,114 @@
+#include "waveform.hpp"
+#include "dsp_kernels.hpp"
+#include <cmath>
+
+namespace AnantaDigital {
+
+namespace {
+
+// Встроенные модели; t и r входят так же, как в прежней лямбде createQuantumSoundField
+template <WaveformType Type>
+inline std::complex<double> evaluateModel(double frequency, double r, double t) {
+    const double time_phase = 2.0 * M_PI * frequency * t;
+    const double space_phase = 2.0 * M_PI * r / Kernels::kSpeedOfSound;
+
+    switch (Type) {
+        case WaveformType::PLANE_WAVE:
+            return std::polar(1.0, time_phase - space_phase);
+        case WaveformType::SPHERICAL_WAVE:
+            return std::polar(Kernels::distanceAttenuation<double>(r), time_phase - space_phase);
+        case WaveformType::STANDING_WAVE:
+            return std::polar(std::cos(space_phase), time_phase);
+        default:
+            return std::complex<double>(0.0, 0.0);
+    }
+}
+
+} // namespace
+
+WaveFunctionRegistry::WaveFunctionRegistry()
+    : next_id_(1) {
+}
+
+WaveFunctionRegistry& WaveFunctionRegistry::instance() {
+    static WaveFunctionRegistry registry;
+    return registry;
+}
+
+WaveformDescriptor WaveFunctionRegistry::add(WaveFunction function, double frequency) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t id = next_id_++;
+    functions_.emplace(id, std::make_shared<const WaveFunction>(std::move(function)));
+    return WaveformDescriptor{WaveformType::CALLABLE, id, frequency};
+}
+
+bool WaveFunctionRegistry::remove(uint32_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return functions_.erase(id) > 0;
+}
+
+size_t WaveFunctionRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return functions_.size();
+}
+
+std::complex<double> WaveFunctionRegistry::evaluate(uint32_t id, double r, double theta, double phi, double t) const {
+    std::shared_ptr<const WaveFunction> function;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = functions_.find(id);
+        if (it != functions_.end()) {
+            function = it->second;
+        }
+    }
+    // Вызов вне мьютекса: параллельные вычисления не сериализуются, а remove()
+    // во время вызова лишь отпускает ссылку реестра
+    if (!function || !*function) {
+        return std::complex<double>(0.0, 0.0);
+    }
+    return (*function)(r, theta, phi, t);
+}
+
+std::complex<double> evaluateWaveform(const WaveformDescriptor& waveform,
+                                      double r, double theta, double phi, double t) {
+    switch (waveform.type) {
+        case WaveformType::PLANE_WAVE:
+            return evaluateModel<WaveformType::PLANE_WAVE>(waveform.frequency, r, t);
+        case WaveformType::SPHERICAL_WAVE:
+            return evaluateModel<WaveformType::SPHERICAL_WAVE>(waveform.frequency, r, t);
+        case WaveformType::STANDING_WAVE:
+            return evaluateModel<WaveformType::STANDING_WAVE>(waveform.frequency, r, t);
+        case WaveformType::CALLABLE:
+            return WaveFunctionRegistry::instance().evaluate(waveform.callable_id, r, theta, phi, t);
+        case WaveformType::NONE:
+        default:
+            return std::complex<double>(0.0, 0.0);
+    }
+}
+
+void evaluateWaveforms(const WaveformDescriptor* waveforms, size_t count,
+                       double r, double theta, double phi, double t,
+                       std::complex<double>* out) {
+    for (size_t i = 0; i < count; ++i) {
+        const WaveformDescriptor& waveform = waveforms[i];
+        switch (waveform.type) {
+            case WaveformType::PLANE_WAVE:
+                out[i] = evaluateModel<WaveformType::PLANE_WAVE>(waveform.frequency, r, t);
+                break;
+            case WaveformType::SPHERICAL_WAVE:
+                out[i] = evaluateModel<WaveformType::SPHERICAL_WAVE>(waveform.frequency, r, t);
+                break;
+            case WaveformType::STANDING_WAVE:
+                out[i] = evaluateModel<WaveformType::STANDING_WAVE>(waveform.frequency, r, t);
+                break;
+            case WaveformType::CALLABLE:
+                out[i] = WaveFunctionRegistry::instance().evaluate(waveform.callable_id, r, theta, phi, t);
+                break;
+            default:
+                out[i] = std::complex<double>(0.0, 0.0);
+                break;
+        }
+    }
+}
+
+} // namespace AnantaDigital
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "anantadigital_types.hpp"
+#include <complex>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaDigital {
+
+// Волновая функция в прежней форме: psi(r, theta, phi, t)
+using WaveFunction = std::function<std::complex<double>(double, double, double, double)>;
+
+// Реестр произвольных волновых функций — явный медленный путь.
+// Поле хранит только идентификатор; под мьютексом берется только ссылка
+// на функцию, сам вызов идет без блокировки, поэтому функция может
+// обращаться к реестру. Функцию нужно удалить, когда поля с ней больше не нужны.
+class WaveFunctionRegistry {
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<uint32_t, std::shared_ptr<const WaveFunction>> functions_;
+    uint32_t next_id_;
+
+    WaveFunctionRegistry();
+
+public:
+    static WaveFunctionRegistry& instance();
+
+    // Зарегистрировать функцию и получить описание CALLABLE
+    WaveformDescriptor add(WaveFunction function, double frequency = 0.0);
+    bool remove(uint32_t id);
+    size_t size() const;
+
+    std::complex<double> evaluate(uint32_t id, double r, double theta, double phi, double t) const;
+};
+
+// Значение волновой функции поля в точке (r, theta, phi) в момент t
+std::complex<double> evaluateWaveform(const WaveformDescriptor& waveform,
+                                      double r, double theta, double phi, double t);
+
+// Пакетное вычисление для массива описаний (SoA): встроенные модели
+// вычисляются без косвенных вызовов, CALLABLE — через реестр
+void evaluateWaveforms(const WaveformDescriptor* waveforms, size_t count,
+                       double r, double theta, double phi, double t,
+                       std::complex<double>* out);
+
+} // namespace AnantaDigital
@@ -0,0 +1,217 @@
+#include "worker_pool.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace AnantaDigital {
+
+namespace {
+
+constexpr uint64_t kIndexBits = 21;
+constexpr uint64_t kIndexMask = (uint64_t(1) << kIndexBits) - 1;
+constexpr uint64_t kGenerationMask = (uint64_t(1) << (64 - 2 * kIndexBits)) - 1;
+
+inline uint64_t packRange(uint64_t generation, uint64_t next, uint64_t end) {
+    return ((generation & kGenerationMask) << (2 * kIndexBits)) | (next << kIndexBits) | end;
+}
+
+inline uint64_t rangeGeneration(uint64_t state) { return state >> (2 * kIndexBits); }
+inline uint64_t rangeNext(uint64_t state) { return (state >> kIndexBits) & kIndexMask; }
+inline uint64_t rangeEnd(uint64_t state) { return state & kIndexMask; }
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+} // namespace
+
+WorkerPool::WorkerPool(size_t worker_count, bool pin_threads)
+    : worker_count_(worker_count)
+    , invoker_(nullptr)
+    , context_(nullptr)
+    , remaining_(0)
+    , generation_(0)
+    , stopping_(false)
+    , spin_iterations_(0) {
+    const size_t hardware = std::max<unsigned>(1, std::thread::hardware_concurrency());
+    if (worker_count_ == 0) {
+        worker_count_ = hardware;
+    }
+
+    // На одноядерной машине активное ожидание только мешает
+    spin_iterations_ = hardware > 1 ? 20000 : 0;
+
+    ranges_.reset(new TaskRange[worker_count_]);
+    for (size_t w = 0; w < worker_count_; ++w) {
+        ranges_[w].state.store(packRange(0, 0, 0), std::memory_order_relaxed);
+    }
+
+    // Поток 0 — вызывающий, остальные создаются здесь
+    threads_.reserve(worker_count_ - 1);
+    for (size_t w = 1; w < worker_count_; ++w) {
+        threads_.emplace_back([this, w, pin_threads, hardware]() {
+            if (pin_threads) {
+                pinCurrentThread(w % hardware);
+            }
+            workerLoop(w);
+        });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_.store(true, std::memory_order_release);
+    }
+    wake_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+size_t WorkerPool::homeWorker(size_t task, size_t count) const {
+    if (count == 0) return 0;
+    // Обратное к разбиению в dispatch(): диапазон потока w — [count*w/W, count*(w+1)/W)
+    size_t worker = (task * worker_count_) / count;
+    while (worker > 0 && task < count * worker / worker_count_) --worker;
+    while (worker + 1 < worker_count_ && task >= count * (worker + 1) / worker_count_) ++worker;
+    return worker;
+}
+
+void WorkerPool::dispatch(size_t count, TaskInvoker invoker, void* context) {
+    if (count == 0) return;
+
+    if (worker_count_ == 1) {
+        for (size_t task = 0; task < count; ++task) {
+            invoker(context, task, 0);
+        }
+        return;
+    }
+
+    // Задачи сверх kMaxTasks выполняются последовательными порциями
+    if (count > kMaxTasks) {
+        struct Offset {
+            TaskInvoker invoker;
+            void* context;
+            size_t base;
+        };
+        for (size_t base = 0; base < count; base += kMaxTasks) {
+            Offset offset{invoker, context, base};
+            dispatch(std::min(kMaxTasks, count - base), [](void* ctx, size_t task, size_t worker) {
+                auto* o = static_cast<Offset*>(ctx);
+                o->invoker(o->context, o->base + task, worker);
+            }, &offset);
+        }
+        return;
+    }
+
+    const uint64_t generation = generation_.load(std::memory_order_relaxed) + 1;
+
+    invoker_ = invoker;
+    context_ = context;
+    remaining_.store(count, std::memory_order_relaxed);
+
+    // Статическое разбиение: поток w получает одни и те же задачи каждый блок
+    for (size_t w = 0; w < worker_count_; ++w) {
+        uint64_t begin = count * w / worker_count_;
+        uint64_t end = count * (w + 1) / worker_count_;
+        ranges_[w].state.store(packRange(generation, begin, end), std::memory_order_release);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        generation_.store(generation, std::memory_order_release);
+    }
+    wake_cv_.notify_all();
+
+    drain(0, generation);
+
+    // Барьер: ждем, пока все задачи блока будут выполнены
+    uint32_t spins = 0;
+    while (remaining_.load(std::memory_order_acquire) != 0) {
+        if (++spins < spin_iterations_) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void WorkerPool::workerLoop(size_t worker) {
+    uint64_t seen = 0;
+
+    while (true) {
+        // Короткое активное ожидание, затем сон до следующего блока
+        uint32_t spins = 0;
+        while (generation_.load(std::memory_order_acquire) == seen &&
+               !stopping_.load(std::memory_order_acquire) &&
+               spins < spin_iterations_) {
+            cpuRelax();
+            ++spins;
+        }
+
+        if (generation_.load(std::memory_order_acquire) == seen) {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_cv_.wait(lock, [&]() {
+                return generation_.load(std::memory_order_acquire) != seen ||
+                       stopping_.load(std::memory_order_acquire);
+            });
+        }
+
+        if (stopping_.load(std::memory_order_acquire)) return;
+
+        seen = generation_.load(std::memory_order_acquire);
+        drain(worker, seen);
+    }
+}
+
+void WorkerPool::drain(size_t worker, uint64_t generation) {
+    size_t task;
+    while (claimTask(worker, generation, task)) {
+        invoker_(context_, task, worker);
+        remaining_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+bool WorkerPool::claimTask(size_t worker, uint64_t generation, size_t& task) {
+    const uint64_t tag = generation & kGenerationMask;
+
+    // Сначала свой диапазон, затем кража у соседей по кольцу
+    for (size_t k = 0; k < worker_count_; ++k) {
+        TaskRange& range = ranges_[(worker + k) % worker_count_];
+        uint64_t state = range.state.load(std::memory_order_acquire);
+        while (rangeGeneration(state) == tag && rangeNext(state) < rangeEnd(state)) {
+            uint64_t claimed = packRange(generation, rangeNext(state) + 1, rangeEnd(state));
+            if (range.state.compare_exchange_weak(state, claimed, std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)) {
+                task = static_cast<size_t>(rangeNext(state));
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void WorkerPool::pinCurrentThread(size_t cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(cpu), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+} // namespace AnantaDigital
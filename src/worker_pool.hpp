@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+namespace AnantaDigital {
+
+// Фиксированный пул рабочих потоков для поблочной параллельной обработки.
+//
+// run() раздает задачи 0..count-1: каждый поток сначала берет задачи из своего
+// диапазона (подсказка привязки — одна и та же задача попадает на тот же поток
+// от блока к блоку), затем крадет оставшиеся задачи у соседей. Вызывающий поток
+// участвует как поток 0. Возврат из run() — единственный барьер на блок.
+// run() не выделяет память и не создает потоков.
+class WorkerPool {
+private:
+    // Диапазон задач потока в одном атомарном слове: поколение | next | end.
+    // Поколение отсекает устаревших воров из предыдущего блока.
+    struct alignas(64) TaskRange {
+        std::atomic<uint64_t> state;
+    };
+
+    using TaskInvoker = void (*)(void* context, size_t task, size_t worker);
+
+    std::vector<std::thread> threads_;
+    std::unique_ptr<TaskRange[]> ranges_;
+    size_t worker_count_;
+
+    // Текущее задание
+    TaskInvoker invoker_;
+    void* context_;
+    std::atomic<size_t> remaining_;
+
+    // Пробуждение рабочих потоков
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<uint64_t> generation_;
+    std::atomic<bool> stopping_;
+    uint32_t spin_iterations_;
+
+public:
+    // worker_count включает вызывающий поток; 0 — по числу ядер
+    explicit WorkerPool(size_t worker_count = 0, bool pin_threads = false);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    size_t getWorkerCount() const { return worker_count_; }
+
+    // Сколько итераций поток ожидает задание активно, прежде чем уснуть
+    void setSpinIterations(uint32_t iterations) { spin_iterations_ = iterations; }
+
+    // Максимальное число задач за один вызов run()
+    static constexpr size_t kMaxTasks = (size_t(1) << 21) - 1;
+
+    // Выполнить fn(task, worker) для всех task из [0, count) и дождаться завершения
+    template <typename Fn>
+    void run(size_t count, Fn&& fn) {
+        using FnType = typename std::remove_reference<Fn>::type;
+        dispatch(count, [](void* context, size_t task, size_t worker) {
+            (*static_cast<FnType*>(context))(task, worker);
+        }, const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+    // Поток, который по умолчанию получает задачу task при count задачах
+    size_t homeWorker(size_t task, size_t count) const;
+
+private:
+    void dispatch(size_t count, TaskInvoker invoker, void* context);
+    void workerLoop(size_t worker);
+    void drain(size_t worker, uint64_t generation);
+    bool claimTask(size_t worker, uint64_t generation, size_t& task);
+    static void pinCurrentThread(size_t cpu);
+};
+
+} // namespace AnantaDigital
@@ -0,0 +1,227 @@
+#include "../src/ambisonic_renderer.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaDigital;
+
+// Точки, почти равномерно покрывающие сферу (сетка Фибоначчи)
+static std::vector<SphericalCoord> makeSphere(size_t count, double radius) {
+    std::vector<SphericalCoord> points;
+    const double golden_angle = M_PI * (3.0 - std::sqrt(5.0));
+    for (size_t i = 0; i < count; ++i) {
+        double z = 1.0 - (2.0 * i + 1.0) / count;
+        points.push_back(SphericalCoord{radius, std::acos(z), golden_angle * i, 0.0});
+    }
+    return points;
+}
+
+// Купол: кольца громкоговорителей на высотах 0°, 30°, 60° и зенит
+static std::vector<SphericalCoord> makeDome(double radius) {
+    std::vector<SphericalCoord> speakers;
+    const int rings[] = {16, 12, 8};
+    for (int ring = 0; ring < 3; ++ring) {
+        double theta = M_PI / 2 - ring * M_PI / 6;
+        for (int s = 0; s < rings[ring]; ++s) {
+            speakers.push_back(SphericalCoord{radius, theta, 2.0 * M_PI * (s + 0.5 * ring) / rings[ring], 0.0});
+        }
+    }
+    speakers.push_back(SphericalCoord{radius, 0.0, 0.0, 0.0});
+    return speakers;
+}
+
+void test_spherical_harmonics() {
+    std::cout << "Testing real spherical harmonics..." << std::endl;
+
+    const double theta = 1.1, phi = -0.7;
+    std::vector<double> y(Kernels::sphericalHarmonicCount(2));
+    Kernels::realSphericalHarmonics(2, theta, phi, y.data());
+    const double k1 = std::sqrt(3.0 / (4.0 * M_PI));
+    assert(std::abs(y[0] - 1.0 / std::sqrt(4.0 * M_PI)) < 1e-12);
+    assert(std::abs(y[1] - k1 * std::sin(theta) * std::sin(phi)) < 1e-12);
+    assert(std::abs(y[2] - k1 * std::cos(theta)) < 1e-12);
+    assert(std::abs(y[3] - k1 * std::sin(theta) * std::cos(phi)) < 1e-12);
+    assert(std::abs(y[6] - std::sqrt(5.0 / (16.0 * M_PI)) * (3.0 * std::cos(theta) * std::cos(theta) - 1.0)) < 1e-12);
+
+    // Одна гармоника совпадает с соответствующим коэффициентом полного набора
+    std::vector<double> all(Kernels::sphericalHarmonicCount(AmbisonicRenderer::kMaxOrder));
+    Kernels::realSphericalHarmonics(AmbisonicRenderer::kMaxOrder, theta, phi, all.data());
+    for (int l = 0; l <= AmbisonicRenderer::kMaxOrder; ++l) {
+        for (int m = -l; m <= l; ++m) {
+            const double single = Kernels::realSphericalHarmonic(l, m, theta, phi);
+            assert(std::abs(single - all[Kernels::sphericalHarmonicIndex(l, m)]) < 1e-12);
+        }
+    }
+    assert(Kernels::realSphericalHarmonic(2, 3, theta, phi) == 0.0);
+
+    // Ортонормированность до 7-го порядка (квадратура по сетке Фибоначчи)
+    const int order = AmbisonicRenderer::kMaxOrder;
+    const size_t channels = Kernels::sphericalHarmonicCount(order);
+    const auto points = makeSphere(20000, 1.0);
+    std::vector<double> gram(channels * channels, 0.0);
+    std::vector<double> harmonics(channels);
+    for (const auto& point : points) {
+        Kernels::realSphericalHarmonics(order, point.theta, point.phi, harmonics.data());
+        for (size_t i = 0; i < channels; ++i) {
+            for (size_t j = 0; j < channels; ++j) {
+                gram[i * channels + j] += harmonics[i] * harmonics[j] * 4.0 * M_PI / points.size();
+            }
+        }
+    }
+    for (size_t i = 0; i < channels; ++i) {
+        for (size_t j = 0; j < channels; ++j) {
+            assert(std::abs(gram[i * channels + j] - (i == j ? 1.0 : 0.0)) < 1e-2);
+        }
+    }
+
+    std::cout << "Spherical harmonic tests passed!" << std::endl;
+}
+
+void test_mode_matching() {
+    std::cout << "Testing mode-matching decoder..." << std::endl;
+
+    // На плотной сферической расстановке декодер восстанавливает поле шины
+    const int order = 3;
+    AmbisonicRenderer renderer;
+    renderer.setOrder(order);
+    renderer.setMaxRE(false);
+    const auto speakers = makeSphere(100, 5.0);
+    renderer.setSpeakers(speakers, AmbisonicDecoder::MODE_MATCHING);
+
+    const size_t channels = renderer.getChannelCount();
+    const auto& decode = renderer.getDecodeMatrix();
+    std::vector<double> target(channels), feeds(speakers.size()), harmonics(channels);
+    Kernels::realSphericalHarmonics(order, 0.8, 2.0, target.data());
+    for (size_t s = 0; s < speakers.size(); ++s) {
+        feeds[s] = 0.0;
+        for (size_t c = 0; c < channels; ++c) feeds[s] += decode[s * channels + c] * target[c];
+    }
+
+    std::vector<double> reencoded(channels, 0.0);
+    for (size_t s = 0; s < speakers.size(); ++s) {
+        Kernels::realSphericalHarmonics(order, speakers[s].theta, speakers[s].phi, harmonics.data());
+        for (size_t c = 0; c < channels; ++c) reencoded[c] += harmonics[c] * feeds[s];
+    }
+    for (size_t c = 0; c < channels; ++c) {
+        assert(std::abs(reencoded[c] - target[c]) < 1e-2);
+    }
+
+    std::cout << "Mode-matching decoder tests passed!" << std::endl;
+}
+
+void test_allrad_dome() {
+    std::cout << "Testing AllRAD dome decoding..." << std::endl;
+
+    const auto speakers = makeDome(8.0);
+    const size_t frames = 64;
+
+    AmbisonicRenderer renderer;
+    renderer.setOrder(5);
+    renderer.setSpeakers(speakers, AmbisonicDecoder::ALLRAD);
+    renderer.prepare(frames, 1);
+    renderer.setSourceCount(1);
+
+    std::vector<float> signal(frames, 1.0f);
+    const float* sources[] = {signal.data()};
+    std::vector<std::vector<float>> planar(speakers.size(), std::vector<float>(frames));
+    std::vector<float*> outputs;
+    for (auto& channel : planar) outputs.push_back(channel.data());
+
+    // Источник в направлении громкоговорителя громче всего в нем самом
+    double min_energy = 1e9, max_energy = 0.0;
+    for (size_t target = 0; target < speakers.size(); ++target) {
+        renderer.setSource(0, speakers[target]);
+        renderer.render(sources, frames, outputs.data());
+
+        size_t loudest = 0;
+        double energy = 0.0;
+        for (size_t s = 0; s < speakers.size(); ++s) {
+            assert(std::isfinite(planar[s][0]));
+            energy += planar[s][0] * planar[s][0];
+            if (std::abs(planar[s][0]) > std::abs(planar[loudest][0])) loudest = s;
+        }
+        assert(loudest == target);
+        min_energy = std::min(min_energy, energy);
+        max_energy = std::max(max_energy, energy);
+    }
+
+    // Громкость почти не зависит от направления (в пределах 3 дБ)
+    assert(10.0 * std::log10(max_energy / min_energy) < 3.0);
+
+    std::cout << "AllRAD dome decoding tests passed!" << std::endl;
+}
+
+void test_render_matches_reference() {
+    std::cout << "Testing AmbisonicRenderer block rendering..." << std::endl;
+
+    const auto speakers = makeDome(6.0);
+    const size_t frames = 100;  // не кратно ширине SIMD
+    const size_t source_count = 6;
+
+    AmbisonicRenderer renderer;
+    renderer.setOrder(AmbisonicRenderer::kMaxOrder);
+    renderer.setSpeakers(speakers);
+    renderer.prepare(frames, 8);
+    assert(renderer.getChannelCount() == 64);
+
+    std::vector<std::vector<float>> encodings(source_count, std::vector<float>(renderer.getChannelCount()));
+    for (size_t j = 0; j < source_count; ++j) {
+        SphericalCoord position{2.0 + j, 0.3 + 0.2 * j, 1.1 * j, 0.5};
+        renderer.computeSourceEncoding(position, 1.0, InterferenceFieldType::CONSTRUCTIVE, encodings[j].data());
+        renderer.setSourceEncoding(j, encodings[j].data());
+    }
+    renderer.setSourceCount(source_count);
+
+    std::vector<std::vector<float>> signals(source_count, std::vector<float>(frames));
+    std::vector<const float*> sources;
+    for (size_t j = 0; j < source_count; ++j) {
+        for (size_t t = 0; t < frames; ++t) {
+            signals[j][t] = static_cast<float>(std::sin(0.05 * (j + 1) * t));
+        }
+        sources.push_back(signals[j].data());
+    }
+
+    std::vector<std::vector<float>> planar(speakers.size(), std::vector<float>(frames));
+    std::vector<float*> outputs;
+    for (auto& channel : planar) outputs.push_back(channel.data());
+    std::vector<float> interleaved(speakers.size() * frames);
+    renderer.render(sources.data(), frames, outputs.data());
+    renderer.renderInterleaved(sources.data(), frames, interleaved.data());
+
+    // Эталон: декодирование суммы закодированных источников в double
+    const size_t channels = renderer.getChannelCount();
+    const auto& decode = renderer.getDecodeMatrix();
+    for (size_t t = 0; t < frames; ++t) {
+        std::vector<double> bus(channels, 0.0);
+        for (size_t j = 0; j < source_count; ++j) {
+            for (size_t c = 0; c < channels; ++c) bus[c] += encodings[j][c] * signals[j][t];
+        }
+        for (size_t s = 0; s < speakers.size(); ++s) {
+            double expected = 0.0;
+            for (size_t c = 0; c < channels; ++c) expected += decode[s * channels + c] * bus[c];
+            assert(std::abs(planar[s][t] - expected) < 1e-4);
+            assert(planar[s][t] == interleaved[t * speakers.size() + s]);
+        }
+    }
+
+    std::cout << "AmbisonicRenderer block rendering tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== AmbisonicRenderer Tests ===" << std::endl;
+
+    try {
+        test_spherical_harmonics();
+        test_mode_matching();
+        test_allrad_dome();
+        test_render_matches_reference();
+
+        std::cout << "All ambisonic renderer tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,276 @@
+#include "../src/audibility_culler.hpp"
+#include "../src/anantadigital_core.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace AnantaDigital;
+
+// Набор полей в SoA для AudibilityCuller
+struct FieldSet {
+    std::vector<double> frequencies;
+    std::vector<std::complex<double>> amplitudes;
+    std::vector<SphericalCoord> positions;
+
+    void add(double frequency, double amplitude, const SphericalCoord& position) {
+        frequencies.push_back(frequency);
+        amplitudes.emplace_back(amplitude, 0.0);
+        positions.push_back(position);
+    }
+
+    void plan(AudibilityCuller& culler) const {
+        culler.plan(frequencies.data(), amplitudes.data(), positions.data(), frequencies.size());
+    }
+};
+
+// Без слияния и маскировки
+static CullingSettings plainSettings() {
+    CullingSettings settings;
+    settings.masking_db = 0.0;
+    settings.cluster_distance = 0.0;
+    return settings;
+}
+
+void test_level_culling() {
+    std::cout << "Testing level culling and voice order..." << std::endl;
+
+    FieldSet fields;
+    fields.add(440.0, 0.2, SphericalCoord{2.0, M_PI / 2, 0.0, 0.0});
+    fields.add(550.0, 1e-6, SphericalCoord{2.0, M_PI / 2, 1.0, 0.0});    // ниже -100 дБ
+    fields.add(660.0, -0.8, SphericalCoord{5.0, M_PI / 2, 2.0, 0.0});
+    fields.add(770.0, 0.5, SphericalCoord{40.0, M_PI / 2, 3.0, 0.0});
+
+    AudibilityCuller culler;
+    culler.setSettings(plainSettings());
+    fields.plan(culler);
+    const auto& voices = culler.getVoices();
+    assert(voices.size() == 3);
+    assert(culler.getStatistics().fields == 4 && culler.getStatistics().culled_silent == 1);
+
+    // Уровень у слушателя — амплитуда с затуханием 1/(1 + 0.1·d), голоса по убыванию
+    assert(voices[0].field == 2 && voices[1].field == 0 && voices[2].field == 3);
+    assert(std::abs(voices[0].level - 0.8 / 1.5) < 1e-6);
+    assert(std::abs(voices[2].level - 0.5 / 5.0) < 1e-6);
+    assert(voices[0].amplitude == -0.8 && voices[0].members == 1);
+
+    // Предел голосов отбрасывает самые тихие
+    CullingSettings limited = plainSettings();
+    limited.max_voices = 2;
+    culler.setSettings(limited);
+    fields.plan(culler);
+    assert(culler.getVoices().size() == 2 && culler.getStatistics().culled_limit == 1);
+    assert(culler.getVoices()[1].field == 0);
+
+    // Выключенный отбор оставляет все поля в исходном порядке
+    CullingSettings disabled;
+    disabled.enabled = false;
+    culler.setSettings(disabled);
+    fields.plan(culler);
+    assert(culler.getVoices().size() == 4);
+    for (size_t i = 0; i < 4; ++i) {
+        assert(culler.getVoices()[i].field == i);
+    }
+
+    std::cout << "Level culling tests passed!" << std::endl;
+}
+
+void test_distant_clusters() {
+    std::cout << "Testing distant field clustering..." << std::endl;
+
+    // 20 дальних полей одной частоты в одной ячейке, 5 дальних другой частоты
+    // и 10 ближних той же частоты
+    FieldSet fields;
+    for (int k = 0; k < 20; ++k) {
+        fields.add(440.0, 0.1, SphericalCoord{100.0 + 0.1 * k, M_PI / 2, 0.001 * k, 0.0});
+    }
+    for (int k = 0; k < 5; ++k) {
+        fields.add(880.0, 0.1 + 0.01 * k, SphericalCoord{102.0, M_PI / 2, 0.001 * k, 0.0});
+    }
+    for (int k = 0; k < 10; ++k) {
+        fields.add(440.0, 0.1, SphericalCoord{3.0, M_PI / 2, 0.5 * k, 0.0});
+    }
+
+    CullingSettings settings = plainSettings();
+    settings.cluster_distance = 30.0;
+    AudibilityCuller culler;
+    culler.setSettings(settings);
+    fields.plan(culler);
+
+    const auto& voices = culler.getVoices();
+    assert(voices.size() == 12);
+    assert(culler.getStatistics().merged == 23);
+
+    size_t clusters = 0;
+    for (const auto& voice : voices) {
+        if (voice.members == 1) {
+            assert(voice.frequency == 440.0 && voice.position.r == 3.0);
+            continue;
+        }
+        ++clusters;
+        assert(voice.position.r > 99.0 && voice.position.r < 103.0);
+        if (voice.members == 20) {
+            // Некогерентная сумма: амплитуда sqrt(Σa²), частота без изменений
+            assert(std::abs(voice.amplitude - 0.1 * std::sqrt(20.0)) < 1e-12);
+            assert(std::abs(voice.frequency - 440.0) < 1e-9);
+        } else {
+            // Представитель — самое громкое поле скопления
+            assert(voice.members == 5 && voice.field == 24);
+            assert(std::abs(voice.frequency - 880.0) < 1e-9);
+        }
+    }
+    assert(clusters == 2);
+
+    // Нулевые дальние поля при пороге -∞ не дают NaN в скоплении
+    FieldSet silent;
+    for (int k = 0; k < 4; ++k) {
+        silent.add(440.0, 0.0, SphericalCoord{100.0 + 0.1 * k, M_PI / 2, 0.001 * k, 0.0});
+    }
+    silent.add(880.0, 0.1, SphericalCoord{100.5, M_PI / 2, 0.0, 0.0});
+    settings.threshold_db = -std::numeric_limits<double>::infinity();
+    culler.setSettings(settings);
+    silent.plan(culler);
+    assert(culler.getVoices().size() == 1 && culler.getStatistics().culled_silent == 4);
+    const auto& survivor = culler.getVoices()[0];
+    assert(survivor.members == 1 && survivor.field == 4 && survivor.frequency == 880.0);
+    assert(std::isfinite(survivor.position.r) && std::isfinite(survivor.amplitude));
+
+    std::cout << "Distant field clustering tests passed!" << std::endl;
+}
+
+void test_masking() {
+    std::cout << "Testing critical band masking..." << std::endl;
+
+    assert(AudibilityCuller::barkBand(50.0) == 0);
+    assert(AudibilityCuller::barkBand(1000.0) == 8);
+    assert(AudibilityCuller::barkBand(20000.0) == AudibilityCuller::kBarkBands - 1);
+
+    // Тихое поле рядом с громким по частоте маскируется, в другой полосе — нет
+    FieldSet fields;
+    const SphericalCoord position{2.0, M_PI / 2, 0.0, 0.0};
+    fields.add(1000.0, 1.0, position);
+    fields.add(1010.0, 1e-4, position);
+    fields.add(5000.0, 1e-4, position);
+
+    CullingSettings settings = plainSettings();
+    settings.masking_db = 60.0;
+    AudibilityCuller culler;
+    culler.setSettings(settings);
+    fields.plan(culler);
+    assert(culler.getVoices().size() == 2 && culler.getStatistics().culled_masked == 1);
+    assert(culler.getVoices()[1].field == 2);
+
+    std::cout << "Critical band masking tests passed!" << std::endl;
+}
+
+void test_voice_budget() {
+    std::cout << "Testing CPU voice budget..." << std::endl;
+
+    VoiceBudget budget;
+    assert(budget.getLimit() == VoiceBudget::kUnlimited);
+
+    // Блок 10 мс, бюджет 50 %: синтез 1000 голосов за 10 мс — предел 1000·5/10·0.9
+    const bool lowered = budget.update(0.5, 0.01, 0.01, 1000, 1000);
+    assert(lowered);
+    assert(budget.getLimit() == 450);
+
+    // С запасом предел растет на восьмую часть, но не выше доступного
+    const bool raised = budget.update(0.5, 0.01, 0.001, 450, 1000);
+    assert(raised);
+    assert(budget.getLimit() == 450 + 56);
+    const bool kept = budget.update(0.5, 0.01, 0.004, 506, 1000);
+    assert(!kept);
+    for (int block = 0; block < 20; ++block) {
+        budget.update(0.5, 0.01, 0.001, budget.getLimit(), 1000);
+    }
+    assert(budget.getLimit() == 1000);
+
+    // Не меньше kMinVoices; без бюджета предела нет
+    budget.update(0.5, 0.01, 100.0, 1000, 1000);
+    assert(budget.getLimit() == VoiceBudget::kMinVoices);
+    const bool unlimited = budget.update(0.0, 0.01, 100.0, 16, 1000);
+    assert(unlimited);
+    assert(budget.getLimit() == VoiceBudget::kUnlimited);
+
+    std::cout << "CPU voice budget tests passed!" << std::endl;
+}
+
+void test_core_culling() {
+    std::cout << "Testing AnantaDigitalCore culling..." << std::endl;
+
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    core.prepareBlockProcessing(48000.0, 256);
+
+    const size_t count = 600;
+    for (size_t k = 0; k < count; ++k) {
+        SphericalCoord position{2.0 + 0.01 * k, M_PI / 3, 0.01 * k, 1.0};
+        core.processSoundField(core.createQuantumSoundField(200.0 + k, position, QuantumSoundState::COHERENT));
+    }
+    assert(core.getCullingStatistics().fields == core.getSoundFieldCount());
+
+    // Заведомо невыполнимый бюджет: голоса сокращаются до минимума, выход остается
+    CullingSettings settings = plainSettings();
+    settings.cpu_budget = 1e-9;
+    core.setCulling(settings);
+    assert(core.getCulling().cpu_budget == 1e-9);
+
+    std::vector<float> out(256);
+    for (int block = 0; block < 8; ++block) {
+        core.processBlock(nullptr, out.data(), out.size());
+    }
+    assert(core.getRealtimeVoiceCount() == VoiceBudget::kMinVoices);
+    bool audible = false;
+    for (float sample : out) {
+        assert(std::isfinite(sample));
+        audible = audible || std::abs(sample) > 1e-6f;
+    }
+    assert(audible);
+
+    // Без бюджета все голоса возвращаются за блок
+    core.setCulling(plainSettings());
+    core.processBlock(nullptr, out.data(), out.size());
+    assert(core.getRealtimeVoiceCount() == core.getCullingStatistics().voices);
+    assert(core.getRealtimeVoiceCount() == core.getSoundFieldCount());
+
+    // Порог отбора действует на источники интерференционных полей
+    auto field = std::make_unique<InterferenceField>(InterferenceFieldType::CONSTRUCTIVE,
+                                                     SphericalCoord{0.0, 0.0, 0.0, 0.0}, 50.0);
+    QuantumSoundField loud = core.createQuantumSoundField(300.0, SphericalCoord{1.0, 0.0, 0.0, 0.0},
+                                                          QuantumSoundState::COHERENT);
+    QuantumSoundField quiet = loud;
+    quiet.amplitude = std::complex<double>(1e-6, 0.0);
+    quiet.position = SphericalCoord{30.0, 0.0, 0.0, 0.0};
+    field->addSourceField(loud);
+    const SphericalCoord observer{0.0, 0.0, 0.0, 0.0};
+    const std::complex<double> reference = field->calculateInterference(observer, 0.25);
+    field->addSourceField(quiet);
+    assert(field->calculateInterference(observer, 0.25) != reference);
+
+    InterferenceField* raw = field.get();
+    core.addInterferenceField(std::move(field));
+    assert(std::abs(raw->getCullingThreshold() - 1e-5) < 1e-12);
+    assert(raw->calculateInterference(observer, 0.25) == reference);
+
+    std::cout << "AnantaDigitalCore culling tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== AudibilityCuller Tests ===" << std::endl;
+
+    try {
+        test_level_culling();
+        test_distant_clusters();
+        test_masking();
+        test_voice_budget();
+        test_core_culling();
+
+        std::cout << "All audibility culler tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,201 @@
+#include "../src/dome_texture_renderer.hpp"
+#include "../src/format_handler.hpp"
+#include "../src/worker_pool.hpp"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+
+using namespace AnantaDigital;
+
+static void fillField(InterferenceField& field, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.3 + 0.05 * (i % 5), 0.02 * i - 0.2);
+        source.frequency = 60.0 + 47.0 * i;
+        source.position = SphericalCoord{2.0 + 0.3 * i, 0.2 + 0.05 * i, 0.7 * i, 0.0};
+        field.addSourceField(source);
+    }
+}
+
+// Наибольшая разница каналов двух цветов RGBA
+static int channelDifference(uint32_t a, uint32_t b) {
+    int worst = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        const int difference = static_cast<int>((a >> shift) & 0xFF) - static_cast<int>((b >> shift) & 0xFF);
+        worst = std::max(worst, std::abs(difference));
+    }
+    return worst;
+}
+
+static uint32_t pixelAt(const std::vector<uint8_t>& frame, uint32_t width, uint32_t px, uint32_t py) {
+    uint32_t color;
+    std::memcpy(&color, frame.data() + (size_t(py) * width + px) * 4, 4);
+    return color;
+}
+
+void test_projection_geometry() {
+    std::cout << "Testing dome projections..." << std::endl;
+
+    DomeTextureSettings settings;
+    settings.width = settings.height = 64;
+    settings.dome_radius = 12.0;
+    DomeTextureRenderer fisheye(settings);
+
+    // Зенит в центре, горизонт на краю круга, углы кадра вне купола
+    Kernels::CartesianPoint<double> point;
+    assert(fisheye.pixelPoint(32, 32, point));
+    assert(point.z > 11.9);
+    assert(fisheye.pixelPoint(63, 32, point));
+    assert(std::abs(point.z) < 0.5 && point.x > 11.9);
+    assert(!fisheye.pixelPoint(0, 0, point));
+    assert(!fisheye.pixelPoint(64, 10, point));
+    const double disc = M_PI / 4.0 * 64 * 64;
+    assert(std::abs(fisheye.getCoveredPixels() - disc) < 0.03 * disc);
+
+    settings.projection = DomeProjection::EQUIRECTANGULAR;
+    settings.width = 80;
+    settings.height = 40;
+    DomeTextureRenderer equirectangular(settings);
+    assert(equirectangular.getCoveredPixels() == 80 * 40);
+    assert(equirectangular.pixelPoint(40, 0, point) && point.z > 11.9);
+    assert(equirectangular.pixelPoint(40, 39, point) && point.z < -11.9);
+
+    // Недопустимые параметры заменяются
+    DomeTextureSettings invalid;
+    invalid.width = 0;
+    invalid.dome_radius = -1.0;
+    invalid.fps = 0.0f;
+    DomeTextureRenderer fallback(invalid);
+    assert(fallback.getSettings().width == 1);
+    assert(fallback.getSettings().dome_radius > 0.0);
+    assert(fallback.getSettings().fps > 0.0f);
+
+    std::cout << "Dome projection tests passed!" << std::endl;
+}
+
+void test_frame_matches_field() {
+    std::cout << "Testing dome frame against calculateInterference..." << std::endl;
+
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, {0.0, 0.0, 0.0, 0.0}, 10.0);
+    fillField(field, 24);
+
+    for (DomeColorMode mode : {DomeColorMode::MAGNITUDE, DomeColorMode::REAL_PART, DomeColorMode::PHASE}) {
+        DomeTextureSettings settings;
+        settings.width = 48;
+        settings.height = 40;
+        settings.dome_radius = 6.0;
+        settings.reference = 3.0;
+        settings.color_mode = mode;
+        DomeTextureRenderer renderer(settings);
+
+        std::vector<uint8_t> frame(renderer.getFrameBytes(), 0xAB);
+        renderer.renderFrame(field, 2.5, frame.data());
+
+        size_t covered = 0;
+        for (uint32_t py = 0; py < settings.height; ++py) {
+            for (uint32_t px = 0; px < settings.width; ++px) {
+                const uint32_t color = pixelAt(frame, settings.width, px, py);
+                Kernels::CartesianPoint<double> point;
+                if (!renderer.pixelPoint(px, py, point)) {
+                    assert(color == 0);
+                    continue;
+                }
+                ++covered;
+                assert((color >> 24) == 255);
+
+                // Пакетный расчет во float32: соседние цвета палитры допустимы;
+                // фаза почти нулевого значения не определена
+                const std::complex<double> value = field.calculateInterference(point, 2.5);
+                if (mode == DomeColorMode::PHASE && std::abs(value) < 1e-2) continue;
+                assert(channelDifference(color, renderer.colorFor(value)) <= 16);
+            }
+        }
+        assert(covered == renderer.getCoveredPixels());
+    }
+
+    std::cout << "Dome frame tests passed!" << std::endl;
+}
+
+void test_bands_and_threads() {
+    std::cout << "Testing banded parallel rendering..." << std::endl;
+
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, {0.0, 0.0, 0.0, 0.0}, 10.0);
+    fillField(field, 16);
+
+    // Больше одной полосы, ширина не кратна 8
+    DomeTextureSettings settings;
+    settings.projection = DomeProjection::EQUIRECTANGULAR;
+    settings.width = 403;
+    settings.height = 200;
+    DomeTextureRenderer renderer(settings);
+    assert(renderer.getCoveredPixels() > DomeTextureRenderer::kBandPixels);
+
+    std::vector<uint8_t> serial(renderer.getFrameBytes()), parallel(renderer.getFrameBytes());
+    renderer.renderFrame(field, 0.75, serial.data());
+    WorkerPool pool(4);
+    renderer.renderFrame(field, 0.75, parallel.data(), &pool);
+    assert(serial == parallel);
+
+    std::cout << "Banded rendering tests passed!" << std::endl;
+}
+
+void test_sequence_saved() {
+    std::cout << "Testing VisualData sequence and FormatHandler..." << std::endl;
+
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, {0.0, 0.0, 0.0, 0.0}, 10.0);
+    fillField(field, 8);
+
+    DomeTextureSettings settings;
+    settings.width = settings.height = 32;
+    settings.fps = 24.0f;
+    DomeTextureRenderer renderer(settings);
+    FreeDomeVision::VisualData visual = renderer.renderSequence(field, 1.0, 3);
+    assert(visual.width == 32 && visual.height == 32 && visual.depth == 0);
+    assert(visual.frameCount == 3 && visual.fps == 24.0f);
+    assert(visual.data.size() == 3 * renderer.getFrameBytes());
+    assert(visual.pixelFormat == FreeDomeVision::PixelFormat::RGBA8);
+    assert(visual.quantumData.elementCount == 8);
+    assert(visual.quantumData.geometryType == FreeDomeVision::QuantumGeometryType::SPHERICAL);
+    assert(visual.quantumData.quantumStates == DomeTextureRenderer::kColormapSize);
+
+    // Кадр k — момент start_time + k/fps; соседние кадры различаются
+    std::vector<uint8_t> second(renderer.getFrameBytes());
+    renderer.renderFrame(field, 1.0 + 1.0 / 24.0, second.data());
+    assert(std::equal(second.begin(), second.end(), visual.data.begin() + renderer.getFrameBytes()));
+    assert(!std::equal(second.begin(), second.end(), visual.data.begin()));
+
+    const std::string path = "dome_texture_test.zelim";
+    FreeDomeVision::FormatHandler handler;
+    assert(handler.saveVisualFile(path, visual));
+    FreeDomeVision::VisualData loaded;
+    assert(handler.loadVisualFile(path, loaded));
+    assert(loaded.width == visual.width && loaded.height == visual.height);
+    assert(loaded.frameCount == visual.frameCount && loaded.data == visual.data);
+    assert(loaded.pixelFormat == FreeDomeVision::PixelFormat::RGBA8);
+    assert(loaded.quantumData.elementCount == visual.quantumData.elementCount);
+    std::remove(path.c_str());
+
+    std::cout << "VisualData sequence tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== DomeTextureRenderer Tests ===" << std::endl;
+
+    try {
+        test_projection_geometry();
+        test_frame_matches_field();
+        test_bands_and_threads();
+        test_sequence_saved();
+
+        std::cout << "All dome texture renderer tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,324 @@
+#include "../src/dsp_kernels.hpp"
+#include "../src/interference_field.hpp"
+#include "../src/worker_pool.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaDigital;
+
+static SphericalCoord makePosition(int i) {
+    return SphericalCoord{1.0 + 0.37 * i, 0.2 + 0.11 * i, 0.3 * i, 0.5 + 0.05 * i};
+}
+
+void test_float_kernels_within_bounds() {
+    std::cout << "Testing float kernels against double..." << std::endl;
+
+    using FloatPrecision = SamplePrecision<float>;
+    const SphericalCoord observer{2.0, 1.0, 0.5, 1.0};
+
+    for (int i = 0; i < 16; ++i) {
+        SphericalCoord source = makePosition(i);
+        double d64 = Kernels::distance(Kernels::toCartesian<double>(source), Kernels::toCartesian<double>(observer));
+        float d32 = Kernels::distance(Kernels::toCartesian<float>(source), Kernels::toCartesian<float>(observer));
+        assert(std::abs(d32 - d64) <= FloatPrecision::scalarBound * std::max(1.0, d64));
+
+        // Большие t проверяют приведение временной фазы к [0, 1)
+        for (double time : {0.0, 0.37, 125.5, 3600.25}) {
+            double frequency = 50.0 + 113.0 * i;
+            auto c64 = Kernels::sourceContribution<double>(std::complex<double>(1.0, 0.0), frequency, d64, time);
+            auto c32 = Kernels::sourceContribution<float>(std::complex<float>(1.0f, 0.0f), frequency, d32, time);
+            double bound = FloatPrecision::interferenceBound(frequency, d64) +
+                           FloatPrecision::scalarBound;
+            assert(std::abs(std::complex<double>(c32) - c64) <= bound);
+        }
+    }
+
+    for (int n = 1; n < 12; ++n) {
+        double f64 = Kernels::domeEigenFrequency<double>(n, 10.0, 5.0);
+        float f32 = Kernels::domeEigenFrequency<float>(n, 10.0f, 5.0f);
+        assert(std::abs(f32 - f64) <= FloatPrecision::scalarBound * f64);
+    }
+
+    std::complex<double> input(0.8, 0.3), feedback(0.7, 0.35);
+    auto q64 = Kernels::quantumCorrection(input, feedback);
+    auto q32 = Kernels::quantumCorrection(std::complex<float>(input), std::complex<float>(feedback));
+    assert(std::abs(std::complex<double>(q32) - q64) <= FloatPrecision::scalarBound * std::abs(q64));
+
+    std::cout << "Float kernel bound tests passed!" << std::endl;
+}
+
+void test_interference_matches_reference() {
+    std::cout << "Testing calculateInterference against double reference..." << std::endl;
+
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, {0.0, 0.0, 0.0, 0.0}, 10.0);
+
+    std::vector<QuantumSoundField> sources;
+    for (int i = 0; i < 8; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.5 + 0.1 * i, 0.05 * i);
+        source.frequency = 110.0 * (i + 1);
+        source.phase = 0.0;
+        source.quantum_state = QuantumSoundState::COHERENT;
+        source.position = makePosition(i);
+        field.addSourceField(source);
+        sources.push_back(source);
+    }
+
+    const SphericalCoord observer{3.0, 0.8, 1.2, 1.0};
+    for (double time : {0.0, 0.01, 42.0}) {
+        std::complex<double> reference(0.0, 0.0);
+        double tolerance = 0.0;
+        for (const auto& source : sources) {
+            double d = Kernels::distance(Kernels::toCartesian<double>(source.position),
+                                         Kernels::toCartesian<double>(observer));
+            reference += Kernels::sourceContribution<double>(source.amplitude, source.frequency, d, time);
+            tolerance += std::abs(source.amplitude) *
+                         (SamplePrecision<Sample>::interferenceBound(source.frequency, d) +
+                          SamplePrecision<Sample>::scalarBound);
+        }
+
+        std::complex<double> result = field.calculateInterference(observer, time);
+        assert(std::abs(result - reference) <= tolerance + 1e-12);
+    }
+
+    std::cout << "Interference reference tests passed!" << std::endl;
+}
+
+void test_batch_interference() {
+    std::cout << "Testing batched calculateInterference..." << std::endl;
+
+    using FloatPrecision = SamplePrecision<float>;
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, {0.0, 0.0, 0.0, 0.0}, 10.0);
+    std::vector<QuantumSoundField> sources;
+    for (int i = 0; i < 24; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.5 + 0.1 * (i % 5), 0.05 * i - 0.4);
+        source.frequency = 55.0 * (i + 1) + 0.37 * i;
+        source.quantum_state = QuantumSoundState::COHERENT;
+        source.position = makePosition(i);
+        field.addSourceField(source);
+        sources.push_back(source);
+    }
+
+    // Неполная последняя плитка; время точек растет внутри плитки
+    const size_t count = 2 * InterferenceField::kBatchTile + 37;
+    std::vector<double> r(count), theta(count), phi(count), height(count), time(count);
+    for (size_t i = 0; i < count; ++i) {
+        r[i] = 0.5 + 0.013 * i;
+        theta[i] = 0.1 + 0.0021 * i;
+        phi[i] = 0.017 * i;
+        height[i] = 0.002 * i;
+        time[i] = 7.25 + 1e-4 * i;
+    }
+    ObserverBatch batch;
+    batch.r = r.data();
+    batch.theta = theta.data();
+    batch.phi = phi.data();
+    batch.height = height.data();
+    batch.time = time.data();
+    batch.count = count;
+
+    std::vector<std::complex<double>> serial(count), parallel(count);
+    field.calculateInterferenceBatch(batch, serial.data());
+    for (size_t i = 0; i < count; ++i) {
+        // Граница float32 плюс ошибка смещения времени внутри плитки
+        const SphericalCoord observer{r[i], theta[i], phi[i], height[i]};
+        const double tile_time = time[i / InterferenceField::kBatchTile * InterferenceField::kBatchTile];
+        double tolerance = 0.0;
+        for (const auto& source : sources) {
+            double d = Kernels::distance(Kernels::toCartesian<double>(source.position),
+                                         Kernels::toCartesian<double>(observer));
+            tolerance += std::abs(source.amplitude) *
+                         (FloatPrecision::interferenceBound(source.frequency, d) + FloatPrecision::scalarBound +
+                          2.0 * M_PI * FloatPrecision::epsilon * source.frequency * (time[i] - tile_time));
+        }
+        std::complex<double> reference = field.calculateInterference(observer, time[i]);
+        assert(std::abs(serial[i] - reference) <= tolerance + 1e-9);
+    }
+
+    // Разбиение плиток по потокам не меняет результат
+    WorkerPool pool(3);
+    field.calculateInterferenceBatch(batch, parallel.data(), &pool);
+    assert(parallel == serial);
+
+    // Без массива времен — общее время; порог отбора действует так же, как в одной точке
+    batch.time = nullptr;
+    batch.common_time = 0.5;
+    field.setCullingThreshold(0.05);
+    field.calculateInterferenceBatch(batch, serial.data(), &pool);
+    for (size_t i = 0; i < count; i += 17) {
+        std::complex<double> reference = field.calculateInterference({r[i], theta[i], phi[i], height[i]}, 0.5);
+        assert(std::abs(serial[i] - reference) <= 1e-3);
+    }
+
+    std::cout << "Batched interference tests passed!" << std::endl;
+}
+
+void test_cartesian_source_cache() {
+    std::cout << "Testing cached Cartesian source positions..." << std::endl;
+
+    auto makeSource = [](int i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.3 + 0.1 * i, 0.0);
+        source.frequency = 220.0 + 31.0 * i;
+        source.quantum_state = QuantumSoundState::COHERENT;
+        source.position = makePosition(i);
+        return source;
+    };
+    // Интерференция поля, собранного заново из тех же источников, — эталон для кэша
+    auto rebuilt = [](const InterferenceField& field, const SphericalCoord& observer, double time) {
+        InterferenceField fresh(field.getType(), field.getCenter(), field.getRadius());
+        for (const auto& source : field.getSourceFields()) {
+            fresh.addSourceField(source);
+        }
+        return fresh.calculateInterference(observer, time);
+    };
+
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, {0.0, 0.0, 0.0, 0.0}, 10.0);
+    for (int i = 0; i < 6; ++i) {
+        field.addSourceField(makeSource(i));
+    }
+    const SphericalCoord observer{3.0, 0.8, 1.2, 1.0};
+    const double time = 0.75;
+
+    // Перемещение, удаление и вытеснение обновляют кэш
+    const bool moved = field.moveSourceField(2, SphericalCoord{7.0, 1.1, 2.0, 0.3});
+    assert(moved);
+    const bool moved_missing = field.moveSourceField(6, observer);
+    assert(!moved_missing);
+    assert(field.getSourceFields()[2].position.r == 7.0);
+    assert(field.calculateInterference(observer, time) == rebuilt(field, observer, time));
+
+    field.removeSourceField(0);
+    assert(field.calculateInterference(observer, time) == rebuilt(field, observer, time));
+
+    field.setSourceCapacity(4, VoiceStealPolicy::QUIETEST);
+    QuantumSoundField loud = makeSource(9);
+    loud.amplitude = std::complex<double>(5.0, 0.0);
+    const bool added = field.addSourceField(loud);
+    assert(added);
+    assert(field.getSourceFieldCount() == 4);
+    assert(field.calculateInterference(observer, time) == rebuilt(field, observer, time));
+
+    // Уменьшение емкости вытесняет по политике и учитывается в stolen;
+    // REJECT не опускает емкость ниже числа источников
+    const uint64_t stolen = field.getSourceStatistics().stolen;
+    field.setSourceCapacity(2, VoiceStealPolicy::QUIETEST);
+    assert(field.getSourceFieldCount() == 2);
+    assert(field.getSourceStatistics().stolen == stolen + 2);
+    const auto kept = field.getSourceFields();
+    assert(kept[0].amplitude == loud.amplitude || kept[1].amplitude == loud.amplitude);
+    assert(field.calculateInterference(observer, time) == rebuilt(field, observer, time));
+    field.setSourceCapacity(1, VoiceStealPolicy::REJECT);
+    assert(field.getSourceFieldCount() == 2);
+    assert(field.getSourceStatistics().capacity == 2);
+
+    // Декартова точка наблюдения дает тот же результат в пределах точности Sample
+    const auto point = Kernels::toCartesian<double>(observer);
+    const std::complex<double> spherical = field.calculateInterference(observer, time);
+    const std::complex<double> cartesian = field.calculateInterference(point, time);
+    assert(std::abs(cartesian - spherical) <= 1e3 * SamplePrecision<Sample>::scalarBound * (1.0 + std::abs(spherical)));
+
+    // Пакет с декартовыми координатами совпадает с пакетом в сферических
+    const double r[] = {observer.r, 1.0}, theta[] = {observer.theta, 0.3}, phi[] = {observer.phi, 2.0};
+    const double height[] = {observer.height, 0.0};
+    const auto second = Kernels::toCartesian<double>(SphericalCoord{1.0, 0.3, 2.0, 0.0});
+    const double x[] = {point.x, second.x}, y[] = {point.y, second.y}, z[] = {point.z, second.z};
+    ObserverBatch batch;
+    batch.r = r;
+    batch.theta = theta;
+    batch.phi = phi;
+    batch.height = height;
+    batch.common_time = time;
+    batch.count = 2;
+    std::complex<double> from_spherical[2], from_cartesian[2];
+    field.calculateInterferenceBatch(batch, from_spherical);
+    batch.x = x;
+    batch.y = y;
+    batch.z = z;
+    field.calculateInterferenceBatch(batch, from_cartesian);
+    assert(from_spherical[0] == from_cartesian[0] && from_spherical[1] == from_cartesian[1]);
+
+    field.clearSourceFields();
+    assert(field.calculateInterference(point, time) == std::complex<double>(0.0, 0.0));
+
+    std::cout << "Cartesian source cache tests passed!" << std::endl;
+}
+
+void test_interference_stream() {
+    std::cout << "Testing phasor-recurrence interference stream..." << std::endl;
+
+    InterferenceField field(InterferenceFieldType::DESTRUCTIVE, {0.0, 0.0, 0.0, 0.0}, 10.0);
+    std::vector<QuantumSoundField> sources;
+    for (int i = 0; i < 13; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.2 + 0.05 * i, 0.1 - 0.02 * i);
+        source.frequency = 97.0 * (i + 1) + 0.5 * i;
+        source.quantum_state = QuantumSoundState::COHERENT;
+        source.position = makePosition(i);
+        field.addSourceField(source);
+        sources.push_back(source);
+    }
+
+    const SphericalCoord listener{2.5, 0.9, 0.4, 1.0};
+    const double sample_rate = 48000.0;
+    const double start_time = 3.5;
+    InterferenceStream stream;
+    stream.prepare(field, listener, start_time, sample_rate);
+    assert(stream.getSourceCount() == sources.size());
+
+    // Блоки разной длины пересекают границы точного пересчета фазоров
+    const size_t frames = 3 * InterferenceStream::kReanchorFrames + 100;
+    std::vector<std::complex<double>> streamed(frames);
+    for (size_t position = 0, block = 1; position < frames; position += block, block = block * 3 % 509 + 1) {
+        stream.render(streamed.data() + position, std::min(block, frames - position));
+    }
+    assert(std::abs(stream.getTime() - (start_time + frames / sample_rate)) < 1e-12);
+
+    // Граница: ошибка Sample у calculateInterference плюс дрейф kReanchorFrames умножений
+    double tolerance = 0.0;
+    const auto observer = Kernels::toCartesian<double>(listener);
+    for (const auto& source : sources) {
+        double d = Kernels::distance(Kernels::toCartesian<double>(source.position), observer);
+        tolerance += std::abs(source.amplitude) *
+                     (SamplePrecision<Sample>::interferenceBound(source.frequency, d) +
+                      SamplePrecision<Sample>::scalarBound +
+                      8.0 * InterferenceStream::kReanchorFrames * SamplePrecision<Sample>::epsilon);
+    }
+    for (size_t t = 0; t < frames; t += 7) {
+        std::complex<double> reference = field.calculateInterference(listener, start_time + t / sample_rate);
+        assert(std::abs(streamed[t] - reference) <= tolerance);
+    }
+
+    // Порог отбора поля действует и на поток
+    field.setCullingThreshold(0.3);
+    stream.prepare(field, listener, start_time, sample_rate);
+    assert(stream.getSourceCount() < sources.size());
+    std::complex<double> culled;
+    stream.render(&culled, 1);
+    assert(std::abs(culled - field.calculateInterference(listener, start_time)) <= tolerance);
+
+    std::cout << "Interference stream tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== DSP Kernel Precision Tests ===" << std::endl;
+    std::cout << "Sample type: " << (sizeof(Sample) == sizeof(float) ? "float32" : "float64") << std::endl;
+
+    try {
+        test_float_kernels_within_bounds();
+        test_interference_matches_reference();
+        test_batch_interference();
+        test_cartesian_source_cache();
+        test_interference_stream();
+
+        std::cout << "All DSP kernel tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
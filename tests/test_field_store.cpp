@@ -0,0 +1,298 @@
+#include "../src/field_store.hpp"
+#include "../src/waveform.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+using namespace AnantaDigital;
+
+static QuantumSoundField makeField(double frequency, const SphericalCoord& position) {
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(1.0, 0.0);
+    field.frequency = frequency;
+    field.phase = 0.0;
+    field.quantum_state = QuantumSoundState::COHERENT;
+    field.position = position;
+    return field;
+}
+
+void test_insert_update_remove() {
+    std::cout << "Testing FieldStore insert/update/remove..." << std::endl;
+    
+    FieldStore store;
+    store.reserve(16);
+    
+    FieldHandle a = store.insert(makeField(100.0, {1.0, 0.1, 0.0, 0.0}));
+    FieldHandle b = store.insert(makeField(200.0, {2.0, 0.2, 0.0, 0.0}));
+    FieldHandle c = store.insert(makeField(300.0, {3.0, 0.3, 0.0, 0.0}));
+    assert(store.size() == 3);
+    assert(store.contains(a) && store.contains(b) && store.contains(c));
+    
+    bool updated = store.setFrequency(b, 250.0);
+    assert(updated);
+    assert(std::abs(store.get(b).frequency - 250.0) < 1e-12);
+    
+    // Удаление не меняет дескрипторы оставшихся полей
+    bool removed = store.remove(a);
+    assert(removed);
+    assert(!store.contains(a));
+    assert(store.size() == 2);
+    assert(std::abs(store.get(c).frequency - 300.0) < 1e-12);
+    assert(std::abs(store.get(b).frequency - 250.0) < 1e-12);
+    removed = store.remove(a);
+    assert(!removed);
+    
+    // Слот переиспользуется, но старый дескриптор остается недействительным
+    FieldHandle d = store.insert(makeField(400.0, {4.0, 0.4, 0.0, 0.0}));
+    assert(d.index == a.index);
+    assert(d != a);
+    assert(!store.contains(a));
+    assert(store.contains(d));
+    
+    // Плотные массивы содержат ровно живые поля
+    double sum = 0.0;
+    for (size_t i = 0; i < store.size(); ++i) {
+        sum += store.frequencies()[i];
+        assert(store.denseIndex(store.handleAt(i)) == i);
+    }
+    assert(std::abs(sum - 950.0) < 1e-9);
+    
+    store.clear();
+    assert(store.empty());
+    assert(!store.contains(b));
+    
+    std::cout << "FieldStore insert/update/remove tests passed!" << std::endl;
+}
+
+void test_spatial_merge() {
+    std::cout << "Testing FieldStore spatial merge..." << std::endl;
+    
+    FieldStore store;
+    SphericalCoord position{2.0, M_PI / 2, 0.0, 1.0};
+    
+    // Точное совпадение позиции заменяет поле, как в std::map
+    FieldHandle first = store.insertOrMerge(makeField(100.0, position));
+    FieldHandle second = store.insertOrMerge(makeField(200.0, position));
+    assert(first == second);
+    assert(store.size() == 1);
+    assert(std::abs(store.get(first).frequency - 200.0) < 1e-12);
+    
+    // Без квантования почти совпадающая позиция дает новое поле
+    SphericalCoord nearby{2.0 + 1e-4, M_PI / 2, 0.0, 1.0};
+    FieldHandle third = store.insertOrMerge(makeField(300.0, nearby));
+    assert(third != first);
+    assert(store.size() == 2);
+    
+    // С шагом 0.1 м близкие поля сливаются
+    store.setMergeResolution(0.1);
+    assert(store.size() == 1);
+    FieldHandle merged = store.insertOrMerge(makeField(400.0, {2.0 + 2e-4, M_PI / 2, 0.0, 1.0}));
+    assert(store.size() == 1);
+    assert(store.contains(merged));
+    assert(store.find(position) == merged);
+    
+    // Поля insert() не становятся целью слияния и не сливаются при смене шага
+    FieldHandle fixed = store.insert(makeField(500.0, {2.0 + 3e-4, M_PI / 2, 0.0, 1.0}));
+    FieldHandle fixed_twin = store.insert(makeField(600.0, {2.0 + 4e-4, M_PI / 2, 0.0, 1.0}));
+    assert(store.size() == 3);
+    FieldHandle remerged = store.insertOrMerge(makeField(700.0, position));
+    assert(remerged == merged);
+    assert(std::abs(store.get(fixed).frequency - 500.0) < 1e-12);
+    store.setMergeResolution(0.2);
+    assert(store.size() == 3 && store.contains(fixed) && store.contains(fixed_twin));
+    
+    // Удаление представителя ячейки оставляет в индексе остальные поля ключа
+    bool removed = store.remove(merged);
+    assert(removed);
+    FieldHandle remaining = store.find(position);
+    assert(remaining == fixed);
+    removed = store.remove(fixed);
+    assert(removed);
+    remaining = store.find(position);
+    assert(remaining == fixed_twin);
+    FieldHandle fresh = store.insertOrMerge(makeField(800.0, position));
+    assert(fresh != fixed_twin && store.size() == 2);
+    removed = store.remove(fixed_twin);
+    assert(removed);
+    assert(store.find(position) == fresh);
+    
+    std::cout << "FieldStore spatial merge tests passed!" << std::endl;
+}
+
+void test_trivially_copyable_fields() {
+    std::cout << "Testing trivially copyable fields and waveforms..." << std::endl;
+    
+    static_assert(std::is_trivially_copyable<QuantumSoundField>::value, "QuantumSoundField must be trivially copyable");
+    
+    // Массив полей копируется memcpy вместе с описанием волновой функции
+    std::vector<QuantumSoundField> source(16);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = makeField(100.0 * (i + 1), {1.0 + i, 0.5, 0.1 * i, 0.0});
+        source[i].sample_time = 480 * i;
+        source[i].waveform = WaveformDescriptor::planeWave(source[i].frequency);
+    }
+    std::vector<QuantumSoundField> copy(source.size());
+    std::memcpy(copy.data(), source.data(), source.size() * sizeof(QuantumSoundField));
+    
+    FieldStore store;
+    for (const auto& field : copy) {
+        store.insert(field);
+    }
+    for (size_t i = 0; i < store.size(); ++i) {
+        assert(store.sampleTimes()[i] == 480 * i);
+        assert(store.waveforms()[i].type == WaveformType::PLANE_WAVE);
+        assert(store.waveforms()[i].frequency == source[i].frequency);
+    }
+    
+    // Плоская волна совпадает с прежней лямбдой createQuantumSoundField
+    const double frequency = 440.0, r = 3.7, t = 0.0123;
+    double phase = 2.0 * M_PI * frequency * t - 2.0 * M_PI * r / 343.0;
+    std::complex<double> value = evaluateWaveform(WaveformDescriptor::planeWave(frequency), r, 0.3, 0.2, t);
+    assert(std::abs(value - std::polar(1.0, phase)) < 1e-12);
+    assert(std::abs(evaluateWaveform(WaveformDescriptor{}, r, 0.3, 0.2, t)) == 0.0);
+    
+    // Пакетное вычисление совпадает с поштучным
+    std::vector<std::complex<double>> batch(store.size());
+    evaluateWaveforms(store.waveforms(), store.size(), r, 0.3, 0.2, t, batch.data());
+    for (size_t i = 0; i < store.size(); ++i) {
+        assert(batch[i] == evaluateWaveform(store.waveforms()[i], r, 0.3, 0.2, t));
+    }
+    
+    // Произвольная функция — через реестр
+    auto& registry = WaveFunctionRegistry::instance();
+    WaveformDescriptor callable = registry.add([](double r, double, double, double t) {
+        return std::complex<double>(r, t);
+    });
+    assert(callable.type == WaveformType::CALLABLE);
+    assert(evaluateWaveform(callable, 2.0, 0.0, 0.0, 5.0) == std::complex<double>(2.0, 5.0));
+    
+    // Функция может обращаться к реестру, в том числе удалять себя
+    WaveformDescriptor nested = registry.add([&callable, &registry](double r, double theta, double phi, double t) {
+        std::complex<double> inner = evaluateWaveform(callable, r, theta, phi, t);
+        WaveformDescriptor temporary = registry.add([](double, double, double, double) {
+            return std::complex<double>(1.0, 0.0);
+        });
+        registry.remove(temporary.callable_id);
+        return inner * 2.0;
+    });
+    assert(evaluateWaveform(nested, 2.0, 0.0, 0.0, 5.0) == std::complex<double>(4.0, 10.0));
+    const bool removed_nested = registry.remove(nested.callable_id);
+    assert(removed_nested);
+    
+    const bool removed = registry.remove(callable.callable_id);
+    assert(removed);
+    assert(evaluateWaveform(callable, 2.0, 0.0, 0.0, 5.0) == std::complex<double>(0.0, 0.0));
+    
+    std::cout << "Trivially copyable field tests passed!" << std::endl;
+}
+
+void test_fixed_capacity() {
+    std::cout << "Testing FieldStore fixed capacity..." << std::endl;
+    
+    // Отклонение при REJECT
+    FieldStore store;
+    store.setCapacity(3, VoiceStealPolicy::REJECT);
+    for (int i = 0; i < 3; ++i) {
+        FieldHandle handle = store.insert(makeField(100.0 * (i + 1), {1.0 + i, 0.1, 0.0, 0.0}));
+        assert(handle.isValid());
+    }
+    assert(store.full());
+    FieldHandle overflow = store.insert(makeField(400.0, {5.0, 0.1, 0.0, 0.0}));
+    assert(!overflow.isValid());
+    assert(store.getStatistics().rejected == 1 && store.size() == 3);
+    
+    // OLDEST вытесняет поле с наименьшим sample_time
+    store.clear();
+    store.setCapacity(3, VoiceStealPolicy::OLDEST);
+    for (int i = 0; i < 3; ++i) {
+        QuantumSoundField field = makeField(100.0, {1.0 + i, 0.2, 0.0, 0.0});
+        field.sample_time = 100 - i;
+        store.insert(field);
+    }
+    QuantumSoundField newest = makeField(100.0, {9.0, 0.2, 0.0, 0.0});
+    newest.sample_time = 200;
+    FieldHandle newest_handle = store.insert(newest);
+    assert(newest_handle.isValid());
+    assert(!store.find({3.0, 0.2, 0.0, 0.0}).isValid());
+    assert(store.getStatistics().stolen == 1);
+    
+    // LOWEST_PRIORITY: важное поле не вытесняется тихим, но неважным
+    store.clear();
+    store.setCapacity(2, VoiceStealPolicy::LOWEST_PRIORITY);
+    QuantumSoundField important = makeField(100.0, {1.0, 0.3, 0.0, 0.0});
+    important.priority = 10;
+    important.amplitude = 0.01;
+    QuantumSoundField background = makeField(200.0, {2.0, 0.3, 0.0, 0.0});
+    background.priority = 1;
+    store.insert(important);
+    store.insert(background);
+    QuantumSoundField lowest = makeField(300.0, {3.0, 0.3, 0.0, 0.0});
+    FieldHandle lowest_handle = store.insert(lowest);
+    assert(!lowest_handle.isValid());
+    lowest.priority = 5;
+    lowest_handle = store.insert(lowest);
+    assert(lowest_handle.isValid());
+    assert(store.find(important.position).isValid());
+    assert(!store.find(background.position).isValid());
+    
+    // Пространственный индекс согласован после множества вставок и удалений
+    FieldStore churn;
+    churn.setCapacity(64, VoiceStealPolicy::QUIETEST);
+    std::vector<FieldHandle> handles;
+    for (int i = 0; i < 2000; ++i) {
+        SphericalCoord position{1.0 + (i * 7) % 97, 0.5, 0.01 * (i % 13), 0.0};
+        QuantumSoundField field = makeField(100.0 + i, position);
+        field.amplitude = 1.0 + (i * 31) % 17;
+        FieldHandle handle = churn.insertOrMerge(field);
+        if (handle.isValid()) handles.push_back(handle);
+        if (i % 3 == 0 && !handles.empty()) {
+            churn.remove(handles[(i * 5) % handles.size()]);
+        }
+        assert(churn.size() <= 64);
+    }
+    for (size_t i = 0; i < churn.size(); ++i) {
+        assert(churn.find(churn.positions()[i]) == churn.handleAt(i));
+    }
+    assert(churn.getStatistics().peak_in_use == 64);
+    
+    // Куча жертв совпадает с перебором после вставок, правок громкости и удалений
+    auto quietest = [](const FieldStore& store) {
+        double level = std::norm(store.amplitudes()[0]);
+        for (size_t i = 1; i < store.size(); ++i) {
+            level = std::min(level, std::norm(store.amplitudes()[i]));
+        }
+        return level;
+    };
+    for (int i = 0; i < 500; ++i) {
+        FieldHandle handle = churn.handleAt((i * 11) % churn.size());
+        churn.setAmplitude(handle, std::complex<double>(0.5 + (i * 13) % 23, 0.0));
+        if (i % 4 == 0) churn.remove(churn.handleAt((i * 3) % churn.size()));
+        QuantumSoundField field = makeField(50.0 + i, {200.0 + i, 0.5, 0.0, 0.0});
+        field.amplitude = 1.0 + (i * 7) % 19;
+        churn.insert(field);
+        assert(std::norm(churn.amplitudes()[churn.selectVictim(VoiceStealPolicy::QUIETEST)]) == quietest(churn));
+    }
+    
+    std::cout << "FieldStore fixed capacity tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== FieldStore Tests ===" << std::endl;
+    
+    try {
+        test_insert_update_remove();
+        test_spatial_merge();
+        test_trivially_copyable_fields();
+        test_fixed_capacity();
+        
+        std::cout << "All field store tests passed!" << std::endl;
+        return 0;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include "../src/anantadigital_core.hpp"
 
 using namespace AnantaDigital;
@@ -22,6 +25,31 @@ void test_dome_resonator() {
     resonator.setAcousticProperty(100.0, 0.8);
     assert(std::abs(resonator.getAcousticProperty(100.0) - 0.8) < 1e-6);
     
+    // Test cached resonance model versioning
+    uint64_t version = resonator.getModelVersion();
+    resonator.setAcousticProperty(100.0, 0.8);
+    assert(resonator.getModelVersion() == version);
+    resonator.setAcousticProperty(100.0, 0.6);
+    assert(resonator.getModelVersion() == version + 1);
+    
+    std::vector<double> targets = {100.0, 1000.0, 5000.0};
+    resonator.optimizeFrequencyResponse(targets);
+    assert(resonator.getModelVersion() == version + 2);
+    resonator.optimizeFrequencyResponse(targets);
+    assert(resonator.getModelVersion() == version + 2);
+    
+    // Вырожденные моды объединены, частоты строго возрастают
+    const auto& modes = resonator.getResonanceModes();
+    assert(!modes.empty());
+    int total_degeneracy = 0;
+    for (size_t i = 0; i < modes.size(); ++i) {
+        total_degeneracy += modes[i].degeneracy;
+        if (i > 0) {
+            assert(modes[i].frequency > modes[i - 1].frequency);
+        }
+    }
+    assert(static_cast<size_t>(total_degeneracy) == resonator.getResonantFrequencies().size());
+    
     std::cout << "DomeAcousticResonator tests passed!" << std::endl;
 }
 
@@ -75,6 +103,600 @@ void test_quantum_sound_field() {
     std::cout << "QuantumSoundField tests passed!" << std::endl;
 }
 
+void test_process_block() {
+    std::cout << "Testing AnantaDigitalCore::processBlock..." << std::endl;
+    
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    
+    // До подготовки выход должен быть тишиной
+    float silent[64];
+    core.processBlock(nullptr, silent, 64);
+    for (float sample : silent) {
+        assert(sample == 0.0f);
+    }
+    
+    core.prepareBlockProcessing(48000.0, 64);
+    assert(core.getSampleRate() == 48000.0);
+    assert(core.getMaxBlockFrames() == 64);
+    
+    SphericalCoord position{1.0, M_PI/2, 0.0, 1.0};
+    FieldHandle handle = core.processSoundField(core.createQuantumSoundField(440.0, position, QuantumSoundState::COHERENT));
+    
+    // Новое поле нарастает за время сглаживания; дожидаемся полной амплитуды
+    float input[128] = {};
+    float output[128];
+    for (int block = 0; block < 8; ++block) {
+        core.processBlock(input, output, 64);
+    }
+    
+    // Соседние блоки должны продолжать друг друга без разрыва фазы:
+    // скачок на границе не больше максимального шага синусоиды
+    core.processBlock(input, output, 64);
+    core.processBlock(input + 64, output + 64, 64);
+    
+    float peak = 0.0f;
+    for (float sample : output) {
+        assert(std::isfinite(sample));
+        peak = std::max(peak, std::abs(sample));
+    }
+    assert(peak > 0.0f);
+    
+    const float max_step = peak * static_cast<float>(2.0 * M_PI * 440.0 / 48000.0);
+    for (size_t i = 1; i < 128; ++i) {
+        assert(std::abs(output[i] - output[i - 1]) <= max_step * 1.01f + 1e-6f);
+    }
+    
+    // Удаленное поле затухает за время сглаживания, а не обрывается
+    const bool removed = core.removeSoundField(handle);
+    assert(removed);
+    float fade[64];
+    core.processBlock(nullptr, fade, 64);
+    assert(core.getRealtimeVoiceCount() == 0);
+    float fade_peak = 0.0f;
+    for (size_t i = 1; i < 64; ++i) {
+        assert(std::abs(fade[i] - fade[i - 1]) <= max_step * 1.01f + 1e-6f);
+        fade_peak = std::max(fade_peak, std::abs(fade[i]));
+    }
+    assert(fade_peak > 0.5f * peak);
+    for (int block = 0; block < 8; ++block) {
+        core.processBlock(nullptr, fade, 64);
+    }
+    for (float sample : fade) {
+        assert(sample == 0.0f);
+    }
+    
+    std::cout << "processBlock tests passed!" << std::endl;
+}
+
+void test_cached_dome_resonance() {
+    std::cout << "Testing cached dome resonance..." << std::endl;
+    
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    
+    std::vector<double> input(256, 0.1);
+    core.processAudioSignal(input);
+    size_t resonance_count = core.getResonanceFieldCount();
+    uint64_t model_version = core.getResonanceModelVersion();
+    assert(model_version > 0);
+    // Поля спектральных пиков входа зависят от сигнала, их не считаем
+    size_t field_count = core.getSoundFieldCount() - core.getInputFieldCount();
+    assert(resonance_count > 0);
+    assert(field_count >= resonance_count);
+    
+    // Повторные вызовы не создают новых полей, пока модель не изменилась
+    core.processAudioSignal(input);
+    core.processAudioSignal(input);
+    assert(core.getResonanceFieldCount() == resonance_count);
+    assert(core.getResonanceModelVersion() == model_version);
+    assert(core.getSoundFieldCount() - core.getInputFieldCount() == field_count);
+    assert(core.getProcessedSignal().size() == 1024);
+    
+    std::cout << "Cached dome resonance tests passed!" << std::endl;
+}
+
+void test_input_analysis() {
+    std::cout << "Testing input spectrum analysis..." << std::endl;
+    
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    core.prepareBlockProcessing(48000.0, 512);
+    
+    // Два тона во входном сигнале становятся полями с их частотами
+    std::vector<double> input(512);
+    for (int block = 0; block < 8; ++block) {
+        for (size_t i = 0; i < input.size(); ++i) {
+            double t = static_cast<double>(block * input.size() + i) / 48000.0;
+            input[i] = 0.5 * std::sin(2.0 * M_PI * 440.0 * t) + 0.25 * std::sin(2.0 * M_PI * 1500.0 * t);
+        }
+        core.processInterferenceField(input);
+    }
+    
+    size_t input_count = core.getInputFieldCount();
+    assert(input_count >= 2);
+    
+    bool found_low = false;
+    bool found_high = false;
+    for (const auto& field : core.getOutputFields()) {
+        found_low = found_low || std::abs(field.frequency - 440.0) < 2.0;
+        found_high = found_high || std::abs(field.frequency - 1500.0) < 2.0;
+    }
+    assert(found_low && found_high);
+    
+    // Новые кадры обновляют поля на месте, а не добавляют новые
+    core.processInterferenceField(input);
+    assert(core.getInputFieldCount() <= input_count + 2);
+    assert(core.getSoundFieldCount() == core.getInputFieldCount());
+    
+    // Вход processBlock() копируется аудио-потоком и разбирается analyzeBlockInput()
+    AnantaDigitalCore block_core(10.0, 5.0);
+    block_core.initialize();
+    block_core.prepareBlockProcessing(48000.0, 256);
+    assert(!block_core.analyzeBlockInput());
+    std::vector<float> block_input(256), block_output(256);
+    for (int block = 0; block < 16; ++block) {
+        for (size_t i = 0; i < block_input.size(); ++i) {
+            double t = static_cast<double>(block * block_input.size() + i) / 48000.0;
+            block_input[i] = static_cast<float>(0.5 * std::sin(2.0 * M_PI * 660.0 * t));
+        }
+        block_core.processBlock(block_input.data(), block_output.data(), block_input.size());
+    }
+    assert(block_core.analyzeBlockInput());
+    assert(block_core.getInputFieldCount() >= 1 && block_core.getDroppedInputFrames() == 0);
+    bool found_block = false;
+    for (const auto& field : block_core.getOutputFields()) {
+        found_block = found_block || std::abs(field.frequency - 660.0) < 2.0;
+    }
+    assert(found_block);
+    
+    std::cout << "Input spectrum analysis tests passed!" << std::endl;
+}
+
+void test_speaker_rendering() {
+    std::cout << "Testing multichannel speaker rendering..." << std::endl;
+    
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    core.prepareBlockProcessing(48000.0, 128);
+    
+    const size_t channels = 32;
+    std::vector<SphericalCoord> speakers;
+    for (size_t s = 0; s < channels; ++s) {
+        speakers.push_back(SphericalCoord{10.0, M_PI / 2, 2.0 * M_PI * s / channels, 0.0});
+    }
+    core.prepareSpeakerRendering(speakers);
+    assert(core.getSpeakerCount() == channels);
+    
+    // Поле рядом с громкоговорителем 0 громче всего на нем и тише всего напротив
+    core.processSoundField(core.createQuantumSoundField(440.0, {9.0, M_PI / 2, 0.0, 0.0},
+                                                        QuantumSoundState::COHERENT));
+    
+    // Блок длиннее подготовленного обрабатывается частями
+    const size_t frames = 4096;
+    std::vector<float> interleaved(frames * channels);
+    core.processBlockInterleaved(nullptr, interleaved.data(), frames);
+    
+    std::vector<float> peak(channels, 0.0f);
+    for (size_t t = frames / 2; t < frames; ++t) {
+        for (size_t s = 0; s < channels; ++s) {
+            assert(std::isfinite(interleaved[t * channels + s]));
+            peak[s] = std::max(peak[s], std::abs(interleaved[t * channels + s]));
+        }
+    }
+    assert(peak[0] > 0.0f);
+    assert(peak[0] > peak[channels / 2] * 2.0f);
+    
+    std::vector<std::vector<float>> planar(channels, std::vector<float>(256));
+    std::vector<float*> outputs;
+    for (auto& channel : planar) outputs.push_back(channel.data());
+    core.processBlockMultichannel(nullptr, outputs.data(), 256);
+    for (size_t s = 0; s < channels; ++s) {
+        for (float sample : planar[s]) {
+            assert(std::isfinite(sample));
+        }
+    }
+    
+    // Тот же купол через шину Ambisonics 3-го порядка
+    core.prepareAmbisonicRendering(speakers, 3);
+    assert(core.getSpeakerRenderMode() == SpeakerRenderMode::AMBISONIC);
+    assert(core.getSpeakerCount() == channels);
+    core.processBlockInterleaved(nullptr, interleaved.data(), frames);
+    std::fill(peak.begin(), peak.end(), 0.0f);
+    for (size_t t = 0; t < frames; ++t) {
+        for (size_t s = 0; s < channels; ++s) {
+            assert(std::isfinite(interleaved[t * channels + s]));
+            peak[s] = std::max(peak[s], std::abs(interleaved[t * channels + s]));
+        }
+    }
+    assert(std::max_element(peak.begin(), peak.end()) - peak.begin() == 0);
+    assert(peak[0] > peak[channels / 2] * 2.0f);
+    
+    core.prepareSpeakerRendering(speakers);
+    assert(core.getSpeakerRenderMode() == SpeakerRenderMode::DIRECT);
+    
+    std::cout << "Multichannel speaker rendering tests passed!" << std::endl;
+}
+
+void test_speaker_voice_groups() {
+    std::cout << "Testing speaker rendering beyond the first source group..." << std::endl;
+    
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    core.prepareBlockProcessing(48000.0, 128);
+    CullingSettings culling;
+    culling.masking_db = 0.0;
+    core.setCulling(culling);
+    
+    const size_t channels = 16;
+    std::vector<SphericalCoord> speakers;
+    for (size_t s = 0; s < channels; ++s) {
+        speakers.push_back(SphericalCoord{10.0, M_PI / 2, 2.0 * M_PI * s / channels, 0.0});
+    }
+    
+    // 64 громких поля на оси купола одинаково слышны на всех громкоговорителях;
+    // тихое поле у громкоговорителя 0 идет в снимке 65-м
+    for (size_t i = 0; i < 64; ++i) {
+        core.processSoundField(core.createQuantumSoundField(200.0 + 3.0 * i, {0.01 * i, 0.0, 0.0, 0.0},
+                                                            QuantumSoundState::COHERENT));
+    }
+    QuantumSoundField quiet = core.createQuantumSoundField(2000.0, {9.0, M_PI / 2, 0.0, 0.0},
+                                                           QuantumSoundState::COHERENT);
+    quiet.amplitude = std::complex<double>(0.3, 0.0);
+    core.processSoundField(quiet);
+    assert(core.getSoundFieldCount() == 65);
+    
+    const size_t frames = 4096;
+    std::vector<float> interleaved(frames * channels);
+    for (int mode = 0; mode < 2; ++mode) {
+        if (mode == 0) {
+            core.prepareSpeakerRendering(speakers);
+        } else {
+            core.prepareAmbisonicRendering(speakers, 3);
+        }
+        core.processBlockInterleaved(nullptr, interleaved.data(), frames);
+        
+        float difference = 0.0f;
+        for (size_t t = frames / 2; t < frames; ++t) {
+            const float near = interleaved[t * channels];
+            const float far = interleaved[t * channels + channels / 2];
+            difference = std::max(difference, std::abs(near - far));
+        }
+        assert(difference > 1e-3f);
+    }
+    
+    std::cout << "Speaker source group tests passed!" << std::endl;
+}
+
+void test_speaker_voice_fade() {
+    std::cout << "Testing speaker rendering of removed fields..." << std::endl;
+    
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    core.prepareBlockProcessing(48000.0, 128);
+    
+    const size_t channels = 16;
+    std::vector<SphericalCoord> speakers;
+    for (size_t s = 0; s < channels; ++s) {
+        speakers.push_back(SphericalCoord{10.0, M_PI / 2, 2.0 * M_PI * s / channels, 0.0});
+    }
+    
+    std::vector<float> interleaved(4096 * channels);
+    auto peakAt = [&](size_t first, size_t last) {
+        float peak = 0.0f;
+        for (size_t t = first; t < last; ++t) peak = std::max(peak, std::abs(interleaved[t * channels]));
+        return peak;
+    };
+    
+    // Удаленное поле затухает за время сглаживания и на многоканальном выходе
+    for (int mode = 0; mode < 2; ++mode) {
+        if (mode == 0) {
+            core.prepareSpeakerRendering(speakers);
+        } else {
+            core.prepareAmbisonicRendering(speakers, 3);
+        }
+        FieldHandle field = core.processSoundField(core.createQuantumSoundField(
+            440.0, {9.0, M_PI / 2, 0.0, 0.0}, QuantumSoundState::COHERENT));
+        assert(field.isValid());
+        core.processBlockInterleaved(nullptr, interleaved.data(), 4096);
+        const float steady = peakAt(3072, 4096);
+        assert(steady > 0.0f);
+        
+        const bool removed = core.removeSoundField(field);
+        assert(removed);
+        core.processBlockInterleaved(nullptr, interleaved.data(), 4096);
+        assert(peakAt(0, 32) > 0.5f * steady);
+        assert(peakAt(2048, 4096) == 0.0f);
+        assert(core.getRealtimeVoiceCount() == 0);
+    }
+    
+    std::cout << "Speaker fade tests passed!" << std::endl;
+}
+
+void test_output_voice_growth() {
+    std::cout << "Testing output voice continuity as the voice count grows..." << std::endl;
+    
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    core.prepareBlockProcessing(48000.0, 1024);
+    
+    auto spawn = [&core](size_t i) {
+        QuantumSoundField field = core.createQuantumSoundField(200.0 + 37.0 * i, {2.0, M_PI / 3, 0.1 * i, 0.0},
+                                                               QuantumSoundState::COHERENT);
+        field.amplitude = std::complex<double>(0.01, 0.0);
+        field.phase = 0.7 * i;
+        core.processSoundField(field);
+    };
+    auto rms = [](const std::vector<float>& block) {
+        double energy = 0.0;
+        for (float sample : block) energy += sample * sample;
+        return std::sqrt(energy / block.size());
+    };
+    
+    // Новое поле не перезапускает уже звучащие голоса
+    for (size_t i = 0; i < 64; ++i) spawn(i);
+    std::vector<float> block(1024);
+    for (int warmup = 0; warmup < 4; ++warmup) core.generateOutput(block.data(), block.size());
+    const double before = rms(block);
+    
+    spawn(64);
+    core.generateOutput(block.data(), block.size());
+    const double after = rms(block);
+    assert(before > 0.0);
+    assert(after < before * 1.5 && after > before * 0.67);
+    
+    std::cout << "Output voice growth tests passed!" << std::endl;
+}
+
+void test_output_views() {
+    std::cout << "Testing zero-copy output views..." << std::endl;
+    
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    const bool published = core.acquireProcessedSignal().valid();
+    assert(!published);
+    
+    core.processSoundField(core.createQuantumSoundField(440.0, {1.0, M_PI / 2, 0.0, 1.0}, QuantumSoundState::COHERENT));
+    core.processSoundField(core.createQuantumSoundField(660.0, {2.0, M_PI / 2, 0.0, 1.0}, QuantumSoundState::COHERENT));
+    core.generateOutput();
+    
+    // Закрепленный блок не меняется, пока публикуются новые
+    auto view = core.acquireProcessedSignal();
+    assert(view.valid() && view.size() == 1024);
+    std::vector<double> pinned(view.begin(), view.end());
+    uint64_t sequence = view.sequence();
+    for (int i = 0; i < 8; ++i) {
+        core.generateOutput();
+    }
+    for (size_t i = 0; i < view.size(); ++i) {
+        assert(view[i] == pinned[i]);
+    }
+    const uint64_t latest = core.acquireProcessedSignal().sequence();
+    assert(latest == sequence + 8);
+    view.release();
+    
+    // Рендер в буфер вызывающей стороны
+    std::vector<float> out(256);
+    core.generateOutput(out.data(), out.size());
+    float peak = 0.0f;
+    for (float sample : out) {
+        peak = std::max(peak, std::abs(sample));
+    }
+    assert(peak > 0.0f);
+    
+    {
+        auto fields = core.viewOutputFields();
+        assert(fields.size() == 2);
+        assert(fields.frequencies().size() == 2);
+        double sum = 0.0;
+        for (double frequency : fields.frequencies()) {
+            sum += frequency;
+        }
+        assert(std::abs(sum - 1100.0) < 1e-9);
+    }
+    assert(core.getSoundFieldCount() == 2);
+    
+    // Писатель и читатели одновременно: каждый блок заполнен своим номером
+    PublishedBuffers<double> blocks;
+    std::atomic<bool> running(true);
+    std::atomic<long> reads(0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (running.load(std::memory_order_relaxed)) {
+                auto block = blocks.acquire();
+                if (!block) continue;
+                for (double value : block) {
+                    assert(value == static_cast<double>(block.sequence()));
+                }
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (uint64_t n = 1; n <= 2000; ++n) {
+        double* data = blocks.beginWrite(512);
+        if (!data) continue;
+        std::fill(data, data + 512, static_cast<double>(blocks.publishedCount() + 1));
+        blocks.publish();
+    }
+    running.store(false);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    assert(blocks.publishedCount() + blocks.droppedCount() == 2000);
+    
+    std::cout << "Zero-copy output view tests passed!" << std::endl;
+}
+
+void test_pool_limits() {
+    std::cout << "Testing preallocated pools and voice stealing..." << std::endl;
+    
+    PoolLimits limits;
+    limits.max_fields = 4;
+    limits.max_sources_per_interference = 2;
+    limits.max_interference_fields = 1;
+    limits.steal_policy = VoiceStealPolicy::QUIETEST;
+    
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize(limits);
+    
+    auto spawn = [&core](double amplitude, double phi) {
+        QuantumSoundField field = core.createQuantumSoundField(440.0, {1.0, M_PI / 2, phi, 1.0}, QuantumSoundState::COHERENT);
+        field.amplitude = std::complex<double>(amplitude, 0.0);
+        return core.processSoundField(field);
+    };
+    
+    for (int i = 0; i < 4; ++i) {
+        FieldHandle handle = spawn(0.5 + i, 0.1 * i);
+        assert(handle.isValid());
+    }
+    assert(core.getSoundFieldCount() == 4);
+    
+    // Громкое поле вытесняет самое тихое, совсем тихое отклоняется
+    FieldHandle loud = spawn(10.0, 1.0);
+    assert(loud.isValid());
+    FieldHandle quiet = spawn(0.01, 1.1);
+    assert(!quiet.isValid());
+    assert(core.getSoundFieldCount() == 4);
+    {
+        auto fields = core.viewOutputFields();
+        for (const auto& amplitude : fields.amplitudes()) {
+            assert(std::abs(amplitude) > 1.0);
+        }
+    }
+    
+    // Интерференционные поля и их источники
+    auto field = std::make_unique<InterferenceField>(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord{0.0, 0.0, 0.0, 0.0}, 5.0);
+    InterferenceField* interference = field.get();
+    core.addInterferenceField(std::move(field));
+    core.addInterferenceField(std::make_unique<InterferenceField>(InterferenceFieldType::DESTRUCTIVE, SphericalCoord{0.0, 0.0, 0.0, 0.0}, 5.0));
+    
+    QuantumSoundField source = core.createQuantumSoundField(220.0, {2.0, M_PI / 2, 0.0, 1.0}, QuantumSoundState::COHERENT);
+    bool added = interference->addSourceField(source);
+    assert(added);
+    added = interference->addSourceField(source);
+    assert(added);
+    source.amplitude = std::complex<double>(3.0, 0.0);
+    added = interference->addSourceField(source);
+    assert(added);
+    assert(interference->getSourceFieldCount() == 2);
+    
+    auto pressure = core.getPoolPressure();
+    assert(pressure.fields.capacity == 4 && pressure.fields.in_use == 4);
+    assert(pressure.fields.stolen == 1 && pressure.fields.rejected == 1);
+    assert(pressure.fields.pressure() == 1.0);
+    assert(pressure.interference.in_use == 1 && pressure.interference.rejected == 1);
+    assert(pressure.sources.capacity == 2 && pressure.sources.stolen == 1);
+    
+    // Повторная инициализация применяет новые лимиты к заполненным пулам
+    limits.max_fields = 2;
+    limits.max_sources_per_interference = 1;
+    const bool reinitialized = core.initialize(limits);
+    assert(reinitialized);
+    assert(core.getPoolLimits().max_fields == 2);
+    assert(core.getSoundFieldCount() == 2);
+    assert(interference->getSourceFieldCount() == 1);
+    pressure = core.getPoolPressure();
+    assert(pressure.fields.capacity == 2 && pressure.fields.stolen == 3);
+    {
+        auto fields = core.viewOutputFields();
+        for (const auto& amplitude : fields.amplitudes()) {
+            assert(std::abs(amplitude) > 2.0);
+        }
+    }
+    
+    // initialize() без лимитов не сбрасывает их к значениям по умолчанию
+    const bool initialized_again = core.initialize();
+    assert(initialized_again && core.getPoolLimits().max_fields == 2);
+    
+    std::cout << "Pool limit tests passed!" << std::endl;
+}
+
+void test_snapshot_exchange() {
+    std::cout << "Testing SnapshotExchange..." << std::endl;
+    
+    SnapshotExchange<RenderSnapshot, 4> exchange;
+    const RenderSnapshot* empty = exchange.acquire();
+    assert(empty == nullptr);
+    
+    // Непрочитанный снимок заменяется новым
+    auto* first = new RenderSnapshot();
+    first->version = 1;
+    exchange.publish(first);
+    auto* second = new RenderSnapshot();
+    second->version = 2;
+    exchange.publish(second);
+    
+    const RenderSnapshot* current = exchange.acquire();
+    assert(current && current->version == 2);
+    const RenderSnapshot* again = exchange.acquire();
+    assert(again == current);
+    
+    // Прежний снимок возвращается писателю и освобождается в collect()
+    auto* third = new RenderSnapshot();
+    third->version = 3;
+    exchange.publish(third);
+    const RenderSnapshot* latest = exchange.acquire();
+    assert(latest->version == 3);
+    assert(exchange.retiredCount() == 1);
+    assert(exchange.collect() == 1);
+    assert(exchange.retiredCount() == 0);
+    
+    // С заранее выделенными снимками отработанные возвращаются в пул
+    // вместе с памятью массивов и выдаются снова
+    SnapshotExchange<RenderSnapshot, 4> pooled;
+    pooled.preallocate(3, [](RenderSnapshot& snapshot) { snapshot.field_ids.reserve(256); });
+    assert(pooled.freeCount() == 3);
+    std::vector<const RenderSnapshot*> seen;
+    for (uint64_t version = 1; version <= 32; ++version) {
+        RenderSnapshot* snapshot = pooled.allocate();
+        assert(snapshot->field_ids.capacity() >= 256);
+        if (std::find(seen.begin(), seen.end(), snapshot) == seen.end()) seen.push_back(snapshot);
+        snapshot->version = version;
+        snapshot->field_ids.assign(100 + version, version);
+        pooled.publish(snapshot);
+        const RenderSnapshot* current = pooled.acquire();
+        assert(current == snapshot && current->field_ids.size() == 100 + version);
+    }
+    assert(seen.size() <= 3);
+    
+    std::cout << "SnapshotExchange tests passed!" << std::endl;
+}
+
+void test_concurrent_edits() {
+    std::cout << "Testing concurrent edits during processBlock..." << std::endl;
+    
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    core.prepareBlockProcessing(48000.0, 64);
+    
+    std::atomic<bool> running(true);
+    std::thread control([&]() {
+        int edit = 0;
+        while (running.load()) {
+            SphericalCoord position{1.0 + (edit % 32) * 0.1, M_PI / 2, 0.0, 1.0};
+            core.processSoundField(core.createQuantumSoundField(200.0 + edit % 100, position,
+                                                                QuantumSoundState::COHERENT));
+            ++edit;
+        }
+    });
+    
+    float output[64];
+    for (int block = 0; block < 2000; ++block) {
+        core.processBlock(nullptr, output, 64);
+        for (float sample : output) {
+            assert(std::isfinite(sample));
+        }
+    }
+    
+    running.store(false);
+    control.join();
+    core.collectRetiredSnapshots();
+    assert(core.getSoundFieldCount() <= 32);
+    
+    std::cout << "Concurrent edit tests passed!" << std::endl;
+}
+
 int main() {
     std::cout << "=== anAntaDigital Core Tests ===" << std::endl;
     
@@ -82,6 +704,17 @@ int main() {
         test_dome_resonator();
         test_interference_field();
         test_quantum_sound_field();
+        test_process_block();
+        test_cached_dome_resonance();
+        test_input_analysis();
+        test_speaker_rendering();
+        test_speaker_voice_groups();
+        test_speaker_voice_fade();
+        test_output_voice_growth();
+        test_output_views();
+        test_pool_limits();
+        test_snapshot_exchange();
+        test_concurrent_edits();
         
         std::cout << "All tests passed successfully!" << std::endl;
         return 0;
@@ -0,0 +1,179 @@
+#include "../src/offline_renderer.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+using namespace AnantaDigital;
+
+static std::unique_ptr<AnantaDigitalCore> makeCore() {
+    return std::make_unique<AnantaDigitalCore>(10.0, 5.0);
+}
+
+// Сумма двух тонов с медленно меняющейся частотой
+static std::vector<float> makeInput(size_t frames, double sample_rate) {
+    std::vector<float> input(frames);
+    double phase = 0.0;
+    for (size_t t = 0; t < frames; ++t) {
+        double frequency = 600.0 + 200.0 * std::sin(2.0 * M_PI * t / (4.0 * sample_rate));
+        phase += 2.0 * M_PI * frequency / sample_rate;
+        input[t] = static_cast<float>(0.4 * std::sin(phase) + 0.2 * std::sin(2.0 * M_PI * 2500.0 * t / sample_rate));
+    }
+    return input;
+}
+
+static OfflineRenderSettings makeSettings() {
+    OfflineRenderSettings settings;
+    settings.sample_rate = 48000.0;
+    settings.chunk_frames = 16384;
+    settings.warmup_frames = 4096;
+    settings.seed = 42;
+    return settings;
+}
+
+void test_serial_equivalence() {
+    std::cout << "Testing single-chunk offline render against serial processing..." << std::endl;
+
+    const size_t frames = 20000;
+    auto input = makeInput(frames, 48000.0);
+
+    // Один фрагмент на весь вход — та же последовательность шагов, что и вручную
+    OfflineRenderSettings settings = makeSettings();
+    settings.chunk_frames = frames;
+    OfflineRenderer renderer(makeCore, 2);
+    renderer.setSettings(settings);
+    std::vector<float> offline;
+    OfflineRenderReport report = renderer.render(input, offline);
+    assert(report.chunks == 1 && report.frames == frames);
+
+    auto core = makeCore();
+    core->setRandomSeed(settings.seed);
+    core->initialize();
+    core->prepareBlockProcessing(settings.sample_rate, OfflineRenderer::kHopFrames);
+    std::vector<float> serial(frames);
+    for (size_t position = 0; position < frames; position += OfflineRenderer::kHopFrames) {
+        size_t count = std::min(OfflineRenderer::kHopFrames, frames - position);
+        core->processInterferenceField(std::vector<double>(input.begin() + position, input.begin() + position + count));
+        core->processDomeResonance();
+        core->generateOutput(serial.data() + position, count);
+    }
+    assert(offline == serial);
+
+    std::cout << "Serial equivalence tests passed!" << std::endl;
+}
+
+void test_deterministic_chunks() {
+    std::cout << "Testing chunk-parallel determinism..." << std::endl;
+
+    const size_t frames = 5 * 16384 + 3000;
+    auto input = makeInput(frames, 48000.0);
+
+    // Результат не зависит от числа потоков
+    std::vector<float> single, parallel;
+    OfflineRenderer one(makeCore, 1);
+    one.setSettings(makeSettings());
+    OfflineRenderReport report = one.render(input, single);
+
+    OfflineRenderer four(makeCore, 4);
+    four.setSettings(makeSettings());
+    OfflineRenderReport parallel_report = four.render(input, parallel);
+    assert(single == parallel);
+    assert(parallel_report.workers == 4);
+
+    // Шесть фрагментов; разгон у всех, кроме первого, до разгона — проход без синтеза
+    assert(report.chunks == 6);
+    assert(report.frames == frames && single.size() == frames);
+    assert(report.processed_frames == frames + 5 * 4096);
+    assert(report.advanced_frames == 16384 * (1 + 2 + 3 + 4 + 5) - 5 * 4096);
+    assert(report.real_time_factor > 0.0 && report.wall_seconds > 0.0);
+    assert(std::abs(report.audio_seconds - frames / 48000.0) < 1e-12);
+
+    float peak = 0.0f;
+    for (float sample : single) {
+        assert(std::isfinite(sample));
+        peak = std::max(peak, std::abs(sample));
+    }
+    assert(peak > 0.0f);
+
+    std::cout << "Chunk-parallel determinism tests passed!" << std::endl;
+}
+
+void test_seamless_boundaries() {
+    std::cout << "Testing chunk boundary stitching..." << std::endl;
+
+    const size_t frames = 4 * 16384;
+    auto input = makeInput(frames, 48000.0);
+
+    OfflineRenderSettings settings = makeSettings();
+    OfflineRenderer chunked(makeCore, 4);
+    chunked.setSettings(settings);
+    std::vector<float> stitched;
+    chunked.render(input, stitched);
+
+    settings.chunk_frames = frames;
+    OfflineRenderer whole(makeCore, 1);
+    whole.setSettings(settings);
+    std::vector<float> serial;
+    whole.render(input, serial);
+
+    // Фрагменты стыкуются встык и совпадают с последовательной обработкой отсчет в отсчет
+    assert(stitched == serial);
+
+    std::cout << "Chunk boundary stitching tests passed!" << std::endl;
+}
+
+void test_slow_chunks() {
+    std::cout << "Testing determinism of chunks slower than the feedback delay..." << std::endl;
+
+    // Сотни полей делают фрагмент дольше 50 мс настенного времени — задержки
+    // обратной связи; результат все равно не зависит от скорости и числа потоков
+    auto makeBusyCore = [] {
+        auto core = makeCore();
+        for (int i = 0; i < 300; ++i) {
+            QuantumSoundField field = core->createQuantumSoundField(
+                100.0 + 7.0 * i, {1.0 + 0.01 * i, M_PI / 3, 0.05 * i, 0.0}, QuantumSoundState::COHERENT);
+            field.amplitude = std::complex<double>(0.001, 0.0);
+            core->processSoundField(field);
+        }
+        return core;
+    };
+
+    const size_t frames = 4 * 32768;
+    auto input = makeInput(frames, 48000.0);
+    OfflineRenderSettings settings = makeSettings();
+    settings.chunk_frames = 32768;
+
+    std::vector<float> first, second, parallel;
+    OfflineRenderer one(makeBusyCore, 1);
+    one.setSettings(settings);
+    OfflineRenderReport report = one.render(input, first);
+    assert(report.wall_seconds / report.chunks > 0.05);
+    one.render(input, second);
+    assert(first == second);
+
+    OfflineRenderer four(makeBusyCore, 4);
+    four.setSettings(settings);
+    four.render(input, parallel);
+    assert(first == parallel);
+
+    std::cout << "Slow chunk determinism tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== OfflineRenderer Tests ===" << std::endl;
+
+    try {
+        test_serial_equivalence();
+        test_deterministic_chunks();
+        test_seamless_boundaries();
+        test_slow_chunks();
+
+        std::cout << "All offline renderer tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,267 @@
+#include "../src/oscillator_bank.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaDigital;
+
+void test_single_oscillator_accuracy() {
+    std::cout << "Testing OscillatorBank accuracy..." << std::endl;
+    
+    OscillatorBank bank(48000.0);
+    bank.addOscillator(440.0, 0.5, M_PI / 3);
+    
+    std::vector<float> output(1000);
+    bank.render(output.data(), output.size());
+    
+    for (size_t i = 0; i < output.size(); ++i) {
+        double expected = 0.5 * std::sin(2.0 * M_PI * 440.0 * i / 48000.0 + M_PI / 3);
+        assert(std::abs(output[i] - expected) < 1e-4);
+    }
+    
+    std::cout << "OscillatorBank accuracy tests passed!" << std::endl;
+}
+
+void test_phase_continuity() {
+    std::cout << "Testing OscillatorBank phase continuity..." << std::endl;
+    
+    OscillatorBank split(44100.0);
+    OscillatorBank whole(44100.0);
+    split.addOscillator(1234.5, 1.0);
+    whole.addOscillator(1234.5, 1.0);
+    
+    // Блоки разной длины должны давать тот же сигнал, что и один длинный блок
+    std::vector<float> a(300);
+    split.render(a.data(), 37);
+    split.render(a.data() + 37, 64);
+    split.render(a.data() + 101, 199);
+    
+    std::vector<float> b(300);
+    whole.render(b.data(), b.size());
+    
+    for (size_t i = 0; i < a.size(); ++i) {
+        assert(std::abs(a[i] - b[i]) < 1e-4f);
+    }
+    
+    std::cout << "OscillatorBank phase continuity tests passed!" << std::endl;
+}
+
+void test_mixing_and_removal() {
+    std::cout << "Testing OscillatorBank mixing..." << std::endl;
+    
+    OscillatorBank bank(48000.0);
+    bank.reserve(20);
+    assert(bank.capacity() >= 20);
+    
+    // Больше одной SIMD-плитки: проверяем смешивание и хвостовые дорожки
+    for (int k = 0; k < 11; ++k) {
+        bank.addOscillator(100.0 + 50.0 * k, 0.1);
+    }
+    assert(bank.size() == 11);
+    
+    std::vector<float> output(256);
+    bank.render(output.data(), output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        double expected = 0.0;
+        for (int k = 0; k < 11; ++k) {
+            expected += 0.1 * std::sin(2.0 * M_PI * (100.0 + 50.0 * k) * i / 48000.0);
+        }
+        assert(std::abs(output[i] - expected) < 1e-4);
+    }
+    
+    // Удаление переставляет последний осциллятор на место удаленного
+    bank.removeOscillator(0);
+    assert(bank.size() == 10);
+    assert(std::abs(bank.getFrequency(0) - 600.0) < 1e-3);
+    
+    bank.clear();
+    assert(bank.empty());
+    bank.render(output.data(), output.size());
+    for (float sample : output) {
+        assert(sample == 0.0f);
+    }
+    
+    std::cout << "OscillatorBank mixing tests passed!" << std::endl;
+}
+
+void test_render_each() {
+    std::cout << "Testing OscillatorBank separate outputs..." << std::endl;
+    
+    OscillatorBank separate(48000.0);
+    OscillatorBank mixed(48000.0);
+    for (OscillatorBank* bank : {&separate, &mixed}) {
+        for (int k = 0; k < 5; ++k) {
+            bank->addOscillator(200.0 + 130.0 * k, 0.2, 0.3 * k);
+        }
+    }
+    
+    // Два блока по 100 отсчетов: сумма раздельных сигналов равна общей смеси
+    const size_t frames = 100;
+    const size_t stride = 128;
+    std::vector<float> each(5 * stride);
+    std::vector<float> mix(frames);
+    for (int block = 0; block < 2; ++block) {
+        separate.renderEach(each.data(), stride, 5, frames);
+        mixed.render(mix.data(), frames);
+        for (size_t i = 0; i < frames; ++i) {
+            float sum = 0.0f;
+            for (size_t k = 0; k < 5; ++k) {
+                sum += each[k * stride + i];
+            }
+            assert(std::abs(sum - mix[i]) < 1e-5);
+        }
+    }
+    
+    // Осцилляторы сверх count не пишутся, но их фаза продвигается
+    separate.renderEach(each.data(), stride, 2, frames);
+    mixed.render(mix.data(), frames);
+    assert(std::abs(separate.getPhase(4) - mixed.getPhase(4)) < 1e-5);
+    
+    std::cout << "OscillatorBank separate output tests passed!" << std::endl;
+}
+
+void test_amplitude_ramps() {
+    std::cout << "Testing OscillatorBank amplitude ramps..." << std::endl;
+    
+    // Нулевая частота с фазой π/2 выдает саму амплитуду
+    OscillatorBank bank(48000.0);
+    bank.addOscillator(0.0, 0.0, M_PI / 2);
+    bank.setAmplitudeTarget(0, 1.0, 100.0);
+    assert(bank.isRamping() && bank.getRampingCount() == 1);
+    assert(bank.getAmplitudeTarget(0) == 1.0);
+    
+    // Линейная рампа: ровно target через 100 отсчетов, затем удержание
+    std::vector<float> output(160);
+    bank.render(output.data(), 30);
+    bank.render(output.data() + 30, 130);
+    ParameterRamp reference = ParameterRamp::plan(0.0f, 1.0f, 100.0, RampShape::LINEAR);
+    std::vector<float> expected(160);
+    reference.advance(0.0f, expected.data(), expected.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        assert(std::abs(output[i] - i / 100.0f) < 1e-4f || i >= 100);
+        assert(std::abs(output[i] - expected[i]) < 1e-5f);
+    }
+    assert(std::abs(output[100] - 1.0f) < 1e-5f && std::abs(output[159] - 1.0f) < 1e-5f);
+    assert(!bank.isRamping() && bank.getAmplitude(0) == 1.0);
+    
+    // Экспоненциальная и однополюсная формы приходят точно в цель, не проскакивая ее
+    for (RampShape shape : {RampShape::EXPONENTIAL, RampShape::ONE_POLE}) {
+        bank.setAmplitudeTarget(0, 0.25, 200.0, shape);
+        std::vector<float> block(4096);
+        bank.render(block.data(), block.size());
+        for (size_t i = 1; i < block.size(); ++i) {
+            assert(block[i] <= block[i - 1] + 1e-7f && block[i] >= 0.25f - 1e-5f);
+        }
+        assert(std::abs(block.back() - 0.25f) < 1e-5f && bank.getAmplitude(0) == 0.25);
+        assert(!bank.isRamping());
+        bank.setAmplitudeTarget(0, 1.0, 200.0, shape);
+        bank.render(block.data(), block.size());
+        assert(bank.getAmplitude(0) == 1.0);
+    }
+    
+    // Экспоненциальное нарастание из нуля (новый голос) монотонно и сразу слышно
+    OscillatorBank fade_in(48000.0);
+    fade_in.addOscillator(0.0, 0.0, M_PI / 2);
+    fade_in.setAmplitudeTarget(0, 0.8, 240.0, RampShape::EXPONENTIAL);
+    std::vector<float> envelope(480);
+    fade_in.render(envelope.data(), envelope.size());
+    assert(envelope[0] == 0.0f && envelope[1] > 0.0f);
+    for (size_t i = 1; i < envelope.size(); ++i) {
+        assert(envelope[i] >= envelope[i - 1] && envelope[i] <= 0.8f + 1e-6f);
+    }
+    assert(envelope[120] > 0.8f * 1e-3f && envelope[120] < 0.8f * 1e-1f);
+    assert(std::abs(envelope[240] - 0.8f) < 1e-4f && std::abs(envelope.back() - 0.8f) < 1e-6f);
+    
+    // Одиночный отсчет 0 → -v тоже выходит из нуля
+    ParameterRamp negative = ParameterRamp::plan(0.0f, -0.5f, 64.0, RampShape::EXPONENTIAL);
+    float value = 0.0f;
+    for (int i = 0; i < 32; ++i) {
+        const float next = negative.step(value);
+        assert(next < 0.0f && next <= value);
+        value = next;
+    }
+    
+    // Один большой блок совпадает с последовательностью малых
+    OscillatorBank whole(48000.0);
+    OscillatorBank chunked(48000.0);
+    std::vector<float> mix_whole(4096);
+    std::vector<float> mix_chunked(4096);
+    for (OscillatorBank* target : {&whole, &chunked}) {
+        for (int k = 0; k < 9; ++k) {
+            target->addOscillator(110.0 * (k + 1), 0.1, 0.2 * k);
+            target->setAmplitudeTarget(k, 0.05 * k, 300.0 + 250.0 * k,
+                                       static_cast<RampShape>(k % 3));
+        }
+    }
+    whole.render(mix_whole.data(), mix_whole.size());
+    for (size_t offset = 0; offset < mix_chunked.size(); offset += 64) {
+        chunked.render(mix_chunked.data() + offset, 64);
+    }
+    for (size_t i = 0; i < mix_whole.size(); ++i) {
+        assert(std::abs(mix_whole[i] - mix_chunked[i]) < 1e-5f);
+    }
+    
+    // Раздельные сигналы во время рампы складываются в общую смесь
+    OscillatorBank separate(48000.0);
+    OscillatorBank mixed(48000.0);
+    for (OscillatorBank* target : {&separate, &mixed}) {
+        for (int k = 0; k < 4; ++k) {
+            target->addOscillator(300.0 + 50.0 * k, 0.5, 0.0);
+            target->setAmplitudeTarget(k, 0.1 * k, 150.0, RampShape::EXPONENTIAL);
+        }
+    }
+    const size_t stride = 128;
+    std::vector<float> each(4 * stride);
+    std::vector<float> mix(100);
+    for (int block = 0; block < 3; ++block) {
+        separate.renderEach(each.data(), stride, 4, 100);
+        mixed.render(mix.data(), 100);
+        for (size_t i = 0; i < 100; ++i) {
+            float sum = 0.0f;
+            for (size_t k = 0; k < 4; ++k) {
+                sum += each[k * stride + i];
+            }
+            assert(std::abs(sum - mix[i]) < 1e-5f);
+        }
+    }
+    assert(!separate.isRamping() && !mixed.isRamping());
+    
+    // Ступенька амплитуды со сглаживанием не дает щелчка:
+    // шаг между отсчетами не больше шага синусоиды полной амплитуды
+    OscillatorBank step(48000.0);
+    step.addOscillator(100.0, 0.0, 0.0);
+    step.setAmplitudeTarget(0, 1.0, 240.0);
+    std::vector<float> smooth(1024);
+    step.render(smooth.data(), smooth.size());
+    const float max_step = static_cast<float>(2.0 * M_PI * 100.0 / 48000.0 + 1.0 / 240.0);
+    for (size_t i = 1; i < smooth.size(); ++i) {
+        assert(std::abs(smooth[i] - smooth[i - 1]) <= max_step * 1.01f);
+    }
+    
+    // setAmplitude отменяет рампу
+    step.setAmplitudeTarget(0, 0.0, 1000.0);
+    step.setAmplitude(0, 0.5);
+    assert(!step.isRamping() && step.getAmplitudeTarget(0) == 0.5);
+    
+    std::cout << "OscillatorBank amplitude ramp tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== OscillatorBank Tests ===" << std::endl;
+    
+    try {
+        test_single_oscillator_accuracy();
+        test_phase_continuity();
+        test_mixing_and_removal();
+        test_render_each();
+        test_amplitude_ramps();
+        
+        std::cout << "All oscillator bank tests passed!" << std::endl;
+        return 0;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
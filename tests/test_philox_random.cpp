@@ -0,0 +1,155 @@
+#include "../src/philox_random.hpp"
+#include "../src/interference_field.hpp"
+#include "../src/quantum_feedback_system.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace AnantaDigital;
+
+void test_known_answers() {
+    std::cout << "Testing Philox4x32-10 known answers..." << std::endl;
+
+    // Контрольные векторы Random123
+    auto zero = PhiloxRandom::generate(0, 0, 0);
+    assert(zero[0] == 0x6627e8d5u && zero[1] == 0xe169c58du && zero[2] == 0xbc57ac4cu && zero[3] == 0x9b00dbd8u);
+
+    auto ones = PhiloxRandom::generate(UINT64_MAX, UINT64_MAX, UINT64_MAX);
+    assert(ones[0] == 0x408f276du && ones[1] == 0x41c83b0eu && ones[2] == 0xa20bc7c6u && ones[3] == 0x6d5451fdu);
+
+    auto pi = PhiloxRandom::generate(0x85a308d3243f6a88ULL, 0x0370734413198a2eULL, 0x299f31d0a4093822ULL);
+    assert(pi[0] == 0xd16cfe09u && pi[1] == 0x94fdccebu && pi[2] == 0x5001e420u && pi[3] == 0x24126ea1u);
+
+    std::cout << "Philox known answer tests passed!" << std::endl;
+}
+
+void test_bulk_and_split() {
+    std::cout << "Testing PhiloxRandom bulk generation..." << std::endl;
+
+    const size_t count = 10001;
+    PhiloxRandom rng(42, 7);
+    std::vector<double> serial(count);
+    rng.fillUniform(serial.data(), count);
+    assert(rng.getCounter() == (count + 1) / 2);
+
+    // Тот же диапазон, разбитый между потоками, дает те же значения
+    std::vector<double> parallel(count);
+    const size_t parts = 4;
+    const size_t chunk = 2500;  // четное: части начинаются с границы блока
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < parts; ++p) {
+        threads.emplace_back([&, p]() {
+            size_t begin = p * chunk;
+            size_t end = (p + 1 == parts) ? count : begin + chunk;
+            rng.fillUniformAt(begin / 2, parallel.data() + begin, end - begin);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    assert(parallel == serial);
+
+    // Равномерность и независимость потоков
+    double mean = 0.0;
+    for (double value : serial) {
+        assert(value >= 0.0 && value < 1.0);
+        mean += value;
+    }
+    mean /= count;
+    assert(std::abs(mean - 0.5) < 0.01);
+
+    PhiloxRandom other(42, 8);
+    assert(other.uniform() != serial[0]);
+
+    // Нормальное распределение
+    std::vector<double> normal(count);
+    PhiloxRandom(3).fillNormalAt(0, normal.data(), count, 1.0, 2.0);
+    double sum = 0.0, sum_sq = 0.0;
+    for (double value : normal) {
+        assert(std::isfinite(value));
+        sum += value;
+        sum_sq += value * value;
+    }
+    double normal_mean = sum / count;
+    double variance = sum_sq / count - normal_mean * normal_mean;
+    assert(std::abs(normal_mean - 1.0) < 0.1);
+    assert(std::abs(variance - 4.0) < 0.3);
+
+    std::cout << "PhiloxRandom bulk generation tests passed!" << std::endl;
+}
+
+void test_reproducible_updates() {
+    std::cout << "Testing reproducible quantum state updates..." << std::endl;
+
+    // Два поля с одним seed проходят одинаковую последовательность состояний
+    auto run = [](uint64_t seed) {
+        InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord{0.0, 0.0, 0.0, 0.0}, 10.0);
+        field.setRandomSeed(seed, 3);
+        for (int i = 0; i < 64; ++i) {
+            QuantumSoundField source;
+            source.quantum_state = static_cast<QuantumSoundState>(1 + i % 3);
+            field.addSourceField(source);
+        }
+        std::vector<QuantumSoundState> history;
+        for (int step = 0; step < 50; ++step) {
+            field.updateQuantumState(0.01);
+            for (const auto& source : field.getSourceFields()) {
+                history.push_back(source.quantum_state);
+            }
+        }
+        return history;
+    };
+
+    auto first = run(1234);
+    auto second = run(1234);
+    auto different = run(4321);
+    assert(first == second);
+    assert(first != different);
+
+    std::cout << "Reproducible quantum state update tests passed!" << std::endl;
+}
+
+void test_feedback_sample_time() {
+    std::cout << "Testing feedback gating on signal time..." << std::endl;
+
+    // Обратная связь срабатывает по времени сигнала: паузы между вызовами
+    // не меняют ни моменты срабатывания, ни случайные числа
+    auto run = [](bool slow) {
+        Feedback::QuantumFeedbackSystem feedback(std::chrono::microseconds(50000), 0.7);
+        feedback.setRandomSeed(99, 0);
+        std::vector<std::complex<double>> outputs;
+        for (int call = 0; call <= 40; ++call) {
+            if (slow && call % 10 == 3) std::this_thread::sleep_for(std::chrono::milliseconds(60));
+            const std::complex<double> input(0.5 + 0.01 * call, 0.1);
+            outputs.push_back(feedback.processQuantumSignal(input, std::chrono::microseconds(10000 * call)));
+        }
+        assert(feedback.getFeedback().size() == 8);
+        return outputs;
+    };
+
+    auto fast = run(false);
+    auto slow = run(true);
+    assert(fast == slow);
+    assert(fast[4] == std::complex<double>(0.54, 0.1));
+    assert(fast[5] != std::complex<double>(0.55, 0.1));
+
+    std::cout << "Feedback signal time tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== PhiloxRandom Tests ===" << std::endl;
+
+    try {
+        test_known_answers();
+        test_bulk_and_split();
+        test_reproducible_updates();
+        test_feedback_sample_time();
+
+        std::cout << "All Philox random tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
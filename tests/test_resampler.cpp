@@ -0,0 +1,221 @@
+#include "../src/resampler.hpp"
+#include "../src/anantadigital_core.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+using namespace AnantaDigital;
+
+// Ошибка синуса на выходе относительно идеального (с учетом задержки), дБ
+static double sineErrorDb(const std::vector<float>& output, double frequency, double output_rate,
+                          double latency_seconds, size_t skip) {
+    double signal = 0.0, error = 0.0;
+    for (size_t t = skip; t + skip < output.size(); ++t) {
+        double expected = std::sin(2.0 * M_PI * frequency * (t / output_rate - latency_seconds));
+        signal += expected * expected;
+        error += (output[t] - expected) * (output[t] - expected);
+    }
+    return 10.0 * std::log10(error / signal);
+}
+
+static std::vector<float> makeSine(double frequency, double rate, size_t frames) {
+    std::vector<float> signal(frames);
+    for (size_t t = 0; t < frames; ++t) {
+        signal[t] = static_cast<float>(std::sin(2.0 * M_PI * frequency * t / rate));
+    }
+    return signal;
+}
+
+void test_rational_ratio() {
+    std::cout << "Testing rational ratio reduction..." << std::endl;
+
+    uint32_t l, m;
+    PolyphaseResampler::rationalRatio(44100.0, 48000.0, PolyphaseResampler::kMaxPhases, l, m);
+    assert(l == 160 && m == 147);
+    PolyphaseResampler::rationalRatio(96000.0, 48000.0, PolyphaseResampler::kMaxPhases, l, m);
+    assert(l == 1 && m == 2);
+
+    // Нецелое отношение приближается подходящей дробью
+    PolyphaseResampler::rationalRatio(44100.0, 44100.0 * M_PI, 1000, l, m);
+    assert(l <= 1000 && m <= 1000);
+    assert(std::abs(static_cast<double>(l) / m - M_PI) < 1e-5);
+
+    // Таблица разделяется экземплярами с тем же отношением
+    PolyphaseResampler a, b;
+    a.configure(44100.0, 48000.0);
+    b.configure(44100.0, 48000.0);
+    assert(a.getInterpolation() == 160 && a.getDecimation() == 147);
+    assert(PolyphaseResampler::filterTable(160, 147, ResamplerQuality::STANDARD) ==
+           PolyphaseResampler::filterTable(160, 147, ResamplerQuality::STANDARD));
+
+    std::cout << "Rational ratio tests passed!" << std::endl;
+}
+
+void test_sine_accuracy() {
+    std::cout << "Testing resampled sine accuracy..." << std::endl;
+
+    struct Case { double in, out, frequency; ResamplerQuality quality; double max_error_db; };
+    const Case cases[] = {
+        {44100.0, 48000.0, 1000.0, ResamplerQuality::STANDARD, -80.0},
+        {48000.0, 96000.0, 5000.0, ResamplerQuality::STANDARD, -80.0},
+        {96000.0, 48000.0, 3000.0, ResamplerQuality::STANDARD, -80.0},
+        {48000.0, 44100.0, 12000.0, ResamplerQuality::HIGH, -100.0},
+        {44100.0, 48000.0, 1000.0, ResamplerQuality::FAST, -50.0},
+    };
+
+    for (const auto& test : cases) {
+        PolyphaseResampler resampler;
+        resampler.configure(test.in, test.out, test.quality);
+        resampler.prepare(512);
+
+        auto input = makeSine(test.frequency, test.in, 8192);
+        std::vector<float> output(resampler.getMaxOutputFrames(input.size()));
+        size_t produced = resampler.process(input.data(), input.size(), output.data());
+        output.resize(produced);
+        assert(std::abs(static_cast<double>(produced) - input.size() * test.out / test.in) < 2.0);
+
+        // Переходный процесс в начале занимает задержку фильтра
+        size_t skip = static_cast<size_t>(4.0 * resampler.getLatencyFrames() * test.out / test.in) + 16;
+        double error_db = sineErrorDb(output, test.frequency, test.out, resampler.getLatencySeconds(), skip);
+        assert(error_db < test.max_error_db);
+    }
+
+    std::cout << "Resampled sine accuracy tests passed!" << std::endl;
+}
+
+void test_stopband() {
+    std::cout << "Testing anti-aliasing rejection..." << std::endl;
+
+    // 30 кГц при понижении 96 → 48 кГц должен исчезнуть, а не отразиться в 18 кГц
+    PolyphaseResampler resampler;
+    resampler.configure(96000.0, 48000.0);
+    resampler.prepare(1024);
+    auto input = makeSine(30000.0, 96000.0, 16384);
+    std::vector<float> output(resampler.getMaxOutputFrames(input.size()));
+    size_t produced = resampler.process(input.data(), input.size(), output.data());
+
+    double energy = 0.0;
+    size_t skip = 256;
+    for (size_t t = skip; t < produced; ++t) energy += output[t] * output[t];
+    double level_db = 10.0 * std::log10(energy / (produced - skip) / 0.5 + 1e-30);
+    assert(level_db < -80.0);
+
+    std::cout << "Anti-aliasing rejection tests passed!" << std::endl;
+}
+
+void test_streaming() {
+    std::cout << "Testing streaming push and pull..." << std::endl;
+
+    auto input = makeSine(440.0, 44100.0, 5000);
+
+    PolyphaseResampler whole;
+    whole.configure(44100.0, 48000.0);
+    whole.prepare(8192);
+    std::vector<float> reference(whole.getMaxOutputFrames(input.size()));
+    reference.resize(whole.process(input.data(), input.size(), reference.data()));
+
+    // Блоки нечетной длины, в том числе длиннее подготовленного, дают тот же поток
+    PolyphaseResampler chunked;
+    chunked.configure(44100.0, 48000.0);
+    chunked.prepare(100);
+    std::vector<float> streamed;
+    const size_t sizes[] = {1, 7, 64, 333, 2};
+    size_t offset = 0;
+    for (size_t i = 0; offset < input.size(); ++i) {
+        size_t count = std::min(sizes[i % 5], input.size() - offset);
+        std::vector<float> block(chunked.getMaxOutputFrames(count));
+        block.resize(chunked.process(input.data() + offset, count, block.data()));
+        streamed.insert(streamed.end(), block.begin(), block.end());
+        offset += count;
+    }
+    assert(streamed == reference);
+
+    // Pull выдает ровно запрошенное число отсчетов, запрашивая вход по мере надобности
+    PolyphaseResampler pulled;
+    pulled.configure(44100.0, 48000.0);
+    pulled.prepare(256);
+    std::vector<float> output;
+    size_t source_position = 0;
+    for (size_t frames : {480u, 1u, 1000u, 37u}) {
+        std::vector<float> block(frames);
+        pulled.pull(block.data(), frames, [&](float* destination, size_t count) {
+            for (size_t t = 0; t < count; ++t) {
+                destination[t] = source_position + t < input.size() ? input[source_position + t] : 0.0f;
+            }
+            source_position += count;
+        });
+        output.insert(output.end(), block.begin(), block.end());
+    }
+    assert(output.size() == 1518);
+    for (size_t t = 0; t < output.size() && t < reference.size(); ++t) {
+        assert(output[t] == reference[t]);
+    }
+    assert(source_position <= input.size());
+
+    std::cout << "Streaming push and pull tests passed!" << std::endl;
+}
+
+void test_core_stream_rates() {
+    std::cout << "Testing core stream sample rates..." << std::endl;
+
+    AnantaDigitalCore core(10.0, 5.0);
+    core.initialize();
+    core.prepareBlockProcessing(48000.0, 256);
+    core.setStreamSampleRates(44100.0, 96000.0);
+    assert(core.getInputSampleRate() == 44100.0);
+    assert(core.getOutputSampleRate() == 96000.0);
+    assert(core.getOutputLatency() > 0.0);
+
+    core.processSoundField(core.createQuantumSoundField(1000.0, {1.0, M_PI / 2, 0.0, 1.0}, QuantumSoundState::COHERENT));
+
+    // Выход на 96 кГц получает вдвое меньше отсчетов синтеза на 48 кГц
+    const SampleTime clock_before = core.getSampleClock();
+    std::vector<float> out(9600);
+    core.generateOutput(out.data(), out.size());
+    const SampleTime rendered = core.getSampleClock() - clock_before;
+    assert(rendered >= 4800 && rendered <= 4800 + 128);
+
+    double peak = 0.0;
+    for (float sample : out) {
+        assert(std::isfinite(sample));
+        peak = std::max(peak, static_cast<double>(std::abs(sample)));
+    }
+    assert(peak > 0.0);
+
+    // Вход на 44.1 кГц анализируется на частоте обработки: пик остается на месте
+    auto input = makeSine(3000.0, 44100.0, 44100);
+    core.processAudioSignal(std::vector<double>(input.begin(), input.end()));
+    bool found = false;
+    for (const auto& field : core.getOutputFields()) {
+        found = found || std::abs(field.frequency - 3000.0) < 30.0;
+    }
+    assert(found);
+
+    // Без заданных частот потоки совпадают с частотой обработки
+    core.setStreamSampleRates(0.0, 0.0);
+    assert(core.getInputSampleRate() == 48000.0 && core.getOutputSampleRate() == 48000.0);
+    assert(core.getOutputLatency() == 0.0);
+
+    std::cout << "Core stream sample rate tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== PolyphaseResampler Tests ===" << std::endl;
+
+    try {
+        test_rational_ratio();
+        test_sine_accuracy();
+        test_stopband();
+        test_streaming();
+        test_core_stream_rates();
+
+        std::cout << "All resampler tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,258 @@
+#include "../src/source_octree.hpp"
+#include "../src/interference_field.hpp"
+#include "../src/worker_pool.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaDigital;
+using Point = Kernels::CartesianPoint<double>;
+
+// Плотное скопление источников на нескольких общих частотах и немного одиночных
+static std::vector<SourceOctree::Source> makeCluster(size_t count) {
+    const double frequencies[] = {40.0, 63.0, 80.0};
+    std::vector<SourceOctree::Source> sources(count);
+    for (size_t i = 0; i < count; ++i) {
+        SourceOctree::Source& source = sources[i];
+        source.position = {std::fmod(i * 7.31, 24.0) - 12.0, std::fmod(i * 3.17, 24.0) - 12.0,
+                           std::fmod(i * 0.913, 6.0) - 3.0};
+        source.amplitude = std::complex<double>(0.3 + 0.1 * (i % 7), 0.05 * (i % 11) - 0.25);
+        source.frequency = i % 50 == 0 ? 100.0 + 0.37 * i : frequencies[i % 3];
+    }
+    return sources;
+}
+
+// Прямая сумма и сумма модулей вкладов
+static std::complex<double> directSum(const std::vector<SourceOctree::Source>& sources, const Point& observer,
+                                      double time, double* magnitude = nullptr) {
+    std::complex<double> total(0.0, 0.0);
+    double sum = 0.0;
+    for (const auto& source : sources) {
+        const double distance = Kernels::distance(source.position, observer);
+        total += Kernels::sourceContribution<double>(source.amplitude, source.frequency, distance, time);
+        sum += std::abs(source.amplitude) * Kernels::distanceAttenuation(distance);
+    }
+    if (magnitude) *magnitude = sum;
+    return total;
+}
+
+static Point observerAt(int i) {
+    return Point{90.0 * std::cos(0.7 * i), 90.0 * std::sin(0.7 * i), 10.0 + 4.0 * i};
+}
+
+void test_far_field_accuracy() {
+    std::cout << "Testing far-field aggregation accuracy..." << std::endl;
+
+    const auto sources = makeCluster(12000);
+    for (double error_bound : {3e-2, 1e-2, 1e-3}) {
+        SourceOctree tree(error_bound);
+        tree.build(sources.data(), sources.size());
+        assert(tree.size() == sources.size());
+        assert(tree.getStatistics().multipole_groups > 0);
+
+        OctreeStatistics statistics;
+        for (int i = 0; i < 8; ++i) {
+            const Point observer = observerAt(i);
+            double magnitude = 0.0;
+            const auto expected = directSum(sources, observer, 3.7 + i, &magnitude);
+            const auto actual = tree.evaluate(observer, 3.7 + i, 0.0, &statistics);
+            assert(std::abs(actual - expected) <= error_bound * magnitude);
+        }
+        // Вдали большинство источников свернуто в разложения; при строгой границе
+        // s(d) ≈ s(D) на этом расстоянии выполняется только для мелких узлов
+        if (error_bound >= 1e-2) {
+            assert(statistics.multipole_evaluations > 0);
+            assert(statistics.aggregated_sources > statistics.direct_sources);
+        }
+    }
+
+    // Внутри скопления ближние узлы считаются напрямую, граница та же
+    SourceOctree tree(1e-2);
+    tree.build(sources.data(), sources.size());
+    for (const Point& observer : {Point{0.0, 0.0, 0.0}, Point{11.0, -4.0, 2.0}, Point{30.0, 5.0, 1.0}}) {
+        double magnitude = 0.0;
+        const auto expected = directSum(sources, observer, 0.25, &magnitude);
+        assert(std::abs(tree.evaluate(observer, 0.25) - expected) <= 1e-2 * magnitude);
+    }
+
+    // Дерево из одного листа совпадает с прямой суммой
+    SourceOctree small;
+    small.build(sources.data(), SourceOctree::kLeafSources);
+    const std::vector<SourceOctree::Source> head(sources.begin(), sources.begin() + SourceOctree::kLeafSources);
+    assert(std::abs(small.evaluate(observerAt(1), 1.5) - directSum(head, observerAt(1), 1.5)) < 1e-12);
+
+    // Порог отбора в ближних узлах
+    const auto all = small.evaluate(Point{0.0, 0.0, 0.0}, 0.0);
+    const auto culled = small.evaluate(Point{0.0, 0.0, 0.0}, 0.0, 1e6);
+    assert(std::abs(all) > 0.0 && std::abs(culled) == 0.0);
+
+    std::cout << "Far-field accuracy tests passed!" << std::endl;
+}
+
+void test_parallel_build() {
+    std::cout << "Testing parallel tree build..." << std::endl;
+
+    const auto sources = makeCluster(8000);
+    SourceOctree serial(1e-2), parallel(1e-2);
+    serial.build(sources.data(), sources.size());
+    WorkerPool pool(4);
+    parallel.build(sources.data(), sources.size(), &pool);
+
+    assert(serial.getStatistics().nodes == parallel.getStatistics().nodes);
+    assert(serial.getStatistics().multipole_groups == parallel.getStatistics().multipole_groups);
+    for (int i = 0; i < 6; ++i) {
+        assert(serial.evaluate(observerAt(i), 0.5 * i) == parallel.evaluate(observerAt(i), 0.5 * i));
+    }
+
+    // Листья поддеревьев, собранных на пуле, привязаны к своим источникам
+    for (size_t i = 0; i < sources.size(); i += 97) {
+        const bool moved_serial = serial.moveSource(i, sources[i].position);
+        const bool moved_parallel = parallel.moveSource(i, sources[i].position);
+        assert(moved_serial && moved_parallel);
+    }
+
+    std::cout << "Parallel build tests passed!" << std::endl;
+}
+
+void test_incremental_refit() {
+    std::cout << "Testing incremental refit of moved sources..." << std::endl;
+
+    // Угловые источники фиксируют корневой куб: перестроенное дерево той же формы
+    auto sources = makeCluster(8000);
+    const size_t moving = sources.size();
+    for (int corner = 0; corner < 8; ++corner) {
+        const Point position{(corner & 1) ? 13.0 : -13.0, (corner & 2) ? 13.0 : -13.0, (corner & 4) ? 4.0 : -4.0};
+        sources.push_back({position, std::complex<double>(0.1, 0.0), 40.0});
+    }
+    SourceOctree tree(1e-2);
+    tree.build(sources.data(), sources.size());
+
+    // Малые сдвиги остаются в своих листах
+    size_t refitted = 0;
+    for (size_t i = 0; i < moving; i += 13) {
+        Point moved = sources[i].position;
+        moved.x += 1e-3;
+        moved.z -= 1e-3;
+        if (tree.moveSource(i, moved)) {
+            sources[i].position = moved;
+            ++refitted;
+        }
+    }
+    assert(refitted > 0);
+
+    SourceOctree rebuilt(1e-2);
+    rebuilt.build(sources.data(), sources.size());
+    for (int i = 0; i < 6; ++i) {
+        const auto a = tree.evaluate(observerAt(i), 2.0);
+        const auto b = rebuilt.evaluate(observerAt(i), 2.0);
+        assert(std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b)));
+    }
+
+    // Выход из листа требует перестройки
+    const bool escaped = tree.moveSource(0, Point{500.0, 0.0, 0.0});
+    assert(!escaped);
+    const bool unknown = tree.moveSource(sources.size(), Point{0.0, 0.0, 0.0});
+    assert(!unknown);
+
+    std::cout << "Incremental refit tests passed!" << std::endl;
+}
+
+void test_interference_field_tree() {
+    std::cout << "Testing InterferenceField tree acceleration..." << std::endl;
+
+    InterferenceField exact(InterferenceFieldType::CONSTRUCTIVE, {0.0, 0.0, 0.0, 0.0}, 10.0);
+    InterferenceField fast(InterferenceFieldType::CONSTRUCTIVE, {0.0, 0.0, 0.0, 0.0}, 10.0);
+    fast.setTreeAcceleration(1e-2);
+    assert(fast.getTreeAcceleration() == 1e-2);
+
+    // Меньше kTreeMinSources — точный перебор
+    for (size_t i = 0; i < 4000; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.2 + 0.1 * (i % 5), 0.1);
+        source.frequency = i % 2 ? 50.0 : 71.0;
+        source.position = SphericalCoord{5.0 + std::fmod(i * 0.37, 8.0), 0.3 + std::fmod(i * 0.011, 1.2),
+                                         std::fmod(i * 0.137, 6.28), 0.0};
+        exact.addSourceField(source);
+        fast.addSourceField(source);
+        if (i == 10) {
+            const Point observer{40.0, 0.0, 3.0};
+            assert(exact.calculateInterference(observer, 0.3) == fast.calculateInterference(observer, 0.3));
+        }
+    }
+    WorkerPool pool(2);
+    fast.rebuildSourceTree(&pool);
+    assert(fast.getTreeStatistics().multipole_groups > 0);
+
+    // Граница ошибки дерева: ε·Σ|a|·A(d) по точности Sample
+    auto bound = [&](const Point& observer) {
+        double magnitude = 0.0;
+        for (const auto& source : exact.getSourceFields()) {
+            const double distance = Kernels::distance(Kernels::toCartesian<double>(source.position), observer);
+            magnitude += std::abs(source.amplitude) * Kernels::distanceAttenuation(distance);
+        }
+        return (1e-2 + 1e-4) * magnitude;
+    };
+    std::vector<double> x(300), y(300), z(300);
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = 120.0 * std::cos(0.021 * i);
+        y[i] = 120.0 * std::sin(0.021 * i);
+        z[i] = 5.0 + 0.1 * i;
+    }
+    for (size_t i = 0; i < x.size(); i += 37) {
+        const Point observer{x[i], y[i], z[i]};
+        const auto expected = exact.calculateInterference(observer, 1.25);
+        assert(std::abs(fast.calculateInterference(observer, 1.25) - expected) <= bound(observer));
+    }
+
+    // Пакетный расчет идет через дерево и совпадает с расчетом в точке
+    ObserverBatch batch;
+    batch.x = x.data();
+    batch.y = y.data();
+    batch.z = z.data();
+    batch.common_time = 1.25;
+    batch.count = x.size();
+    std::vector<std::complex<double>> out(x.size());
+    fast.calculateInterferenceBatch(batch, out.data(), &pool);
+    for (size_t i = 0; i < x.size(); i += 29) {
+        assert(out[i] == fast.calculateInterference(Point{x[i], y[i], z[i]}, 1.25));
+    }
+
+    // Перемещения и удаление видны в следующем расчете
+    for (size_t i = 0; i < 4000; i += 9) {
+        SphericalCoord position = exact.getSourceFields()[i].position;
+        position.phi += 1e-4;
+        const bool moved_exact = exact.moveSourceField(i, position);
+        const bool moved_fast = fast.moveSourceField(i, position);
+        assert(moved_exact && moved_fast);
+    }
+    exact.removeSourceField(3);
+    fast.removeSourceField(3);
+    const Point observer{x[5], y[5], z[5]};
+    assert(std::abs(fast.calculateInterference(observer, 2.0) - exact.calculateInterference(observer, 2.0)) <=
+           bound(observer));
+
+    // Отключение возвращает точный перебор
+    fast.setTreeAcceleration(0.0);
+    assert(fast.calculateInterference(observer, 2.0) == exact.calculateInterference(observer, 2.0));
+
+    std::cout << "InterferenceField tree acceleration tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== SourceOctree Tests ===" << std::endl;
+
+    try {
+        test_far_field_accuracy();
+        test_parallel_build();
+        test_incremental_refit();
+        test_interference_field_tree();
+
+        std::cout << "All source octree tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,137 @@
+#include "../src/speaker_renderer.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaDigital;
+
+// Кольцо громкоговорителей на экваторе купола
+static std::vector<SphericalCoord> makeRing(size_t count, double radius) {
+    std::vector<SphericalCoord> speakers;
+    for (size_t s = 0; s < count; ++s) {
+        speakers.push_back(SphericalCoord{radius, M_PI / 2, 2.0 * M_PI * s / count, 0.0});
+    }
+    return speakers;
+}
+
+void test_delay_and_gain() {
+    std::cout << "Testing SpeakerRenderer delay and gain..." << std::endl;
+
+    const double sample_rate = 48000.0;
+    const size_t frames = 256;
+
+    SpeakerRenderer renderer;
+    renderer.setSpeakers(makeRing(12, 10.0));
+    assert(renderer.getStride() == 16);
+    renderer.prepare(sample_rate, frames, 4, 0.1);
+
+    SphericalCoord source{3.0, M_PI / 2, 0.4, 1.0};
+    renderer.setSource(0, source);
+    renderer.setSourceCount(1);
+
+    std::vector<float> gains(renderer.getStride());
+    std::vector<float> delays(renderer.getStride());
+    renderer.computeSourceGeometry(source, 1.0, InterferenceFieldType::CONSTRUCTIVE, gains.data(), delays.data());
+
+    // Импульс в первом отсчете появляется на каждом канале с его дробной задержкой
+    std::vector<float> impulse(frames, 0.0f);
+    impulse[0] = 1.0f;
+    const float* sources[] = {impulse.data()};
+
+    std::vector<std::vector<float>> planar(12, std::vector<float>(frames));
+    std::vector<float*> outputs;
+    for (auto& channel : planar) outputs.push_back(channel.data());
+    renderer.render(sources, frames, outputs.data());
+
+    for (size_t s = 0; s < 12; ++s) {
+        auto target = Kernels::toCartesian<double>(renderer.getSpeakers()[s]);
+        double distance = Kernels::distance(Kernels::toCartesian<double>(source), target);
+        double delay = distance / Kernels::kSpeedOfSound * sample_rate;
+        assert(std::abs(delays[s] - delay) < 1e-3);
+        assert(std::abs(gains[s] - 1.0 / (1.0 + 0.1 * distance)) < 1e-6);
+
+        size_t whole = static_cast<size_t>(std::floor(delays[s]));
+        float fraction = delays[s] - std::floor(delays[s]);
+        for (size_t t = 0; t < frames; ++t) {
+            float expected = 0.0f;
+            if (t == whole) expected = gains[s] * (1.0f - fraction);
+            if (t == whole + 1) expected = gains[s] * fraction;
+            assert(std::abs(planar[s][t] - expected) < 1e-5);
+        }
+    }
+
+    // Деструктивная интерференция инвертирует вес
+    renderer.computeSourceGeometry(source, 1.0, InterferenceFieldType::DESTRUCTIVE, gains.data(), delays.data());
+    for (size_t s = 0; s < 12; ++s) {
+        assert(gains[s] < 0.0f);
+    }
+
+    std::cout << "SpeakerRenderer delay and gain tests passed!" << std::endl;
+}
+
+void test_planar_matches_interleaved() {
+    std::cout << "Testing SpeakerRenderer output layouts..." << std::endl;
+
+    const size_t channels = 32;
+    const size_t frames = 128;
+    const size_t source_count = 5;
+
+    SpeakerRenderer planar_renderer;
+    SpeakerRenderer interleaved_renderer;
+    for (SpeakerRenderer* renderer : {&planar_renderer, &interleaved_renderer}) {
+        renderer->setSpeakers(makeRing(channels, 12.0));
+        renderer->prepare(48000.0, frames, 8, 0.1);
+        for (size_t j = 0; j < source_count; ++j) {
+            renderer->setSource(j, SphericalCoord{1.0 + j, 1.0, 0.7 * j, 0.5});
+        }
+        renderer->setSourceCount(source_count);
+    }
+
+    std::vector<std::vector<float>> signals(source_count, std::vector<float>(frames));
+    std::vector<const float*> sources;
+    for (size_t j = 0; j < source_count; ++j) {
+        sources.push_back(signals[j].data());
+    }
+
+    std::vector<std::vector<float>> planar(channels, std::vector<float>(frames));
+    std::vector<float*> outputs;
+    for (auto& channel : planar) outputs.push_back(channel.data());
+    std::vector<float> interleaved(channels * frames);
+
+    // Несколько блоков подряд: задержанный сигнал переходит через границу блока
+    for (int block = 0; block < 4; ++block) {
+        for (size_t j = 0; j < source_count; ++j) {
+            for (size_t t = 0; t < frames; ++t) {
+                signals[j][t] = static_cast<float>(std::sin(0.01 * (j + 1) * (block * frames + t)));
+            }
+        }
+        planar_renderer.render(sources.data(), frames, outputs.data());
+        interleaved_renderer.renderInterleaved(sources.data(), frames, interleaved.data());
+
+        for (size_t t = 0; t < frames; ++t) {
+            for (size_t s = 0; s < channels; ++s) {
+                assert(std::isfinite(planar[s][t]));
+                assert(planar[s][t] == interleaved[t * channels + s]);
+            }
+        }
+    }
+
+    std::cout << "SpeakerRenderer output layout tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== SpeakerRenderer Tests ===" << std::endl;
+
+    try {
+        test_delay_and_gain();
+        test_planar_matches_interleaved();
+
+        std::cout << "All speaker renderer tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
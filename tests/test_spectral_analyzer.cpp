@@ -0,0 +1,143 @@
+#include "../src/spectral_analyzer.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace AnantaDigital;
+
+void test_real_fft() {
+    std::cout << "Testing RealFFT against direct DFT..." << std::endl;
+
+    for (size_t size : {4u, 8u, 64u, 1024u}) {
+        RealFFT fft(size);
+        assert(fft.size() == size);
+
+        std::vector<float> signal(size);
+        for (size_t n = 0; n < size; ++n) {
+            signal[n] = static_cast<float>(std::sin(0.37 * n) + 0.25 * std::cos(1.9 * n) + 0.1);
+        }
+
+        std::vector<float> data = signal;
+        fft.forward(data.data());
+
+        for (size_t k = 0; k <= size / 2; ++k) {
+            std::complex<double> expected(0.0, 0.0);
+            for (size_t n = 0; n < size; ++n) {
+                double angle = -2.0 * M_PI * static_cast<double>(k * n) / static_cast<double>(size);
+                expected += static_cast<double>(signal[n]) * std::complex<double>(std::cos(angle), std::sin(angle));
+            }
+            std::complex<float> actual = RealFFT::bin(data.data(), k, size);
+            assert(std::abs(std::complex<double>(actual) - expected) < 1e-3 * std::sqrt(static_cast<double>(size)));
+        }
+
+        // Обратное преобразование восстанавливает сигнал
+        fft.inverse(data.data());
+        for (size_t n = 0; n < size; ++n) {
+            assert(std::abs(data[n] - signal[n]) < 1e-4);
+        }
+    }
+
+    // Размер округляется до степени двойки
+    assert(RealFFT(1000).size() == 1024);
+
+    std::cout << "RealFFT tests passed!" << std::endl;
+}
+
+void test_peak_extraction() {
+    std::cout << "Testing SpectralAnalyzer peak extraction..." << std::endl;
+
+    const double sample_rate = 48000.0;
+    SpectralAnalyzer analyzer(2048, 512, WindowType::HANN);
+    analyzer.setSampleRate(sample_rate);
+
+    std::vector<float> input(8192);
+    for (size_t n = 0; n < input.size(); ++n) {
+        input[n] = static_cast<float>(0.5 * std::sin(2.0 * M_PI * 440.0 * n / sample_rate) +
+                                      0.2 * std::sin(2.0 * M_PI * 3100.0 * n / sample_rate));
+    }
+
+    // Кадры завершаются каждые hop_size отсчетов, в том числе внутри одного вызова
+    size_t frames = 0;
+    for (size_t offset = 0; offset < input.size(); offset += 300) {
+        size_t count = std::min<size_t>(300, input.size() - offset);
+        frames += analyzer.process(input.data() + offset, count);
+    }
+    assert(frames == input.size() / 512);
+    assert(analyzer.getFrameCount() == frames);
+
+    const auto& peaks = analyzer.getPeaks();
+    assert(peaks.size() >= 2);
+    assert(std::abs(peaks[0].frequency - 440.0) < 2.0);
+    assert(std::abs(peaks[0].amplitude - 0.5) < 0.05);
+    assert(std::abs(peaks[1].frequency - 3100.0) < 2.0);
+    assert(std::abs(peaks[1].amplitude - 0.2) < 0.02);
+
+    // Ограничение числа пиков
+    analyzer.setMaxPeaks(1);
+    analyzer.process(input.data(), 512);
+    assert(analyzer.getPeaks().size() == 1);
+
+    // Тишина не дает пиков
+    std::vector<float> silence(2048, 0.0f);
+    analyzer.reset();
+    analyzer.process(silence.data(), silence.size());
+    assert(analyzer.getPeaks().empty());
+
+    std::cout << "SpectralAnalyzer peak extraction tests passed!" << std::endl;
+}
+
+void test_overlap_add() {
+    std::cout << "Testing SpectralAnalyzer overlap-add..." << std::endl;
+
+    SpectralAnalyzer analyzer(1024, 256, WindowType::HANN);
+    const size_t latency = analyzer.getLatency();
+
+    std::vector<float> input(8192);
+    for (size_t n = 0; n < input.size(); ++n) {
+        input[n] = static_cast<float>(std::sin(0.05 * n) * std::cos(0.003 * n));
+    }
+
+    std::vector<float> output(input.size());
+    for (size_t offset = 0; offset < input.size(); offset += 100) {
+        size_t count = std::min<size_t>(100, input.size() - offset);
+        analyzer.process(input.data() + offset, output.data() + offset, count);
+    }
+
+    // Без обработки спектра выход повторяет вход с задержкой fft_size
+    for (size_t n = 2 * latency; n < output.size(); ++n) {
+        assert(std::abs(output[n] - input[n - latency]) < 1e-4);
+    }
+
+    // Обработчик спектра применяется перед синтезом
+    analyzer.reset();
+    analyzer.setSpectrumProcessor([](float* spectrum, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            spectrum[i] *= 0.5f;
+        }
+    });
+    analyzer.process(input.data(), output.data(), input.size());
+    for (size_t n = 2 * latency; n < output.size(); ++n) {
+        assert(std::abs(output[n] - 0.5f * input[n - latency]) < 1e-4);
+    }
+
+    std::cout << "SpectralAnalyzer overlap-add tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== SpectralAnalyzer Tests ===" << std::endl;
+
+    try {
+        test_real_fft();
+        test_peak_extraction();
+        test_overlap_add();
+
+        std::cout << "All spectral analyzer tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,155 @@
+#include "../src/spectral_synthesizer.hpp"
+#include "../src/anantadigital_core.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+using namespace AnantaDigital;
+
+// Одинаковые партиалы в двух банках
+static void fillBanks(OscillatorBank& a, OscillatorBank& b, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        double frequency = 50.0 + std::fmod(i * 137.3, 20000.0);
+        double amplitude = 0.01 * (1 + i % 7);
+        a.addOscillator(frequency, amplitude, i * 0.7);
+        b.addOscillator(frequency, amplitude, i * 0.7);
+    }
+}
+
+// Отношение сигнал/ошибка в дБ
+static double snr(const std::vector<float>& reference, const std::vector<float>& test, size_t begin = 0) {
+    double signal = 0.0, error = 0.0;
+    for (size_t t = begin; t < reference.size(); ++t) {
+        double d = static_cast<double>(reference[t]) - test[t];
+        signal += static_cast<double>(reference[t]) * reference[t];
+        error += d * d;
+    }
+    return 10.0 * std::log10(signal / std::max(error, 1e-30));
+}
+
+void test_frame_size() {
+    std::cout << "Testing frame size..." << std::endl;
+
+    assert(SpectralSynthesizer(1000).getFrameSize() == 1024);
+    assert(SpectralSynthesizer(1000).getHopSize() == 256);
+    assert(SpectralSynthesizer(3).getFrameSize() == 64);
+    assert(SpectralSynthesizer().getFrameSize() == 2048);
+
+    std::cout << "Frame size tests passed!" << std::endl;
+}
+
+void test_matches_oscillator_bank() {
+    std::cout << "Testing spectral synthesis against oscillator bank..." << std::endl;
+
+    OscillatorBank reference(48000.0), spectral_bank(48000.0);
+    fillBanks(reference, spectral_bank, 200);
+
+    // Блоки не кратны шагу кадра; первый блок без нарастания
+    SpectralSynthesizer synthesizer;
+    std::vector<float> expected(24000), actual(24000);
+    reference.render(expected.data(), expected.size());
+    for (size_t position = 0; position < actual.size(); position += 300) {
+        synthesizer.render(spectral_bank, actual.data() + position, std::min<size_t>(300, actual.size() - position));
+    }
+    assert(synthesizer.isPrimed());
+    assert(snr(expected, actual) > 55.0);
+    assert(std::abs(expected[0] - actual[0]) < 1e-3f);
+
+    // Фазы банка продвинуты так же, как при синтезе осцилляторами
+    for (size_t i = 0; i < reference.size(); ++i) {
+        double difference = std::remainder(reference.getPhase(i) - spectral_bank.getPhase(i), 2.0 * M_PI);
+        assert(std::abs(difference) < 5e-3);
+    }
+
+    std::cout << "Spectral synthesis tests passed!" << std::endl;
+}
+
+void test_path_switching() {
+    std::cout << "Testing seamless switching between synthesis paths..." << std::endl;
+
+    OscillatorBank reference(48000.0), switched(48000.0);
+    fillBanks(reference, switched, 64);
+
+    SpectralSynthesizer synthesizer(1024);
+    std::vector<float> expected(12000), actual(12000);
+    reference.render(expected.data(), expected.size());
+
+    // Осцилляторы -> БПФ -> осцилляторы -> БПФ после reset()
+    switched.render(actual.data(), 2000);
+    synthesizer.render(switched, actual.data() + 2000, 3000);
+    switched.render(actual.data() + 5000, 3000);
+    synthesizer.reset();
+    assert(!synthesizer.isPrimed());
+    synthesizer.render(switched, actual.data() + 8000, 4000);
+
+    assert(snr(expected, actual) > 55.0);
+    float worst = 0.0f;
+    for (size_t t = 0; t < expected.size(); ++t) {
+        worst = std::max(worst, std::abs(expected[t] - actual[t]));
+    }
+    assert(worst < 0.01f);
+
+    std::cout << "Path switching tests passed!" << std::endl;
+}
+
+void test_core_auto_switch() {
+    std::cout << "Testing AnantaDigitalCore automatic switch..." << std::endl;
+
+    auto makeCore = []() {
+        auto core = std::make_unique<AnantaDigitalCore>(10.0, 5.0);
+        core->initialize();
+        core->prepareBlockProcessing(48000.0, 256);
+        for (size_t k = 0; k < 300; ++k) {
+            SphericalCoord position{2.0 + 0.01 * k, M_PI / 3, 0.01 * k, 1.0};
+            core->processSoundField(core->createQuantumSoundField(200.0 + 7.0 * k, position, QuantumSoundState::COHERENT));
+        }
+        return core;
+    };
+    auto oscillators = makeCore();
+    auto spectral = makeCore();
+    assert(spectral->getSpectralSynthesisThreshold() == 0);
+    spectral->setSpectralSynthesisThreshold(256);
+    assert(spectral->getSpectralSynthesisThreshold() == 256);
+
+    std::vector<float> expected(8192), actual(8192);
+    for (size_t position = 0; position < expected.size(); position += 512) {
+        oscillators->generateOutput(expected.data() + position, 512);
+        spectral->generateOutput(actual.data() + position, 512);
+        assert(spectral->isSpectralSynthesisActive() && !oscillators->isSpectralSynthesisActive());
+    }
+    // Нарастание новых полей короче кадра и растягивается на кадр: сравнение после него
+    assert(snr(expected, actual, 4096) > 50.0);
+
+    // Выше 7/8 порога путь сохраняется, ниже — возврат к осцилляторам
+    spectral->setSpectralSynthesisThreshold(330);
+    spectral->generateOutput(actual.data(), 512);
+    assert(spectral->isSpectralSynthesisActive());
+    spectral->setSpectralSynthesisThreshold(400);
+    spectral->generateOutput(actual.data(), 512);
+    assert(!spectral->isSpectralSynthesisActive());
+    spectral->setSpectralSynthesisThreshold(0);
+    spectral->generateOutput(actual.data(), 512);
+    assert(!spectral->isSpectralSynthesisActive());
+
+    std::cout << "AnantaDigitalCore automatic switch tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== SpectralSynthesizer Tests ===" << std::endl;
+
+    try {
+        test_frame_size();
+        test_matches_oscillator_bank();
+        test_path_switching();
+        test_core_auto_switch();
+
+        std::cout << "All spectral synthesizer tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
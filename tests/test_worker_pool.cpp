@@ -0,0 +1,119 @@
+#include "../src/worker_pool.hpp"
+#include "../src/multi_venue_engine.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <atomic>
+
+using namespace AnantaDigital;
+
+void test_each_task_runs_once() {
+    std::cout << "Testing WorkerPool task distribution..." << std::endl;
+    
+    WorkerPool pool(4);
+    assert(pool.getWorkerCount() == 4);
+    
+    std::vector<std::atomic<int>> hits(1000);
+    for (int block = 0; block < 200; ++block) {
+        for (auto& hit : hits) {
+            hit.store(0);
+        }
+        
+        size_t count = 1 + (block * 37) % hits.size();
+        pool.run(count, [&](size_t task, size_t worker) {
+            assert(worker < 4);
+            hits[task].fetch_add(1);
+        });
+        
+        // После run() все задачи блока выполнены ровно один раз
+        for (size_t i = 0; i < hits.size(); ++i) {
+            assert(hits[i].load() == (i < count ? 1 : 0));
+        }
+    }
+    
+    // Разбиение по потокам покрывает все задачи без пропусков
+    for (size_t task = 0; task < 10; ++task) {
+        assert(pool.homeWorker(task, 10) < 4);
+    }
+    assert(pool.homeWorker(0, 10) == 0);
+    assert(pool.homeWorker(9, 10) == 3);
+    
+    std::cout << "WorkerPool task distribution tests passed!" << std::endl;
+}
+
+void test_multi_venue_engine() {
+    std::cout << "Testing MultiVenueEngine..." << std::endl;
+    
+    const size_t venues = 6;
+    const size_t frames = 64;
+    
+    MultiVenueEngine engine(3, false);
+    for (size_t i = 0; i < venues; ++i) {
+        auto core = std::make_unique<AnantaDigitalCore>(8.0 + i, 4.0);
+        core->initialize();
+        engine.addVenue(std::move(core));
+    }
+    assert(engine.getVenueCount() == venues);
+    engine.prepare(48000.0, frames);
+    
+    for (size_t i = 0; i < venues; ++i) {
+        SphericalCoord position{1.0, M_PI / 2, 0.0, 1.0};
+        AnantaDigitalCore* core = engine.getVenue(i);
+        core->processSoundField(core->createQuantumSoundField(220.0 * (i + 1), position, QuantumSoundState::COHERENT));
+    }
+    
+    std::vector<std::vector<float>> buffers(venues, std::vector<float>(frames));
+    std::vector<float*> outputs(venues);
+    for (size_t i = 0; i < venues; ++i) {
+        outputs[i] = buffers[i].data();
+    }
+    
+    for (int block = 0; block < 50; ++block) {
+        engine.processBlock(nullptr, outputs.data(), frames);
+    }
+    
+    for (size_t i = 0; i < venues; ++i) {
+        double energy = 0.0;
+        for (float sample : buffers[i]) {
+            assert(std::isfinite(sample));
+            energy += sample * sample;
+        }
+        assert(energy > 0.0);
+        
+        auto stats = engine.getVenueStatistics(i);
+        assert(stats.blocks == 50);
+        assert(stats.last_worker < engine.getWorkerCount());
+        assert(stats.home_worker < engine.getWorkerCount());
+        assert(stats.peak_cpu_us >= stats.last_cpu_us);
+    }
+    
+    // Новые купола сверх прежней емкости не сбрасывают статистику остальных
+    for (size_t i = 0; i < 4; ++i) {
+        auto core = std::make_unique<AnantaDigitalCore>(8.0, 4.0);
+        core->initialize();
+        engine.addVenue(std::move(core));
+    }
+    for (size_t i = 0; i < venues; ++i) {
+        assert(engine.getVenueStatistics(i).blocks == 50);
+    }
+    assert(engine.getVenueStatistics(venues).blocks == 0);
+    
+    std::cout << "MultiVenueEngine tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "=== WorkerPool Tests ===" << std::endl;
+    
+    try {
+        test_each_task_runs_once();
+        test_multi_venue_engine();
+        
+        std::cout << "All worker pool tests passed!" << std::endl;
+        return 0;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}